@@ -0,0 +1,138 @@
+#ifndef CONFLICTGRAPH_H
+#define CONFLICTGRAPH_H
+
+#include <module.h>
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+/**
+ *  @class ConflictGraph
+ *  @brief The graph of modules, that can not be scheduled at the same time
+ *
+ *  Two modules conflict, if they share a group. The graph is stored in
+ * compressed sparse row form: the neighbors of module i are
+ * getAdjacency()[getOffsets()[i]] to getAdjacency()[getOffsets()[i + 1] - 1],
+ * sorted by index. Modules are identified by their index in the list passed
+ * to the constructor. The graph is a snapshot, it does not follow changes of
+ * the modules.
+ */
+class ConflictGraph {
+ public:
+  /**
+   *  @brief Creates the conflict graph of some modules
+   *  @param modules are the modules
+   *
+   *  Uses an index from groups to modules, so building the components takes
+   * time linear in the number of group memberships. Building the adjacency
+   * takes time linear in its size.
+   */
+  explicit ConflictGraph(const QList<Module*>& modules);
+
+  QList<Module*> getModules() const;
+  int getModuleCount() const;
+
+  /**
+   *  @brief Get the index of a module
+   *  @param [in] module is the module
+   *  @return The index or -1 if the module is not in the graph
+   */
+  int indexOf(Module* module) const;
+
+  const QVector<int>& getOffsets() const;
+  const QVector<int>& getAdjacency() const;
+
+  /**
+   *  @brief Get the modules conflicting with a module
+   *  @param [in] module is the index of the module
+   *  @return The indices of the conflicting modules in ascending order
+   */
+  QVector<int> getNeighbors(int module) const;
+
+  /**
+   *  @brief Check if two modules conflict
+   *  @param [in] first is the index of the first module
+   *  @param [in] second is the index of the second module
+   *  @return True if the modules share a group
+   */
+  bool conflicts(int first, int second) const;
+
+  int getDegree(int module) const;
+  int getEdgeCount() const;
+  int getMinimumDegree() const;
+  int getMaximumDegree() const;
+  double getAverageDegree() const;
+
+  /**
+   *  @brief Get the size of a large clique
+   *  @return The number of modules in the clique
+   *
+   *  All modules of a group form a clique. The largest of these cliques is
+   * extended greedily by modules conflicting with all of its members, so the
+   * result is a lower bound for the size of the largest clique and for the
+   * number of timeslots a conflict free schedule needs.
+   */
+  int getCliqueLowerBound() const;
+
+  /**
+   *  @brief Get a lower bound for the number of timeslots
+   *  @return The number of timeslots
+   *
+   *  Like getCliqueLowerBound, but counts every module of a clique with its
+   * examDuration, as the exams of a clique can not overlap.
+   */
+  int getRequiredSlotsLowerBound() const;
+
+  /**
+   *  @brief Get the modules of the largest clique
+   *  @return The indices of the modules of the clique found by
+   * getCliqueLowerBound
+   */
+  QVector<int> getClique() const;
+
+  int getComponentCount() const;
+
+  /**
+   *  @brief Get the component of a module
+   *  @param [in] module is the index of the module
+   *  @return The index of the connected component containing the module
+   *
+   *  Components are numbered in the order of their first module.
+   */
+  int getComponent(int module) const;
+
+  /**
+   *  @brief Get the modules of every connected component
+   *  @return A list containing the module indices of every component
+   */
+  QList<QVector<int>> getComponents() const;
+
+  /**
+   *  @brief Find the modules connected by shared groups
+   *  @param [in] moduleCount is the number of modules
+   *  @param [in] groupModules are the indices of the modules of every group
+   *  @param [out] components will contain the component of every module
+   *  @return The number of components
+   *
+   *  Uses a union-find over the modules of every group. Components are
+   * numbered in the order of their first module.
+   */
+  static int findComponents(int moduleCount,
+                            const QHash<Group*, QVector<int>>& groupModules,
+                            QVector<int>& components);
+
+ private:
+  QList<Module*> modules;
+  QHash<Module*, int> moduleIndices;
+  QVector<int> offsets;
+  QVector<int> adjacency;
+  QVector<int> components;
+  int componentCount;
+  QVector<int> clique;
+  int requiredSlots;
+
+  void buildAdjacency(const QHash<Group*, QVector<int>>& groupModules);
+  void buildClique(const QHash<Group*, QVector<int>>& groupModules);
+};
+
+#endif  // CONFLICTGRAPH_H
@@ -0,0 +1,127 @@
+#ifndef CONTENTHASH_H
+#define CONTENTHASH_H
+
+#include <QJsonArray>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QUuid>
+#include <QtGlobal>
+
+/**
+ *  @class ContentHash
+ *  @brief Functions for building the content hashes of the data objects
+ *
+ *  Every data object keeps a 64 bit hash of its properties up to date. Objects
+ * owned by another object are included with their content hash, objects that
+ * are only referenced with their id. Unordered lists are combined with a sum,
+ * so adding, removing or changing a single element is possible in constant
+ * time.
+ */
+class ContentHash {
+ public:
+  /**
+   *  @brief Scramble the bits of a value
+   *  @param [in] value is the value
+   *  @return The scrambled value
+   */
+  static quint64 mix(quint64 value);
+
+  /**
+   *  @brief Combine a hash with another value, depending on the order
+   *  @param [in] seed is the hash built so far
+   *  @param [in] value is the value, that gets added
+   *  @return The combined hash
+   */
+  static quint64 combine(quint64 seed, quint64 value);
+
+  /**
+   *  @brief Hash a string
+   *  @param [in] string is the string
+   *  @return The hash of the string
+   */
+  static quint64 ofString(const QString& string);
+
+  /**
+   *  @brief Hash an id
+   *  @param [in] id is the id
+   *  @return The hash of the id
+   */
+  static quint64 ofId(const QUuid& id);
+
+  /**
+   *  @brief Replace one element in an unordered list hash
+   *  @param [in] hash is the hash of the list
+   *  @param [in] oldHash is the old hash of the element
+   *  @param [in] newHash is the new hash of the element
+   *  @return The hash of the list with the new element
+   */
+  static quint64 replace(quint64 hash, quint64 oldHash, quint64 newHash);
+
+  /**
+   *  @brief Hash the ids of a JSON array of references like ofIds
+   *  @param [in] references are the ids as strings
+   *  @param [in] ids are the ids, that can be resolved
+   *  @return The hash of the resolved references
+   *
+   *  References, that fromJsonObject would not resolve, are skipped.
+   */
+  static quint64 ofReferences(const QJsonArray& references,
+                              const QSet<QUuid>& ids);
+
+  /**
+   *  @brief Hash a referenced object as an element of an unordered list
+   *  @param [in] object is the object or a nullptr
+   *  @return The hash of the id of the object or 0 for a nullptr
+   */
+  template <typename T>
+  static quint64 ofReference(const T* object) {
+    return object != nullptr ? mix(ofId(object->getId())) : 0;
+  }
+
+  /**
+   *  @brief Hash the ids of a list of referenced objects, ignoring the order
+   *  @param [in] objects are the objects
+   *  @return The hash of the list
+   */
+  template <typename T>
+  static quint64 ofIds(const QList<T*>& objects) {
+    quint64 hash = 0;
+    for (T* object : objects) {
+      hash += ofReference(object);
+    }
+    return hash;
+  }
+
+  /**
+   *  @brief Hash the contents of a list of owned objects, ignoring the order
+   *  @param [in] objects are the objects
+   *  @return The hash of the list
+   */
+  template <typename T>
+  static quint64 ofContents(const QList<T*>& objects) {
+    quint64 hash = 0;
+    for (T* object : objects) {
+      if (object != nullptr) {
+        hash += mix(object->getContentHash());
+      }
+    }
+    return hash;
+  }
+
+  /**
+   *  @brief Hash the contents of a list of owned objects in their order
+   *  @param [in] objects are the objects
+   *  @return The hash of the list
+   */
+  template <typename T>
+  static quint64 ofOrderedContents(const QList<T*>& objects) {
+    quint64 hash = objects.size();
+    for (T* object : objects) {
+      hash = combine(hash, object != nullptr ? object->getContentHash() : 0);
+    }
+    return hash;
+  }
+};
+
+#endif  // CONTENTHASH_H
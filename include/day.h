@@ -26,13 +26,42 @@ class Day : public SerializableDataObject {
   QList<Timeslot*> getTimeslots() const;
   void setTimeslots(QList<Timeslot*> timeslots);
 
+  /**
+   *  @brief Get the hash of the contents of this day
+   *  @return The content hash
+   *
+   *  Includes the content hashes of the timeslots, so it changes whenever
+   * one of them changes.
+   */
+  quint64 getContentHash() const;
+
+  /**
+   *  @brief Get the content hash of a day without creating it
+   *  @param [in] content is the JSON object of the day
+   *  @param [in] moduleIds are the ids of the modules of the plan
+   *  @param [in] groupIds are the ids of the groups and constraints of the
+   * plan
+   *  @return The hash the day would have after fromJsonObject
+   */
+  static quint64 contentHashOf(const QJsonObject& content,
+                               const QSet<QUuid>& moduleIds,
+                               const QSet<QUuid>& groupIds);
+
  signals:
   void nameChanged(const QString name);
   void timeslotsChanged(const QList<Timeslot*> timeslots);
+  void contentHashChanged(const quint64 oldHash, const quint64 newHash);
 
  private:
   QString name;
   QList<Timeslot*> timeslots;
+  quint64 contentHash;
+
+  void updateContentHash();
+  static quint64 hashOf(const QUuid& id,
+                        const QString& name,
+                        quint64 timeslotsHash);
+  void trackTimeslots(const QList<Timeslot*>& timeslots, bool track);
 };
 
 #endif  // DAY_H
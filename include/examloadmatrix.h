@@ -0,0 +1,151 @@
+#ifndef EXAMLOADMATRIX_H
+#define EXAMLOADMATRIX_H
+
+#include <plan.h>
+#include <QHash>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+
+/**
+ *  @class ExamLoadMatrix
+ *  @brief Counts the exams of every group on every day of a plan
+ *
+ *  The counts are stored in a dense matrix with a row for every group of the
+ * plan and a column for every day of all weeks. An exam is a module of the
+ * group scheduled in a timeslot of the day, so a module in two timeslots of
+ * the same day counts twice. Adding or removing a module of a timeslot only
+ * updates the cells of its groups on that day. Replacing the modules of the
+ * plan only updates the cells of the added and removed modules. Changes to
+ * the groups, weeks, days or timeslots rebuild the whole matrix.
+ *
+ *  MoveEvaluator reads the exams per day from the matrix of the plan.
+ */
+class ExamLoadMatrix : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   *  @brief Creates the matrix for a plan
+   *  @param plan is the plan, that gets counted
+   *  @param parent is the parent QObject
+   */
+  explicit ExamLoadMatrix(Plan* plan, QObject* parent = nullptr);
+
+  /**
+   *  @brief Get the groups in the order of the rows
+   *  @return The groups of the plan
+   */
+  QList<Group*> getGroups() const;
+
+  /**
+   *  @brief Get the days in the order of the columns
+   *  @return All days of all weeks
+   */
+  QList<Day*> getDays() const;
+
+  /**
+   *  @brief Get the row of a group
+   *  @param [in] group is the group
+   *  @return The row or -1 if group is not a group of the plan
+   */
+  int indexOf(Group* group) const;
+
+  /**
+   *  @brief Get the column of a day
+   *  @param [in] day is the day
+   *  @return The column or -1 if day is not in the plan
+   */
+  int indexOf(Day* day) const;
+
+  /**
+   *  @brief Get the number of exams of a group on a day
+   *  @param [in] group is the row of the group
+   *  @param [in] day is the column of the day
+   *  @return The number of exams or 0 if an index is out of range
+   */
+  int getCount(int group, int day) const;
+  int getCount(Group* group, Day* day) const;
+
+  /**
+   *  @brief Get the number of exams of a group on every day
+   *  @param [in] group is the group
+   *  @return The row of group, which is empty for unknown groups
+   */
+  QVector<int> getCounts(Group* group) const;
+
+  /**
+   *  @brief Get the number of exams of a group in the whole plan
+   *  @param [in] group is the group
+   *  @return The sum of the row of group
+   */
+  int getTotal(Group* group) const;
+
+  /**
+   *  @brief Check if a group has more exams on a day than allowed
+   *  @param [in] group is the group
+   *  @param [in] day is the day
+   *  @return True if the count exceeds Group::getExamsPerDay
+   */
+  bool isOverloaded(Group* group, Day* day) const;
+
+  /**
+   *  @brief Get the days a group has more exams than allowed
+   *  @param [in] group is the group
+   *  @return The days in the order of the plan
+   */
+  QList<Day*> getOverloadedDays(Group* group) const;
+
+  /**
+   *  @brief Check if another exam of a module fits on a day
+   *  @param [in] module is the module
+   *  @param [in] day is the day
+   *  @return True if none of the groups of module would exceed
+   * Group::getExamsPerDay
+   */
+  bool canAdd(Module* module, Day* day) const;
+
+ signals:
+  void countChanged(Group* group, Day* day, int count, int previousCount);
+  /**
+   *  @brief Emitted after all counts were recreated without single
+   * countChanged signals
+   */
+  void rebuilt();
+
+ public slots:
+  /**
+   *  @brief Recreate the matrix from the current state of the plan
+   */
+  void rebuild();
+
+ private:
+  QPointer<Plan> plan;
+  QList<QMetaObject::Connection> connections;
+  QHash<Module*, QMetaObject::Connection> moduleConnections;
+
+  QList<Group*> groups;
+  QHash<Group*, int> groupIndices;
+  QList<Day*> days;
+  QHash<Day*, int> dayIndices;
+  QVector<int> counts;
+  QVector<int> totals;
+
+  QHash<Timeslot*, int> slotDays;
+  QHash<Timeslot*, QList<Module*>> scheduledModules;
+  // The groups of every module of the plan, only these modules are counted
+  QHash<Module*, QList<Group*>> moduleGroups;
+  // The day of every timeslot a module is scheduled in, also for modules,
+  // that are not in the plan
+  QHash<Module*, QList<int>> moduleDays;
+
+  void disconnectAll();
+  void updateTimeslot(Timeslot* timeslot);
+  void updateModule(Module* module);
+  void updateModules(const QList<Module*>& modules);
+  void add(const QList<Group*>& affected, int day, int count, bool notify);
+};
+
+#endif  // EXAMLOADMATRIX_H
@@ -0,0 +1,124 @@
+#ifndef FEASIBLESLOTINDEX_H
+#define FEASIBLESLOTINDEX_H
+
+#include <groupindex.h>
+#include <plan.h>
+#include <QHash>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+#include "slotmask.h"
+
+/**
+ *  @class FeasibleSlotIndex
+ *  @brief Keeps track of the timeslots every module of a plan can start in
+ *
+ *  A module can start in a timeslot, if all of its groups and constraints are
+ * active in it. Modules with an examDuration of 2 additionally need all of
+ * them to be active in the next timeslot of the same day.
+ *
+ *  The index follows the plan through its GroupIndex, which already knows the
+ * timeslots and modules of every group. The masks are updated incrementally,
+ * when the active groups of a timeslot or the groups, constraints or
+ * examDuration of a module change. Adding or removing modules only adds or
+ * removes their masks. Changes to the weeks, days or timeslots rebuild the
+ * whole index after the GroupIndex was rebuilt.
+ */
+class FeasibleSlotIndex : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   *  @brief Creates an index for a plan
+   *  @param plan is the plan, that gets indexed
+   *  @param parent is the parent QObject
+   */
+  explicit FeasibleSlotIndex(Plan* plan, QObject* parent = nullptr);
+
+  /**
+   *  @brief Get the number of timeslots in the plan
+   *  @return The size of all masks
+   */
+  int getSlotCount() const;
+
+  /**
+   *  @brief Get the timeslots in the order of the mask bits
+   *  @return All timeslots of all days of all weeks
+   */
+  QList<Timeslot*> getTimeslots() const;
+
+  /**
+   *  @brief Get the index of a timeslot
+   *  @param [in] timeslot is the timeslot
+   *  @return The index of the bit of timeslot or -1 if it is not in the plan
+   */
+  int indexOf(Timeslot* timeslot) const;
+
+  /**
+   *  @brief Get the timeslots a group is active in
+   *  @param [in] group is a group or constraint
+   *  @return The mask of the timeslots
+   */
+  SlotMask getAvailability(Group* group) const;
+
+  /**
+   *  @brief Get the timeslots a module can start in
+   *  @param [in] module is the module
+   *  @return The mask of the timeslots, which is empty for unknown modules
+   */
+  SlotMask getFeasibleSlots(Module* module) const;
+
+  /**
+   *  @brief Get the timeslots a module can start in
+   *  @param [in] module is the module
+   *  @return The timeslots in the order of the plan
+   */
+  QList<Timeslot*> getFeasibleTimeslots(Module* module) const;
+
+  /**
+   *  @brief Check if a module can start in a timeslot
+   *  @param [in] module is the module
+   *  @param [in] timeslot is the timeslot
+   *  @return True if all groups and constraints of module are active
+   */
+  bool isFeasible(Module* module, Timeslot* timeslot) const;
+
+ signals:
+  void feasibleSlotsChanged(Module* module);
+
+ public slots:
+  /**
+   *  @brief Recreate the index from the current state of the plan
+   */
+  void rebuild();
+
+ private:
+  QPointer<Plan> plan;
+  QPointer<GroupIndex> groupIndex;
+  QHash<Module*, QMetaObject::Connection> moduleConnections;
+
+  QList<Timeslot*> timeslots;
+  QHash<Timeslot*, int> slotIndices;
+  // Bit i is set, if timeslot i + 1 is on the same day as timeslot i
+  SlotMask sameDaySuccessors;
+
+  // The masks of the groups and constraints of all modules
+  QHash<Group*, SlotMask> availability;
+  QHash<Module*, SlotMask> feasibleSlots;
+
+  void disconnectAll();
+  void insertModule(Module* module);
+  void removeModule(Module* module);
+  void insertAvailability(const QList<Group*>& groups);
+  void removeUnusedAvailability();
+  void updateTimeslot(Timeslot* timeslot,
+                      const QList<Group*>& removed,
+                      const QList<Group*>& added);
+  void updateModuleGroups(Module* module);
+  void updateModule(Module* module);
+  SlotMask calculateAvailability(Group* group) const;
+  SlotMask calculateFeasibleSlots(Module* module) const;
+};
+
+#endif  // FEASIBLESLOTINDEX_H
@@ -5,6 +5,7 @@ class Group;
 
 #include <QObject>
 #include <QString>
+#include "contenthash.h"
 #include "serializabledataobject.h"
 
 class Group : public SerializableDataObject {
@@ -39,6 +40,22 @@ class Group : public SerializableDataObject {
   void setObsolete(const bool obsolete);
   bool getObsolete() const;
 
+  /**
+   *  @brief Get the hash of the contents of this group
+   *  @return The content hash
+   *
+   *  Covers all properties. Two groups with the same id and the same
+   * properties have the same hash.
+   */
+  quint64 getContentHash() const;
+
+  /**
+   *  @brief Get the content hash of a group without creating it
+   *  @param [in] content is the JSON object of the group
+   *  @return The hash the group would have after fromJsonObject
+   */
+  static quint64 contentHashOf(const QJsonObject& content);
+
  signals:
   void nameChanged(const QString name);
   void selectedChanged(const bool selected);
@@ -46,6 +63,7 @@ class Group : public SerializableDataObject {
   void activeChanged(const bool active);
   void smallChanged(const bool small);
   void obsoleteChanged(const bool obsolete);
+  void contentHashChanged(const quint64 oldHash, const quint64 newHash);
 
  private:
   QString name;
@@ -54,6 +72,16 @@ class Group : public SerializableDataObject {
   bool active;
   bool small;
   bool obsolete;
+  quint64 contentHash;
+
+  void updateContentHash();
+  static quint64 hashOf(const QUuid& id,
+                        const QString& name,
+                        bool selected,
+                        unsigned int examsPerDay,
+                        bool active,
+                        bool small,
+                        bool obsolete);
 };
 
 #endif  // CONSTRAINT_H
@@ -0,0 +1,105 @@
+#ifndef GROUPINDEX_H
+#define GROUPINDEX_H
+
+#include <plan.h>
+#include <QHash>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+
+/**
+ *  @class GroupIndex
+ *  @brief Keeps track of the timeslots and modules of every group of a plan
+ *
+ *  The reverse of Timeslot::getActiveGroups and of Module::getGroups and
+ * Module::getConstraints. Changing the active groups of a timeslot or the
+ * groups of a module only updates the entries of the affected groups, in
+ * time proportional to the number of their timeslots and modules. Replacing
+ * the modules of the plan only updates the added and removed modules.
+ * Changes to the weeks, days or timeslots rebuild the whole index.
+ *
+ *  Every update is reported by a signal, so other indexes of the plan, like
+ * FeasibleSlotIndex, can follow the plan through this index. A rebuild only
+ * emits rebuilt.
+ */
+class GroupIndex : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   *  @brief Creates an index for a plan
+   *  @param plan is the plan, that gets indexed
+   *  @param parent is the parent QObject
+   */
+  explicit GroupIndex(Plan* plan, QObject* parent = nullptr);
+
+  /**
+   *  @brief Get the timeslots a group is active in
+   *  @param [in] group is a group or constraint
+   *  @return The timeslots in no particular order
+   */
+  QList<Timeslot*> getTimeslots(Group* group) const;
+
+  /**
+   *  @brief Get the modules a group belongs to
+   *  @param [in] group is a group or constraint
+   *  @return The modules, that have group as group or constraint, in no
+   * particular order
+   */
+  QList<Module*> getModules(Group* group) const;
+
+  /**
+   *  @brief Get the number of timeslots a group is active in
+   *  @param [in] group is a group or constraint
+   *  @return The number of timeslots
+   */
+  int getTimeslotCount(Group* group) const;
+
+  /**
+   *  @brief Get the number of modules a group belongs to
+   *  @param [in] group is a group or constraint
+   *  @return The number of modules
+   */
+  int getModuleCount(Group* group) const;
+
+  /**
+   *  @brief Get the groups and constraints of a module
+   *  @param [in] module is a module of the plan
+   *  @return The groups followed by the constraints of module, or an empty
+   * list for unknown modules
+   */
+  QList<Group*> getGroups(Module* module) const;
+
+ signals:
+  void activeGroupsChanged(Timeslot* timeslot,
+                           const QList<Group*>& removed,
+                           const QList<Group*>& added);
+  void moduleChanged(Module* module);
+  void moduleRemoved(Module* module);
+  void rebuilt();
+
+ public slots:
+  /**
+   *  @brief Recreate the index from the current state of the plan
+   */
+  void rebuild();
+
+ private:
+  QPointer<Plan> plan;
+  QList<QMetaObject::Connection> connections;
+  QHash<Module*, QList<QMetaObject::Connection>> moduleConnections;
+
+  QHash<Timeslot*, QList<Group*>> timeslotGroups;
+  QHash<Group*, QList<Timeslot*>> groupTimeslots;
+  QHash<Module*, QList<Group*>> moduleGroups;
+  QHash<Group*, QList<Module*>> groupModules;
+  bool rebuilding = false;
+
+  void disconnectAll();
+  void updateTimeslot(Timeslot* timeslot);
+  void updateModule(Module* module);
+  void updateModules(const QList<Module*>& modules);
+};
+
+#endif  // GROUPINDEX_H
@@ -0,0 +1,92 @@
+#ifndef IDINDEX_H
+#define IDINDEX_H
+
+#include <plan.h>
+#include <QHash>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+#include <QUuid>
+
+/**
+ *  @class IdIndex
+ *  @brief Maps the ids of all objects of a plan to the objects
+ *
+ *  Contains the plan, its groups, constraints, modules, weeks, days and
+ * timeslots. When one of the lists of the plan, of a week or of a day is
+ * replaced, only the added and removed objects are inserted or removed, so
+ * adding a single module does not reindex the whole plan.
+ */
+class IdIndex : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   *  @brief Creates an index for a plan
+   *  @param plan is the plan, that gets indexed
+   *  @param parent is the parent QObject
+   */
+  explicit IdIndex(Plan* plan, QObject* parent = nullptr);
+
+  /**
+   *  @brief Find an object of the plan
+   *  @param [in] id is the id of the object
+   *  @return The object or a nullptr if the plan has no object with id
+   */
+  SerializableDataObject* find(const QUuid& id) const;
+
+  /**
+   *  @brief Get the number of indexed objects
+   *  @return The number of objects including the plan
+   */
+  int getCount() const;
+
+  /**
+   *  @brief Get the ids of all indexed objects
+   *  @return The ids in no particular order
+   */
+  QList<QUuid> getIds() const;
+
+ signals:
+  void inserted(const QUuid& id);
+  void removed(const QUuid& id);
+
+ public slots:
+  /**
+   *  @brief Recreate the index from the current state of the plan
+   */
+  void rebuild();
+
+ private:
+  QPointer<Plan> plan;
+  QList<QMetaObject::Connection> planConnections;
+
+  QHash<QUuid, QPointer<SerializableDataObject>> objects;
+  QHash<QObject*, QUuid> ids;
+  // The lists of the plan, weeks and days as they were indexed
+  QList<QObject*> groups;
+  QList<QObject*> constraints;
+  QList<QObject*> modules;
+  QList<QObject*> weeks;
+  QHash<QObject*, QList<QObject*>> children;
+  QHash<QObject*, QMetaObject::Connection> childConnections;
+
+  void clear();
+  void insert(SerializableDataObject* object);
+  void remove(QObject* object);
+  void insertWeek(Week* week);
+  void removeWeek(QObject* week);
+  void insertDay(Day* day);
+  void removeDay(QObject* day);
+  void updateWeek(Week* week);
+  void updateDay(Day* day);
+
+  template <typename T, typename Insert, typename Remove>
+  void updateList(QList<QObject*>& known,
+                  const QList<T*>& current,
+                  Insert insertObject,
+                  Remove removeObject);
+};
+
+#endif  // IDINDEX_H
@@ -0,0 +1,85 @@
+#ifndef MEMORYFOOTPRINT_H
+#define MEMORYFOOTPRINT_H
+
+#include <QDebug>
+#include <QJsonValue>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include "plan.h"
+#include "semester.h"
+
+/**
+ *  @struct MemoryFootprint
+ *  @brief The approximate heap usage of a part of the datamodel in bytes
+ *
+ *  The object categories contain the size of the objects themselves. The
+ * memory used by strings, QList storage and signal connections of all objects
+ * is accounted separately in strings, lists and connections. Plans of a
+ * semester, that are not loaded, only count with their JSON in planContents.
+ */
+struct MemoryFootprint {
+  qint64 semesters = 0;
+  qint64 plans = 0;
+  qint64 modules = 0;
+  qint64 groups = 0;
+  qint64 weeks = 0;
+  qint64 days = 0;
+  qint64 timeslots = 0;
+  qint64 strings = 0;
+  qint64 lists = 0;
+  qint64 connections = 0;
+  qint64 planContents = 0;
+
+  /**
+   *  @brief Get the sum of all categories
+   *  @return The approximate total footprint in bytes
+   */
+  qint64 total() const;
+
+  MemoryFootprint& operator+=(const MemoryFootprint& other);
+};
+
+QDebug operator<<(QDebug debug, const MemoryFootprint& footprint);
+
+/**
+ *  @class MemoryFootprintHelper
+ *  @brief A helper for estimating the memory used by plans and semesters
+ *
+ *  The footprint is calculated by walking the object tree, so nothing gets
+ * serialized. All values are estimates, because Qt does not expose the exact
+ * size of its private data. Implicitly shared data is counted for every
+ * object, that references it.
+ */
+class MemoryFootprintHelper {
+ public:
+  /**
+   *  @brief Estimate the memory used by a plan and all of its children
+   *  @param [in] plan is the plan that will be measured
+   *  @return The footprint of the plan. Empty, if plan is a nullptr
+   */
+  static MemoryFootprint measure(const Plan* plan);
+
+  /**
+   *  @brief Estimate the memory used by a semester and its plans
+   *  @param [in] semester is the semester that will be measured
+   *  @return The footprint of the semester. Empty, if semester is a nullptr
+   */
+  static MemoryFootprint measure(const Semester* semester);
+
+ private:
+  static void addObject(MemoryFootprint& footprint,
+                        qint64& category,
+                        const QObject* object,
+                        qint64 objectSize);
+  static void addModule(MemoryFootprint& footprint, const Module* module);
+  static void addGroup(MemoryFootprint& footprint, const Group* group);
+  static void addWeek(MemoryFootprint& footprint, const Week* week);
+  static qint64 stringSize(const QString& string);
+  template <typename T>
+  static qint64 listSize(const QList<T>& list);
+  static qint64 connectionsSize(const QObject* object);
+  static qint64 jsonSize(const QJsonValue& value);
+};
+
+#endif  // MEMORYFOOTPRINT_H
@@ -5,9 +5,11 @@ class Module;
 
 #include <QList>
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <iostream>
 #include <vector>
+#include "contenthash.h"
 #include "group.h"
 #include "plan.h"
 #include "serializabledataobject.h"
@@ -25,6 +27,7 @@ class Module : public SerializableDataObject {
                  examTypeChanged)
   Q_PROPERTY(unsigned int examDuration READ getExamDuration WRITE
                  setExamDuration NOTIFY examDurationChanged)
+  Q_PROPERTY(bool pinned READ getPinned WRITE setPinned NOTIFY pinnedChanged)
   Q_PROPERTY(QList<Group*> constraints READ getConstraints WRITE setConstraints
                  NOTIFY constraintsChanged)
   Q_PROPERTY(
@@ -49,11 +52,41 @@ class Module : public SerializableDataObject {
   void setExamType(QString examType);
   unsigned int getExamDuration() const;
   void setExamDuration(unsigned int examDuration);
+  /**
+   *  @brief Check if the module keeps its timeslots
+   *  @return True if the module is pinned
+   *
+   *  Pinned modules are not moved by PlanCsvHelper::readSchedule. A
+   * PlanCsvHelper with fixed pinned modules exports them as fixed
+   * assignments.
+   */
+  bool getPinned() const;
+  void setPinned(const bool pinned);
   QList<Group*> getConstraints() const;
   void setConstraints(QList<Group*> constraints);
   QList<Group*> getGroups() const;
   void setGroups(QList<Group*> groups);
 
+  /**
+   *  @brief Get the hash of the contents of this module
+   *  @return The content hash
+   *
+   *  Covers all properties. Groups and constraints are only included with
+   * their ids, so changing a group does not change the hash of the module.
+   */
+  quint64 getContentHash() const;
+
+  /**
+   *  @brief Get the content hash of a module without creating it
+   *  @param [in] content is the JSON object of the module
+   *  @param [in] groupIds are the ids of the groups of the plan
+   *  @param [in] constraintIds are the ids of the constraints of the plan
+   *  @return The hash the module would have after fromJsonObject
+   */
+  static quint64 contentHashOf(const QJsonObject& content,
+                               const QSet<QUuid>& groupIds,
+                               const QSet<QUuid>& constraintIds);
+
  public slots:
   void removeGroup(Group* group);
   void removeConstraint(Group* constraint);
@@ -67,6 +100,8 @@ class Module : public SerializableDataObject {
   void groupsChanged(const QList<Group*> groups);
   void examTypeChanged(const QString examType);
   void examDurationChanged(const unsigned int examDuration);
+  void pinnedChanged(const bool pinned);
+  void contentHashChanged(const quint64 oldHash, const quint64 newHash);
 
  private:
   QString name;
@@ -75,8 +110,22 @@ class Module : public SerializableDataObject {
   bool active;
   QString examType;
   unsigned int examDuration;
+  bool pinned;
   QList<Group*> constraints;
   QList<Group*> groups;
+  quint64 contentHash;
+
+  void updateContentHash();
+  static quint64 hashOf(const QUuid& id,
+                        const QString& name,
+                        const QString& origin,
+                        const QString& number,
+                        bool active,
+                        const QString& examType,
+                        unsigned int examDuration,
+                        bool pinned,
+                        quint64 constraintsHash,
+                        quint64 groupsHash);
 };
 
 #endif  // MODULE_H
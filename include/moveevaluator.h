@@ -0,0 +1,197 @@
+#ifndef MOVEEVALUATOR_H
+#define MOVEEVALUATOR_H
+
+#include <examloadmatrix.h>
+#include <plan.h>
+#include <QHash>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QPair>
+#include <QPointer>
+#include <QVector>
+#include "slotmask.h"
+
+/**
+ *  @struct ScheduleCost
+ *  @brief The violated soft constraints of a schedule or the change of them
+ */
+struct ScheduleCost {
+  /**
+   *  For every group and timeslot the number of scheduled modules of the group
+   * in the timeslot minus one
+   */
+  int collisions = 0;
+  /**
+   *  For every group and day the number of exams of the group on that day
+   * exceeding its examsPerDay
+   */
+  int examsPerDayOverflow = 0;
+  /**
+   *  The number of timeslots occupied by a group or constraint, that is not
+   * active in them
+   */
+  int blockedSlots = 0;
+
+  /**
+   *  @brief Get the sum of all costs
+   *  @return The total cost
+   */
+  int total() const;
+
+  ScheduleCost& operator+=(const ScheduleCost& other);
+  ScheduleCost operator+(const ScheduleCost& other) const;
+  ScheduleCost operator-(const ScheduleCost& other) const;
+  bool operator==(const ScheduleCost& other) const;
+  bool operator!=(const ScheduleCost& other) const;
+};
+
+/**
+ *  @class MoveEvaluator
+ *  @brief Calculates the cost change of moving modules between timeslots
+ *
+ *  Keeps the number of scheduled modules for every group and timeslot. The
+ * number of exams for every group and day is read from the ExamLoadMatrix of
+ * the plan, so only groups of the plan count for examsPerDay. With these
+ * counters the change of the ScheduleCost by moving or swapping modules only
+ * depends on the number of groups of the modules and not on the size of the
+ * plan. A module with an examDuration of 2 occupies its timeslot and the next
+ * one of the same day. If there is no next timeslot, the missing timeslot
+ * counts as blocked for all of its groups and constraints. Collisions and
+ * examsPerDay only consider groups, constraints only have to be active.
+ *
+ *  The counters are updated incrementally, when modules are added to or
+ * removed from timeslots, the active groups of a timeslot change or the
+ * groups, constraints or examDuration of a module change. Adding or removing
+ * modules only adds or removes their counts. Changes to the groups,
+ * constraints or weeks of the plan rebuild the counters.
+ */
+class MoveEvaluator : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   *  @brief Creates an evaluator for a plan
+   *  @param plan is the plan, that gets evaluated
+   *  @param parent is the parent QObject
+   */
+  explicit MoveEvaluator(Plan* plan, QObject* parent = nullptr);
+
+  /**
+   *  @brief Get the cost of the current schedule of the plan
+   *  @return The cost of all scheduled modules
+   */
+  ScheduleCost getCost() const;
+
+  /**
+   *  @brief Calculate the cost change of moving a module
+   *  @param [in] module is the module
+   *  @param [in] from is the timeslot of the module or nullptr, if the module
+   * is not scheduled yet
+   *  @param [in] to is the new timeslot of the module or nullptr, if the
+   * module gets unscheduled
+   *  @return The change of the cost, which is empty if module is unknown or
+   * not scheduled in from
+   */
+  ScheduleCost evaluateMove(Module* module, Timeslot* from, Timeslot* to) const;
+
+  /**
+   *  @brief Calculate the cost change of swapping the timeslots of two modules
+   *  @param [in] first is the first module
+   *  @param [in] firstTimeslot is the timeslot of first
+   *  @param [in] second is the second module
+   *  @param [in] secondTimeslot is the timeslot of second
+   *  @return The change of the cost, which is empty if a module is unknown or
+   * not scheduled in its timeslot
+   */
+  ScheduleCost evaluateSwap(Module* first,
+                            Timeslot* firstTimeslot,
+                            Module* second,
+                            Timeslot* secondTimeslot) const;
+
+  /**
+   *  @brief Get the number of scheduled modules of a group in a timeslot
+   *  @param [in] group is a group or constraint
+   *  @param [in] timeslot is the timeslot
+   *  @return The number of modules occupying timeslot
+   */
+  int getSlotCount(Group* group, Timeslot* timeslot) const;
+
+  /**
+   *  @brief Get the number of exams of a group on a day
+   *  @param [in] group is a group
+   *  @param [in] day is the day
+   *  @return The number of modules of group starting on day
+   */
+  int getDayCount(Group* group, Day* day) const;
+
+ public slots:
+  /**
+   *  @brief Recreate the counters from the current state of the plan
+   */
+  void rebuild();
+
+ private:
+  struct ModuleData {
+    QList<Group*> groups;
+    QList<Group*> constraints;
+    int duration = 1;
+    // The indices of the timeslots the module is scheduled in
+    QList<int> startSlots;
+  };
+
+  // The changes of the counters, keyed by group and slot or day index
+  struct Changes {
+    QHash<QPair<Group*, int>, int> groupSlots;
+    QHash<QPair<Group*, int>, int> constraintSlots;
+    QHash<QPair<Group*, int>, int> days;
+    int missingSlots = 0;
+  };
+
+  QPointer<Plan> plan;
+  QPointer<ExamLoadMatrix> loads;
+  QList<QMetaObject::Connection> connections;
+  QHash<Module*, QList<QMetaObject::Connection>> moduleConnections;
+
+  QList<Timeslot*> timeslots;
+  QHash<Timeslot*, int> slotIndices;
+  // The index of the day of every timeslot
+  QVector<int> slotDays;
+  QList<Day*> days;
+
+  QHash<Group*, SlotMask> availability;
+  QHash<Timeslot*, QList<Group*>> activeGroups;
+  QHash<Timeslot*, QList<Module*>> scheduledModules;
+  QHash<Module*, ModuleData> modules;
+  QHash<Group*, unsigned int> examsPerDay;
+  QHash<Group*, QVector<int>> slotCounts;
+  QHash<Group*, QVector<int>> constraintSlotCounts;
+  ScheduleCost cost;
+
+  void disconnectAll();
+  void insertModule(Module* module);
+  void updateModuleList(const QList<Module*>& current);
+  void updateModules(Timeslot* timeslot);
+  void updateActiveGroups(Timeslot* timeslot);
+  void updateExamsPerDay(Group* group);
+  void updateDayCount(Group* group, Day* day, int count, int previousCount);
+  void updateExamsPerDayOverflow();
+  void updateModule(Module* module);
+  void collectChanges(const ModuleData& data,
+                      int slot,
+                      int sign,
+                      Changes& changes) const;
+  ScheduleCost evaluate(const Changes& changes) const;
+  void apply(const Changes& changes);
+  bool isActive(Group* group, int slot) const;
+  static int countAt(const QHash<Group*, QVector<int>>& counts,
+                     Group* group,
+                     int index);
+  static void addAt(QHash<Group*, QVector<int>>& counts,
+                    Group* group,
+                    int index,
+                    int size,
+                    int value);
+};
+
+#endif  // MOVEEVALUATOR_H
@@ -0,0 +1,101 @@
+#ifndef OBJECTLISTMODEL_H
+#define OBJECTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QVariant>
+#include <QVector>
+
+/**
+ *  @class ObjectListModel
+ *  @brief A list model over QObjects, that exposes their properties as roles
+ *
+ *  Every Q_PROPERTY of the object type is a role with the name of the
+ * property, and the object itself is available with the role "object". When
+ * the list is replaced, only the rows of removed and added objects are
+ * removed and inserted, so views keep the delegates of all other rows. If the
+ * remaining objects were reordered, the model is reset instead. A notify
+ * signal of a property emits dataChanged for the row of its object and the
+ * role of the property only.
+ */
+class ObjectListModel : public QAbstractListModel {
+  Q_OBJECT
+
+ public:
+  static constexpr int ObjectRole = Qt::UserRole;
+
+  /**
+   *  @brief Creates an empty model
+   *  @param objectType is the type of the objects, which defines the roles
+   *  @param parent is the parent QObject
+   */
+  explicit ObjectListModel(const QMetaObject* objectType,
+                           QObject* parent = nullptr);
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+  /**
+   *  @brief Get the object in a row
+   *  @param [in] row is the row
+   *  @return The object or a nullptr if row is out of range
+   */
+  Q_INVOKABLE QObject* get(int row) const;
+
+  /**
+   *  @brief Get the row of an object
+   *  @param [in] object is the object
+   *  @return The row or -1 if object is not in the model
+   */
+  Q_INVOKABLE int indexOf(QObject* object) const;
+
+  /**
+   *  @brief Get the role of a property
+   *  @param [in] name is the name of the property
+   *  @return The role or -1 if the object type has no such property
+   */
+  int roleOf(const QByteArray& name) const;
+
+ protected:
+  /**
+   *  @brief Replace the objects of the model
+   *  @param [in] objects is the new list
+   */
+  void setObjects(const QList<QObject*>& objects);
+
+  template <typename T>
+  void setObjects(const QList<T*>& objects) {
+    QList<QObject*> list;
+    list.reserve(objects.size());
+    for (T* object : objects) {
+      list.append(object);
+    }
+    setObjects(list);
+  }
+
+ private slots:
+  void propertyChanged();
+
+ private:
+  const QMetaObject* objectType;
+  QHash<int, QByteArray> roles;
+  // Notify signal index of the object type to the roles of its properties
+  QHash<int, QVector<int>> notifyRoles;
+  int displayRole;
+
+  QList<QObject*> objects;
+  QHash<QObject*, int> rows;
+
+  void track(QObject* object);
+  void untrack(QObject* object);
+  void removeDestroyed(QObject* object);
+  void updateRows();
+};
+
+#endif  // OBJECTLISTMODEL_H
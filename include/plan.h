@@ -8,14 +8,21 @@ class Plan;
 #include <QMetaProperty>
 #include <QObject>
 #include <QString>
+#include <QUuid>
 #include <QVariant>
 #include <iostream>
+#include "contenthash.h"
 #include "group.h"
 #include "module.h"
 #include "week.h"
 
 using namespace std;
 
+class ExamLoadMatrix;
+class FeasibleSlotIndex;
+class GroupIndex;
+class IdIndex;
+
 class Plan : public SerializableDataObject {
   using SerializableDataObject::SerializableDataObject;
   Q_OBJECT
@@ -47,6 +54,101 @@ class Plan : public SerializableDataObject {
   QList<Module*> getModules() const;
   void setModules(QList<Module*> modules);
 
+  /**
+   *  @brief Get the hash of the contents of this plan
+   *  @return The content hash
+   *
+   *  Combines the hashes of the name and of all parts of the plan. It changes
+   * whenever any object of the plan changes, so comparing it with an older
+   * value tells whether the plan was modified in the meantime. Changes of a
+   * single module or group are applied in constant time.
+   */
+  quint64 getContentHash() const;
+
+  /**
+   *  @brief Get the content hash of a plan without creating it
+   *  @param [in] content is the JSON object of the plan
+   *  @return The hash the plan would have after fromJsonObject
+   *
+   *  Reads the values and resolves the references like fromJsonObject, but
+   * creates no objects.
+   */
+  static quint64 contentHashOf(const QJsonObject& content);
+
+  /**
+   *  @brief Get the hash of the contents of all constraints
+   *  @return The hash, which does not depend on the order of the constraints
+   */
+  quint64 getConstraintsHash() const;
+
+  /**
+   *  @brief Get the hash of the contents of all groups
+   *  @return The hash, which does not depend on the order of the groups
+   */
+  quint64 getGroupsHash() const;
+
+  /**
+   *  @brief Get the hash of the contents of all modules
+   *  @return The hash, which does not depend on the order of the modules
+   */
+  quint64 getModulesHash() const;
+
+  /**
+   *  @brief Get the hash of the contents of all weeks
+   *  @return The hash of the timeslot grid, with the available groups and the
+   * scheduled modules
+   */
+  quint64 getWeeksHash() const;
+
+  /**
+   *  @brief Get the index of the timeslots and modules of every group
+   *  @return The index, which is created on the first call and kept up to
+   * date with the plan afterwards
+   */
+  GroupIndex* getGroupIndex();
+
+  /**
+   *  @brief Get the number of exams of every group on every day
+   *  @return The matrix, which is created on the first call and kept up to
+   * date with the plan afterwards
+   */
+  ExamLoadMatrix* getExamLoadMatrix();
+
+  /**
+   *  @brief Get the timeslots every module can start in
+   *  @return The index, which is created on the first call and kept up to
+   * date with the plan afterwards
+   */
+  FeasibleSlotIndex* getFeasibleSlotIndex();
+
+  /**
+   *  @brief Get the lookup table of the objects of this plan
+   *  @return The table, which is created on the first call and kept up to
+   * date with the plan afterwards
+   */
+  IdIndex* getIdIndex();
+
+  /**
+   *  @brief Find an object of this plan by its id
+   *  @param [in] id is the id of the plan or one of its groups, constraints,
+   * modules, weeks, days or timeslots
+   *  @return The object or a nullptr if there is no object with id
+   *
+   *  The lookup table is created on the first call and kept up to date with
+   * the plan afterwards, so further lookups take constant time.
+   */
+  SerializableDataObject* findById(const QUuid& id);
+
+  /**
+   *  @brief Find an object of this plan by its id and type
+   *  @param [in] id is the id of the object
+   *  @return The object or a nullptr if there is no object of type T with id
+   */
+  template <typename T>
+  T* findById(const QUuid& id) {
+    return qobject_cast<T*>(findById(id));
+  }
+
  public slots:
   void addNewGroup(const QString& name);
   void removeGroup(Group* gp);
@@ -59,6 +161,7 @@ class Plan : public SerializableDataObject {
   void constraintsChanged(const QList<Group*> groups);
   void groupsChanged(const QList<Group*> groups);
   void weeksChanged(const QList<Week*> weeks);
+  void contentHashChanged(const quint64 oldHash, const quint64 newHash);
 
  private:
   QString name;
@@ -66,6 +169,31 @@ class Plan : public SerializableDataObject {
   QList<Group*> groups;
   QList<Module*> modules;
   QList<Week*> weeks;
+  quint64 constraintsHash;
+  quint64 groupsHash;
+  quint64 modulesHash;
+  quint64 weeksHash;
+  quint64 contentHash;
+  GroupIndex* groupIndex;
+  ExamLoadMatrix* examLoadMatrix;
+  FeasibleSlotIndex* feasibleSlotIndex;
+  IdIndex* idIndex;
+
+  void updateContentHash();
+  void updateWeeksHash();
+  static quint64 hashOf(const QUuid& id,
+                        const QString& name,
+                        quint64 constraintsHash,
+                        quint64 groupsHash,
+                        quint64 modulesHash,
+                        quint64 weeksHash);
+  void constraintContentHashChanged(const quint64 oldHash,
+                                    const quint64 newHash);
+  void groupContentHashChanged(const quint64 oldHash, const quint64 newHash);
+  void moduleContentHashChanged(const quint64 oldHash, const quint64 newHash);
+  void removeGroupReferences(Group* gp);
+  template <typename T, typename Slot>
+  void trackContentHashes(const QList<T*>& objects, Slot slot, bool track);
 };
 
 #endif  // PLAN_H
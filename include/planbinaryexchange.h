@@ -0,0 +1,217 @@
+#ifndef PLANBINARYEXCHANGE_H
+#define PLANBINARYEXCHANGE_H
+
+#include <plan.h>
+#include <QByteArray>
+#include <QSharedMemory>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ *  @struct PlanBinaryHeader
+ *  @brief The header at the start of a binary problem
+ *
+ *  All values are stored in the native byte order, because the problem is
+ * only exchanged with processes on the same machine. The offsets are counted
+ * in bytes from the start of the header and are multiples of 8.
+ */
+struct PlanBinaryHeader {
+  quint32 magic;
+  quint32 version;
+  /**
+   *  PlanBinaryExchange::Problem until the solver writes its solution and sets
+   * it to PlanBinaryExchange::Solved
+   */
+  quint32 status;
+  quint32 slotCount;
+  quint32 dayCount;
+  /**
+   *  The number of groups and constraints
+   */
+  quint32 groupCount;
+  quint32 moduleCount;
+  /**
+   *  The number of quint64 words of the availability mask of every group
+   */
+  quint32 maskWords;
+  /**
+   *  quint32 day index for every slot
+   */
+  quint32 slotDaysOffset;
+  /**
+   *  PlanBinaryGroup for every group
+   */
+  quint32 groupsOffset;
+  /**
+   *  maskWords quint64 for every group, bit i of word j is set if the group
+   * is active in slot 64 * j + i
+   */
+  quint32 availabilityOffset;
+  /**
+   *  PlanBinaryModule for every module
+   */
+  quint32 modulesOffset;
+  /**
+   *  quint32 group indices referenced by the modules
+   */
+  quint32 moduleGroupsOffset;
+  /**
+   *  qint32 start slot for every module or -1 if it is not scheduled
+   */
+  quint32 assignmentsOffset;
+  quint32 size;
+  quint32 reserved;
+};
+
+/**
+ *  @struct PlanBinaryGroup
+ *  @brief A group or constraint in a binary problem
+ */
+struct PlanBinaryGroup {
+  quint32 examsPerDay;
+  /**
+   *  A combination of PlanBinaryExchange::GroupFlags
+   */
+  quint32 flags;
+};
+
+/**
+ *  @struct PlanBinaryModule
+ *  @brief A module in a binary problem
+ */
+struct PlanBinaryModule {
+  quint32 examDuration;
+  /**
+   *  A combination of PlanBinaryExchange::ModuleFlags
+   */
+  quint32 flags;
+  /**
+   *  The index of the first group of the module in the module groups
+   */
+  quint32 firstGroup;
+  /**
+   *  The number of groups and constraints of the module
+   */
+  quint32 groupCount;
+};
+
+/**
+ *  @class PlanBinaryExchange
+ *  @brief Exchanges plans with a solver through shared memory
+ *
+ *  A binary problem contains the plan as indices: the slots are all
+ * timeslots of all days of all weeks in the order of the plan, the groups are
+ * the groups followed by the constraints of the plan and the modules are in
+ * the order of the plan. The solver only has to write the assignment vector
+ * and set the status to Solved, which is then applied to the plan without any
+ * text parsing. The problem can be placed in a QSharedMemory segment or in a
+ * file, that both processes map into memory.
+ */
+class PlanBinaryExchange {
+ public:
+  static constexpr quint32 magic = 0x58425050;  // "PPBX"
+  static constexpr quint32 version = 1;
+
+  enum Status : quint32 { Problem = 0, Solved = 1 };
+  enum GroupFlags : quint32 { GroupActive = 1, Constraint = 2 };
+  enum ModuleFlags : quint32 { ModuleActive = 1, Pinned = 2 };
+
+  /**
+   *  @brief Create the binary problem for a plan
+   *  @param [in] plan is the plan
+   *  @return The problem or an empty QByteArray if plan is a nullptr
+   *
+   *  The assignment vector contains the first timeslot of every module, that
+   * is already scheduled.
+   */
+  static QByteArray createProblem(Plan* plan);
+
+  /**
+   *  @brief Write the binary problem for a plan into shared memory
+   *  @param [in] plan is the plan
+   *  @param [in] memory is the segment. If it is not attached, it gets
+   * created with the size of the problem.
+   *  @return True if the problem fits into the segment and was written
+   */
+  static bool writeProblem(Plan* plan, QSharedMemory* memory);
+
+  /**
+   *  @brief Write the binary problem for a plan into a file
+   *  @param [in] plan is the plan
+   *  @param [in] path is the path of the file, that gets replaced
+   *  @return True if the file was written
+   */
+  static bool writeProblem(Plan* plan, const QString& path);
+
+  /**
+   *  @brief Check that data contains a valid binary problem
+   *  @param [in] data is the start of the problem
+   *  @param [in] size is the number of available bytes
+   *  @return True if the header and all sections are valid
+   */
+  static bool isValid(const char* data, qint64 size);
+
+  /**
+   *  @brief Write a solution into a binary problem
+   *  @param [in] data is the start of the problem
+   *  @param [in] size is the number of available bytes
+   *  @param [in] assignments contains the start slot of every module or -1
+   *  @return True if the solution matches the problem and was written
+   *
+   *  This is what a solver does after solving the problem. The status gets
+   * set to Solved.
+   */
+  static bool writeSolution(char* data,
+                            qint64 size,
+                            const QVector<qint32>& assignments);
+
+  /**
+   *  @brief Read the assignment vector of a binary problem
+   *  @param [in] data is the start of the problem
+   *  @param [in] size is the number of available bytes
+   *  @param [out] assignments will contain the start slot of every module
+   *  @return True if data contains a valid problem
+   */
+  static bool readAssignments(const char* data,
+                              qint64 size,
+                              QVector<qint32>& assignments);
+
+  /**
+   *  @brief Apply the solution of a binary problem to a plan
+   *  @param [in] data is the start of the problem
+   *  @param [in] size is the number of available bytes
+   *  @param [in] plan is the plan, that the problem was created for
+   *  @return True if the solution was applied
+   *
+   *  Fails without modifying plan, if the problem is not solved, does not
+   * match the size of plan or contains an invalid slot. Every module, that is
+   * not pinned, is moved to its assigned timeslot or unscheduled if it has
+   * none.
+   */
+  static bool readSolution(const char* data, qint64 size, Plan* plan);
+
+  /**
+   *  @brief Apply the solution in shared memory to a plan
+   *  @param [in] memory is the attached segment
+   *  @param [in] plan is the plan, that the problem was created for
+   *  @return True if the solution was applied
+   */
+  static bool readSolution(QSharedMemory* memory, Plan* plan);
+
+  /**
+   *  @brief Apply the solution in a file to a plan
+   *  @param [in] path is the path of the file, which gets mapped into memory
+   *  @param [in] plan is the plan, that the problem was created for
+   *  @return True if the solution was applied
+   */
+  static bool readSolution(const QString& path, Plan* plan);
+
+ private:
+  static QList<Timeslot*> getTimeslots(Plan* plan);
+  static bool readHeader(const char* data,
+                         qint64 size,
+                         PlanBinaryHeader& header);
+};
+
+#endif  // PLANBINARYEXCHANGE_H
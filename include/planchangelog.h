@@ -0,0 +1,149 @@
+#ifndef PLANCHANGELOG_H
+#define PLANCHANGELOG_H
+
+#include <plan.h>
+#include <QByteArray>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QJsonObject>
+#include <QList>
+#include <QMetaObject>
+#include <QMetaProperty>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QUuid>
+#include <QtGlobal>
+
+/**
+ *  @class PlanChangeLog
+ *  @brief Saves a plan as a JSON snapshot and a binary log of its changes
+ *
+ *  After attach, every change of a property of the plan or one of its
+ * groups, modules, weeks, days or timeslots is appended to the log as a
+ * record with the id of the object, the name of the property and its new
+ * value. References, like the modules of a timeslot, are stored as the list
+ * of their ids. Saving a change does not depend on the size of the plan.
+ *
+ *  load reads the snapshot and replays the log on top of it. Once the log
+ * grows beyond the compaction threshold, a new snapshot is written on a
+ * background thread and the records it contains are dropped from the log.
+ * Adding or removing groups, modules, weeks, days or timeslots can not be
+ * replayed, so it starts a compaction as well.
+ *
+ *  Every record repeats the complete new value, so replaying records that
+ * are already part of the snapshot, e.g. after a crash during a compaction,
+ * gives the same plan. A record cut off at the end of the log is ignored.
+ */
+class PlanChangeLog : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   *  @brief Creates a change log
+   *  @param path is the path of the JSON snapshot, the log is stored next to
+   * it with the suffix .log
+   *  @param parent is the parent QObject
+   */
+  explicit PlanChangeLog(const QString& path, QObject* parent = nullptr);
+  ~PlanChangeLog();
+
+  QString getSnapshotPath() const;
+  QString getLogPath() const;
+
+  /**
+   *  @brief Load the plan from the snapshot and replay the log
+   *  @param parent is the parent of the new plan
+   *  @return The plan or a nullptr if there is no readable snapshot
+   */
+  Plan* load(QObject* parent = nullptr);
+
+  /**
+   *  @brief Start logging the changes of a plan
+   *  @param plan is the plan returned by load. If there is no snapshot yet,
+   * the current state of plan is written as the snapshot.
+   *  @return True if the log could be opened
+   */
+  bool attach(Plan* plan);
+
+  /**
+   *  @brief Stop logging the changes of the attached plan
+   */
+  void detach();
+
+  Plan* getPlan() const;
+
+  /**
+   *  @brief Get the size of the log
+   *  @return The size in bytes
+   */
+  qint64 getLogSize() const;
+
+  /**
+   *  @brief Get the number of records replayed by the last call of load
+   *  @return The number of applied records
+   */
+  int getReplayedCount() const;
+
+  /**
+   *  @brief Set the size of the log, that starts a compaction
+   *  @param compactionThreshold is the size in bytes
+   */
+  void setCompactionThreshold(qint64 compactionThreshold);
+  qint64 getCompactionThreshold() const;
+
+  bool isCompacting() const;
+
+  /**
+   *  @brief Block until a running compaction is finished
+   *  @return False if the last compaction failed
+   */
+  bool waitForCompaction();
+
+ signals:
+  void compacted(bool success);
+
+ public slots:
+  /**
+   *  @brief Write a new snapshot of the attached plan in the background
+   *  @return False if no plan is attached
+   *
+   *  The JSON object is created on the calling thread, writing it happens on
+   * the global thread pool. Records appended meanwhile stay in the log.
+   */
+  bool compact();
+
+ private slots:
+  void propertyChanged();
+
+ private:
+  enum RecordType : quint8 { PropertyRecord, ReferencesRecord };
+
+  QString path;
+  QPointer<Plan> plan;
+  QList<QMetaObject::Connection> connections;
+  QFile log;
+  int replayedCount;
+  qint64 compactionThreshold;
+  QFutureWatcher<bool> compaction;
+  // Set while the result of the running compaction was not handled yet
+  bool compactionPending;
+  // Start a new compaction after the running one
+  bool compactionRequested;
+  bool lastCompactionSucceeded;
+  // The size of the log, when the running compaction took its snapshot
+  qint64 compactedLogSize;
+
+  void connectObjects();
+  void disconnectObjects();
+  void track(QObject* object);
+  void record(SerializableDataObject* object, const QMetaProperty& property);
+  bool openLog(bool truncate);
+  bool append(const QByteArray& payload);
+  void replay(Plan* plan, const QByteArray& content);
+  bool apply(Plan* plan, const QByteArray& payload);
+  void finishCompaction();
+  static bool writeSnapshot(const QString& path, const QJsonObject& content);
+};
+
+#endif  // PLANCHANGELOG_H
@@ -0,0 +1,112 @@
+#ifndef PLANCSVCACHE_H
+#define PLANCSVCACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QDateTime>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include "plancsvdata.h"
+
+/**
+ *  @struct PlanCsvFileFingerprint
+ *  @brief Identifies a version of a csv file without reading it
+ */
+struct PlanCsvFileFingerprint {
+  qint64 size = -1;
+  QDateTime lastModified;
+
+  bool operator==(const PlanCsvFileFingerprint& other) const;
+  bool operator!=(const PlanCsvFileFingerprint& other) const;
+};
+
+/**
+ *  @class PlanCsvCache
+ *  @brief A cache for parsed csv files
+ *
+ *  Stores the PlanCsvData parsed from a set of csv files together with the
+ * fingerprint and a content hash of every file. An entry is only returned, if
+ * all files still have the same size, modification time and content hash.
+ * The contents are only hashed, if sizes and modification times match, with
+ * a fast non-cryptographic hash. The cache is thread safe, so it can be
+ * shared by multiple PlanCsvHelpers and their asynchronous functions.
+ */
+class PlanCsvCache {
+ public:
+  /**
+   *  @brief Creates an empty cache
+   *  @param maximumEntries is the number of file sets kept in the cache
+   */
+  explicit PlanCsvCache(int maximumEntries = 16);
+
+  /**
+   *  @brief Create the fingerprint of a file
+   *  @param [in] path is the path of the file
+   *  @return The size and modification time of the file
+   */
+  static PlanCsvFileFingerprint createFingerprint(const QString& path);
+
+  /**
+   *  @brief Get the cached data for a set of files
+   *  @param [in] key identifies the set of files
+   *  @param [in] fingerprints are the current fingerprints of the files
+   *  @param [in] contents are the current contents of the files
+   *  @param [out] data will contain the cached data, if there is a hit
+   *  @return True if there is an entry with the same fingerprints and
+   * contents
+   */
+  bool lookup(const QString& key,
+              const QList<PlanCsvFileFingerprint>& fingerprints,
+              const QList<QByteArray>& contents,
+              PlanCsvData& data);
+
+  /**
+   *  @brief Add the parsed data of a set of files to the cache
+   *  @param [in] key identifies the set of files
+   *  @param [in] fingerprints are the fingerprints of the parsed files
+   *  @param [in] contents are the parsed contents of the files
+   *  @param [in] data is the parsed data
+   */
+  void insert(const QString& key,
+              const QList<PlanCsvFileFingerprint>& fingerprints,
+              const QList<QByteArray>& contents,
+              const PlanCsvData& data);
+
+  /**
+   *  @brief Remove all entries from the cache
+   */
+  void clear();
+
+  /**
+   *  @brief Get the number of cached file sets
+   *  @return The number of entries
+   */
+  int size() const;
+
+  /**
+   *  @brief Get the number of successful lookups
+   *  @return The number of hits since the cache was created
+   */
+  int getHits() const;
+
+  /**
+   *  @brief Get the number of failed lookups
+   *  @return The number of misses since the cache was created
+   */
+  int getMisses() const;
+
+ private:
+  struct Entry {
+    QList<PlanCsvFileFingerprint> fingerprints;
+    QList<uint> hashes;
+    PlanCsvData data;
+  };
+
+  mutable QMutex mutex;
+  QCache<QString, Entry> entries;
+  int hits;
+  int misses;
+};
+
+#endif  // PLANCSVCACHE_H
@@ -0,0 +1,85 @@
+#ifndef PLANCSVDATA_H
+#define PLANCSVDATA_H
+
+#include <QList>
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+
+/**
+ *  @struct PlanCsvGroupData
+ *  @brief A group or constraint as it is stored in the csv files
+ */
+struct PlanCsvGroupData {
+  QString name;
+  unsigned int examsPerDay = 0;
+  bool active = true;
+  bool small = false;
+  bool obsolete = false;
+  /**
+   *  One entry for every block in the order of the csv files. True means the
+   * group is available (FREI) in that block. Groups, that are not listed in
+   * the availability files have an empty list.
+   */
+  QList<bool> availability;
+};
+
+/**
+ *  @struct PlanCsvModuleData
+ *  @brief A module as it is stored in pruefungen.csv
+ */
+struct PlanCsvModuleData {
+  QString name;
+  QString origin;
+  QString number;
+  bool active = true;
+  QString examType = "-";
+  unsigned int examDuration = 1;
+  /**
+   *  The names of the groups of the module. Names are resolved to the first
+   * group with that name.
+   */
+  QStringList groups;
+  /**
+   *  The name of the constraint of the module, or an empty string if it has
+   * none. The legacy algorithm supports only one constraint per module.
+   */
+  QString constraint;
+};
+
+/**
+ *  @struct PlanCsvScheduleEntry
+ *  @brief A line of SPA-ERGEBNIS-PP/SPA-planung-pruef.csv
+ */
+struct PlanCsvScheduleEntry {
+  /**
+   *  The module number in the format BelegNr[,Zug]
+   */
+  QString number;
+  QString name;
+  QString origin;
+  QString examType;
+  QStringList groups;
+  int week = 0;
+  int day = 0;
+  int timeslot = 0;
+};
+
+/**
+ *  @struct PlanCsvData
+ *  @brief A thread neutral representation of the contents of the csv files
+ *
+ *  Contains only value types, so it can be created and processed on any
+ * thread. Converting it from and to a Plan has to happen on the thread of the
+ * Plan.
+ */
+struct PlanCsvData {
+  QList<PlanCsvGroupData> constraints;
+  QList<PlanCsvGroupData> groups;
+  QList<PlanCsvModuleData> modules;
+  QList<PlanCsvScheduleEntry> schedule;
+};
+
+Q_DECLARE_METATYPE(PlanCsvData)
+
+#endif  // PLANCSVDATA_H
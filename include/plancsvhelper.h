@@ -2,10 +2,29 @@
 #define PLANCSVHELPER_H
 
 #include <plan.h>
+#include <QFile>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QIODevice>
 #include <QScopedPointer>
 #include <QSharedPointer>
 #include <QString>
 #include <QTemporaryDir>
+#include <QTextStream>
+#include "plancsvcache.h"
+#include "plancsvdata.h"
+
+/**
+ *  @struct PlanCsvDevices
+ *  @brief The devices a PlanCsvHelper reads from and writes to
+ */
+struct PlanCsvDevices {
+  QIODevice* examsIntervals = nullptr;
+  QIODevice* exams = nullptr;
+  QIODevice* groupsExams = nullptr;
+  QIODevice* groupsExamsPref = nullptr;
+  QIODevice* planningExamsResult = nullptr;
+};
 
 /**
  *  @class PlanCsvHelper
@@ -27,6 +46,17 @@ class PlanCsvHelper {
   QFile planningExamsResultFile;
   QFile groupsExamsResultFile;
 
+  PlanCsvDevices devices;
+  bool usesDevices = false;
+
+  QSharedPointer<PlanCsvCache> cache;
+  bool pinnedModulesFixed = false;
+
+  static constexpr int weekCount = 3;
+  static constexpr int dayCount = 6;
+  static constexpr int timeslotCount = 6;
+  static constexpr int blockCount = weekCount * dayCount * timeslotCount;
+
   static constexpr char const* blockNames[108] = {
       "MO1_1", "MO1_2", "MO1_3", "MO1_4", "MO1_5", "MO1_6", "DI1_1", "DI1_2",
       "DI1_3", "DI1_4", "DI1_5", "DI1_6", "MI1_1", "MI1_2", "MI1_3", "MI1_4",
@@ -43,6 +73,12 @@ class PlanCsvHelper {
       "FR3_1", "FR3_2", "FR3_3", "FR3_4", "FR3_5", "FR3_6", "SA3_1", "SA3_2",
       "SA3_3", "SA3_4", "SA3_5", "SA3_6"};
 
+  static constexpr char const* scheduleHeader =
+      "BelegNr;Zug;Modul;Import;Prüfungsform;Zuordnung;Tag;Block;";
+
+  // Reads the result file incrementally with the same parser
+  friend class PlanCsvScheduleTailer;
+
  public:
   /**
    *  @brief Creates a PlanCsvHelper for the given path
@@ -58,6 +94,21 @@ class PlanCsvHelper {
    */
   PlanCsvHelper();
 
+  /**
+   *  @brief Creates a PlanCsvHelper, that uses the given devices
+   *  @param devices are the devices the csv files are read from and written
+   * to
+   *
+   *  No files are touched and getPath returns an empty string. Devices, that
+   * are not open get opened and closed for every read or write, so a QBuffer
+   * can be written and read again. Devices, that are already open, like the
+   * channels of a QProcess, are used at their current position and stay open.
+   * They have to contain the complete file when it is read. The
+   * planningExamsResult device can be a nullptr, if only the input files are
+   * needed. The devices are not owned by the PlanCsvHelper.
+   */
+  explicit PlanCsvHelper(const PlanCsvDevices& devices);
+
   /**
    *  @brief Create a plan from the files in path
    *  @param [in] parent is the parent QObject of the generated plan
@@ -75,6 +126,7 @@ class PlanCsvHelper {
    *  @return True if the plan was written successfully
    *
    *  Writes the plan to csv files.
+   *  Devices, that get opened by the helper are truncated before writing.
    *  If the plan contains scheduling information it will also be written, but
    *  not to the groupsExamsResultFile. If csv files already exist in the path,
    *  everything there will be deleted and new csv files will be written.
@@ -85,6 +137,7 @@ class PlanCsvHelper {
    *  @brief Check if the files required by sp-automatisch exist
    *  @return True, if the files required by sp-automatisch exist
    *
+   *  If the helper uses devices, this checks that all input devices are set.
    *  These files are required:
    *   - pruef-intervalle.csv
    *   - pruefungen.csv
@@ -97,6 +150,8 @@ class PlanCsvHelper {
    *  @brief Check if the plan is scheduled
    *  @return True, if the files that are generated by sp-automatisch exist
    *
+   *  If the helper uses devices, this checks that the planningExamsResult
+   * device is set.
    *  These files are checked:
    *   - SPA-ERGEBNIS-PP/SPA-planung-pruef.csv
    *   - SPA-ERGEBNIS-PP/SPA-zuege-pruef.cs
@@ -121,10 +176,114 @@ class PlanCsvHelper {
    *
    * Every scheduled module, that is read from the csv file will only be
    * scheduled once in plan. Old schedulings for modules contained in the csv
-   * file will be removed.
+   * file will be removed. Entries for pinned modules are ignored, so they keep
+   * their timeslots.
    */
   bool readSchedule(Plan* plan);
 
+  /**
+   *  @brief Add the scheduling information from multiple helpers to a plan
+   *  @param [in] helpers are the helpers containing the result files
+   *  @param [in] plan is the plan to which the scheduling information will be
+   * added
+   *  @return True if succeeded
+   *
+   *  Works like readSchedule with the combined contents of all result files.
+   * The plan is only modified, if all files are valid and all entries match.
+   */
+  static bool readSchedules(const QList<PlanCsvHelper*>& helpers, Plan* plan);
+
+  /**
+   *  @brief Create a plan from the files in path without blocking
+   *  @param [in] parent is the parent QObject of the generated plan
+   *  @return A QFuture, that will contain the generated plan
+   *
+   *  The files are read and parsed on a worker thread. The Plan object is
+   * created on the calling thread, so it needs a running event loop. The
+   * result is a nullptr in the same cases in which readPlan would return one,
+   * or if parent gets deleted before the plan is created. The future reports
+   * progress and can be canceled. A canceled future has no result.
+   *  If the helper uses devices, their contents are read on the calling
+   * thread and only parsed on the worker thread.
+   */
+  QFuture<Plan*> readPlanAsync(QObject* parent = nullptr);
+
+  /**
+   *  @brief Write plan to csv files without blocking
+   *  @param [in] plan is the plan, that will be written
+   *  @return A QFuture, that will contain true if the plan was written
+   * successfully
+   *
+   *  The contents of the plan are collected on the calling thread, formatting
+   * and writing the files happens on a worker thread. The future reports
+   * progress and can be canceled, which may leave some files unwritten. A
+   * canceled future has no result.
+   *  If the helper uses devices, they are written on the calling thread, so
+   * it needs a running event loop.
+   */
+  QFuture<bool> writePlanAsync(Plan* plan);
+
+  /**
+   *  @brief Add the scheduling information from the files to a plan without
+   * blocking
+   *  @param [in] plan is the plan to which the scheduling information will be
+   * added
+   *  @return A QFuture, that will contain true if succeeded
+   *
+   *  The result file is read and parsed on a worker thread, the plan gets
+   * modified on the calling thread, so it needs a running event loop. If plan
+   * gets deleted before that, the result is false. The future reports its
+   * progress and can be canceled. A canceled future has no result.
+   */
+  QFuture<bool> readScheduleAsync(Plan* plan);
+
+  /**
+   *  @brief Set the cache for parsed csv files
+   *  @param [in] cache is the cache, or a nullptr to disable caching
+   *
+   *  If a cache is set, readPlan and readPlanAsync look up the parsed
+   * contents of the input files in the cache, before parsing them. The files
+   * are still read to check their fingerprints, but only parsed if they
+   * changed. The cache can be shared by multiple helpers. Helpers, that use
+   * devices, ignore the cache.
+   */
+  void setCache(QSharedPointer<PlanCsvCache> cache);
+
+  /**
+   *  @brief Get the cache for parsed csv files
+   *  @return The cache or a nullptr if no cache is set
+   */
+  QSharedPointer<PlanCsvCache> getCache();
+
+  /**
+   *  @brief Set if pinned modules are exported as fixed assignments
+   *  @param [in] pinnedModulesFixed is true to only let the solver schedule
+   * the modules, that are not pinned
+   *
+   *  If enabled, writePlan and writePlanAsync write pinned modules as
+   * inactive, so the solver does not schedule them, but keep their timeslots
+   * in the result file. The timeslots occupied by pinned modules are marked
+   * as unavailable for all of their groups and constraints in
+   * pruef-intervalle.csv and zuege-pruef.csv, so the solver schedules the
+   * remaining modules around them.
+   */
+  void setPinnedModulesFixed(bool pinnedModulesFixed);
+
+  /**
+   *  @brief Check if pinned modules are exported as fixed assignments
+   *  @return True if pinned modules are fixed
+   */
+  bool getPinnedModulesFixed();
+
+  /**
+   *  @brief Get the paths of the input files
+   *  @return The paths in the order of PlanCsvDevices
+   *
+   *  These are the files written by writePlan without the result files.
+   * Helpers, that use devices, have no files and return empty paths.
+   */
+  QStringList getInputFilePaths();
+
  private:
   /**
    *  @brief Initialize the QFile objects with the correct paths
@@ -132,80 +291,189 @@ class PlanCsvHelper {
   void initializeFilePaths();
 
   /**
-   *  @brief Write the pruef-intervalle.csv file
-   *  @param [in] plan is the plan, that will be written
-   *  @return True if the the file was written successfully
+   *  @brief Get the devices of this helper
+   *  @return The devices for the files in basePath
    */
-  bool writeExamsIntervalsFile(Plan* plan);
+  PlanCsvDevices getDevices();
 
   /**
-   *  @brief Write the pruefungen.csv file
-   *  @param [in] plan is the plan, that will be written
-   *  @return True if the the file was written successfully
+   *  @brief Read the contents of all plan files
+   *  @param [in] devices are the devices that will be read
+   *  @param [out] data will contain the contents of the files
+   *  @param [in] future is used to report progress and check for cancellation
+   *  @return True if all files were read successfully
    */
-  bool writeExamsFile(Plan* plan);
+  static bool readPlanData(const PlanCsvDevices& devices,
+                           PlanCsvData& data,
+                           QFutureInterfaceBase* future = nullptr);
 
   /**
-   *  @brief Write the zuege-pruef.csv file
-   *  @param [in] plan is the plan, that will be written
-   *  @return True if the the file was written successfully
+   *  @brief Read the contents of all plan files using a cache
+   *  @param [in] paths are the paths of the input files in the order of
+   * PlanCsvDevices
+   *  @param [in] cache is the cache
+   *  @param [out] data will contain the contents of the files
+   *  @param [in] future is used to report progress and check for cancellation
+   *  @return True if all files were read successfully
+   *
+   *  Every file is read once. If the cache contains an entry with the same
+   * fingerprints, the cached data is used. Otherwise the read contents are
+   * parsed and added to the cache.
    */
-  bool writeGroupsExamsFile(Plan* plan);
+  static bool readCachedPlanData(const QStringList& paths,
+                                 PlanCsvCache* cache,
+                                 PlanCsvData& data,
+                                 QFutureInterfaceBase* future = nullptr);
 
   /**
-   *  @brief Write the zuege-pruef-pref2.csv file
-   *  @param [in] plan is the plan, that will be written
-   *  @return True if the the file was written successfully
+   *  @brief Write all plan files
+   *  @param [in] devices are the devices that will be written
+   *  @param [in] data are the contents of the files
+   *  @param [in] future is used to report progress and check for cancellation
+   *  @return True if all files were written successfully
    */
-  bool writeGroupsExamsPrefFile(Plan* plan);
+  static bool writePlanData(const PlanCsvDevices& devices,
+                            const PlanCsvData& data,
+                            QFutureInterfaceBase* future = nullptr);
 
   /**
-   *  @brief Write the SPA-ERGEBNIS-PP/SPA-planung-pruef.csv file
-   *  @param [in] plan is the plan, that will be written
-   *  @return True if the the file was written successfully
+   *  @brief Create a new plan from csv data
+   *  @param [in] data is the data read from the csv files
+   *  @param [in] parent is the parent QObject of the generated plan
+   *  @return The created plan
    */
-  bool writePlanningExamsResultFile(Plan* plan);
+  static Plan* createPlan(const PlanCsvData& data, QObject* parent);
 
   /**
-   *  @brief Read the pruef-intervalle.csv file and add the information to plan
-   *  @param plan is the Plan
-   *  @return True if the the file was read successfully
+   *  @brief Collect everything from plan, that gets written to the csv files
+   *  @param [in] plan is the plan
+   *  @param [in] pinnedModulesFixed is true to export pinned modules as fixed
+   * assignments
+   *  @return The data for the csv files
+   */
+  static PlanCsvData createPlanData(Plan* plan,
+                                    bool pinnedModulesFixed = false);
+
+  /**
+   *  @brief Create a directory for the result files in path
+   *  @param [in] path is the directory containing the csv files
+   *  @return True if path exists and contains the result directory
+   */
+  static bool createResultDirectory(const QString& path);
+
+  /**
+   *  @brief Read the SPA-ERGEBNIS-PP/SPA-planung-pruef.csv file
+   *  @param [in] device is the device containing the file
+   *  @param [out] schedule will contain the lines of the file
+   *  @return True if the file was read successfully
+   */
+  static bool readScheduleFile(QIODevice* device,
+                               QList<PlanCsvScheduleEntry>& schedule);
+
+  /**
+   *  @brief Parse a line of the SPA-ERGEBNIS-PP/SPA-planung-pruef.csv file
+   *  @param [in] line is the line
+   *  @param [out] entry will contain the contents of the line
+   *  @return True if the line is valid
+   */
+  static bool parseScheduleLine(const QString& line,
+                                PlanCsvScheduleEntry& entry);
+
+  /**
+   *  @brief Add a schedule to a plan
+   *  @param [in] schedule are the scheduled modules
+   *  @param [in] plan is the plan
+   *  @return True if every entry matches a module and a timeslot in plan
    *
-   * If reading the file fails, plan has to be considered as invalid and get
-   * deleted
+   *  The plan is only modified, if all entries are valid.
    */
-  bool readExamsIntervalsFile(Plan* plan);
+  static bool applySchedule(const QList<PlanCsvScheduleEntry>& schedule,
+                            Plan* plan);
 
   /**
-   *  @brief Read the pruefungen.csv file and add the information to plan
-   *  @param plan is the Plan
+   *  @brief Write a pruef-intervalle.csv or zuege-pruef.csv file
+   *  @param [in] device is the device the file will be written to
+   *  @param [in] groups are the groups or constraints, that will be written
+   *  @return True if the the file was written successfully
+   */
+  static bool writeAvailabilityFile(QIODevice* device,
+                                    const QList<PlanCsvGroupData>& groups);
+
+  /**
+   *  @brief Read a pruef-intervalle.csv or zuege-pruef.csv file
+   *  @param [in] device is the device containing the file
+   *  @param [out] groups will get the groups or constraints from the file
+   * appended
    *  @return True if the the file was read successfully
-   *
-   * If reading the file fails, plan has to be considered as invalid and get
-   * deleted
    */
-  bool readExamsFile(Plan* plan, bool parseComments = true, bool addMissingGroups = true);
+  static bool readAvailabilityFile(QIODevice* device,
+                                   QList<PlanCsvGroupData>& groups);
 
   /**
-   *  @brief Read the zuege-pruef.csv file and add the information to plan
-   *  @param plan is the Plan
+   *  @brief Write the pruefungen.csv file
+   *  @param [in] device is the device the file will be written to
+   *  @param [in] data is the data, that will be written
+   *  @return True if the the file was written successfully
+   */
+  static bool writeExamsFile(QIODevice* device, const PlanCsvData& data);
+
+  /**
+   *  @brief Write the zuege-pruef-pref2.csv file
+   *  @param [in] device is the device the file will be written to
+   *  @param [in] data is the data, that will be written
+   *  @return True if the the file was written successfully
+   */
+  static bool writeGroupsExamsPrefFile(QIODevice* device,
+                                       const PlanCsvData& data);
+
+  /**
+   *  @brief Write the SPA-ERGEBNIS-PP/SPA-planung-pruef.csv file
+   *  @param [in] device is the device the file will be written to
+   *  @param [in] data is the data, that will be written
+   *  @return True if the the file was written successfully
+   */
+  static bool writePlanningExamsResultFile(QIODevice* device,
+                                           const PlanCsvData& data);
+
+  /**
+   *  @brief Read the pruefungen.csv file and add the information to data
+   *  @param [in] device is the device containing the file
+   *  @param [in,out] data is the data read so far
    *  @return True if the the file was read successfully
    *
-   * If reading the file fails, plan has to be considered as invalid and get
-   * deleted
+   * If reading the file fails, data has to be considered as invalid
    */
-  bool readGroupsExamsFile(Plan* plan);
+  static bool readExamsFile(QIODevice* device,
+                            PlanCsvData& data,
+                            bool parseComments = true,
+                            bool addMissingGroups = true);
 
   /**
    *  @brief Read the zuege-pruef-pref2.csv file and add the information to
-   * plan
-   *  @param plan is the Plan
+   * data
+   *  @param [in] device is the device containing the file
+   *  @param [in,out] data is the data read so far
    *  @return True if the the file was read successfully
    *
-   * If reading the file fails, plan has to be considered as invalid and get
-   * deleted
+   * If reading the file fails, data has to be considered as invalid
+   */
+  static bool readGroupsExamsPrefFile(QIODevice* device,
+                                      PlanCsvData& data,
+                                      bool addMissingGroups = true);
+
+  /**
+   *  @brief Read a section of the zuege-pruef-pref2.csv file
+   *  @param [in] fileStream is positioned at the start of the section
+   *  @param [in,out] data is the data read so far
+   *  @param [in] flag is the flag, that gets set for the listed groups
+   *  @param [in] value is the value the flag gets set to
+   *  @return True if the the section was read successfully
    */
-  bool readGroupsExamsPrefFile(Plan* plan, bool addMissingGroups = true);
+  static bool readGroupsExamsPrefSection(QTextStream& fileStream,
+                                         PlanCsvData& data,
+                                         bool PlanCsvGroupData::*flag,
+                                         bool value,
+                                         bool addMissingGroups);
 };
 
 #endif  // PLANCSVHELPER_H
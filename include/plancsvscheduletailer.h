@@ -0,0 +1,129 @@
+#ifndef PLANCSVSCHEDULETAILER_H
+#define PLANCSVSCHEDULETAILER_H
+
+#include <plan.h>
+#include <QByteArray>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+
+/**
+ *  @class PlanCsvScheduleTailer
+ *  @brief Applies the result file of sp-automatisch to a plan while it is
+ * written
+ *
+ *  Watches SPA-ERGEBNIS-PP/SPA-planung-pruef.csv in a directory and parses
+ * only the lines appended since the last read. Incomplete lines are kept in
+ * the file until their line break is written. Every new entry is validated
+ * and applied to the plan on its own like PlanCsvHelper::readSchedule does,
+ * so invalid entries are skipped without affecting the valid ones. Like
+ * there, the schedule ends at the first empty line. If the file gets shorter
+ * or the last read line changed, it was replaced and is read from the start
+ * again, but the already applied entries stay in the plan.
+ */
+class PlanCsvScheduleTailer : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   *  @brief Creates a tailer for the result file in a directory
+   *  @param path is the directory the csv files are located, like the path of
+   * a PlanCsvHelper
+   *  @param plan is the plan the entries are applied to
+   *  @param parent is the parent QObject
+   */
+  PlanCsvScheduleTailer(const QString& path,
+                        Plan* plan,
+                        QObject* parent = nullptr);
+
+  /**
+   *  @brief Get the path of the watched result file
+   *  @return The path of SPA-ERGEBNIS-PP/SPA-planung-pruef.csv
+   */
+  QString getFilePath() const;
+
+  /**
+   *  @brief Set the time to wait for further changes before reading
+   *  @param debounceInterval is the time in milliseconds
+   */
+  void setDebounceInterval(int debounceInterval);
+
+  /**
+   *  @brief Get the time to wait for further changes before reading
+   *  @return The time in milliseconds
+   */
+  int getDebounceInterval() const;
+
+  /**
+   *  @brief Get the position up to which the file was read
+   *  @return The number of bytes of all complete lines read so far
+   */
+  qint64 getOffset() const;
+
+  /**
+   *  @brief Get the number of applied entries
+   *  @return The number of entries applied to the plan since the creation
+   */
+  int getAppliedCount() const;
+
+  /**
+   *  @brief Get the number of rejected lines
+   *  @return The number of lines, that could not be parsed or applied
+   */
+  int getRejectedCount() const;
+
+  /**
+   *  @brief Check if the file is watched
+   *  @return True between start and stop
+   */
+  bool isRunning() const;
+
+ signals:
+  void entriesApplied(int count);
+  void linesRejected(int count);
+
+ public slots:
+  /**
+   *  @brief Read the current contents of the file and watch it for changes
+   *
+   *  Changes are read after the debounce interval, so the calling thread
+   * needs a running event loop. The file does not have to exist yet.
+   */
+  void start();
+
+  /**
+   *  @brief Stop watching the file
+   */
+  void stop();
+
+  /**
+   *  @brief Read the lines appended since the last read and apply them
+   *  @return True if the file could be read
+   */
+  bool readNewLines();
+
+ private:
+  QString path;
+  QString filePath;
+  QPointer<Plan> plan;
+  QFileSystemWatcher watcher;
+  QTimer debounceTimer;
+  bool running;
+
+  qint64 offset;
+  // The last complete line read, to detect a replaced file
+  QByteArray lastLine;
+  bool headerRead;
+  bool headerValid;
+  bool endReached;
+  int appliedCount;
+  int rejectedCount;
+
+  void updateWatchedPaths();
+  bool isReplaced(QFile& file) const;
+};
+
+#endif  // PLANCSVSCHEDULETAILER_H
@@ -0,0 +1,254 @@
+#ifndef PLANDATABASE_H
+#define PLANDATABASE_H
+
+#include <plan.h>
+#include <semester.h>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QSqlDatabase>
+#include <QString>
+#include <QTimer>
+#include <QUuid>
+#include <QVariantList>
+
+/**
+ *  @class PlanDatabase
+ *  @brief Stores semesters and plans in a SQLite database
+ *
+ *  Every object is a row indexed by its id: plans, groups and constraints,
+ * modules, weeks, days and timeslots, plus one row for every active group
+ * (availability) and every scheduled module (assignments) of a timeslot.
+ * Groups and modules keep their properties as a JSON object.
+ *
+ *  A tracked plan is followed through its change signals. Only the rows of
+ * changed objects are marked and written by flush in a single transaction,
+ * so moving a module only rewrites the assignments of two timeslots.
+ * Groups, constraints and modules, that are added to or removed from the
+ * plan, only insert or delete their own rows, and renaming a week or a day
+ * updates a single row. Replacing the weeks, days or timeslots rewrites all
+ * rows of the plan. Plans can be loaded one by one without loading the rest
+ * of their semester.
+ *
+ *  The class needs QtSql and is only built with CONFIG+=plandatabase.
+ */
+class PlanDatabase : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit PlanDatabase(QObject* parent = nullptr);
+  ~PlanDatabase();
+
+  /**
+   *  @brief Open or create a database
+   *  @param path is the path of the SQLite file
+   *  @return True if the database was opened and the tables exist
+   */
+  bool open(const QString& path);
+
+  /**
+   *  @brief Flush pending changes and close the database
+   */
+  void close();
+
+  bool isOpen() const;
+
+  /**
+   *  @brief Get the last error
+   *  @return The message of the last failed operation
+   */
+  QString getLastError() const;
+
+  /**
+   *  @brief Write a semester and all of its plans
+   *  @param semester is the semester, that replaces the stored one
+   *  @return True if the semester was written
+   *
+   *  Plans, that are not loaded, are written from their JSON without loading
+   * them.
+   */
+  bool saveSemester(Semester* semester);
+
+  /**
+   *  @brief Write a plan
+   *  @param plan is the plan, that replaces the stored one
+   *  @param semesterId is the id of the semester of the plan
+   *  @param position is the position of the plan in the semester
+   *  @return True if the plan was written
+   */
+  bool savePlan(Plan* plan,
+                const QUuid& semesterId = QUuid(),
+                int position = 0);
+
+  /**
+   *  @brief Get the ids of all stored semesters
+   *  @return The ids
+   */
+  QList<QUuid> getSemesterIds() const;
+
+  /**
+   *  @brief Get the ids of the plans of a semester without loading them
+   *  @param semesterId is the id of the semester
+   *  @return The ids in the order of the semester
+   */
+  QList<QUuid> getPlanIds(const QUuid& semesterId) const;
+
+  /**
+   *  @brief Get the name of a plan without loading it
+   *  @param id is the id of the plan
+   *  @return The name or a null string if there is no such plan
+   */
+  QString getPlanName(const QUuid& id) const;
+
+  /**
+   *  @brief Load a single plan
+   *  @param id is the id of the plan
+   *  @param parent is the parent of the new plan
+   *  @return The plan or a nullptr if there is no such plan
+   */
+  Plan* loadPlan(const QUuid& id, QObject* parent = nullptr) const;
+
+  /**
+   *  @brief Load a semester with all of its plans
+   *  @param id is the id of the semester
+   *  @param parent is the parent of the new semester
+   *  @return The semester or a nullptr if there is no such semester
+   */
+  Semester* loadSemester(const QUuid& id, QObject* parent = nullptr) const;
+
+  /**
+   *  @brief Follow the changes of a plan
+   *  @param plan is a plan, that was saved or loaded with this database
+   *
+   *  Changes are written one flush interval after the first change, that
+   * is not written yet, or by calling flush.
+   */
+  void track(Plan* plan);
+
+  /**
+   *  @brief Stop following a plan, pending changes are discarded
+   *  @param plan is the plan
+   */
+  void untrack(Plan* plan);
+
+  /**
+   *  @brief Check if changes of tracked plans were not written yet
+   *  @return True if flush would write something
+   */
+  bool hasPendingChanges() const;
+
+  /**
+   *  @brief Set the time to collect changes before they are written
+   *  @param flushInterval is the time in milliseconds or -1 to only write on
+   * calls of flush
+   */
+  void setFlushInterval(int flushInterval);
+  int getFlushInterval() const;
+
+ signals:
+  void flushed(int rowCount);
+
+ public slots:
+  /**
+   *  @brief Write all pending changes in one transaction
+   *  @return True if the changes were written
+   */
+  bool flush();
+
+ private:
+  /**
+   *  The rows of a list of groups, constraints or modules
+   *
+   *  Rows only need positions in the order of the list, so rows keep their
+   * position as long as it is larger than the one of the row before them.
+   */
+  struct TrackedList {
+    // The objects of the list as they were last seen
+    QList<QObject*> known;
+    QHash<QObject*, QUuid> ids;
+    QHash<QObject*, int> positions;
+    QHash<QObject*, QMetaObject::Connection> connections;
+    // Rows to delete and objects, that need a new row
+    QSet<QUuid> removed;
+    QSet<QObject*> placed;
+  };
+
+  /**
+   *  The changes of a tracked plan, that were not written yet
+   */
+  struct TrackedPlan {
+    QPointer<Plan> plan;
+    QUuid semesterId;
+    int position = 0;
+    QList<QMetaObject::Connection> connections;
+    QList<QMetaObject::Connection> weekConnections;
+    // Groups, constraints and modules
+    TrackedList lists[3];
+    bool structureChanged = false;
+    bool nameChanged = false;
+    QHash<Group*, QPointer<Group>> groups;
+    QHash<Module*, QPointer<Module>> modules;
+    QHash<Week*, QPointer<Week>> weeks;
+    QHash<Day*, QPointer<Day>> days;
+    QHash<Timeslot*, QPointer<Timeslot>> timeslots;
+    QHash<Timeslot*, QPointer<Timeslot>> assignments;
+    QHash<Timeslot*, QPointer<Timeslot>> availability;
+  };
+
+  QString connectionName;
+  QSqlDatabase database;
+  QString lastError;
+  QHash<Plan*, TrackedPlan> trackedPlans;
+  QTimer flushTimer;
+  int flushInterval;
+
+  bool createTables();
+  bool exec(const QString& statement, const QVariantList& values = {});
+  bool exec(const QString& statement,
+            const QVariantList& values,
+            int& rowCount);
+  bool writePlan(const QJsonObject& content,
+                 const QUuid& semesterId,
+                 int position,
+                 int& rowCount);
+  bool deletePlan(const QUuid& id);
+  bool insertGroup(const QString& planKey,
+                   const QJsonObject& content,
+                   int kind,
+                   int position,
+                   int& rowCount);
+  bool insertModule(const QString& planKey,
+                    const QJsonObject& content,
+                    int position,
+                    int& rowCount);
+  bool writeGroup(const QUuid& planId, Group* group, int& rowCount);
+  bool writeModule(const QUuid& planId, Module* module, int& rowCount);
+  bool writeTimeslotIds(const QString& table,
+                        const QString& column,
+                        const QString& planKey,
+                        const QString& timeslotKey,
+                        const QList<QUuid>& ids,
+                        int& rowCount);
+  QJsonObject readPlan(const QUuid& id) const;
+  void connectPlan(TrackedPlan& tracked);
+  void connectWeeks(TrackedPlan& tracked);
+  void disconnectPlan(TrackedPlan& tracked);
+  void disconnectWeeks(TrackedPlan& tracked);
+  void readPositions(TrackedPlan& tracked);
+  void resetPositions(TrackedPlan& tracked);
+  void clearChanges(TrackedPlan& tracked);
+  void changed();
+
+  template <typename Update>
+  auto mark(Plan* plan, Update update);
+  QMetaObject::Connection connectContent(Plan* plan, Group* group);
+  QMetaObject::Connection connectContent(Plan* plan, Module* module);
+  template <typename T>
+  bool updateList(TrackedPlan& tracked, int list, const QList<T*>& current);
+};
+
+#endif  // PLANDATABASE_H
@@ -0,0 +1,112 @@
+#ifndef PLANDECOMPOSITION_H
+#define PLANDECOMPOSITION_H
+
+#include <plan.h>
+#include <QFuture>
+#include <QList>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+
+/**
+ *  @class PlanDecomposition
+ *  @brief Splits a plan into parts, that can be scheduled independently
+ *
+ *  Two modules are in the same part, if they are connected by shared groups
+ * or constraints. Modules without groups and constraints are collected in one
+ * part. Every part can be exported as its own plan and scheduled by a
+ * separate run of sp-automatisch. The results of all parts are merged back
+ * into the original plan.
+ */
+class PlanDecomposition {
+ public:
+  /**
+   *  @brief Decompose a plan
+   *  @param plan is the plan
+   *
+   *  The decomposition is a snapshot of the current groups and constraints of
+   * the modules of plan.
+   */
+  explicit PlanDecomposition(Plan* plan);
+
+  /**
+   *  @brief Get the number of independent parts
+   *  @return The number of parts
+   */
+  int getPartCount() const;
+
+  /**
+   *  @brief Get the modules of a part
+   *  @param [in] part is the index of the part
+   *  @return The modules in the order of the plan
+   */
+  QList<Module*> getModules(int part) const;
+
+  /**
+   *  @brief Create a plan containing only one part
+   *  @param [in] part is the index of the part
+   *  @param [in] parent is the parent QObject of the created plan
+   *  @return The plan or a nullptr if part or the original plan do not exist
+   *
+   *  The plan contains the modules of the part and the groups and constraints
+   * used by them with their original ids. Timeslots only contain these
+   * modules and groups.
+   */
+  Plan* createPartPlan(int part, QObject* parent = nullptr) const;
+
+  /**
+   *  @brief Get the directory of a part
+   *  @param [in] path is the directory containing all parts
+   *  @param [in] part is the index of the part
+   *  @return The path of the directory of the part
+   */
+  static QString getPartPath(const QString& path, int part);
+
+  /**
+   *  @brief Write the csv files of all parts
+   *  @param [in] path is the directory, that will contain one directory for
+   * every part
+   *  @return True if all parts were written
+   */
+  bool writePlans(const QString& path) const;
+
+  /**
+   *  @brief Merge the schedules of all parts into the original plan
+   *  @param [in] path is the directory containing the directories of the
+   * parts
+   *  @return True if succeeded
+   *
+   *  Works like PlanCsvHelper::readSchedule with the result files of all
+   * parts. The plan is only modified, if the results of all parts are valid.
+   */
+  bool readSchedules(const QString& path) const;
+
+  /**
+   *  @brief Schedule all parts concurrently
+   *  @param [in] path is the directory for the parts
+   *  @param [in] program is the scheduling program, like sp-automatisch
+   *  @param [in] arguments are the arguments of the program. Every occurrence
+   * of {path} gets replaced by the directory of the part.
+   *  @param [in] timeout is the maximum runtime of every process in
+   * milliseconds or -1 to wait forever
+   *  @return A QFuture, that will contain true if all parts were scheduled and
+   * merged into the plan
+   *
+   *  The parts are written on the calling thread. Then the program is run in
+   * the directory of every part, each from a thread of the global thread
+   * pool. Once all runs succeeded, the results are merged with
+   * readSchedules on the calling thread, so it needs a running event loop.
+   * The plan is not modified, if any run fails or the future is canceled.
+   * Canceling it kills the running processes and skips the remaining parts.
+   */
+  QFuture<bool> schedule(const QString& path,
+                         const QString& program,
+                         const QStringList& arguments,
+                         int timeout = -1) const;
+
+ private:
+  QPointer<Plan> plan;
+  QList<QList<Module*>> parts;
+};
+
+#endif  // PLANDECOMPOSITION_H
@@ -0,0 +1,132 @@
+#ifndef PLANITEMMODELS_H
+#define PLANITEMMODELS_H
+
+#include <objectlistmodel.h>
+#include <plan.h>
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QList>
+#include <QMetaObject>
+#include <QPair>
+#include <QPointer>
+#include <QVector>
+
+/**
+ *  @class ModuleListModel
+ *  @brief A list model over the modules of a plan or a timeslot
+ *
+ *  Follows Plan::modulesChanged or Timeslot::modulesChanged and only inserts
+ * or removes the rows of the added or removed modules.
+ */
+class ModuleListModel : public ObjectListModel {
+  Q_OBJECT
+
+ public:
+  /**
+   *  @brief Creates a model over all modules of a plan
+   *  @param plan is the plan
+   *  @param parent is the parent QObject
+   */
+  explicit ModuleListModel(Plan* plan, QObject* parent = nullptr);
+
+  /**
+   *  @brief Creates a model over the modules scheduled in a timeslot
+   *  @param timeslot is the timeslot
+   *  @param parent is the parent QObject
+   */
+  explicit ModuleListModel(Timeslot* timeslot, QObject* parent = nullptr);
+};
+
+/**
+ *  @class GroupListModel
+ *  @brief A list model over the groups or the constraints of a plan
+ */
+class GroupListModel : public ObjectListModel {
+  Q_OBJECT
+
+ public:
+  enum Source { Groups, Constraints };
+
+  /**
+   *  @brief Creates a model over the groups or constraints of a plan
+   *  @param plan is the plan
+   *  @param source selects Plan::getGroups or Plan::getConstraints
+   *  @param parent is the parent QObject
+   */
+  GroupListModel(Plan* plan, Source source, QObject* parent = nullptr);
+};
+
+/**
+ *  @class TimeslotTableModel
+ *  @brief A table model over the timeslot grid of a plan
+ *
+ *  Every row is a day of the plan, in the order of the weeks, and every
+ * column a timeslot of that day. Changing the modules, active groups or name
+ * of a timeslot only emits dataChanged for its cell and the affected roles.
+ * Adding or removing weeks, days or timeslots resets the model.
+ */
+class TimeslotTableModel : public QAbstractTableModel {
+  Q_OBJECT
+
+ public:
+  enum Roles {
+    TimeslotRole = Qt::UserRole,
+    NameRole,
+    ModulesRole,
+    ModuleCountRole,
+    ActiveGroupsRole,
+    DayRole,
+    WeekRole
+  };
+
+  /**
+   *  @brief Creates a model over the timeslots of a plan
+   *  @param plan is the plan
+   *  @param parent is the parent QObject
+   */
+  explicit TimeslotTableModel(Plan* plan, QObject* parent = nullptr);
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section,
+                      Qt::Orientation orientation,
+                      int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+  /**
+   *  @brief Get the timeslot of a cell
+   *  @param [in] row is the day
+   *  @param [in] column is the timeslot of the day
+   *  @return The timeslot or a nullptr if the cell is empty
+   */
+  Q_INVOKABLE Timeslot* getTimeslot(int row, int column) const;
+
+  /**
+   *  @brief Get the cell of a timeslot
+   *  @param [in] timeslot is the timeslot
+   *  @return The index of the cell or an invalid index
+   */
+  QModelIndex indexOf(Timeslot* timeslot) const;
+
+ public slots:
+  /**
+   *  @brief Recreate the grid from the current state of the plan
+   */
+  void rebuild();
+
+ private:
+  QPointer<Plan> plan;
+  QList<QMetaObject::Connection> connections;
+
+  QList<Day*> days;
+  QList<Week*> dayWeeks;
+  int columns;
+  QHash<Timeslot*, QPair<int, int>> cells;
+
+  void disconnectAll();
+  void emitChanged(Timeslot* timeslot, const QVector<int>& roles);
+};
+
+#endif  // PLANITEMMODELS_H
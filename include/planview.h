@@ -0,0 +1,252 @@
+#ifndef PLANVIEW_H
+#define PLANVIEW_H
+
+#include <plan.h>
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+#include <QUuid>
+
+class GroupView;
+class ModuleView;
+class TimeslotView;
+class DayView;
+class WeekView;
+class PlanView;
+
+using GroupViewPointer = QSharedPointer<const GroupView>;
+using ModuleViewPointer = QSharedPointer<const ModuleView>;
+using TimeslotViewPointer = QSharedPointer<const TimeslotView>;
+using DayViewPointer = QSharedPointer<const DayView>;
+using WeekViewPointer = QSharedPointer<const WeekView>;
+using PlanViewPointer = QSharedPointer<const PlanView>;
+
+/**
+ *  @class GroupView
+ *  @brief An immutable copy of a Group
+ */
+class GroupView {
+ public:
+  explicit GroupView(const Group* group);
+
+  QUuid getId() const;
+  QString getName() const;
+  bool getSelected() const;
+  unsigned int getExamsPerDay() const;
+  bool getActive() const;
+  bool getSmall() const;
+  bool getObsolete() const;
+  quint64 getContentHash() const;
+
+ private:
+  const QUuid id;
+  const QString name;
+  const bool selected;
+  const unsigned int examsPerDay;
+  const bool active;
+  const bool small;
+  const bool obsolete;
+  const quint64 contentHash;
+};
+
+/**
+ *  @class ModuleView
+ *  @brief An immutable copy of a Module
+ *
+ *  Groups and constraints are referenced by their ids, they can be resolved
+ * with the PlanView containing the module.
+ */
+class ModuleView {
+ public:
+  explicit ModuleView(const Module* module);
+
+  QUuid getId() const;
+  QString getName() const;
+  QString getOrigin() const;
+  QString getNumber() const;
+  bool getActive() const;
+  QString getExamType() const;
+  unsigned int getExamDuration() const;
+  bool getPinned() const;
+  QList<QUuid> getConstraintIds() const;
+  QList<QUuid> getGroupIds() const;
+  quint64 getContentHash() const;
+
+ private:
+  const QUuid id;
+  const QString name;
+  const QString origin;
+  const QString number;
+  const bool active;
+  const QString examType;
+  const unsigned int examDuration;
+  const bool pinned;
+  const QList<QUuid> constraintIds;
+  const QList<QUuid> groupIds;
+  const quint64 contentHash;
+};
+
+/**
+ *  @class TimeslotView
+ *  @brief An immutable copy of a Timeslot
+ *
+ *  Modules and active groups are referenced by their ids, they can be resolved
+ * with the PlanView containing the timeslot.
+ */
+class TimeslotView {
+ public:
+  explicit TimeslotView(const Timeslot* timeslot);
+
+  QUuid getId() const;
+  QString getName() const;
+  QList<QUuid> getModuleIds() const;
+  QList<QUuid> getActiveGroupIds() const;
+  quint64 getContentHash() const;
+
+ private:
+  const QUuid id;
+  const QString name;
+  const QList<QUuid> moduleIds;
+  const QList<QUuid> activeGroupIds;
+  const quint64 contentHash;
+};
+
+/**
+ *  @class DayView
+ *  @brief An immutable copy of a Day
+ */
+class DayView {
+ public:
+  /**
+   *  @brief Creates a copy of a day
+   *  @param day is the day
+   *  @param previous is an older copy of the same day, whose unchanged
+   * timeslots are reused, or a nullptr
+   */
+  DayView(const Day* day, const DayView* previous);
+
+  QUuid getId() const;
+  QString getName() const;
+  QList<TimeslotViewPointer> getTimeslots() const;
+  quint64 getContentHash() const;
+
+ private:
+  const QUuid id;
+  const QString name;
+  QList<TimeslotViewPointer> timeslots;
+  const quint64 contentHash;
+};
+
+/**
+ *  @class WeekView
+ *  @brief An immutable copy of a Week
+ */
+class WeekView {
+ public:
+  /**
+   *  @brief Creates a copy of a week
+   *  @param week is the week
+   *  @param previous is an older copy of the same week, whose unchanged days
+   * are reused, or a nullptr
+   */
+  WeekView(const Week* week, const WeekView* previous);
+
+  QUuid getId() const;
+  QString getName() const;
+  QList<DayViewPointer> getDays() const;
+  quint64 getContentHash() const;
+
+ private:
+  const QUuid id;
+  const QString name;
+  QList<DayViewPointer> days;
+  const quint64 contentHash;
+};
+
+/**
+ *  @class PlanView
+ *  @brief An immutable snapshot of a Plan
+ *
+ *  A PlanView and all objects it contains never change after their creation,
+ * so they can be read from any number of threads without locking, while the
+ * Plan is edited. Objects, that did not change since the previous snapshot
+ * of the same plan, are shared with it. Detecting them uses the content
+ * hashes, so unchanged weeks, days and timeslots are skipped entirely and
+ * unchanged modules and groups are not copied. If the hash of a whole list of
+ * modules, groups or constraints did not change and its order is the same,
+ * the previous list and index are shared instead of looking up every
+ * element.
+ */
+class PlanView {
+ public:
+  /**
+   *  @brief Take a snapshot of a plan
+   *  @param [in] plan is the plan
+   *  @param [in] previous is an older snapshot of the same plan or a nullptr
+   *  @return The snapshot or a nullptr if plan is a nullptr
+   *
+   *  Has to be called on the thread of plan. If the plan did not change since
+   * previous was taken, previous is returned.
+   */
+  static PlanViewPointer create(
+      const Plan* plan,
+      const PlanViewPointer& previous = PlanViewPointer());
+
+  QUuid getId() const;
+  QString getName() const;
+  QList<GroupViewPointer> getConstraints() const;
+  QList<GroupViewPointer> getGroups() const;
+  QList<ModuleViewPointer> getModules() const;
+  QList<WeekViewPointer> getWeeks() const;
+  quint64 getContentHash() const;
+
+  /**
+   *  @brief Find a group or constraint by its id
+   *  @param [in] id is the id
+   *  @return The group or a nullptr if the plan contains no such group
+   */
+  GroupViewPointer findGroup(const QUuid& id) const;
+
+  /**
+   *  @brief Find a module by its id
+   *  @param [in] id is the id
+   *  @return The module or a nullptr if the plan contains no such module
+   */
+  ModuleViewPointer findModule(const QUuid& id) const;
+
+  /**
+   *  @brief Resolve a list of group ids
+   *  @param [in] ids are the ids of groups or constraints
+   *  @return The groups, ids without a group are skipped
+   */
+  QList<GroupViewPointer> findGroups(const QList<QUuid>& ids) const;
+
+  /**
+   *  @brief Resolve a list of module ids
+   *  @param [in] ids are the ids of modules
+   *  @return The modules, ids without a module are skipped
+   */
+  QList<ModuleViewPointer> findModules(const QList<QUuid>& ids) const;
+
+ private:
+  PlanView(const Plan* plan, const PlanView* previous);
+
+  static QList<GroupViewPointer> createGroups(const QList<Group*>& groups,
+                                              const PlanView* previous);
+
+  const QUuid id;
+  const QString name;
+  const quint64 constraintsHash;
+  const quint64 groupsHash;
+  const quint64 modulesHash;
+  QList<GroupViewPointer> constraints;
+  QList<GroupViewPointer> groups;
+  QList<ModuleViewPointer> modules;
+  QList<WeekViewPointer> weeks;
+  QHash<QUuid, GroupViewPointer> groupsById;
+  QHash<QUuid, ModuleViewPointer> modulesById;
+  const quint64 contentHash;
+};
+
+#endif  // PLANVIEW_H
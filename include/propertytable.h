@@ -0,0 +1,243 @@
+#ifndef PROPERTYTABLE_H
+#define PROPERTYTABLE_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QLatin1String>
+#include <QList>
+#include <QString>
+#include <QUuid>
+#include <tuple>
+#include <type_traits>
+
+/**
+ *  @namespace PropertyTable
+ *  @brief Serializers generated at compile time from a table of properties
+ *
+ *  Every data object lists its properties once as a constexpr tuple of
+ * getters and setters. toJsonObject and fromJsonObject expand the tuple into
+ * direct calls, so writing looks up no QMetaProperty and boxes no value in a
+ * QVariant. The JSON is the same as SerializableDataObject creates by
+ * reflection: the id and objectName, every simple value, the ids of
+ * referenced objects and the JSON objects of owned objects.
+ *
+ *  Only simple values are read, the lists are still resolved by the classes
+ * themselves. The id has no public setter, so the classes still pass
+ * identity(content) to the reflective simpleValuesFromJsonObject, which walks
+ * the meta properties of the class once per object to set it.
+ */
+namespace PropertyTable {
+
+/**
+ *  A QString, bool or unsigned int property
+ */
+template <typename Getter, typename Setter>
+struct Value {
+  const char* name;
+  Getter getter;
+  Setter setter;
+};
+
+/**
+ *  A list of objects owned by someone else, stored as their ids
+ */
+template <typename Getter>
+struct References {
+  const char* name;
+  Getter getter;
+};
+
+/**
+ *  A list of owned objects, stored as their JSON objects
+ */
+template <typename Getter>
+struct Objects {
+  const char* name;
+  Getter getter;
+};
+
+template <typename Getter, typename Setter>
+constexpr Value<Getter, Setter> value(const char* name,
+                                      Getter getter,
+                                      Setter setter) {
+  return {name, getter, setter};
+}
+
+template <typename Getter>
+constexpr References<Getter> references(const char* name, Getter getter) {
+  return {name, getter};
+}
+
+template <typename Getter>
+constexpr Objects<Getter> objects(const char* name, Getter getter) {
+  return {name, getter};
+}
+
+inline QJsonValue toJson(const QString& value) {
+  return value;
+}
+
+inline QJsonValue toJson(bool value) {
+  return value;
+}
+
+inline QJsonValue toJson(unsigned int value) {
+  return static_cast<double>(value);
+}
+
+template <typename T>
+T fromJson(const QJsonValue& value);
+
+template <>
+inline QString fromJson<QString>(const QJsonValue& value) {
+  return value.toString();
+}
+
+template <>
+inline bool fromJson<bool>(const QJsonValue& value) {
+  return value.toBool();
+}
+
+template <>
+inline unsigned int fromJson<unsigned int>(const QJsonValue& value) {
+  return static_cast<unsigned int>(value.toDouble());
+}
+
+template <typename T, typename Getter, typename Setter>
+void write(const T* object,
+           const Value<Getter, Setter>& property,
+           QJsonObject& content) {
+  content.insert(QLatin1String(property.name),
+                 toJson((object->*property.getter)()));
+}
+
+template <typename T, typename Getter>
+void write(const T* object,
+           const References<Getter>& property,
+           QJsonObject& content) {
+  QJsonArray ids;
+  for (const auto* reference : (object->*property.getter)()) {
+    if (reference != nullptr) {
+      ids.append(reference->getId().toString());
+    }
+  }
+  content.insert(QLatin1String(property.name), ids);
+}
+
+template <typename T, typename Getter>
+void write(const T* object,
+           const Objects<Getter>& property,
+           QJsonObject& content) {
+  QJsonArray children;
+  for (const auto* child : (object->*property.getter)()) {
+    if (child != nullptr) {
+      children.append(child->toJsonObject());
+    }
+  }
+  content.insert(QLatin1String(property.name), children);
+}
+
+template <typename T, typename Getter, typename Setter>
+void read(T* object,
+          const Value<Getter, Setter>& property,
+          const QJsonObject& content) {
+  using Type = std::decay_t<decltype((object->*property.getter)())>;
+  auto iterator = content.constFind(QLatin1String(property.name));
+  if (iterator != content.constEnd()) {
+    (object->*property.setter)(fromJson<Type>(iterator.value()));
+  }
+}
+
+template <typename T, typename Getter>
+void read(T*, const References<Getter>&, const QJsonObject&) {}
+
+template <typename T, typename Getter>
+void read(T*, const Objects<Getter>&, const QJsonObject&) {}
+
+/**
+ *  @brief Write all properties of an object
+ *  @param [in] object is the object
+ *  @param [in] properties is the table of the class of object
+ *  @return The JSON object
+ */
+template <typename T, typename... Properties>
+QJsonObject toJsonObject(const T* object,
+                         const std::tuple<Properties...>& properties) {
+  QJsonObject content;
+  content.insert(QLatin1String("id"), object->getId().toString());
+  content.insert(QLatin1String("objectName"), object->objectName());
+  std::apply(
+      [object, &content](const auto&... property) {
+        (write(object, property, content), ...);
+      },
+      properties);
+  return content;
+}
+
+/**
+ *  @brief Read the objectName and all simple values of an object
+ *  @param object is the object
+ *  @param [in] content is the JSON object
+ *  @param [in] properties is the table of the class of object
+ *
+ *  Values missing in content are left unchanged.
+ */
+template <typename T, typename... Properties>
+void fromJsonObject(T* object,
+                    const QJsonObject& content,
+                    const std::tuple<Properties...>& properties) {
+  auto iterator = content.constFind(QLatin1String("objectName"));
+  if (iterator != content.constEnd()) {
+    object->setObjectName(iterator.value().toString());
+  }
+  std::apply(
+      [object, &content](const auto&... property) {
+        (read(object, property, content), ...);
+      },
+      properties);
+}
+
+/**
+ *  @brief Read a simple value without an object
+ *  @param [in] content is the JSON object
+ *  @param [in] name is the name of the property
+ *  @param [in] defaultValue is returned if content has no such value
+ *  @return The value
+ */
+template <typename T>
+T valueOf(const QJsonObject& content, const char* name, const T& defaultValue) {
+  auto iterator = content.constFind(QLatin1String(name));
+  return iterator != content.constEnd() ? fromJson<T>(iterator.value())
+                                        : defaultValue;
+}
+
+/**
+ *  @brief Read the id of a JSON object
+ *  @param [in] content is the JSON object of a data object
+ *  @return The id or a null QUuid
+ */
+inline QUuid idOf(const QJsonObject& content) {
+  return QUuid(content.value(QLatin1String("id")).toString());
+}
+
+/**
+ *  @brief Get the id of a JSON object
+ *  @param [in] content is the JSON object of a data object
+ *  @return A JSON object that only contains the id
+ *
+ *  The id can only be set by SerializableDataObject, this is the part of
+ * the JSON object it still reads by reflection.
+ */
+inline QJsonObject identity(const QJsonObject& content) {
+  QJsonObject id;
+  auto iterator = content.constFind(QLatin1String("id"));
+  if (iterator != content.constEnd()) {
+    id.insert(QLatin1String("id"), iterator.value());
+  }
+  return id;
+}
+
+}  // namespace PropertyTable
+
+#endif  // PROPERTYTABLE_H
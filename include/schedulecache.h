@@ -0,0 +1,102 @@
+#ifndef SCHEDULECACHE_H
+#define SCHEDULECACHE_H
+
+#include <plan.h>
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+
+/**
+ *  @class ScheduleCache
+ *  @brief A persistent cache for the results of sp-automatisch
+ *
+ *  Maps the fingerprint of the csv files PlanCsvHelper::writePlan exports for
+ * a plan to the SPA-ERGEBNIS-PP/SPA-planung-pruef.csv file sp-automatisch
+ * created for them. Plans, whose exported files did not change since the
+ * result was stored, can get their schedule from the cache instead of running
+ * sp-automatisch again. Every result is stored as a file named after the
+ * fingerprint, so the cache survives restarts and can be shared by multiple
+ * processes.
+ */
+class ScheduleCache {
+ public:
+  /**
+   *  @brief Creates a cache in the default cache location of the application
+   */
+  ScheduleCache();
+
+  /**
+   *  @brief Creates a cache in the given directory
+   *  @param path is the directory for the cached results. It gets created,
+   * when the first result is stored.
+   */
+  explicit ScheduleCache(const QString& path);
+
+  /**
+   *  @brief Get the directory containing the cached results
+   *  @return The path of the directory
+   */
+  QString getPath() const;
+
+  /**
+   *  @brief Create the fingerprint of the csv files of a plan
+   *  @param [in] plan is the plan
+   *  @return The hex encoded SHA-256 hash of the exported files or an empty
+   * QByteArray if plan is a nullptr
+   *
+   *  Only the files read by sp-automatisch are included, so the current
+   * schedule of the plan does not change the fingerprint.
+   */
+  static QByteArray createFingerprint(Plan* plan);
+
+  /**
+   *  @brief Check if there is a cached result for a plan
+   *  @param [in] plan is the plan
+   *  @return True if a result for the current state of plan is cached
+   */
+  bool contains(Plan* plan) const;
+
+  /**
+   *  @brief Store the result of sp-automatisch for a plan
+   *  @param [in] plan is the plan, in the state that was exported for
+   * sp-automatisch
+   *  @param [in] result is the device containing the
+   * SPA-ERGEBNIS-PP/SPA-planung-pruef.csv file
+   *  @return True if the result was stored
+   */
+  bool store(Plan* plan, QIODevice* result);
+
+  /**
+   *  @brief Add a cached schedule to a plan
+   *  @param [in] plan is the plan
+   *  @return True if a result was cached and applied to plan
+   *
+   *  The schedule is applied like PlanCsvHelper::readSchedule does. If there
+   * is no cached result or it does not fit to plan, plan is not modified.
+   */
+  bool apply(Plan* plan) const;
+
+  /**
+   *  @brief Remove the cached result for a plan
+   *  @param [in] plan is the plan
+   *  @return True if there was a cached result, that got removed
+   */
+  bool remove(Plan* plan);
+
+  /**
+   *  @brief Remove all cached results
+   */
+  void clear();
+
+ private:
+  QString path;
+
+  /**
+   *  @brief Get the path of the file for a fingerprint
+   *  @param [in] fingerprint is the fingerprint
+   *  @return The path of the file
+   */
+  QString getFilePath(const QByteArray& fingerprint) const;
+};
+
+#endif  // SCHEDULECACHE_H
@@ -0,0 +1,161 @@
+#ifndef SCHEDULEMETRICS_H
+#define SCHEDULEMETRICS_H
+
+#include <plan.h>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
+#include "slotmask.h"
+
+/**
+ *  @struct MetricWeights
+ *  @brief The weights of the soft criteria in a score
+ */
+struct MetricWeights {
+  int gaps = 1;
+  int consecutiveDays = 1;
+  int saturdaySlots = 1;
+  int lateSlots = 1;
+};
+
+/**
+ *  @struct GroupMetrics
+ *  @brief The soft criteria of the schedule of one or more groups
+ *
+ *  All values count timeslots occupied by exams, so an exam with an
+ * examDuration of 2 counts twice for saturdaySlots and lateSlots.
+ */
+struct GroupMetrics {
+  int occupiedSlots = 0;
+  /**
+   *  Free timeslots between two exams on the same day
+   */
+  int gaps = 0;
+  /**
+   *  Pairs of days in the same week directly after each other, that both
+   * have exams
+   */
+  int consecutiveDays = 0;
+  /**
+   *  Occupied timeslots on the sixth day of a week
+   */
+  int saturdaySlots = 0;
+  /**
+   *  Occupied timeslots among the last timeslots of a day
+   */
+  int lateSlots = 0;
+
+  /**
+   *  @brief Get the weighted sum of the criteria
+   *  @param [in] weights are the weights
+   *  @return The score, lower is better
+   */
+  int score(const MetricWeights& weights = MetricWeights()) const;
+
+  GroupMetrics& operator+=(const GroupMetrics& other);
+  bool operator==(const GroupMetrics& other) const;
+  bool operator!=(const GroupMetrics& other) const;
+};
+
+/**
+ *  @class ScheduleMetrics
+ *  @brief Computes the soft criteria of schedules for all groups of a plan
+ *
+ *  The exams of a group are a SlotMask over all timeslots of the plan. All
+ * criteria are computed with operations on 64 timeslots at once: a
+ * segmented prefix over the timeslots of every day marks the timeslots with
+ * an earlier and a later exam on the same day, which gives the gaps, and the
+ * first and last timeslot of each day tell which days have exams. No
+ * timeslot or day is visited on its own.
+ *
+ *  The layout of the plan, its groups and modules are copied on
+ * construction, so the metrics can evaluate many candidate schedules, like
+ * the assignment vectors of PlanBinaryExchange, without touching the plan.
+ * It has to be recreated when the structure of the plan changes.
+ */
+class ScheduleMetrics {
+ public:
+  /**
+   *  @brief Creates the metrics for the layout of a plan
+   *  @param plan is the plan
+   *  @param lateSlotCount is the number of timeslots at the end of every day,
+   * that count as late
+   */
+  explicit ScheduleMetrics(Plan* plan, int lateSlotCount = 1);
+
+  int getSlotCount() const;
+
+  /**
+   *  @brief Get the groups in the order of the results
+   *  @return The groups of the plan
+   */
+  QList<Group*> getGroups() const;
+
+  /**
+   *  @brief Get the timeslots occupied by every group in the plan
+   *  @param [in] plan is the plan, the metrics were created for
+   *  @return A mask for every group
+   */
+  QVector<SlotMask> getOccupancy(Plan* plan) const;
+
+  /**
+   *  @brief Get the timeslots occupied by every group in a candidate schedule
+   *  @param [in] assignments contains the start slot of every module of the
+   * plan in the order of Plan::getModules or -1
+   *  @return A mask for every group, which is empty if assignments does not
+   * match the plan
+   */
+  QVector<SlotMask> getOccupancy(const QVector<qint32>& assignments) const;
+
+  /**
+   *  @brief Compute the criteria of one group
+   *  @param [in] occupancy are the timeslots occupied by the group
+   *  @return The criteria
+   */
+  GroupMetrics evaluate(const SlotMask& occupancy) const;
+
+  /**
+   *  @brief Compute the criteria of all groups
+   *  @param [in] occupancy contains the occupied timeslots of every group
+   *  @return The criteria of every group
+   */
+  QVector<GroupMetrics> evaluate(const QVector<SlotMask>& occupancy) const;
+
+  /**
+   *  @brief Compute the sum of the criteria of all groups
+   *  @param [in] assignments is a candidate schedule like for getOccupancy
+   *  @return The sum of the criteria of all groups
+   */
+  GroupMetrics evaluateTotal(const QVector<qint32>& assignments) const;
+
+  /**
+   *  @brief Sum up the criteria of several groups
+   *  @param [in] metrics are the criteria of the groups
+   *  @return The sum
+   */
+  static GroupMetrics sum(const QVector<GroupMetrics>& metrics);
+
+ private:
+  int slotCount;
+  QVector<int> slotDays;
+  QList<Group*> groups;
+  QHash<Module*, int> moduleIndices;
+  QVector<QVector<int>> moduleGroups;
+  QVector<int> moduleDurations;
+
+  // backward[s] has bit i set, if timeslot i - 2^s is on the same day
+  QVector<SlotMask> backward;
+  // forward[s] has bit i set, if timeslot i + 2^s is on the same day
+  QVector<SlotMask> forward;
+  SlotMask firstSlots;
+  SlotMask lastSlots;
+  // The last timeslots of days, that are followed by a day of the same week
+  SlotMask followedSlots;
+  SlotMask saturdaySlots;
+  SlotMask lateSlots;
+
+  void occupy(QVector<SlotMask>& occupancy, int module, int slot) const;
+};
+
+#endif  // SCHEDULEMETRICS_H
@@ -3,10 +3,28 @@
 
 class Semester;
 
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QList>
+#include <QMetaObject>
+#include <QMultiHash>
 #include <QObject>
 #include <QString>
+#include <QUuid>
+#include <QVector>
 #include "plan.h"
 
+/**
+ *  @class Semester
+ *  @brief The plans of a semester
+ *
+ *  fromJsonObject only keeps the JSON object of every plan. A Plan is
+ * created from it on the first access with getPlan or getPlans, so opening
+ * a semester does not create the objects of plans that are never opened.
+ * unloadPlan and unloadIdlePlans delete the objects of plans again.
+ * plansChanged is emitted whenever plans are loaded or unloaded, unloaded
+ * plans are a nullptr in its list.
+ */
 class Semester : public SerializableDataObject {
   using SerializableDataObject::SerializableDataObject;
   Q_OBJECT
@@ -23,16 +41,125 @@ class Semester : public SerializableDataObject {
 
   QString getName() const;
   void setName(const QString& name);
+  /**
+   *  @brief Get all plans
+   *  @return The plans, all plans that were not loaded yet are loaded
+   */
   QList<Plan*> getPlans() const;
   void setPlans(QList<Plan*> plans);
 
+  int getPlanCount() const;
+
+  /**
+   *  @brief Get a plan and load it, if it was not loaded yet
+   *  @param [in] index is the position of the plan
+   *  @return The plan or a nullptr if index is out of range
+   */
+  Plan* getPlan(int index) const;
+
+  /**
+   *  @brief Check if the objects of a plan exist
+   *  @param [in] index is the position of the plan
+   *  @return False if the plan is only kept as JSON
+   */
+  bool isPlanLoaded(int index) const;
+
+  /**
+   *  @brief Get the plans, that are loaded, without loading others
+   *  @return The loaded plans in their order
+   */
+  QList<Plan*> getLoadedPlans() const;
+
+  /**
+   *  @brief Get the JSON object of a plan without loading it
+   *  @param [in] index is the position of the plan
+   *  @return The stored JSON of an unloaded plan, the JSON of a loaded plan or
+   * an empty object if there is no such plan
+   */
+  QJsonObject getPlanContent(int index) const;
+
+  /**
+   *  @brief Replace a loaded plan by its JSON object
+   *  @param [in] index is the position of the plan
+   *  @return True if the plan was deleted
+   *
+   *  Only plans owned by this semester are unloaded. Pointers to the plan
+   * and its objects become invalid, the next getPlan creates a new Plan.
+   * Emits plansChanged.
+   */
+  bool unloadPlan(int index);
+
+  /**
+   *  @brief Unload all plans, that were not accessed for some time
+   *  @param [in] idleTime is the time in milliseconds since the last call of
+   * getPlan or getPlans for a plan
+   *  @return The number of unloaded plans
+   */
+  int unloadIdlePlans(qint64 idleTime);
+
+  /**
+   *  @brief Get the hash of the contents of this semester
+   *  @return The content hash
+   *
+   *  Includes the content hashes of the plans, so it changes whenever
+   * one of them changes. The hash of a plan, that is not loaded, is computed
+   * from its JSON object with Plan::contentHashOf, so it only depends on the
+   * content and loading or unloading a plan does not change it.
+   */
+  quint64 getContentHash() const;
+
+  /**
+   *  @brief Find an object of one of the plans by its id
+   *  @param [in] id is the id of a plan or of an object of a plan
+   *  @return The object or a nullptr if no plan contains an object with id
+   *
+   *  The first call creates a table from the ids to the plans containing
+   * them, which follows the lookup tables of the loaded plans and the JSON
+   * objects of the others afterwards, so further lookups take constant
+   * time. Loaded plans are preferred, of the others only the one containing
+   * id is loaded.
+   */
+  SerializableDataObject* findById(const QUuid& id) const;
+
+  /**
+   *  @brief Find an object of one of the plans by its id and type
+   *  @param [in] id is the id of the object
+   *  @return The object or a nullptr if there is no object of type T with id
+   */
+  template <typename T>
+  T* findById(const QUuid& id) const {
+    return qobject_cast<T*>(findById(id));
+  }
+
  signals:
   void nameChanged(const QString name);
   void plansChanged(const QList<Plan*> plans);
+  void contentHashChanged(const quint64 oldHash, const quint64 newHash);
 
  private:
   QString name;
+  // nullptr for plans, that are not loaded
   QList<Plan*> plans;
+  // The JSON object of every plan, that is not loaded, or an empty object
+  QList<QJsonObject> planContents;
+  QVector<bool> planLoaded;
+  // The content hash of every plan, that is not loaded
+  QVector<quint64> planHashes;
+  // The time of the last access of every plan
+  mutable QVector<qint64> planAccesses;
+  QElapsedTimer accessClock;
+  quint64 contentHash;
+  // The indices of the plans containing every id
+  mutable QMultiHash<QUuid, int> planIndices;
+  mutable QVector<QList<QMetaObject::Connection>> indexConnections;
+  mutable bool idsIndexed;
+
+  Plan* loadPlan(int index);
+  quint64 getPlanHash(int index) const;
+  void indexPlan(int index, bool insert) const;
+  void clearPlanIndices();
+  void updateContentHash();
+  void trackPlans(const QList<Plan*>& plans, bool track);
 };
 
 #endif  // SEMESTER_H
@@ -0,0 +1,126 @@
+#ifndef SEMESTERLOADER_H
+#define SEMESTERLOADER_H
+
+#include <plan.h>
+#include <semester.h>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QVector>
+
+/**
+ *  @struct PreparedTimeslot
+ *  @brief A timeslot with its references resolved to indices
+ */
+struct PreparedTimeslot {
+  /**
+   *  The JSON object without the references
+   */
+  QJsonObject content;
+  /**
+   *  Indices into the modules of the plan
+   */
+  QVector<int> modules;
+  /**
+   *  Indices into the groups followed by the constraints of the plan
+   */
+  QVector<int> activeGroups;
+};
+
+/**
+ *  @struct PreparedDay
+ *  @brief A day without its timeslots and the prepared timeslots
+ */
+struct PreparedDay {
+  QJsonObject content;
+  QVector<PreparedTimeslot> timeslots;
+};
+
+/**
+ *  @struct PreparedWeek
+ *  @brief A week without its days and the prepared days
+ */
+struct PreparedWeek {
+  QJsonObject content;
+  QVector<PreparedDay> days;
+};
+
+/**
+ *  @struct PreparedModule
+ *  @brief A module with its references resolved to indices
+ */
+struct PreparedModule {
+  QJsonObject content;
+  /**
+   *  Indices into the groups of the plan
+   */
+  QVector<int> groups;
+  /**
+   *  Indices into the constraints of the plan
+   */
+  QVector<int> constraints;
+};
+
+/**
+ *  @struct PreparedPlan
+ *  @brief The JSON object of a plan split up into its objects
+ *
+ *  Contains no QObjects, so it can be created on any thread. All ids
+ * referenced by modules and timeslots are already resolved to indices.
+ */
+struct PreparedPlan {
+  QJsonObject content;
+  QVector<QJsonObject> groups;
+  QVector<QJsonObject> constraints;
+  QVector<PreparedModule> modules;
+  QVector<PreparedWeek> weeks;
+};
+
+/**
+ *  @class SemesterLoader
+ *  @brief Creates the plans of a semester in parallel
+ *
+ *  Plan::fromJsonObject resolves every referenced id by searching the lists
+ * of the plan. The loader splits loading in two steps: prepare resolves the
+ * references of every plan on the global thread pool, createPlan creates
+ * the QObjects on the calling thread, which owns them afterwards.
+ */
+class SemesterLoader {
+ public:
+  /**
+   *  @brief Create a semester with all of its plans
+   *  @param [in] content is the JSON object of the semester
+   *  @param parent is the parent of the new semester
+   *  @return The semester with all plans loaded
+   */
+  static Semester* load(const QJsonObject& content, QObject* parent = nullptr);
+
+  /**
+   *  @brief Create plans from their JSON objects
+   *  @param [in] plans are the JSON objects of the plans
+   *  @param parent is the parent of the new plans
+   *  @return The plans in the order of plans
+   */
+  static QList<Plan*> loadPlans(const QJsonArray& plans,
+                                QObject* parent = nullptr);
+
+  /**
+   *  @brief Split a plan up and resolve its references
+   *  @param [in] content is the JSON object of the plan
+   *  @return The prepared plan
+   *
+   *  Does not create QObjects, so it can be called on any thread.
+   */
+  static PreparedPlan prepare(const QJsonObject& content);
+
+  /**
+   *  @brief Create a plan from a prepared plan
+   *  @param [in] prepared is the prepared plan
+   *  @param parent is the parent of the new plan
+   *  @return The plan, which equals the one Plan::fromJsonObject creates
+   */
+  static Plan* createPlan(const PreparedPlan& prepared,
+                          QObject* parent = nullptr);
+};
+
+#endif  // SEMESTERLOADER_H
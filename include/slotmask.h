@@ -0,0 +1,78 @@
+#ifndef SLOTMASK_H
+#define SLOTMASK_H
+
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ *  @class SlotMask
+ *  @brief A fixed size set of timeslots stored as a bitset
+ *
+ *  Bit i belongs to the i-th timeslot of a plan, counting the timeslots of
+ * all days of all weeks in order. Operations work on 64 timeslots at once.
+ */
+class SlotMask {
+ public:
+  /**
+   *  @brief Creates a mask
+   *  @param size is the number of timeslots
+   *  @param value is the initial value of all bits
+   */
+  explicit SlotMask(int size = 0, bool value = false);
+
+  int size() const;
+  bool testBit(int slot) const;
+  void setBit(int slot, bool value = true);
+  void fill(bool value);
+
+  /**
+   *  @brief Count the set bits
+   *  @return The number of timeslots in the set
+   */
+  int count() const;
+
+  /**
+   *  @brief Check if any bit is set
+   *  @return True if the set is not empty
+   */
+  bool any() const;
+
+  /**
+   *  @brief Get the indices of all set bits
+   *  @return The timeslot indices in ascending order
+   */
+  QList<int> toList() const;
+
+  /**
+   *  @brief Shift the mask
+   *  @param offset is the number of slots
+   *  @return A mask of the same size, where bit i is bit i + offset of this
+   * mask. Bits outside of this mask are unset.
+   */
+  SlotMask shifted(int offset) const;
+
+  /**
+   *  @brief Get the words storing the bits
+   *  @return The words, bit i is stored in bit i % 64 of word i / 64
+   */
+  const QVector<quint64>& getWords() const;
+
+  SlotMask& operator&=(const SlotMask& other);
+  SlotMask& operator|=(const SlotMask& other);
+  SlotMask operator&(const SlotMask& other) const;
+  SlotMask operator|(const SlotMask& other) const;
+  SlotMask operator~() const;
+  bool operator==(const SlotMask& other) const;
+  bool operator!=(const SlotMask& other) const;
+
+ private:
+  static constexpr int wordSize = 64;
+
+  QVector<quint64> words;
+  int bitCount;
+
+  void clearUnusedBits();
+};
+
+#endif  // SLOTMASK_H
@@ -0,0 +1,135 @@
+#ifndef SOLVERRUNNER_H
+#define SOLVERRUNNER_H
+
+#include <plan.h>
+#include <QFuture>
+#include <QString>
+#include <QStringList>
+#include "moveevaluator.h"
+
+/**
+ *  @struct SolverScore
+ *  @brief The quality of a result of the solver
+ */
+struct SolverScore {
+  /**
+   *  The number of active modules, that are not scheduled in any timeslot
+   */
+  int unscheduledModules = 0;
+  ScheduleCost cost;
+
+  /**
+   *  @brief Check if this score is better than another one
+   *  @param other is the other score
+   *  @return True if fewer modules are unscheduled or the same number of
+   * modules is unscheduled and the total cost is lower
+   */
+  bool operator<(const SolverScore& other) const;
+};
+
+/**
+ *  @class SolverRunner
+ *  @brief Runs a randomised solver several times and keeps the best result
+ *
+ *  The plan is written once and its input files are copied into a directory
+ * for every run. Then one process of the solver is started for every run,
+ * each with a different seed. Once all processes finished or the time budget
+ * is exhausted, every result is scored and the best one is applied to the
+ * plan with PlanCsvHelper::readSchedule.
+ */
+class SolverRunner {
+ public:
+  /**
+   *  @brief Creates a runner for a solver
+   *  @param program is the solver, like sp-automatisch
+   *  @param arguments are the arguments of the solver. Every occurrence of
+   * {path} gets replaced by the directory of the run and every occurrence of
+   * {seed} by the seed of the run.
+   */
+  explicit SolverRunner(const QString& program,
+                        const QStringList& arguments = QStringList());
+
+  /**
+   *  @brief Set the number of runs
+   *  @param runCount is the number of processes started in parallel
+   */
+  void setRunCount(int runCount);
+
+  /**
+   *  @brief Get the number of runs
+   *  @return The number of processes started in parallel
+   */
+  int getRunCount() const;
+
+  /**
+   *  @brief Set the seed of the first run
+   *  @param firstSeed is the seed of the first run, the following runs use
+   * the next seeds
+   */
+  void setFirstSeed(int firstSeed);
+
+  /**
+   *  @brief Get the seed of the first run
+   *  @return The seed of the first run
+   */
+  int getFirstSeed() const;
+
+  /**
+   *  @brief Set the time budget of all runs
+   *  @param timeout is the wall-clock time in milliseconds after which all
+   * running processes are killed, or -1 to wait forever
+   */
+  void setTimeout(int timeout);
+
+  /**
+   *  @brief Get the time budget of all runs
+   *  @return The time in milliseconds or -1 if there is no limit
+   */
+  int getTimeout() const;
+
+  /**
+   *  @brief Get the directory of a run
+   *  @param [in] path is the directory containing the runs
+   *  @param [in] run is the index of the run
+   *  @return The path of the directory of the run
+   */
+  static QString getRunPath(const QString& path, int run);
+
+  /**
+   *  @brief Score the result of a run
+   *  @param [in] plan is the plan, that was scheduled
+   *  @param [in] path is the directory of the run
+   *  @param [out] score will contain the score of the result
+   *  @return True if the result could be read
+   *
+   *  The result is applied to a copy of plan, so plan is not modified.
+   */
+  static bool scoreResult(Plan* plan, const QString& path, SolverScore& score);
+
+  /**
+   *  @brief Run the solver several times and apply the best result
+   *  @param [in] plan is the plan, that gets scheduled
+   *  @param [in] path is the directory for the runs
+   *  @return A QFuture, that will contain true if at least one run succeeded
+   * and its result was applied to plan
+   *
+   *  The files are written on the calling thread and the processes are
+   * watched by its event loop, so it needs a running event loop. A run
+   * succeeds, if the solver exits with code 0 within the time budget and its
+   * result can be read. The future reports the number of finished runs as
+   * progress. Canceling it kills all running processes. If it is canceled or
+   * plan gets deleted, the plan is not modified.
+   */
+  QFuture<bool> run(Plan* plan, const QString& path) const;
+
+ private:
+  QString program;
+  QStringList arguments;
+  int runCount;
+  int firstSeed;
+  int timeout;
+
+  bool prepareRuns(Plan* plan, const QString& path) const;
+};
+
+#endif  // SOLVERRUNNER_H
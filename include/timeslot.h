@@ -5,6 +5,7 @@ class Timeslot;
 
 #include <QObject>
 #include <QString>
+#include "contenthash.h"
 #include "group.h"
 #include "module.h"
 #include "plan.h"
@@ -32,6 +33,27 @@ class Timeslot : public SerializableDataObject {
   QList<Group*> getActiveGroups() const;
   void setActiveGroups(QList<Group*> activeGroups);
 
+  /**
+   *  @brief Get the hash of the contents of this timeslot
+   *  @return The content hash
+   *
+   *  Modules and active groups are only included with their ids. Adding or
+   * removing a single module or group updates the hash in constant time.
+   */
+  quint64 getContentHash() const;
+
+  /**
+   *  @brief Get the content hash of a timeslot without creating it
+   *  @param [in] content is the JSON object of the timeslot
+   *  @param [in] moduleIds are the ids of the modules of the plan
+   *  @param [in] groupIds are the ids of the groups and constraints of the
+   * plan
+   *  @return The hash the timeslot would have after fromJsonObject
+   */
+  static quint64 contentHashOf(const QJsonObject& content,
+                               const QSet<QUuid>& moduleIds,
+                               const QSet<QUuid>& groupIds);
+
  public slots:
   bool containsActiveGroup(Group* gp);
   void addActiveGroup(Group* gp);
@@ -44,11 +66,21 @@ class Timeslot : public SerializableDataObject {
   void nameChanged(const QString name);
   void modulesChanged(const QList<Module*> modules);
   void activeGroupsChanged(const QList<Group*> activeGroups);
+  void contentHashChanged(const quint64 oldHash, const quint64 newHash);
 
  private:
   QString name;
   QList<Module*> modules;
   QList<Group*> activeGroups;
+  quint64 modulesHash;
+  quint64 activeGroupsHash;
+  quint64 contentHash;
+
+  void updateContentHash();
+  static quint64 hashOf(const QUuid& id,
+                        const QString& name,
+                        quint64 modulesHash,
+                        quint64 activeGroupsHash);
 };
 
 #endif  // TIMESLOT_H
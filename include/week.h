@@ -25,13 +25,40 @@ class Week : public SerializableDataObject {
   QList<Day*> getDays() const;
   void setDays(QList<Day*> days);
 
+  /**
+   *  @brief Get the hash of the contents of this week
+   *  @return The content hash
+   *
+   *  Includes the content hashes of the days, so it changes whenever
+   * one of them changes.
+   */
+  quint64 getContentHash() const;
+
+  /**
+   *  @brief Get the content hash of a week without creating it
+   *  @param [in] content is the JSON object of the week
+   *  @param [in] moduleIds are the ids of the modules of the plan
+   *  @param [in] groupIds are the ids of the groups and constraints of the
+   * plan
+   *  @return The hash the week would have after fromJsonObject
+   */
+  static quint64 contentHashOf(const QJsonObject& content,
+                               const QSet<QUuid>& moduleIds,
+                               const QSet<QUuid>& groupIds);
+
  signals:
   void nameChanged(const QString name);
   void daysChanged(const QList<Day*> days);
+  void contentHashChanged(const quint64 oldHash, const quint64 newHash);
 
  private:
   QString name;
   QList<Day*> days;
+  quint64 contentHash;
+
+  void updateContentHash();
+  static quint64 hashOf(const QUuid& id, const QString& name, quint64 daysHash);
+  void trackDays(const QList<Day*>& days, bool track);
 };
 
 #endif  // WEEK_H
@@ -2,6 +2,7 @@ INCLUDEPATH += $$PWD/include
 DEPENDPATH += $$PWD
 
 CONFIG += c++17
+QT += concurrent
 include($$PWD/libs/qt-json-serialization/qt-json-serialization.pri)
 
 SOURCES += \
@@ -12,7 +13,28 @@ SOURCES += \
     $$PWD/src/semester.cpp \
     $$PWD/src/timeslot.cpp \
     $$PWD/src/week.cpp \
-    $$PWD/src/plancsvhelper.cpp
+    $$PWD/src/plancsvhelper.cpp \
+    $$PWD/src/memoryfootprint.cpp \
+    $$PWD/src/plancsvcache.cpp \
+    $$PWD/src/contenthash.cpp \
+    $$PWD/src/schedulecache.cpp \
+    $$PWD/src/planview.cpp \
+    $$PWD/src/slotmask.cpp \
+    $$PWD/src/feasibleslotindex.cpp \
+    $$PWD/src/conflictgraph.cpp \
+    $$PWD/src/plandecomposition.cpp \
+    $$PWD/src/moveevaluator.cpp \
+    $$PWD/src/solverrunner.cpp \
+    $$PWD/src/plancsvscheduletailer.cpp \
+    $$PWD/src/planbinaryexchange.cpp \
+    $$PWD/src/objectlistmodel.cpp \
+    $$PWD/src/planitemmodels.cpp \
+    $$PWD/src/groupindex.cpp \
+    $$PWD/src/idindex.cpp \
+    $$PWD/src/examloadmatrix.cpp \
+    $$PWD/src/schedulemetrics.cpp \
+    $$PWD/src/planchangelog.cpp \
+    $$PWD/src/semesterloader.cpp
 
 HEADERS += \
     $$PWD/include/day.h \
@@ -22,7 +44,37 @@ HEADERS += \
     $$PWD/include/semester.h \
     $$PWD/include/timeslot.h \
     $$PWD/include/week.h \
-    $$PWD/include/plancsvhelper.h
+    $$PWD/include/plancsvhelper.h \
+    $$PWD/include/plancsvdata.h \
+    $$PWD/include/memoryfootprint.h \
+    $$PWD/include/plancsvcache.h \
+    $$PWD/include/contenthash.h \
+    $$PWD/include/schedulecache.h \
+    $$PWD/include/planview.h \
+    $$PWD/include/slotmask.h \
+    $$PWD/include/feasibleslotindex.h \
+    $$PWD/include/conflictgraph.h \
+    $$PWD/include/plandecomposition.h \
+    $$PWD/include/moveevaluator.h \
+    $$PWD/include/solverrunner.h \
+    $$PWD/include/plancsvscheduletailer.h \
+    $$PWD/include/planbinaryexchange.h \
+    $$PWD/include/objectlistmodel.h \
+    $$PWD/include/planitemmodels.h \
+    $$PWD/include/groupindex.h \
+    $$PWD/include/idindex.h \
+    $$PWD/include/examloadmatrix.h \
+    $$PWD/include/schedulemetrics.h \
+    $$PWD/include/planchangelog.h \
+    $$PWD/include/semesterloader.h \
+    $$PWD/include/propertytable.h
+
+# The SQLite backend is optional, as it needs QtSql
+plandatabase{
+    QT += sql
+    SOURCES += $$PWD/src/plandatabase.cpp
+    HEADERS += $$PWD/include/plandatabase.h
+}
 
 test{
     LIBS *= -lgtest
@@ -30,8 +82,34 @@ test{
 
     SOURCES += $$PWD/tests/qthelper.cpp \
             $$PWD/tests/plancsvhelpertest.cpp \
-            $$PWD/tests/testdatatest.cpp
-    HEADERS += $$PWD/tests/include/testdatahelper.h
+            $$PWD/tests/testdatatest.cpp \
+            $$PWD/tests/memoryfootprinttest.cpp \
+            $$PWD/tests/plancsvcachetest.cpp \
+            $$PWD/tests/contenthashtest.cpp \
+            $$PWD/tests/schedulecachetest.cpp \
+            $$PWD/tests/planviewtest.cpp \
+            $$PWD/tests/feasibleslotindextest.cpp \
+            $$PWD/tests/conflictgraphtest.cpp \
+            $$PWD/tests/plandecompositiontest.cpp \
+            $$PWD/tests/moveevaluatortest.cpp \
+            $$PWD/tests/solverrunnertest.cpp \
+            $$PWD/tests/plancsvscheduletailertest.cpp \
+            $$PWD/tests/planbinaryexchangetest.cpp \
+            $$PWD/tests/planitemmodelstest.cpp \
+            $$PWD/tests/groupindextest.cpp \
+            $$PWD/tests/idindextest.cpp \
+            $$PWD/tests/examloadmatrixtest.cpp \
+            $$PWD/tests/schedulemetricstest.cpp \
+            $$PWD/tests/planchangelogtest.cpp \
+            $$PWD/tests/semestertest.cpp \
+            $$PWD/tests/semesterloadertest.cpp \
+            $$PWD/tests/propertytabletest.cpp
+    HEADERS += $$PWD/tests/include/testdatahelper.h \
+            $$PWD/tests/include/futurehelper.h
+
+    plandatabase{
+        SOURCES += $$PWD/tests/plandatabasetest.cpp
+    }
 
     RESOURCES += $$PWD/tests/testdata.qrc
 }
@@ -1,4 +1,5 @@
 QT -= gui
+QT += concurrent
 
 CONFIG += c++17
 
@@ -20,7 +21,28 @@ SOURCES += \
     src/semester.cpp \
     src/timeslot.cpp \
     src/week.cpp \
-    src/plancsvhelper.cpp
+    src/plancsvhelper.cpp \
+    src/memoryfootprint.cpp \
+    src/plancsvcache.cpp \
+    src/contenthash.cpp \
+    src/schedulecache.cpp \
+    src/planview.cpp \
+    src/slotmask.cpp \
+    src/feasibleslotindex.cpp \
+    src/conflictgraph.cpp \
+    src/plandecomposition.cpp \
+    src/moveevaluator.cpp \
+    src/solverrunner.cpp \
+    src/plancsvscheduletailer.cpp \
+    src/planbinaryexchange.cpp \
+    src/objectlistmodel.cpp \
+    src/planitemmodels.cpp \
+    src/groupindex.cpp \
+    src/idindex.cpp \
+    src/examloadmatrix.cpp \
+    src/schedulemetrics.cpp \
+    src/planchangelog.cpp \
+    src/semesterloader.cpp
 
 HEADERS += \
     include/day.h \
@@ -30,7 +52,37 @@ HEADERS += \
     include/semester.h \
     include/timeslot.h \
     include/week.h \
-    include/plancsvhelper.h
+    include/plancsvhelper.h \
+    include/plancsvdata.h \
+    include/memoryfootprint.h \
+    include/plancsvcache.h \
+    include/contenthash.h \
+    include/schedulecache.h \
+    include/planview.h \
+    include/slotmask.h \
+    include/feasibleslotindex.h \
+    include/conflictgraph.h \
+    include/plandecomposition.h \
+    include/moveevaluator.h \
+    include/solverrunner.h \
+    include/plancsvscheduletailer.h \
+    include/planbinaryexchange.h \
+    include/objectlistmodel.h \
+    include/planitemmodels.h \
+    include/groupindex.h \
+    include/idindex.h \
+    include/examloadmatrix.h \
+    include/schedulemetrics.h \
+    include/planchangelog.h \
+    include/semesterloader.h \
+    include/propertytable.h
+
+# The SQLite backend is optional, as it needs QtSql
+plandatabase{
+    QT += sql
+    SOURCES += src/plandatabase.cpp
+    HEADERS += include/plandatabase.h
+}
 
 test{
     include(libs/gtest/gtest_dependency.pri)
@@ -46,10 +98,36 @@ test{
 
     SOURCES += tests/qthelper.cpp \
             tests/plancsvhelpertest.cpp \
-            tests/testdatatest.cpp
-    HEADERS += tests/include/testdatahelper.h
+            tests/testdatatest.cpp \
+            tests/memoryfootprinttest.cpp \
+            tests/plancsvcachetest.cpp \
+            tests/contenthashtest.cpp \
+            tests/schedulecachetest.cpp \
+            tests/planviewtest.cpp \
+            tests/feasibleslotindextest.cpp \
+            tests/conflictgraphtest.cpp \
+            tests/plandecompositiontest.cpp \
+            tests/moveevaluatortest.cpp \
+            tests/solverrunnertest.cpp \
+            tests/plancsvscheduletailertest.cpp \
+            tests/planbinaryexchangetest.cpp \
+            tests/planitemmodelstest.cpp \
+            tests/groupindextest.cpp \
+            tests/idindextest.cpp \
+            tests/examloadmatrixtest.cpp \
+            tests/schedulemetricstest.cpp \
+            tests/planchangelogtest.cpp \
+            tests/semestertest.cpp \
+            tests/semesterloadertest.cpp \
+            tests/propertytabletest.cpp
+    HEADERS += tests/include/testdatahelper.h \
+            tests/include/futurehelper.h
     RESOURCES += tests/testdata.qrc
 
+    plandatabase{
+        SOURCES += tests/plandatabasetest.cpp
+    }
+
     # Default rules for test deployment.
     qnx: target.path = /tmp/$${TARGET}/bin
     else: unix:!android: target.path = /opt/$${TARGET}/bin
@@ -0,0 +1,241 @@
+#include <conflictgraph.h>
+#include <algorithm>
+
+namespace {
+int findRoot(QVector<int>& parents, int element) {
+  while (parents[element] != element) {
+    parents[element] = parents[parents[element]];
+    element = parents[element];
+  }
+  return element;
+}
+}  // namespace
+
+ConflictGraph::ConflictGraph(const QList<Module*>& modules)
+    : modules(modules), componentCount(0), requiredSlots(0) {
+  QHash<Group*, QVector<int>> groupModules;
+  for (int i = 0; i < modules.size(); i++) {
+    moduleIndices.insert(modules[i], i);
+    if (modules[i] == nullptr) {
+      continue;
+    }
+    for (Group* group : modules[i]->getGroups()) {
+      QVector<int>& members = groupModules[group];
+      // A module may list a group twice
+      if (members.isEmpty() || members.last() != i) {
+        members.append(i);
+      }
+    }
+  }
+
+  buildAdjacency(groupModules);
+  componentCount = findComponents(modules.size(), groupModules, components);
+  buildClique(groupModules);
+}
+
+QList<Module*> ConflictGraph::getModules() const {
+  return modules;
+}
+
+int ConflictGraph::getModuleCount() const {
+  return modules.size();
+}
+
+int ConflictGraph::indexOf(Module* module) const {
+  return moduleIndices.value(module, -1);
+}
+
+const QVector<int>& ConflictGraph::getOffsets() const {
+  return offsets;
+}
+
+const QVector<int>& ConflictGraph::getAdjacency() const {
+  return adjacency;
+}
+
+QVector<int> ConflictGraph::getNeighbors(int module) const {
+  if (module < 0 || module >= modules.size()) {
+    return QVector<int>();
+  }
+  return adjacency.mid(offsets[module], getDegree(module));
+}
+
+bool ConflictGraph::conflicts(int first, int second) const {
+  if (first < 0 || first >= modules.size()) {
+    return false;
+  }
+  auto begin = adjacency.constBegin() + offsets[first];
+  auto end = adjacency.constBegin() + offsets[first + 1];
+  return std::binary_search(begin, end, second);
+}
+
+int ConflictGraph::getDegree(int module) const {
+  if (module < 0 || module >= modules.size()) {
+    return 0;
+  }
+  return offsets[module + 1] - offsets[module];
+}
+
+int ConflictGraph::getEdgeCount() const {
+  return adjacency.size() / 2;
+}
+
+int ConflictGraph::getMinimumDegree() const {
+  int minimum = modules.isEmpty() ? 0 : getDegree(0);
+  for (int i = 1; i < modules.size(); i++) {
+    minimum = qMin(minimum, getDegree(i));
+  }
+  return minimum;
+}
+
+int ConflictGraph::getMaximumDegree() const {
+  int maximum = 0;
+  for (int i = 0; i < modules.size(); i++) {
+    maximum = qMax(maximum, getDegree(i));
+  }
+  return maximum;
+}
+
+double ConflictGraph::getAverageDegree() const {
+  if (modules.isEmpty()) {
+    return 0;
+  }
+  return double(adjacency.size()) / modules.size();
+}
+
+int ConflictGraph::getCliqueLowerBound() const {
+  return clique.size();
+}
+
+int ConflictGraph::getRequiredSlotsLowerBound() const {
+  return requiredSlots;
+}
+
+QVector<int> ConflictGraph::getClique() const {
+  return clique;
+}
+
+int ConflictGraph::getComponentCount() const {
+  return componentCount;
+}
+
+int ConflictGraph::getComponent(int module) const {
+  return components.value(module, -1);
+}
+
+QList<QVector<int>> ConflictGraph::getComponents() const {
+  QList<QVector<int>> result;
+  result.reserve(componentCount);
+  for (int i = 0; i < componentCount; i++) {
+    result.append(QVector<int>());
+  }
+  for (int i = 0; i < components.size(); i++) {
+    result[components[i]].append(i);
+  }
+  return result;
+}
+
+void ConflictGraph::buildAdjacency(
+    const QHash<Group*, QVector<int>>& groupModules) {
+  int moduleCount = modules.size();
+  offsets.fill(0, moduleCount + 1);
+  // The last module, that was added as neighbor of each module, so every
+  // neighbor is only added once, even if multiple groups are shared
+  QVector<int> lastSeen(moduleCount, -1);
+  for (int i = 0; i < moduleCount; i++) {
+    offsets[i] = adjacency.size();
+    if (modules[i] == nullptr) {
+      continue;
+    }
+    for (Group* group : modules[i]->getGroups()) {
+      for (int neighbor : groupModules.value(group)) {
+        if (neighbor != i && lastSeen[neighbor] != i) {
+          lastSeen[neighbor] = i;
+          adjacency.append(neighbor);
+        }
+      }
+    }
+    std::sort(adjacency.begin() + offsets[i], adjacency.end());
+  }
+  offsets[moduleCount] = adjacency.size();
+}
+
+int ConflictGraph::findComponents(
+    int moduleCount,
+    const QHash<Group*, QVector<int>>& groupModules,
+    QVector<int>& components) {
+  QVector<int> parents(moduleCount);
+  for (int i = 0; i < moduleCount; i++) {
+    parents[i] = i;
+  }
+  for (const QVector<int>& members : groupModules) {
+    if (members.isEmpty()) {
+      continue;
+    }
+    int root = findRoot(parents, members.first());
+    for (int member : members) {
+      int memberRoot = findRoot(parents, member);
+      if (memberRoot != root) {
+        parents[memberRoot] = root;
+      }
+    }
+  }
+
+  // Number the components in the order of their first module
+  components.fill(-1, moduleCount);
+  QVector<int> rootComponents(moduleCount, -1);
+  int componentCount = 0;
+  for (int i = 0; i < moduleCount; i++) {
+    int root = findRoot(parents, i);
+    if (rootComponents[root] < 0) {
+      rootComponents[root] = componentCount++;
+    }
+    components[i] = rootComponents[root];
+  }
+  return componentCount;
+}
+
+void ConflictGraph::buildClique(
+    const QHash<Group*, QVector<int>>& groupModules) {
+  for (const QVector<int>& members : groupModules) {
+    if (members.size() > clique.size()) {
+      clique = members;
+    }
+  }
+  if (clique.isEmpty()) {
+    if (!modules.isEmpty()) {
+      clique.append(0);
+    }
+  } else {
+    // Only neighbors of the first member can extend the clique
+    for (int candidate : getNeighbors(clique.first())) {
+      if (clique.contains(candidate)) {
+        continue;
+      }
+      bool connected = true;
+      for (int member : clique) {
+        if (!conflicts(candidate, member)) {
+          connected = false;
+          break;
+        }
+      }
+      if (connected) {
+        clique.append(candidate);
+      }
+    }
+  }
+  std::sort(clique.begin(), clique.end());
+
+  for (int member : clique) {
+    requiredSlots +=
+        modules[member] != nullptr ? modules[member]->getExamDuration() : 1;
+  }
+  // A smaller clique of long exams may need more timeslots
+  for (const QVector<int>& members : groupModules) {
+    int duration = 0;
+    for (int member : members) {
+      duration += modules[member]->getExamDuration();
+    }
+    requiredSlots = qMax(requiredSlots, duration);
+  }
+}
@@ -0,0 +1,49 @@
+#include <contenthash.h>
+
+quint64 ContentHash::mix(quint64 value) {
+  // Finalizer of splitmix64
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+quint64 ContentHash::combine(quint64 seed, quint64 value) {
+  return mix(seed ^ (mix(value) + (seed << 6) + (seed >> 2)));
+}
+
+quint64 ContentHash::ofString(const QString& string) {
+  // FNV-1a over the UTF-16 code units
+  quint64 hash = 0xcbf29ce484222325ULL;
+  for (const QChar& character : string) {
+    hash ^= character.unicode();
+    hash *= 0x100000001b3ULL;
+  }
+  return mix(hash);
+}
+
+quint64 ContentHash::ofId(const QUuid& id) {
+  quint64 high = (quint64(id.data1) << 32) | (quint64(id.data2) << 16) |
+                 quint64(id.data3);
+  quint64 low = 0;
+  for (int i = 0; i < 8; i++) {
+    low = (low << 8) | id.data4[i];
+  }
+  return combine(mix(high), low);
+}
+
+quint64 ContentHash::replace(quint64 hash, quint64 oldHash, quint64 newHash) {
+  return hash - mix(oldHash) + mix(newHash);
+}
+
+quint64 ContentHash::ofReferences(const QJsonArray& references,
+                                  const QSet<QUuid>& ids) {
+  quint64 hash = 0;
+  for (const QJsonValue& reference : references) {
+    QUuid id(reference.toString());
+    if (ids.contains(id)) {
+      hash += mix(ofId(id));
+    }
+  }
+  return hash;
+}
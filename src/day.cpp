@@ -1,8 +1,15 @@
 #include <day.h>
+#include <propertytable.h>
 
-Day::Day(QObject *parent) : SerializableDataObject(parent)
-{
+namespace {
+constexpr auto dayProperties = std::make_tuple(
+    PropertyTable::value("name", &Day::getName, &Day::setName),
+    PropertyTable::objects("timeslots", &Day::getTimeslots));
+}  // namespace
 
+Day::Day(QObject *parent) : SerializableDataObject(parent), contentHash(0)
+{
+    updateContentHash();
 }
 
 QString Day::getName() const
@@ -16,6 +23,7 @@ void Day::setName(const QString &name)
         return;
 
     this->name = name;
+    updateContentHash();
     emit nameChanged(name);
 }
 
@@ -29,20 +37,85 @@ void Day::setTimeslots(QList<Timeslot*> timeslots)
     if (this->timeslots == timeslots)
         return;
 
+    trackTimeslots(this->timeslots, false);
     this->timeslots = timeslots;
+    trackTimeslots(this->timeslots, true);
+    updateContentHash();
     emit timeslotsChanged(this->timeslots);
 }
 
+quint64 Day::getContentHash() const
+{
+    return contentHash;
+}
+
+quint64 Day::contentHashOf(const QJsonObject &content,
+                           const QSet<QUuid> &moduleIds,
+                           const QSet<QUuid> &groupIds)
+{
+    // Like ContentHash::ofOrderedContents
+    QJsonArray timeslots = content.value("timeslots").toArray();
+    quint64 timeslotsHash = timeslots.size();
+    for (const QJsonValue &timeslot : timeslots) {
+        timeslotsHash = ContentHash::combine(
+            timeslotsHash,
+            Timeslot::contentHashOf(timeslot.toObject(), moduleIds, groupIds));
+    }
+    return hashOf(PropertyTable::idOf(content),
+                  PropertyTable::valueOf<QString>(content, "name", QString()),
+                  timeslotsHash);
+}
+
+quint64 Day::hashOf(const QUuid &id, const QString &name,
+                    quint64 timeslotsHash)
+{
+    quint64 hash = ContentHash::ofId(id);
+    hash = ContentHash::combine(hash, ContentHash::ofString(name));
+    hash = ContentHash::combine(hash, timeslotsHash);
+    return hash;
+}
+
+void Day::updateContentHash()
+{
+    quint64 hash = hashOf(getId(), name,
+                          ContentHash::ofOrderedContents(timeslots));
+    if (hash == contentHash)
+        return;
+
+    quint64 oldHash = contentHash;
+    contentHash = hash;
+    emit contentHashChanged(oldHash, contentHash);
+}
+
+void Day::trackTimeslots(const QList<Timeslot*> &timeslots, bool track)
+{
+    for (Timeslot* timeslot : timeslots) {
+        if (timeslot == nullptr)
+            continue;
+
+        if (track) {
+            connect(timeslot, &Timeslot::contentHashChanged, this,
+                    &Day::updateContentHash, Qt::UniqueConnection);
+        } else {
+            disconnect(timeslot, &Timeslot::contentHashChanged, this,
+                       &Day::updateContentHash);
+        }
+    }
+}
 
 void Day::fromJsonObject(const QJsonObject &content)
 {
-    simpleValuesFromJsonObject(content);
+    simpleValuesFromJsonObject(PropertyTable::identity(content));
+    PropertyTable::fromJsonObject(this, content, dayProperties);
 
     QJsonArray timeslotsJsonArray = content.value("timeslots").toArray();
+    trackTimeslots(timeslots, false);
     timeslots = fromObjectJsonArray<Timeslot>(timeslotsJsonArray);
+    trackTimeslots(timeslots, true);
+    updateContentHash();
 }
 
 QJsonObject Day::toJsonObject() const
 {
-    return recursiveToJsonObject();
+    return PropertyTable::toJsonObject(this, dayProperties);
 }
@@ -0,0 +1,278 @@
+#include <examloadmatrix.h>
+#include <QSet>
+
+ExamLoadMatrix::ExamLoadMatrix(Plan* plan, QObject* parent)
+    : QObject(parent), plan(plan) {
+  rebuild();
+}
+
+QList<Group*> ExamLoadMatrix::getGroups() const {
+  return groups;
+}
+
+QList<Day*> ExamLoadMatrix::getDays() const {
+  return days;
+}
+
+int ExamLoadMatrix::indexOf(Group* group) const {
+  return groupIndices.value(group, -1);
+}
+
+int ExamLoadMatrix::indexOf(Day* day) const {
+  return dayIndices.value(day, -1);
+}
+
+int ExamLoadMatrix::getCount(int group, int day) const {
+  if (group < 0 || group >= groups.size() || day < 0 || day >= days.size()) {
+    return 0;
+  }
+  return counts[group * days.size() + day];
+}
+
+int ExamLoadMatrix::getCount(Group* group, Day* day) const {
+  return getCount(indexOf(group), indexOf(day));
+}
+
+QVector<int> ExamLoadMatrix::getCounts(Group* group) const {
+  int row = indexOf(group);
+  if (row < 0) {
+    return QVector<int>();
+  }
+  return counts.mid(row * days.size(), days.size());
+}
+
+int ExamLoadMatrix::getTotal(Group* group) const {
+  int row = indexOf(group);
+  return row < 0 ? 0 : totals[row];
+}
+
+bool ExamLoadMatrix::isOverloaded(Group* group, Day* day) const {
+  if (group == nullptr) {
+    return false;
+  }
+  return getCount(group, day) > static_cast<int>(group->getExamsPerDay());
+}
+
+QList<Day*> ExamLoadMatrix::getOverloadedDays(Group* group) const {
+  QList<Day*> result;
+  int row = indexOf(group);
+  if (row < 0) {
+    return result;
+  }
+  int limit = static_cast<int>(group->getExamsPerDay());
+  for (int day = 0; day < days.size(); day++) {
+    if (counts[row * days.size() + day] > limit) {
+      result.append(days[day]);
+    }
+  }
+  return result;
+}
+
+bool ExamLoadMatrix::canAdd(Module* module, Day* day) const {
+  if (module == nullptr || indexOf(day) < 0) {
+    return false;
+  }
+  for (Group* group : module->getGroups()) {
+    if (indexOf(group) >= 0 &&
+        getCount(group, day) + 1 > static_cast<int>(group->getExamsPerDay())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ExamLoadMatrix::rebuild() {
+  disconnectAll();
+  groups.clear();
+  groupIndices.clear();
+  days.clear();
+  dayIndices.clear();
+  slotDays.clear();
+  scheduledModules.clear();
+  moduleGroups.clear();
+  moduleDays.clear();
+  if (plan.isNull()) {
+    counts.clear();
+    totals.clear();
+    emit rebuilt();
+    return;
+  }
+
+  connections.append(connect(plan, &Plan::modulesChanged, this,
+                             &ExamLoadMatrix::updateModules));
+  connections.append(
+      connect(plan, &Plan::groupsChanged, this, &ExamLoadMatrix::rebuild));
+  connections.append(
+      connect(plan, &Plan::weeksChanged, this, &ExamLoadMatrix::rebuild));
+
+  for (Group* group : plan->getGroups()) {
+    if (group != nullptr && !groupIndices.contains(group)) {
+      groupIndices.insert(group, groups.size());
+      groups.append(group);
+    }
+  }
+
+  QList<Timeslot*> timeslots;
+  for (Week* week : plan->getWeeks()) {
+    connections.append(
+        connect(week, &Week::daysChanged, this, &ExamLoadMatrix::rebuild));
+    for (Day* day : week->getDays()) {
+      connections.append(connect(day, &Day::timeslotsChanged, this,
+                                 &ExamLoadMatrix::rebuild));
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        slotDays.insert(timeslot, days.size());
+        timeslots.append(timeslot);
+        connections.append(
+            connect(timeslot, &Timeslot::modulesChanged, this,
+                    [this, timeslot]() { updateTimeslot(timeslot); }));
+      }
+      dayIndices.insert(day, days.size());
+      days.append(day);
+    }
+  }
+  counts.fill(0, groups.size() * days.size());
+  totals.fill(0, groups.size());
+
+  for (Timeslot* timeslot : timeslots) {
+    QList<Module*> scheduled = timeslot->getModules();
+    scheduledModules.insert(timeslot, scheduled);
+    int day = slotDays.value(timeslot);
+    for (Module* module : scheduled) {
+      moduleDays[module].append(day);
+    }
+  }
+
+  for (Module* module : plan->getModules()) {
+    if (module == nullptr || moduleGroups.contains(module)) {
+      continue;
+    }
+    moduleConnections.insert(
+        module, connect(module, &Module::groupsChanged, this,
+                        [this, module]() { updateModule(module); }));
+    QList<Group*> moduleGroupList = module->getGroups();
+    moduleGroups.insert(module, moduleGroupList);
+    for (int day : moduleDays.value(module)) {
+      add(moduleGroupList, day, 1, false);
+    }
+  }
+  emit rebuilt();
+}
+
+void ExamLoadMatrix::disconnectAll() {
+  for (const QMetaObject::Connection& connection : connections) {
+    disconnect(connection);
+  }
+  connections.clear();
+  for (const QMetaObject::Connection& connection : moduleConnections) {
+    disconnect(connection);
+  }
+  moduleConnections.clear();
+}
+
+void ExamLoadMatrix::updateTimeslot(Timeslot* timeslot) {
+  auto dayIterator = slotDays.constFind(timeslot);
+  if (dayIterator == slotDays.constEnd()) {
+    return;
+  }
+  int day = *dayIterator;
+
+  QList<Module*> removed = scheduledModules.value(timeslot);
+  QList<Module*> current = timeslot->getModules();
+  scheduledModules.insert(timeslot, current);
+  QList<Module*> added;
+  for (Module* module : current) {
+    if (!removed.removeOne(module)) {
+      added.append(module);
+    }
+  }
+
+  for (Module* module : removed) {
+    auto iterator = moduleDays.find(module);
+    if (iterator != moduleDays.end()) {
+      iterator->removeOne(day);
+      if (iterator->isEmpty()) {
+        moduleDays.erase(iterator);
+      }
+    }
+    add(moduleGroups.value(module), day, -1, true);
+  }
+  for (Module* module : added) {
+    moduleDays[module].append(day);
+    add(moduleGroups.value(module), day, 1, true);
+  }
+}
+
+void ExamLoadMatrix::updateModule(Module* module) {
+  auto iterator = moduleGroups.find(module);
+  if (iterator == moduleGroups.end()) {
+    return;
+  }
+  QList<Group*> removed = *iterator;
+  QList<Group*> current = module->getGroups();
+  *iterator = current;
+  QList<Group*> added;
+  for (Group* group : current) {
+    if (!removed.removeOne(group)) {
+      added.append(group);
+    }
+  }
+  for (int day : moduleDays.value(module)) {
+    add(removed, day, -1, true);
+    add(added, day, 1, true);
+  }
+}
+
+void ExamLoadMatrix::updateModules(const QList<Module*>& modules) {
+  QSet<Module*> current;
+  current.reserve(modules.size());
+  for (Module* module : modules) {
+    if (module != nullptr) {
+      current.insert(module);
+    }
+  }
+
+  // Removed modules may already be deleted, so only their addresses are used
+  for (auto iterator = moduleGroups.begin(); iterator != moduleGroups.end();) {
+    Module* module = iterator.key();
+    if (current.contains(module)) {
+      ++iterator;
+      continue;
+    }
+    disconnect(moduleConnections.take(module));
+    for (int day : moduleDays.value(module)) {
+      add(*iterator, day, -1, true);
+    }
+    iterator = moduleGroups.erase(iterator);
+  }
+
+  for (Module* module : current) {
+    if (moduleGroups.contains(module)) {
+      continue;
+    }
+    moduleConnections.insert(
+        module, connect(module, &Module::groupsChanged, this,
+                        [this, module]() { updateModule(module); }));
+    QList<Group*> moduleGroupList = module->getGroups();
+    moduleGroups.insert(module, moduleGroupList);
+    for (int day : moduleDays.value(module)) {
+      add(moduleGroupList, day, 1, true);
+    }
+  }
+}
+
+void ExamLoadMatrix::add(const QList<Group*>& affected,
+                         int day,
+                         int count,
+                         bool notify) {
+  for (Group* group : affected) {
+    int row = indexOf(group);
+    if (row < 0) {
+      continue;
+    }
+    int value = counts[row * days.size() + day] += count;
+    totals[row] += count;
+    if (notify) {
+      emit countChanged(group, days[day], value, value - count);
+    }
+  }
+}
@@ -0,0 +1,209 @@
+#include <feasibleslotindex.h>
+#include <QSet>
+
+FeasibleSlotIndex::FeasibleSlotIndex(Plan* plan, QObject* parent)
+    : QObject(parent), plan(plan) {
+  if (plan != nullptr) {
+    groupIndex = plan->getGroupIndex();
+    connect(groupIndex, &GroupIndex::rebuilt, this,
+            &FeasibleSlotIndex::rebuild);
+    connect(groupIndex, &GroupIndex::activeGroupsChanged, this,
+            &FeasibleSlotIndex::updateTimeslot);
+    connect(groupIndex, &GroupIndex::moduleChanged, this,
+            &FeasibleSlotIndex::updateModuleGroups);
+    connect(groupIndex, &GroupIndex::moduleRemoved, this,
+            &FeasibleSlotIndex::removeModule);
+  }
+  rebuild();
+}
+
+int FeasibleSlotIndex::getSlotCount() const {
+  return timeslots.size();
+}
+
+QList<Timeslot*> FeasibleSlotIndex::getTimeslots() const {
+  return timeslots;
+}
+
+int FeasibleSlotIndex::indexOf(Timeslot* timeslot) const {
+  return slotIndices.value(timeslot, -1);
+}
+
+SlotMask FeasibleSlotIndex::getAvailability(Group* group) const {
+  auto iterator = availability.constFind(group);
+  if (iterator == availability.constEnd()) {
+    return calculateAvailability(group);
+  }
+  return *iterator;
+}
+
+SlotMask FeasibleSlotIndex::getFeasibleSlots(Module* module) const {
+  return feasibleSlots.value(module, SlotMask(timeslots.size()));
+}
+
+QList<Timeslot*> FeasibleSlotIndex::getFeasibleTimeslots(
+    Module* module) const {
+  QList<Timeslot*> result;
+  for (int slot : getFeasibleSlots(module).toList()) {
+    result.append(timeslots[slot]);
+  }
+  return result;
+}
+
+bool FeasibleSlotIndex::isFeasible(Module* module, Timeslot* timeslot) const {
+  auto iterator = feasibleSlots.constFind(module);
+  if (iterator == feasibleSlots.constEnd()) {
+    return false;
+  }
+  return iterator->testBit(indexOf(timeslot));
+}
+
+void FeasibleSlotIndex::rebuild() {
+  disconnectAll();
+  timeslots.clear();
+  slotIndices.clear();
+  availability.clear();
+  feasibleSlots.clear();
+  sameDaySuccessors = SlotMask();
+  if (plan.isNull() || groupIndex.isNull()) {
+    return;
+  }
+
+  QList<int> dayEnds;
+  for (Week* week : plan->getWeeks()) {
+    for (Day* day : week->getDays()) {
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        slotIndices.insert(timeslot, timeslots.size());
+        timeslots.append(timeslot);
+      }
+      dayEnds.append(timeslots.size() - 1);
+    }
+  }
+
+  sameDaySuccessors = SlotMask(timeslots.size(), true);
+  for (int dayEnd : dayEnds) {
+    sameDaySuccessors.setBit(dayEnd, false);
+  }
+
+  for (Module* module : plan->getModules()) {
+    if (module != nullptr) {
+      insertModule(module);
+    }
+  }
+}
+
+void FeasibleSlotIndex::disconnectAll() {
+  for (const QMetaObject::Connection& connection : moduleConnections) {
+    disconnect(connection);
+  }
+  moduleConnections.clear();
+}
+
+void FeasibleSlotIndex::insertModule(Module* module) {
+  moduleConnections.insert(
+      module, connect(module, &Module::examDurationChanged, this,
+                      [this, module]() { updateModule(module); }));
+  insertAvailability(groupIndex->getGroups(module));
+  feasibleSlots.insert(module, calculateFeasibleSlots(module));
+}
+
+void FeasibleSlotIndex::removeModule(Module* module) {
+  // The module may already be deleted, so only its address is used
+  disconnect(moduleConnections.take(module));
+  feasibleSlots.remove(module);
+  removeUnusedAvailability();
+}
+
+void FeasibleSlotIndex::insertAvailability(const QList<Group*>& groups) {
+  for (Group* group : groups) {
+    if (!availability.contains(group)) {
+      availability.insert(group, calculateAvailability(group));
+    }
+  }
+}
+
+void FeasibleSlotIndex::removeUnusedAvailability() {
+  for (auto iterator = availability.begin();
+       iterator != availability.end();) {
+    if (groupIndex->getModuleCount(iterator.key()) == 0) {
+      iterator = availability.erase(iterator);
+    } else {
+      ++iterator;
+    }
+  }
+}
+
+void FeasibleSlotIndex::updateTimeslot(Timeslot* timeslot,
+                                       const QList<Group*>& removed,
+                                       const QList<Group*>& added) {
+  int slot = indexOf(timeslot);
+  if (slot < 0) {
+    return;
+  }
+
+  QSet<Module*> affectedModules;
+  for (Group* group : removed + added) {
+    auto iterator = availability.find(group);
+    if (iterator == availability.end()) {
+      continue;
+    }
+    iterator->setBit(slot, added.contains(group));
+    for (Module* module : groupIndex->getModules(group)) {
+      affectedModules.insert(module);
+    }
+  }
+
+  for (Module* module : affectedModules) {
+    updateModule(module);
+  }
+}
+
+void FeasibleSlotIndex::updateModuleGroups(Module* module) {
+  if (!feasibleSlots.contains(module)) {
+    insertModule(module);
+    return;
+  }
+  insertAvailability(groupIndex->getGroups(module));
+  removeUnusedAvailability();
+  updateModule(module);
+}
+
+void FeasibleSlotIndex::updateModule(Module* module) {
+  SlotMask mask = calculateFeasibleSlots(module);
+  auto iterator = feasibleSlots.find(module);
+  if (iterator == feasibleSlots.end() || *iterator == mask) {
+    return;
+  }
+  *iterator = mask;
+  emit feasibleSlotsChanged(module);
+}
+
+SlotMask FeasibleSlotIndex::calculateAvailability(Group* group) const {
+  SlotMask mask(timeslots.size());
+  if (groupIndex.isNull()) {
+    return mask;
+  }
+  for (Timeslot* timeslot : groupIndex->getTimeslots(group)) {
+    int slot = indexOf(timeslot);
+    if (slot >= 0) {
+      mask.setBit(slot);
+    }
+  }
+  return mask;
+}
+
+SlotMask FeasibleSlotIndex::calculateFeasibleSlots(Module* module) const {
+  int slotCount = timeslots.size();
+  SlotMask mask(slotCount, true);
+  for (Group* group : groupIndex->getGroups(module)) {
+    auto iterator = availability.constFind(group);
+    if (iterator == availability.constEnd()) {
+      return SlotMask(slotCount);
+    }
+    mask &= *iterator;
+  }
+  if (module->getExamDuration() == 2) {
+    mask &= mask.shifted(1) & sameDaySuccessors;
+  }
+  return mask;
+}
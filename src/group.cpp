@@ -1,4 +1,17 @@
 #include <group.h>
+#include <propertytable.h>
+
+namespace {
+constexpr auto groupProperties = std::make_tuple(
+    PropertyTable::value("name", &Group::getName, &Group::setName),
+    PropertyTable::value("selected", &Group::getSelected, &Group::setSelected),
+    PropertyTable::value("examsPerDay",
+                         &Group::getExamsPerDay,
+                         &Group::setExamsPerDay),
+    PropertyTable::value("active", &Group::getActive, &Group::setActive),
+    PropertyTable::value("small", &Group::getSmall, &Group::setSmall),
+    PropertyTable::value("obsolete", &Group::getObsolete, &Group::setObsolete));
+}  // namespace
 
 Group::Group(QObject* parent)
     : SerializableDataObject(parent),
@@ -6,7 +19,10 @@ Group::Group(QObject* parent)
       examsPerDay(0),
       active(true),
       small(false),
-      obsolete(false) {}
+      obsolete(false),
+      contentHash(0) {
+  updateContentHash();
+}
 
 QString Group::getName() const {
   return name;
@@ -17,6 +33,7 @@ void Group::setName(const QString& name) {
     return;
 
   this->name = name;
+  updateContentHash();
   emit nameChanged(name);
 }
 
@@ -29,6 +46,7 @@ void Group::setSelected(const bool selected) {
     return;
 
   this->selected = selected;
+  updateContentHash();
   emit selectedChanged(selected);
 }
 
@@ -41,6 +59,7 @@ void Group::setExamsPerDay(unsigned int examsPerDay) {
     return;
 
   this->examsPerDay = examsPerDay;
+  updateContentHash();
   emit examsPerDayChanged(examsPerDay);
 }
 
@@ -53,6 +72,7 @@ void Group::setActive(bool active) {
     return;
 
   this->active = active;
+  updateContentHash();
   emit activeChanged(active);
 }
 
@@ -65,6 +85,7 @@ void Group::setSmall(bool small) {
     return;
 
   this->small = small;
+  updateContentHash();
   emit smallChanged(small);
 }
 
@@ -77,13 +98,59 @@ void Group::setObsolete(bool obsolete) {
     return;
 
   this->obsolete = obsolete;
+  updateContentHash();
   emit obsoleteChanged(obsolete);
 }
 
+quint64 Group::getContentHash() const {
+  return contentHash;
+}
+
+quint64 Group::contentHashOf(const QJsonObject& content) {
+  // Missing values keep the defaults of the constructor
+  return hashOf(PropertyTable::idOf(content),
+                PropertyTable::valueOf<QString>(content, "name", QString()),
+                PropertyTable::valueOf<bool>(content, "selected", false),
+                PropertyTable::valueOf<unsigned int>(content, "examsPerDay", 0),
+                PropertyTable::valueOf<bool>(content, "active", true),
+                PropertyTable::valueOf<bool>(content, "small", false),
+                PropertyTable::valueOf<bool>(content, "obsolete", false));
+}
+
+quint64 Group::hashOf(const QUuid& id,
+                      const QString& name,
+                      bool selected,
+                      unsigned int examsPerDay,
+                      bool active,
+                      bool small,
+                      bool obsolete) {
+  quint64 hash = ContentHash::ofId(id);
+  hash = ContentHash::combine(hash, ContentHash::ofString(name));
+  hash = ContentHash::combine(hash, selected);
+  hash = ContentHash::combine(hash, examsPerDay);
+  hash = ContentHash::combine(hash, active);
+  hash = ContentHash::combine(hash, small);
+  hash = ContentHash::combine(hash, obsolete);
+  return hash;
+}
+
+void Group::updateContentHash() {
+  quint64 hash = hashOf(getId(), name, selected, examsPerDay, active, small,
+                        obsolete);
+  if (hash == contentHash)
+    return;
+
+  quint64 oldHash = contentHash;
+  contentHash = hash;
+  emit contentHashChanged(oldHash, contentHash);
+}
+
 void Group::fromJsonObject(const QJsonObject& content) {
-  simpleValuesFromJsonObject(content);
+  simpleValuesFromJsonObject(PropertyTable::identity(content));
+  PropertyTable::fromJsonObject(this, content, groupProperties);
+  updateContentHash();
 }
 
 QJsonObject Group::toJsonObject() const {
-  return recursiveToJsonObject();
+  return PropertyTable::toJsonObject(this, groupProperties);
 }
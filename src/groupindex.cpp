@@ -0,0 +1,179 @@
+#include <groupindex.h>
+#include <QSet>
+
+namespace {
+/**
+ *  Replaces the entries of owner in the reverse index by the current list and
+ * collects the removed and added groups, if lists for them are given
+ */
+template <typename Owner>
+void updateReverse(Owner* owner,
+                   const QList<Group*>& previous,
+                   const QList<Group*>& current,
+                   QHash<Group*, QList<Owner*>>& reverse,
+                   QList<Group*>* removed = nullptr,
+                   QList<Group*>* added = nullptr) {
+  for (Group* group : previous) {
+    if (!current.contains(group)) {
+      if (removed != nullptr) {
+        removed->append(group);
+      }
+      auto iterator = reverse.find(group);
+      if (iterator != reverse.end()) {
+        iterator->removeOne(owner);
+        if (iterator->isEmpty()) {
+          reverse.erase(iterator);
+        }
+      }
+    }
+  }
+  for (Group* group : current) {
+    if (!previous.contains(group)) {
+      if (added != nullptr) {
+        added->append(group);
+      }
+      QList<Owner*>& owners = reverse[group];
+      if (!owners.contains(owner)) {
+        owners.append(owner);
+      }
+    }
+  }
+}
+}  // namespace
+
+GroupIndex::GroupIndex(Plan* plan, QObject* parent)
+    : QObject(parent), plan(plan) {
+  rebuild();
+}
+
+QList<Timeslot*> GroupIndex::getTimeslots(Group* group) const {
+  return groupTimeslots.value(group);
+}
+
+QList<Module*> GroupIndex::getModules(Group* group) const {
+  return groupModules.value(group);
+}
+
+int GroupIndex::getTimeslotCount(Group* group) const {
+  auto iterator = groupTimeslots.constFind(group);
+  return iterator == groupTimeslots.constEnd() ? 0 : iterator->size();
+}
+
+int GroupIndex::getModuleCount(Group* group) const {
+  auto iterator = groupModules.constFind(group);
+  return iterator == groupModules.constEnd() ? 0 : iterator->size();
+}
+
+QList<Group*> GroupIndex::getGroups(Module* module) const {
+  return moduleGroups.value(module);
+}
+
+void GroupIndex::rebuild() {
+  disconnectAll();
+  timeslotGroups.clear();
+  groupTimeslots.clear();
+  moduleGroups.clear();
+  groupModules.clear();
+  if (plan.isNull()) {
+    emit rebuilt();
+    return;
+  }
+
+  rebuilding = true;
+  connections.append(
+      connect(plan, &Plan::modulesChanged, this, &GroupIndex::updateModules));
+  connections.append(
+      connect(plan, &Plan::weeksChanged, this, &GroupIndex::rebuild));
+  for (Week* week : plan->getWeeks()) {
+    connections.append(
+        connect(week, &Week::daysChanged, this, &GroupIndex::rebuild));
+    for (Day* day : week->getDays()) {
+      connections.append(
+          connect(day, &Day::timeslotsChanged, this, &GroupIndex::rebuild));
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        connections.append(
+            connect(timeslot, &Timeslot::activeGroupsChanged, this,
+                    [this, timeslot]() { updateTimeslot(timeslot); }));
+        updateTimeslot(timeslot);
+      }
+    }
+  }
+  updateModules(plan->getModules());
+  rebuilding = false;
+  emit rebuilt();
+}
+
+void GroupIndex::disconnectAll() {
+  for (const QMetaObject::Connection& connection : connections) {
+    disconnect(connection);
+  }
+  connections.clear();
+  for (const QList<QMetaObject::Connection>& moduleConnection :
+       moduleConnections) {
+    for (const QMetaObject::Connection& connection : moduleConnection) {
+      disconnect(connection);
+    }
+  }
+  moduleConnections.clear();
+}
+
+void GroupIndex::updateTimeslot(Timeslot* timeslot) {
+  QList<Group*> current = timeslot->getActiveGroups();
+  QList<Group*> removed;
+  QList<Group*> added;
+  updateReverse(timeslot, timeslotGroups.value(timeslot), current,
+                groupTimeslots, &removed, &added);
+  timeslotGroups.insert(timeslot, current);
+  if (!rebuilding && (!removed.isEmpty() || !added.isEmpty())) {
+    emit activeGroupsChanged(timeslot, removed, added);
+  }
+}
+
+void GroupIndex::updateModule(Module* module) {
+  QList<Group*> current = module->getGroups() + module->getConstraints();
+  updateReverse(module, moduleGroups.value(module), current, groupModules);
+  moduleGroups.insert(module, current);
+  if (!rebuilding) {
+    emit moduleChanged(module);
+  }
+}
+
+void GroupIndex::updateModules(const QList<Module*>& modules) {
+  QSet<Module*> current;
+  current.reserve(modules.size());
+  for (Module* module : modules) {
+    if (module != nullptr) {
+      current.insert(module);
+    }
+  }
+
+  // Removed modules may already be deleted, so only their addresses are used
+  for (auto iterator = moduleConnections.begin();
+       iterator != moduleConnections.end();) {
+    Module* module = iterator.key();
+    if (current.contains(module)) {
+      ++iterator;
+      continue;
+    }
+    for (const QMetaObject::Connection& connection : iterator.value()) {
+      disconnect(connection);
+    }
+    updateReverse(module, moduleGroups.take(module), {}, groupModules);
+    iterator = moduleConnections.erase(iterator);
+    if (!rebuilding) {
+      emit moduleRemoved(module);
+    }
+  }
+
+  for (Module* module : current) {
+    if (moduleConnections.contains(module)) {
+      continue;
+    }
+    auto update = [this, module]() { updateModule(module); };
+    moduleConnections.insert(
+        module,
+        {connect(module, &Module::groupsChanged, this, update),
+         connect(module, &Module::constraintsChanged, this, update)});
+    updateModule(module);
+  }
+}
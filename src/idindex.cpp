@@ -0,0 +1,193 @@
+#include <idindex.h>
+#include <QSet>
+
+IdIndex::IdIndex(Plan* plan, QObject* parent) : QObject(parent), plan(plan) {
+  rebuild();
+}
+
+SerializableDataObject* IdIndex::find(const QUuid& id) const {
+  auto iterator = objects.constFind(id);
+  if (iterator == objects.constEnd()) {
+    return nullptr;
+  }
+  return iterator->data();
+}
+
+int IdIndex::getCount() const {
+  return objects.size();
+}
+
+QList<QUuid> IdIndex::getIds() const {
+  return objects.keys();
+}
+
+template <typename T, typename Insert, typename Remove>
+void IdIndex::updateList(QList<QObject*>& known,
+                         const QList<T*>& current,
+                         Insert insertObject,
+                         Remove removeObject) {
+  QSet<QObject*> currentSet;
+  currentSet.reserve(current.size());
+  for (T* object : current) {
+    currentSet.insert(object);
+  }
+  QSet<QObject*> knownSet;
+  knownSet.reserve(known.size());
+  for (QObject* object : known) {
+    knownSet.insert(object);
+    if (!currentSet.contains(object)) {
+      removeObject(object);
+    }
+  }
+  known.clear();
+  for (T* object : current) {
+    if (!knownSet.contains(object)) {
+      insertObject(object);
+    }
+    known.append(object);
+  }
+}
+
+void IdIndex::rebuild() {
+  clear();
+  if (plan.isNull()) {
+    return;
+  }
+
+  insert(plan);
+  auto insertObject = [this](SerializableDataObject* object) {
+    insert(object);
+  };
+  auto removeObject = [this](QObject* object) { remove(object); };
+  auto insertWeekObject = [this](Week* week) { insertWeek(week); };
+  auto removeWeekObject = [this](QObject* week) { removeWeek(week); };
+
+  planConnections.append(connect(
+      plan, &Plan::groupsChanged, this,
+      [this, insertObject, removeObject](const QList<Group*> current) {
+        updateList(groups, current, insertObject, removeObject);
+      }));
+  planConnections.append(connect(
+      plan, &Plan::constraintsChanged, this,
+      [this, insertObject, removeObject](const QList<Group*> current) {
+        updateList(constraints, current, insertObject, removeObject);
+      }));
+  planConnections.append(connect(
+      plan, &Plan::modulesChanged, this,
+      [this, insertObject, removeObject](const QList<Module*> current) {
+        updateList(modules, current, insertObject, removeObject);
+      }));
+  planConnections.append(connect(
+      plan, &Plan::weeksChanged, this,
+      [this, insertWeekObject, removeWeekObject](const QList<Week*> current) {
+        updateList(weeks, current, insertWeekObject, removeWeekObject);
+      }));
+
+  updateList(groups, plan->getGroups(), insertObject, removeObject);
+  updateList(constraints, plan->getConstraints(), insertObject, removeObject);
+  updateList(modules, plan->getModules(), insertObject, removeObject);
+  updateList(weeks, plan->getWeeks(), insertWeekObject, removeWeekObject);
+}
+
+void IdIndex::clear() {
+  for (const QMetaObject::Connection& connection : planConnections) {
+    disconnect(connection);
+  }
+  for (const QMetaObject::Connection& connection : childConnections) {
+    disconnect(connection);
+  }
+  planConnections.clear();
+  childConnections.clear();
+  QList<QUuid> removedIds = objects.keys();
+  objects.clear();
+  ids.clear();
+  groups.clear();
+  constraints.clear();
+  modules.clear();
+  weeks.clear();
+  children.clear();
+  for (const QUuid& id : removedIds) {
+    emit removed(id);
+  }
+}
+
+void IdIndex::insert(SerializableDataObject* object) {
+  if (object == nullptr) {
+    return;
+  }
+  QUuid id = object->getId();
+  objects.insert(id, object);
+  ids.insert(object, id);
+  emit inserted(id);
+}
+
+void IdIndex::remove(QObject* object) {
+  // The object may already be deleted, so only its address is used
+  auto iterator = ids.find(object);
+  if (iterator == ids.end()) {
+    return;
+  }
+  QUuid id = *iterator;
+  ids.erase(iterator);
+  auto objectIterator = objects.find(id);
+  if (objectIterator != objects.end() && objectIterator->data() == object) {
+    objects.erase(objectIterator);
+    emit removed(id);
+  }
+}
+
+void IdIndex::insertWeek(Week* week) {
+  if (week == nullptr) {
+    return;
+  }
+  insert(week);
+  childConnections.insert(week, connect(week, &Week::daysChanged, this,
+                                        [this, week]() { updateWeek(week); }));
+  children.insert(week, QList<QObject*>());
+  updateWeek(week);
+}
+
+void IdIndex::removeWeek(QObject* week) {
+  for (QObject* day : children.take(week)) {
+    removeDay(day);
+  }
+  disconnect(childConnections.take(week));
+  remove(week);
+}
+
+void IdIndex::insertDay(Day* day) {
+  if (day == nullptr) {
+    return;
+  }
+  insert(day);
+  childConnections.insert(day, connect(day, &Day::timeslotsChanged, this,
+                                       [this, day]() { updateDay(day); }));
+  children.insert(day, QList<QObject*>());
+  updateDay(day);
+}
+
+void IdIndex::removeDay(QObject* day) {
+  for (QObject* timeslot : children.take(day)) {
+    remove(timeslot);
+  }
+  disconnect(childConnections.take(day));
+  remove(day);
+}
+
+void IdIndex::updateWeek(Week* week) {
+  // Inserting days modifies children, so the list is updated as a copy
+  QList<QObject*> days = children.value(week);
+  updateList(
+      days, week->getDays(), [this](Day* day) { insertDay(day); },
+      [this](QObject* day) { removeDay(day); });
+  children.insert(week, days);
+}
+
+void IdIndex::updateDay(Day* day) {
+  QList<QObject*> timeslots = children.value(day);
+  updateList(
+      timeslots, day->getTimeslots(),
+      [this](Timeslot* timeslot) { insert(timeslot); },
+      [this](QObject* timeslot) { remove(timeslot); });
+  children.insert(day, timeslots);
+}
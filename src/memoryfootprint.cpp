@@ -0,0 +1,223 @@
+#include <memoryfootprint.h>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMetaMethod>
+#include <QMetaObject>
+
+namespace {
+// Approximate sizes of private Qt structures, that are allocated for every
+// QObject and for every connection on 64 bit platforms
+constexpr qint64 objectPrivateSize = 14 * sizeof(void*);
+constexpr qint64 connectionSize = 10 * sizeof(void*);
+// The header of the shared data of a non empty QList
+constexpr qint64 listHeaderSize = 4 * sizeof(int);
+// The private data of a non empty JSON object or array and the size of every
+// value or key in it
+constexpr qint64 jsonContainerSize = 8 * sizeof(void*);
+constexpr qint64 jsonElementSize = 2 * sizeof(void*);
+
+// QObject::receivers is protected, but taking its address through a derived
+// class yields a member pointer, that can be used on every QObject
+struct ReceiverCounter : public QObject {
+  static int count(const QObject* object, const char* signal) {
+    return (object->*(&ReceiverCounter::receivers))(signal);
+  }
+};
+}  // namespace
+
+qint64 MemoryFootprint::total() const {
+  return semesters + plans + modules + groups + weeks + days + timeslots +
+         strings + lists + connections + planContents;
+}
+
+MemoryFootprint& MemoryFootprint::operator+=(const MemoryFootprint& other) {
+  semesters += other.semesters;
+  plans += other.plans;
+  modules += other.modules;
+  groups += other.groups;
+  weeks += other.weeks;
+  days += other.days;
+  timeslots += other.timeslots;
+  strings += other.strings;
+  lists += other.lists;
+  connections += other.connections;
+  planContents += other.planContents;
+  return *this;
+}
+
+QDebug operator<<(QDebug debug, const MemoryFootprint& footprint) {
+  QDebugStateSaver saver(debug);
+  debug.nospace() << "MemoryFootprint(total: " << footprint.total()
+                  << ", semesters: " << footprint.semesters
+                  << ", plans: " << footprint.plans
+                  << ", modules: " << footprint.modules
+                  << ", groups: " << footprint.groups
+                  << ", weeks: " << footprint.weeks
+                  << ", days: " << footprint.days
+                  << ", timeslots: " << footprint.timeslots
+                  << ", strings: " << footprint.strings
+                  << ", lists: " << footprint.lists
+                  << ", connections: " << footprint.connections
+                  << ", planContents: " << footprint.planContents << ")";
+  return debug;
+}
+
+MemoryFootprint MemoryFootprintHelper::measure(const Plan* plan) {
+  MemoryFootprint footprint;
+  if (plan == nullptr) {
+    return footprint;
+  }
+
+  addObject(footprint, footprint.plans, plan, sizeof(Plan));
+  footprint.strings += stringSize(plan->getName());
+  footprint.lists += listSize(plan->getGroups());
+  footprint.lists += listSize(plan->getConstraints());
+  footprint.lists += listSize(plan->getModules());
+  footprint.lists += listSize(plan->getWeeks());
+
+  for (Group* group : plan->getGroups()) {
+    addGroup(footprint, group);
+  }
+  for (Group* constraint : plan->getConstraints()) {
+    addGroup(footprint, constraint);
+  }
+  for (Module* module : plan->getModules()) {
+    addModule(footprint, module);
+  }
+  for (Week* week : plan->getWeeks()) {
+    addWeek(footprint, week);
+  }
+
+  return footprint;
+}
+
+MemoryFootprint MemoryFootprintHelper::measure(const Semester* semester) {
+  MemoryFootprint footprint;
+  if (semester == nullptr) {
+    return footprint;
+  }
+
+  addObject(footprint, footprint.semesters, semester, sizeof(Semester));
+  footprint.strings += stringSize(semester->getName());
+  footprint.lists += listSize(semester->getLoadedPlans());
+
+  for (Plan* plan : semester->getLoadedPlans()) {
+    footprint += measure(plan);
+  }
+  // Plans, that are not loaded, are only kept as JSON
+  for (int i = 0; i < semester->getPlanCount(); i++) {
+    if (!semester->isPlanLoaded(i)) {
+      footprint.planContents += jsonSize(semester->getPlanContent(i));
+    }
+  }
+
+  return footprint;
+}
+
+void MemoryFootprintHelper::addObject(MemoryFootprint& footprint,
+                                      qint64& category,
+                                      const QObject* object,
+                                      qint64 objectSize) {
+  category += objectSize + objectPrivateSize;
+  footprint.strings += stringSize(object->objectName());
+  footprint.connections += connectionsSize(object);
+}
+
+void MemoryFootprintHelper::addModule(MemoryFootprint& footprint,
+                                      const Module* module) {
+  addObject(footprint, footprint.modules, module, sizeof(Module));
+  footprint.strings += stringSize(module->getName());
+  footprint.strings += stringSize(module->getOrigin());
+  footprint.strings += stringSize(module->getNumber());
+  footprint.strings += stringSize(module->getExamType());
+  footprint.lists += listSize(module->getGroups());
+  footprint.lists += listSize(module->getConstraints());
+}
+
+void MemoryFootprintHelper::addGroup(MemoryFootprint& footprint,
+                                     const Group* group) {
+  addObject(footprint, footprint.groups, group, sizeof(Group));
+  footprint.strings += stringSize(group->getName());
+}
+
+void MemoryFootprintHelper::addWeek(MemoryFootprint& footprint,
+                                    const Week* week) {
+  addObject(footprint, footprint.weeks, week, sizeof(Week));
+  footprint.strings += stringSize(week->getName());
+  footprint.lists += listSize(week->getDays());
+
+  for (Day* day : week->getDays()) {
+    addObject(footprint, footprint.days, day, sizeof(Day));
+    footprint.strings += stringSize(day->getName());
+    footprint.lists += listSize(day->getTimeslots());
+
+    for (Timeslot* timeslot : day->getTimeslots()) {
+      addObject(footprint, footprint.timeslots, timeslot, sizeof(Timeslot));
+      footprint.strings += stringSize(timeslot->getName());
+      footprint.lists += listSize(timeslot->getModules());
+      footprint.lists += listSize(timeslot->getActiveGroups());
+    }
+  }
+}
+
+qint64 MemoryFootprintHelper::stringSize(const QString& string) {
+  // Null and empty strings point to static shared data
+  if (string.capacity() == 0) {
+    return 0;
+  }
+  return sizeof(QArrayData) + (string.capacity() + 1) * sizeof(QChar);
+}
+
+template <typename T>
+qint64 MemoryFootprintHelper::listSize(const QList<T>& list) {
+  // Empty lists point to static shared data. QList does not expose its
+  // capacity, so the size is used instead.
+  if (list.isEmpty()) {
+    return 0;
+  }
+  return listHeaderSize + list.size() * sizeof(void*);
+}
+
+qint64 MemoryFootprintHelper::connectionsSize(const QObject* object) {
+  const QMetaObject* metaObject = object->metaObject();
+  int connectionCount = 0;
+  for (int i = 0; i < metaObject->methodCount(); i++) {
+    QMetaMethod method = metaObject->method(i);
+    if (method.methodType() != QMetaMethod::Signal) {
+      continue;
+    }
+    // Build the same signature the SIGNAL() macro would produce
+    QByteArray signature =
+        QByteArray::number(QSIGNAL_CODE) + method.methodSignature();
+    connectionCount += ReceiverCounter::count(object, signature.constData());
+  }
+  return connectionCount * connectionSize;
+}
+
+qint64 MemoryFootprintHelper::jsonSize(const QJsonValue& value) {
+  // Numbers and booleans are stored in the element of their parent, strings
+  // and keys in an additional byte array of it
+  qint64 size = 0;
+  if (value.isString()) {
+    size = value.toString().size() * sizeof(QChar);
+  } else if (value.isArray()) {
+    QJsonArray array = value.toArray();
+    if (!array.isEmpty()) {
+      size = jsonContainerSize;
+    }
+    for (const QJsonValue& element : array) {
+      size += jsonElementSize + jsonSize(element);
+    }
+  } else if (value.isObject()) {
+    QJsonObject object = value.toObject();
+    if (!object.isEmpty()) {
+      size = jsonContainerSize;
+    }
+    for (auto iterator = object.constBegin(); iterator != object.constEnd();
+         iterator++) {
+      size += 2 * jsonElementSize + iterator.key().size() * sizeof(QChar) +
+              jsonSize(iterator.value());
+    }
+  }
+  return size;
+}
@@ -1,7 +1,33 @@
 #include <module.h>
+#include <propertytable.h>
+
+namespace {
+constexpr auto moduleProperties = std::make_tuple(
+    PropertyTable::value("name", &Module::getName, &Module::setName),
+    PropertyTable::value("origin", &Module::getOrigin, &Module::setOrigin),
+    PropertyTable::value("number", &Module::getNumber, &Module::setNumber),
+    PropertyTable::value("active", &Module::getActive, &Module::setActive),
+    PropertyTable::value("examType",
+                         &Module::getExamType,
+                         &Module::setExamType),
+    PropertyTable::value("examDuration",
+                         &Module::getExamDuration,
+                         &Module::setExamDuration),
+    PropertyTable::value("pinned", &Module::getPinned, &Module::setPinned),
+    PropertyTable::references("constraints", &Module::getConstraints),
+    PropertyTable::references("groups", &Module::getGroups));
+}  // namespace
 
 Module::Module(QObject* parent)
-    : SerializableDataObject(parent), active(true), examType("-"), examDuration(1) {}
+    : SerializableDataObject(parent),
+      active(true),
+      examType("-"),
+      examDuration(1),
+      pinned(false),
+      contentHash(0) {
+  updateContentHash();
+}
+
 QString Module::getName() const {
   return name;
 }
@@ -11,6 +37,7 @@ void Module::setName(const QString& name) {
     return;
 
   this->name = name;
+  updateContentHash();
   emit nameChanged(name);
 }
 
@@ -23,6 +50,7 @@ void Module::setOrigin(const QString& origin) {
     return;
 
   this->origin = origin;
+  updateContentHash();
   emit originChanged(origin);
 }
 
@@ -35,6 +63,7 @@ void Module::setNumber(const QString& number) {
     return;
 
   this->number = number;
+  updateContentHash();
   emit numberChanged(number);
 }
 
@@ -47,6 +76,7 @@ void Module::setActive(const bool active) {
     return;
 
   this->active = active;
+  updateContentHash();
   emit activeChanged(active);
 }
 
@@ -62,6 +92,7 @@ void Module::setExamType(QString examType) {
     return;
 
   this->examType = examType;
+  updateContentHash();
   emit examTypeChanged(examType);
 }
 
@@ -79,9 +110,23 @@ void Module::setExamDuration(unsigned int examDuration) {
   }
 
   this->examDuration = examDuration;
+  updateContentHash();
   emit examDurationChanged(this->examDuration);
 }
 
+bool Module::getPinned() const {
+  return pinned;
+}
+
+void Module::setPinned(const bool pinned) {
+  if (pinned == this->pinned)
+    return;
+
+  this->pinned = pinned;
+  updateContentHash();
+  emit pinnedChanged(pinned);
+}
+
 QList<Group*> Module::getConstraints() const {
   return constraints;
 }
@@ -91,6 +136,7 @@ void Module::setConstraints(QList<Group*> constraints) {
     return;
 
   this->constraints = constraints;
+  updateContentHash();
   emit constraintsChanged(this->constraints);
 }
 
@@ -103,6 +149,7 @@ void Module::setGroups(QList<Group*> groups) {
     return;
 
   this->groups = groups;
+  updateContentHash();
   emit groupsChanged(this->groups);
 }
 
@@ -110,6 +157,7 @@ void Module::removeGroup(Group* group) {
   int removed = groups.removeAll(group);
   // int removed = 0;
   if (removed > 0) {
+    updateContentHash();
     emit groupsChanged(this->groups);
   }
 }
@@ -118,20 +166,89 @@ void Module::removeConstraint(Group* constraint) {
   int removed = constraints.removeAll(constraint);
   // int removed = 0;
   if (removed > 0) {
+    updateContentHash();
     emit constraintsChanged(this->constraints);
   }
 }
 
+quint64 Module::getContentHash() const {
+  return contentHash;
+}
+
+quint64 Module::contentHashOf(const QJsonObject& content,
+                              const QSet<QUuid>& groupIds,
+                              const QSet<QUuid>& constraintIds) {
+  // Missing and invalid values keep the defaults of the constructor, like
+  // the setters do
+  QString examType =
+      PropertyTable::valueOf<QString>(content, "examType", QString("-"));
+  if (examType != "P" && examType != "K") {
+    examType = "-";
+  }
+  unsigned int examDuration =
+      PropertyTable::valueOf<unsigned int>(content, "examDuration", 1);
+  if (examDuration != 2) {
+    examDuration = 1;
+  }
+  return hashOf(
+      PropertyTable::idOf(content),
+      PropertyTable::valueOf<QString>(content, "name", QString()),
+      PropertyTable::valueOf<QString>(content, "origin", QString()),
+      PropertyTable::valueOf<QString>(content, "number", QString()),
+      PropertyTable::valueOf<bool>(content, "active", true), examType,
+      examDuration, PropertyTable::valueOf<bool>(content, "pinned", false),
+      ContentHash::ofReferences(content.value("constraints").toArray(),
+                                constraintIds),
+      ContentHash::ofReferences(content.value("groups").toArray(), groupIds));
+}
+
+quint64 Module::hashOf(const QUuid& id,
+                       const QString& name,
+                       const QString& origin,
+                       const QString& number,
+                       bool active,
+                       const QString& examType,
+                       unsigned int examDuration,
+                       bool pinned,
+                       quint64 constraintsHash,
+                       quint64 groupsHash) {
+  quint64 hash = ContentHash::ofId(id);
+  hash = ContentHash::combine(hash, ContentHash::ofString(name));
+  hash = ContentHash::combine(hash, ContentHash::ofString(origin));
+  hash = ContentHash::combine(hash, ContentHash::ofString(number));
+  hash = ContentHash::combine(hash, active);
+  hash = ContentHash::combine(hash, ContentHash::ofString(examType));
+  hash = ContentHash::combine(hash, examDuration);
+  hash = ContentHash::combine(hash, pinned);
+  hash = ContentHash::combine(hash, constraintsHash);
+  hash = ContentHash::combine(hash, groupsHash);
+  return hash;
+}
+
+void Module::updateContentHash() {
+  quint64 hash = hashOf(getId(), name, origin, number, active, examType,
+                        examDuration, pinned, ContentHash::ofIds(constraints),
+                        ContentHash::ofIds(groups));
+  if (hash == contentHash)
+    return;
+
+  quint64 oldHash = contentHash;
+  contentHash = hash;
+  emit contentHashChanged(oldHash, contentHash);
+}
+
 void Module::fromJsonObject(const QJsonObject& content) {
-  simpleValuesFromJsonObject(content);
+  simpleValuesFromJsonObject(PropertyTable::identity(content));
+  PropertyTable::fromJsonObject(this, content, moduleProperties);
   Plan* activePlan = (Plan*)this->parent();
 
   groups =
       fromIdJsonArray<Group>(content.value("groups"), activePlan->getGroups());
   constraints = fromIdJsonArray<Group>(content.value("constraints"),
                                        activePlan->getConstraints());
+  updateContentHash();
 }
 
 QJsonObject Module::toJsonObject() const {
-  return recursiveToJsonObject();
+  return PropertyTable::toJsonObject(this, moduleProperties);
 }
@@ -0,0 +1,528 @@
+#include <moveevaluator.h>
+#include <QSet>
+#include <QtGlobal>
+
+namespace {
+int collisionCost(int count) {
+  return qMax(0, count - 1);
+}
+
+int overflowCost(int count, unsigned int examsPerDay) {
+  return qMax(0, count - static_cast<int>(examsPerDay));
+}
+}  // namespace
+
+int ScheduleCost::total() const {
+  return collisions + examsPerDayOverflow + blockedSlots;
+}
+
+ScheduleCost& ScheduleCost::operator+=(const ScheduleCost& other) {
+  collisions += other.collisions;
+  examsPerDayOverflow += other.examsPerDayOverflow;
+  blockedSlots += other.blockedSlots;
+  return *this;
+}
+
+ScheduleCost ScheduleCost::operator+(const ScheduleCost& other) const {
+  ScheduleCost result = *this;
+  result += other;
+  return result;
+}
+
+ScheduleCost ScheduleCost::operator-(const ScheduleCost& other) const {
+  ScheduleCost result = *this;
+  result.collisions -= other.collisions;
+  result.examsPerDayOverflow -= other.examsPerDayOverflow;
+  result.blockedSlots -= other.blockedSlots;
+  return result;
+}
+
+bool ScheduleCost::operator==(const ScheduleCost& other) const {
+  return collisions == other.collisions &&
+         examsPerDayOverflow == other.examsPerDayOverflow &&
+         blockedSlots == other.blockedSlots;
+}
+
+bool ScheduleCost::operator!=(const ScheduleCost& other) const {
+  return !(*this == other);
+}
+
+MoveEvaluator::MoveEvaluator(Plan* plan, QObject* parent)
+    : QObject(parent), plan(plan) {
+  rebuild();
+}
+
+ScheduleCost MoveEvaluator::getCost() const {
+  return cost;
+}
+
+ScheduleCost MoveEvaluator::evaluateMove(Module* module,
+                                         Timeslot* from,
+                                         Timeslot* to) const {
+  auto iterator = modules.constFind(module);
+  if (iterator == modules.constEnd()) {
+    return ScheduleCost();
+  }
+  int fromSlot = from == nullptr ? -1 : slotIndices.value(from, -1);
+  int toSlot = to == nullptr ? -1 : slotIndices.value(to, -1);
+  if ((from != nullptr && !iterator->startSlots.contains(fromSlot)) ||
+      (to != nullptr && toSlot < 0)) {
+    return ScheduleCost();
+  }
+
+  Changes changes;
+  if (fromSlot >= 0) {
+    collectChanges(*iterator, fromSlot, -1, changes);
+  }
+  if (toSlot >= 0) {
+    collectChanges(*iterator, toSlot, 1, changes);
+  }
+  return evaluate(changes);
+}
+
+ScheduleCost MoveEvaluator::evaluateSwap(Module* first,
+                                         Timeslot* firstTimeslot,
+                                         Module* second,
+                                         Timeslot* secondTimeslot) const {
+  auto firstIterator = modules.constFind(first);
+  auto secondIterator = modules.constFind(second);
+  if (firstIterator == modules.constEnd() ||
+      secondIterator == modules.constEnd()) {
+    return ScheduleCost();
+  }
+  int firstSlot = slotIndices.value(firstTimeslot, -1);
+  int secondSlot = slotIndices.value(secondTimeslot, -1);
+  if (firstSlot < 0 || secondSlot < 0 ||
+      !firstIterator->startSlots.contains(firstSlot) ||
+      !secondIterator->startSlots.contains(secondSlot)) {
+    return ScheduleCost();
+  }
+
+  Changes changes;
+  collectChanges(*firstIterator, firstSlot, -1, changes);
+  collectChanges(*secondIterator, secondSlot, -1, changes);
+  collectChanges(*firstIterator, secondSlot, 1, changes);
+  collectChanges(*secondIterator, firstSlot, 1, changes);
+  return evaluate(changes);
+}
+
+int MoveEvaluator::getSlotCount(Group* group, Timeslot* timeslot) const {
+  int slot = slotIndices.value(timeslot, -1);
+  if (slot < 0) {
+    return 0;
+  }
+  return countAt(slotCounts, group, slot) +
+         countAt(constraintSlotCounts, group, slot);
+}
+
+int MoveEvaluator::getDayCount(Group* group, Day* day) const {
+  return loads.isNull() ? 0 : loads->getCount(group, day);
+}
+
+void MoveEvaluator::rebuild() {
+  disconnectAll();
+  timeslots.clear();
+  slotIndices.clear();
+  slotDays.clear();
+  days.clear();
+  availability.clear();
+  activeGroups.clear();
+  scheduledModules.clear();
+  modules.clear();
+  examsPerDay.clear();
+  slotCounts.clear();
+  constraintSlotCounts.clear();
+  cost = ScheduleCost();
+  if (plan.isNull()) {
+    loads.clear();
+    return;
+  }
+
+  // The matrix reports single changes and rebuilds, either may happen before
+  // or after this evaluator is updated for the same change of the plan
+  loads = plan->getExamLoadMatrix();
+  connections.append(connect(loads.data(), &ExamLoadMatrix::countChanged, this,
+                             &MoveEvaluator::updateDayCount));
+  connections.append(connect(loads.data(), &ExamLoadMatrix::rebuilt, this,
+                             &MoveEvaluator::updateExamsPerDayOverflow));
+
+  connections.append(connect(plan, &Plan::modulesChanged, this,
+                             &MoveEvaluator::updateModuleList));
+  connections.append(
+      connect(plan, &Plan::groupsChanged, this, &MoveEvaluator::rebuild));
+  connections.append(
+      connect(plan, &Plan::constraintsChanged, this, &MoveEvaluator::rebuild));
+  connections.append(
+      connect(plan, &Plan::weeksChanged, this, &MoveEvaluator::rebuild));
+
+  for (Week* week : plan->getWeeks()) {
+    connections.append(
+        connect(week, &Week::daysChanged, this, &MoveEvaluator::rebuild));
+    for (Day* day : week->getDays()) {
+      int dayIndex = days.size();
+      days.append(day);
+      connections.append(connect(day, &Day::timeslotsChanged, this,
+                                 &MoveEvaluator::rebuild));
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        slotIndices.insert(timeslot, timeslots.size());
+        timeslots.append(timeslot);
+        slotDays.append(dayIndex);
+        connections.append(
+            connect(timeslot, &Timeslot::modulesChanged, this,
+                    [this, timeslot]() { updateModules(timeslot); }));
+        connections.append(
+            connect(timeslot, &Timeslot::activeGroupsChanged, this,
+                    [this, timeslot]() { updateActiveGroups(timeslot); }));
+      }
+    }
+  }
+
+  int slotCount = timeslots.size();
+  for (int slot = 0; slot < slotCount; slot++) {
+    QList<Group*> groups = timeslots[slot]->getActiveGroups();
+    activeGroups.insert(timeslots[slot], groups);
+    for (Group* group : groups) {
+      auto iterator = availability.find(group);
+      if (iterator == availability.end()) {
+        iterator = availability.insert(group, SlotMask(slotCount));
+      }
+      iterator->setBit(slot);
+    }
+  }
+
+  for (Group* group : plan->getGroups() + plan->getConstraints()) {
+    if (group == nullptr) {
+      continue;
+    }
+    examsPerDay.insert(group, group->getExamsPerDay());
+    connections.append(connect(group, &Group::examsPerDayChanged, this,
+                               [this, group]() { updateExamsPerDay(group); }));
+  }
+
+  for (Module* module : plan->getModules()) {
+    if (module != nullptr && !modules.contains(module)) {
+      insertModule(module);
+    }
+  }
+
+  Changes changes;
+  for (int slot = 0; slot < slotCount; slot++) {
+    QList<Module*> scheduled = timeslots[slot]->getModules();
+    scheduledModules.insert(timeslots[slot], scheduled);
+    for (Module* module : scheduled) {
+      auto iterator = modules.find(module);
+      if (iterator == modules.end()) {
+        continue;
+      }
+      iterator->startSlots.append(slot);
+      collectChanges(*iterator, slot, 1, changes);
+    }
+  }
+  apply(changes);
+  updateExamsPerDayOverflow();
+}
+
+void MoveEvaluator::disconnectAll() {
+  for (const QMetaObject::Connection& connection : connections) {
+    disconnect(connection);
+  }
+  connections.clear();
+  for (const QList<QMetaObject::Connection>& list : moduleConnections) {
+    for (const QMetaObject::Connection& connection : list) {
+      disconnect(connection);
+    }
+  }
+  moduleConnections.clear();
+}
+
+void MoveEvaluator::insertModule(Module* module) {
+  auto update = [this, module]() { updateModule(module); };
+  QList<QMetaObject::Connection>& list = moduleConnections[module];
+  list.append(connect(module, &Module::groupsChanged, this, update));
+  list.append(connect(module, &Module::constraintsChanged, this, update));
+  list.append(connect(module, &Module::examDurationChanged, this, update));
+  ModuleData data;
+  data.groups = module->getGroups();
+  data.constraints = module->getConstraints();
+  data.duration = static_cast<int>(module->getExamDuration());
+  modules.insert(module, data);
+}
+
+void MoveEvaluator::updateModuleList(const QList<Module*>& current) {
+  QSet<Module*> currentSet;
+  currentSet.reserve(current.size());
+  for (Module* module : current) {
+    if (module != nullptr) {
+      currentSet.insert(module);
+    }
+  }
+
+  // Removed modules may already be deleted, so only their addresses and the
+  // stored data are used
+  Changes changes;
+  for (auto iterator = modules.begin(); iterator != modules.end();) {
+    if (currentSet.contains(iterator.key())) {
+      ++iterator;
+      continue;
+    }
+    for (int slot : iterator->startSlots) {
+      collectChanges(*iterator, slot, -1, changes);
+    }
+    for (const QMetaObject::Connection& connection :
+         moduleConnections.take(iterator.key())) {
+      disconnect(connection);
+    }
+    iterator = modules.erase(iterator);
+  }
+
+  QSet<Module*> added;
+  for (Module* module : currentSet) {
+    if (!modules.contains(module)) {
+      insertModule(module);
+      added.insert(module);
+    }
+  }
+
+  // Added modules may already be scheduled
+  for (int slot = 0; !added.isEmpty() && slot < timeslots.size(); slot++) {
+    for (Module* module : scheduledModules.value(timeslots[slot])) {
+      if (added.contains(module)) {
+        ModuleData& data = modules[module];
+        data.startSlots.append(slot);
+        collectChanges(data, slot, 1, changes);
+      }
+    }
+  }
+  apply(changes);
+}
+
+void MoveEvaluator::updateModules(Timeslot* timeslot) {
+  int slot = slotIndices.value(timeslot, -1);
+  if (slot < 0) {
+    return;
+  }
+
+  QList<Module*> removed = scheduledModules.value(timeslot);
+  QList<Module*> current = timeslot->getModules();
+  scheduledModules.insert(timeslot, current);
+  QList<Module*> added;
+  for (Module* module : current) {
+    if (!removed.removeOne(module)) {
+      added.append(module);
+    }
+  }
+
+  Changes changes;
+  for (Module* module : removed) {
+    auto iterator = modules.find(module);
+    if (iterator != modules.end()) {
+      iterator->startSlots.removeOne(slot);
+      collectChanges(*iterator, slot, -1, changes);
+    }
+  }
+  for (Module* module : added) {
+    auto iterator = modules.find(module);
+    if (iterator != modules.end()) {
+      iterator->startSlots.append(slot);
+      collectChanges(*iterator, slot, 1, changes);
+    }
+  }
+  apply(changes);
+}
+
+void MoveEvaluator::updateActiveGroups(Timeslot* timeslot) {
+  int slot = slotIndices.value(timeslot, -1);
+  if (slot < 0) {
+    return;
+  }
+
+  QList<Group*> previous = activeGroups.value(timeslot);
+  QList<Group*> current = timeslot->getActiveGroups();
+  activeGroups.insert(timeslot, current);
+  for (Group* group : previous) {
+    if (!current.contains(group) && isActive(group, slot)) {
+      availability[group].setBit(slot, false);
+      cost.blockedSlots += countAt(slotCounts, group, slot) +
+                           countAt(constraintSlotCounts, group, slot);
+    }
+  }
+  for (Group* group : current) {
+    if (isActive(group, slot)) {
+      continue;
+    }
+    auto iterator = availability.find(group);
+    if (iterator == availability.end()) {
+      iterator = availability.insert(group, SlotMask(timeslots.size()));
+    }
+    iterator->setBit(slot);
+    cost.blockedSlots -= countAt(slotCounts, group, slot) +
+                         countAt(constraintSlotCounts, group, slot);
+  }
+}
+
+void MoveEvaluator::updateExamsPerDay(Group* group) {
+  unsigned int previous = examsPerDay.value(group);
+  unsigned int current = group->getExamsPerDay();
+  examsPerDay.insert(group, current);
+  if (loads.isNull()) {
+    return;
+  }
+  for (int count : loads->getCounts(group)) {
+    cost.examsPerDayOverflow +=
+        overflowCost(count, current) - overflowCost(count, previous);
+  }
+}
+
+void MoveEvaluator::updateDayCount(Group* group,
+                                   Day* day,
+                                   int count,
+                                   int previousCount) {
+  Q_UNUSED(day)
+  unsigned int limit = examsPerDay.value(group);
+  cost.examsPerDayOverflow +=
+      overflowCost(count, limit) - overflowCost(previousCount, limit);
+}
+
+void MoveEvaluator::updateExamsPerDayOverflow() {
+  cost.examsPerDayOverflow = 0;
+  if (loads.isNull()) {
+    return;
+  }
+  QList<Group*> groups = loads->getGroups();
+  int dayCount = loads->getDays().size();
+  for (int row = 0; row < groups.size(); row++) {
+    unsigned int limit = examsPerDay.value(groups[row]);
+    for (int day = 0; day < dayCount; day++) {
+      cost.examsPerDayOverflow +=
+          overflowCost(loads->getCount(row, day), limit);
+    }
+  }
+}
+
+void MoveEvaluator::updateModule(Module* module) {
+  auto iterator = modules.find(module);
+  if (iterator == modules.end()) {
+    return;
+  }
+
+  Changes changes;
+  for (int slot : iterator->startSlots) {
+    collectChanges(*iterator, slot, -1, changes);
+  }
+  iterator->groups = module->getGroups();
+  iterator->constraints = module->getConstraints();
+  iterator->duration = static_cast<int>(module->getExamDuration());
+  for (int slot : iterator->startSlots) {
+    collectChanges(*iterator, slot, 1, changes);
+  }
+  apply(changes);
+}
+
+void MoveEvaluator::collectChanges(const ModuleData& data,
+                                   int slot,
+                                   int sign,
+                                   Changes& changes) const {
+  int day = slotDays[slot];
+  for (Group* group : data.groups) {
+    changes.days[qMakePair(group, day)] += sign;
+  }
+  for (int offset = 0; offset < qMax(1, data.duration); offset++) {
+    int occupied = slot + offset;
+    if (occupied >= timeslots.size() || slotDays[occupied] != day) {
+      changes.missingSlots +=
+          sign * (data.groups.size() + data.constraints.size());
+      continue;
+    }
+    for (Group* group : data.groups) {
+      changes.groupSlots[qMakePair(group, occupied)] += sign;
+    }
+    for (Group* constraint : data.constraints) {
+      changes.constraintSlots[qMakePair(constraint, occupied)] += sign;
+    }
+  }
+}
+
+ScheduleCost MoveEvaluator::evaluate(const Changes& changes) const {
+  ScheduleCost delta;
+  for (auto iterator = changes.groupSlots.constBegin();
+       iterator != changes.groupSlots.constEnd(); iterator++) {
+    Group* group = iterator.key().first;
+    int slot = iterator.key().second;
+    int count = countAt(slotCounts, group, slot);
+    delta.collisions +=
+        collisionCost(count + iterator.value()) - collisionCost(count);
+    if (!isActive(group, slot)) {
+      delta.blockedSlots += iterator.value();
+    }
+  }
+  for (auto iterator = changes.constraintSlots.constBegin();
+       iterator != changes.constraintSlots.constEnd(); iterator++) {
+    if (!isActive(iterator.key().first, iterator.key().second)) {
+      delta.blockedSlots += iterator.value();
+    }
+  }
+  for (auto iterator = changes.days.constBegin();
+       !loads.isNull() && iterator != changes.days.constEnd(); iterator++) {
+    // Only the groups of the plan have a row in the matrix
+    Group* group = iterator.key().first;
+    int row = loads->indexOf(group);
+    if (row < 0) {
+      continue;
+    }
+    int column = loads->indexOf(days[iterator.key().second]);
+    int count = loads->getCount(row, column);
+    unsigned int limit = examsPerDay.value(group);
+    delta.examsPerDayOverflow += overflowCost(count + iterator.value(), limit) -
+                                 overflowCost(count, limit);
+  }
+  delta.blockedSlots += changes.missingSlots;
+  return delta;
+}
+
+void MoveEvaluator::apply(const Changes& changes) {
+  // The exams per day are counted by the matrix, which reports the changes
+  // of the overflow through countChanged
+  ScheduleCost delta = evaluate(changes);
+  delta.examsPerDayOverflow = 0;
+  cost += delta;
+  for (auto iterator = changes.groupSlots.constBegin();
+       iterator != changes.groupSlots.constEnd(); iterator++) {
+    addAt(slotCounts, iterator.key().first, iterator.key().second,
+          timeslots.size(), iterator.value());
+  }
+  for (auto iterator = changes.constraintSlots.constBegin();
+       iterator != changes.constraintSlots.constEnd(); iterator++) {
+    addAt(constraintSlotCounts, iterator.key().first, iterator.key().second,
+          timeslots.size(), iterator.value());
+  }
+}
+
+bool MoveEvaluator::isActive(Group* group, int slot) const {
+  auto iterator = availability.constFind(group);
+  return iterator != availability.constEnd() && iterator->testBit(slot);
+}
+
+int MoveEvaluator::countAt(const QHash<Group*, QVector<int>>& counts,
+                           Group* group,
+                           int index) {
+  auto iterator = counts.constFind(group);
+  if (iterator == counts.constEnd()) {
+    return 0;
+  }
+  return iterator->at(index);
+}
+
+void MoveEvaluator::addAt(QHash<Group*, QVector<int>>& counts,
+                          Group* group,
+                          int index,
+                          int size,
+                          int value) {
+  if (value == 0) {
+    return;
+  }
+  auto iterator = counts.find(group);
+  if (iterator == counts.end()) {
+    iterator = counts.insert(group, QVector<int>(size, 0));
+  }
+  (*iterator)[index] += value;
+}
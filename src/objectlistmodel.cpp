@@ -0,0 +1,200 @@
+#include <objectlistmodel.h>
+#include <QMetaMethod>
+#include <QMetaProperty>
+#include <QSet>
+
+ObjectListModel::ObjectListModel(const QMetaObject* objectType,
+                                 QObject* parent)
+    : QAbstractListModel(parent), objectType(objectType), displayRole(-1) {
+  roles.insert(ObjectRole, "object");
+  for (int i = 0; i < objectType->propertyCount(); i++) {
+    QMetaProperty property = objectType->property(i);
+    int role = ObjectRole + 1 + i;
+    roles.insert(role, property.name());
+    if (QByteArray(property.name()) == "name") {
+      displayRole = role;
+    }
+    if (property.hasNotifySignal()) {
+      notifyRoles[property.notifySignalIndex()].append(role);
+      if (role == displayRole) {
+        notifyRoles[property.notifySignalIndex()].append(Qt::DisplayRole);
+      }
+    }
+  }
+}
+
+int ObjectListModel::rowCount(const QModelIndex& parent) const {
+  if (parent.isValid()) {
+    return 0;
+  }
+  return objects.size();
+}
+
+QVariant ObjectListModel::data(const QModelIndex& index, int role) const {
+  QObject* object = get(index.row());
+  if (object == nullptr || index.column() != 0) {
+    return QVariant();
+  }
+  if (role == Qt::DisplayRole) {
+    role = displayRole;
+  }
+  if (role == ObjectRole) {
+    return QVariant::fromValue(object);
+  }
+  int propertyIndex = role - ObjectRole - 1;
+  if (propertyIndex < 0 || propertyIndex >= objectType->propertyCount()) {
+    return QVariant();
+  }
+  return objectType->property(propertyIndex).read(object);
+}
+
+QHash<int, QByteArray> ObjectListModel::roleNames() const {
+  return roles;
+}
+
+QObject* ObjectListModel::get(int row) const {
+  if (row < 0 || row >= objects.size()) {
+    return nullptr;
+  }
+  return objects[row];
+}
+
+int ObjectListModel::indexOf(QObject* object) const {
+  return rows.value(object, -1);
+}
+
+int ObjectListModel::roleOf(const QByteArray& name) const {
+  return roles.key(name, -1);
+}
+
+void ObjectListModel::setObjects(const QList<QObject*>& newObjects) {
+  QSet<QObject*> newSet;
+  newSet.reserve(newObjects.size());
+  for (QObject* object : newObjects) {
+    newSet.insert(object);
+  }
+  QList<QObject*> kept;
+  for (QObject* object : objects) {
+    if (newSet.contains(object)) {
+      kept.append(object);
+    }
+  }
+
+  // Rows can only be removed and inserted precisely, if the kept objects
+  // stay in the same order and the new list has no duplicates
+  bool precise = newSet.size() == newObjects.size();
+  QSet<QObject*> keptSet;
+  for (QObject* object : kept) {
+    keptSet.insert(object);
+  }
+  int keptIndex = 0;
+  for (int i = 0; precise && i < newObjects.size(); i++) {
+    if (keptIndex < kept.size() && newObjects[i] == kept[keptIndex]) {
+      keptIndex++;
+    } else if (keptSet.contains(newObjects[i])) {
+      precise = false;
+    }
+  }
+
+  if (!precise) {
+    beginResetModel();
+    for (QObject* object : objects) {
+      untrack(object);
+    }
+    objects = newObjects;
+    for (QObject* object : objects) {
+      track(object);
+    }
+    updateRows();
+    endResetModel();
+    return;
+  }
+
+  // Remove runs of objects from the back, so the rows in front stay valid
+  for (int last = objects.size() - 1; last >= 0; last--) {
+    if (keptSet.contains(objects[last])) {
+      continue;
+    }
+    int first = last;
+    while (first > 0 && !keptSet.contains(objects[first - 1])) {
+      first--;
+    }
+    beginRemoveRows(QModelIndex(), first, last);
+    for (int i = last; i >= first; i--) {
+      untrack(objects[i]);
+      objects.removeAt(i);
+    }
+    updateRows();
+    endRemoveRows();
+    last = first;
+  }
+
+  // Insert runs of new objects from the front
+  for (int first = 0; first < newObjects.size(); first++) {
+    if (keptSet.contains(newObjects[first])) {
+      continue;
+    }
+    int last = first;
+    while (last + 1 < newObjects.size() &&
+           !keptSet.contains(newObjects[last + 1])) {
+      last++;
+    }
+    beginInsertRows(QModelIndex(), first, last);
+    for (int i = first; i <= last; i++) {
+      objects.insert(i, newObjects[i]);
+      track(newObjects[i]);
+    }
+    updateRows();
+    endInsertRows();
+    first = last;
+  }
+}
+
+void ObjectListModel::propertyChanged() {
+  int row = indexOf(sender());
+  if (row < 0) {
+    return;
+  }
+  QModelIndex changed = index(row);
+  emit dataChanged(changed, changed, notifyRoles.value(senderSignalIndex()));
+}
+
+void ObjectListModel::track(QObject* object) {
+  if (object == nullptr) {
+    return;
+  }
+  QMetaMethod slot = staticMetaObject.method(
+      staticMetaObject.indexOfSlot("propertyChanged()"));
+  for (auto iterator = notifyRoles.constBegin();
+       iterator != notifyRoles.constEnd(); iterator++) {
+    connect(object, objectType->method(iterator.key()), this, slot);
+  }
+  connect(object, &QObject::destroyed, this,
+          [this](QObject* object) { removeDestroyed(object); });
+}
+
+void ObjectListModel::untrack(QObject* object) {
+  if (object == nullptr) {
+    return;
+  }
+  disconnect(object, nullptr, this, nullptr);
+}
+
+void ObjectListModel::removeDestroyed(QObject* object) {
+  int row = indexOf(object);
+  if (row < 0) {
+    return;
+  }
+  beginRemoveRows(QModelIndex(), row, row);
+  objects.removeAt(row);
+  updateRows();
+  endRemoveRows();
+}
+
+void ObjectListModel::updateRows() {
+  rows.clear();
+  rows.reserve(objects.size());
+  for (int i = 0; i < objects.size(); i++) {
+    rows.insert(objects[i], i);
+  }
+}
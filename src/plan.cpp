@@ -1,6 +1,46 @@
+#include <examloadmatrix.h>
+#include <feasibleslotindex.h>
+#include <groupindex.h>
+#include <idindex.h>
 #include <plan.h>
+#include <propertytable.h>
 
-Plan::Plan(QObject* parent) : SerializableDataObject(parent) {}
+namespace {
+constexpr auto planProperties = std::make_tuple(
+    PropertyTable::value("name", &Plan::getName, &Plan::setName),
+    PropertyTable::objects("constraints", &Plan::getConstraints),
+    PropertyTable::objects("groups", &Plan::getGroups),
+    PropertyTable::objects("weeks", &Plan::getWeeks),
+    PropertyTable::objects("modules", &Plan::getModules));
+}  // namespace
+
+Plan::Plan(QObject* parent)
+    : SerializableDataObject(parent),
+      constraintsHash(0),
+      groupsHash(0),
+      modulesHash(0),
+      weeksHash(0),
+      contentHash(0),
+      groupIndex(nullptr),
+      examLoadMatrix(nullptr),
+      feasibleSlotIndex(nullptr),
+      idIndex(nullptr) {
+  updateWeeksHash();
+}
+
+template <typename T, typename Slot>
+void Plan::trackContentHashes(const QList<T*>& objects, Slot slot, bool track) {
+  for (T* object : objects) {
+    if (object == nullptr)
+      continue;
+
+    if (track) {
+      connect(object, &T::contentHashChanged, this, slot, Qt::UniqueConnection);
+    } else {
+      disconnect(object, &T::contentHashChanged, this, slot);
+    }
+  }
+}
 
 QString Plan::getName() const {
   return name;
@@ -11,6 +51,7 @@ void Plan::setName(const QString& name) {
     return;
 
   this->name = name;
+  updateContentHash();
   emit nameChanged(this->name);
 }
 
@@ -22,7 +63,13 @@ void Plan::setConstraints(QList<Group*> constraints) {
   if (this->constraints == constraints)
     return;
 
+  trackContentHashes(this->constraints, &Plan::constraintContentHashChanged,
+                     false);
   this->constraints = constraints;
+  trackContentHashes(this->constraints, &Plan::constraintContentHashChanged,
+                     true);
+  constraintsHash = ContentHash::ofContents(this->constraints);
+  updateContentHash();
   emit constraintsChanged(this->constraints);
 }
 
@@ -34,7 +81,11 @@ void Plan::setGroups(QList<Group*> groups) {
   if (this->groups == groups)
     return;
 
+  trackContentHashes(this->groups, &Plan::groupContentHashChanged, false);
   this->groups = groups;
+  trackContentHashes(this->groups, &Plan::groupContentHashChanged, true);
+  groupsHash = ContentHash::ofContents(this->groups);
+  updateContentHash();
   emit groupsChanged(this->groups);
 }
 
@@ -46,7 +97,10 @@ void Plan::setWeeks(QList<Week*> weeks) {
   if (this->weeks == weeks)
     return;
 
+  trackContentHashes(this->weeks, &Plan::updateWeeksHash, false);
   this->weeks = weeks;
+  trackContentHashes(this->weeks, &Plan::updateWeeksHash, true);
+  updateWeeksHash();
   emit weeksChanged(this->weeks);
 }
 
@@ -59,7 +113,11 @@ void Plan::setModules(QList<Module*> modules) {
   if (this->modules == modules)
     return;
 
+  trackContentHashes(this->modules, &Plan::moduleContentHashChanged, false);
   this->modules = modules;
+  trackContentHashes(this->modules, &Plan::moduleContentHashChanged, true);
+  modulesHash = ContentHash::ofContents(this->modules);
+  updateContentHash();
   emit modulesChanged(this->modules);
 }
 
@@ -67,18 +125,18 @@ void Plan::addNewGroup(const QString& name) {
   Group* gp = new Group(this);
   gp->setName(name);
   groups.append(gp);
+  trackContentHashes<Group>({gp}, &Plan::groupContentHashChanged, true);
+  groupsHash += ContentHash::mix(gp->getContentHash());
+  updateContentHash();
   emit groupsChanged(this->groups);
 }
 
 void Plan::removeGroup(Group* gp) {
   if (groups.removeAll(gp) > 0) {
-    for (Week* week : weeks) {
-      for (Day* day : week->getDays()) {
-        for (Timeslot* slot : day->getTimeslots()) {
-          slot->removeActiveGroup(gp);
-        }
-      }
-    }
+    trackContentHashes<Group>({gp}, &Plan::groupContentHashChanged, false);
+    groupsHash = ContentHash::ofContents(groups);
+    updateContentHash();
+    removeGroupReferences(gp);
   }
   emit groupsChanged(this->groups);
 }
@@ -87,24 +145,182 @@ void Plan::addNewConstraint(const QString& name) {
   Group* gp = new Group(this);
   gp->setName(name);
   constraints.append(gp);
+  trackContentHashes<Group>({gp}, &Plan::constraintContentHashChanged, true);
+  constraintsHash += ContentHash::mix(gp->getContentHash());
+  updateContentHash();
   emit constraintsChanged(this->constraints);
 }
 
 void Plan::removeConstraint(Group* gp) {
   if (constraints.removeAll(gp) > 0) {
-    for (Week* week : weeks) {
-      for (Day* day : week->getDays()) {
-        for (Timeslot* slot : day->getTimeslots()) {
-          slot->removeActiveGroup(gp);
-        }
-      }
-    }
+    trackContentHashes<Group>({gp}, &Plan::constraintContentHashChanged, false);
+    constraintsHash = ContentHash::ofContents(constraints);
+    updateContentHash();
+    removeGroupReferences(gp);
   }
   emit constraintsChanged(this->constraints);
 }
 
+quint64 Plan::getContentHash() const {
+  return contentHash;
+}
+
+quint64 Plan::getConstraintsHash() const {
+  return constraintsHash;
+}
+
+quint64 Plan::getGroupsHash() const {
+  return groupsHash;
+}
+
+quint64 Plan::getModulesHash() const {
+  return modulesHash;
+}
+
+quint64 Plan::getWeeksHash() const {
+  return weeksHash;
+}
+
+GroupIndex* Plan::getGroupIndex() {
+  if (groupIndex == nullptr) {
+    groupIndex = new GroupIndex(this, this);
+  }
+  return groupIndex;
+}
+
+ExamLoadMatrix* Plan::getExamLoadMatrix() {
+  if (examLoadMatrix == nullptr) {
+    examLoadMatrix = new ExamLoadMatrix(this, this);
+  }
+  return examLoadMatrix;
+}
+
+FeasibleSlotIndex* Plan::getFeasibleSlotIndex() {
+  if (feasibleSlotIndex == nullptr) {
+    feasibleSlotIndex = new FeasibleSlotIndex(this, this);
+  }
+  return feasibleSlotIndex;
+}
+
+IdIndex* Plan::getIdIndex() {
+  if (idIndex == nullptr) {
+    idIndex = new IdIndex(this, this);
+  }
+  return idIndex;
+}
+
+SerializableDataObject* Plan::findById(const QUuid& id) {
+  return getIdIndex()->find(id);
+}
+
+quint64 Plan::contentHashOf(const QJsonObject& content) {
+  QJsonArray groups = content.value("groups").toArray();
+  QJsonArray constraints = content.value("constraints").toArray();
+  QJsonArray modules = content.value("modules").toArray();
+  QJsonArray weeks = content.value("weeks").toArray();
+
+  // Like ContentHash::ofContents and ofOrderedContents
+  QSet<QUuid> groupIds;
+  quint64 groupsHash = 0;
+  for (const QJsonValue& group : groups) {
+    groupIds.insert(PropertyTable::idOf(group.toObject()));
+    groupsHash += ContentHash::mix(Group::contentHashOf(group.toObject()));
+  }
+  QSet<QUuid> constraintIds;
+  quint64 constraintsHash = 0;
+  for (const QJsonValue& constraint : constraints) {
+    constraintIds.insert(PropertyTable::idOf(constraint.toObject()));
+    constraintsHash +=
+        ContentHash::mix(Group::contentHashOf(constraint.toObject()));
+  }
+  QSet<QUuid> moduleIds;
+  quint64 modulesHash = 0;
+  for (const QJsonValue& module : modules) {
+    moduleIds.insert(PropertyTable::idOf(module.toObject()));
+    modulesHash += ContentHash::mix(Module::contentHashOf(
+        module.toObject(), groupIds, constraintIds));
+  }
+  // Timeslots resolve their active groups in groups and constraints
+  QSet<QUuid> activeGroupIds = groupIds + constraintIds;
+  quint64 weeksHash = weeks.size();
+  for (const QJsonValue& week : weeks) {
+    weeksHash = ContentHash::combine(
+        weeksHash,
+        Week::contentHashOf(week.toObject(), moduleIds, activeGroupIds));
+  }
+  return hashOf(PropertyTable::idOf(content),
+                PropertyTable::valueOf<QString>(content, "name", QString()),
+                constraintsHash, groupsHash, modulesHash, weeksHash);
+}
+
+quint64 Plan::hashOf(const QUuid& id,
+                     const QString& name,
+                     quint64 constraintsHash,
+                     quint64 groupsHash,
+                     quint64 modulesHash,
+                     quint64 weeksHash) {
+  quint64 hash = ContentHash::ofId(id);
+  hash = ContentHash::combine(hash, ContentHash::ofString(name));
+  hash = ContentHash::combine(hash, constraintsHash);
+  hash = ContentHash::combine(hash, groupsHash);
+  hash = ContentHash::combine(hash, modulesHash);
+  hash = ContentHash::combine(hash, weeksHash);
+  return hash;
+}
+
+void Plan::updateContentHash() {
+  quint64 hash = hashOf(getId(), name, constraintsHash, groupsHash,
+                        modulesHash, weeksHash);
+  if (hash == contentHash)
+    return;
+
+  quint64 oldHash = contentHash;
+  contentHash = hash;
+  emit contentHashChanged(oldHash, contentHash);
+}
+
+void Plan::updateWeeksHash() {
+  weeksHash = ContentHash::ofOrderedContents(weeks);
+  updateContentHash();
+}
+
+void Plan::constraintContentHashChanged(const quint64 oldHash,
+                                        const quint64 newHash) {
+  constraintsHash = ContentHash::replace(constraintsHash, oldHash, newHash);
+  updateContentHash();
+}
+
+void Plan::groupContentHashChanged(const quint64 oldHash,
+                                   const quint64 newHash) {
+  groupsHash = ContentHash::replace(groupsHash, oldHash, newHash);
+  updateContentHash();
+}
+
+void Plan::moduleContentHashChanged(const quint64 oldHash,
+                                    const quint64 newHash) {
+  modulesHash = ContentHash::replace(modulesHash, oldHash, newHash);
+  updateContentHash();
+}
+
+void Plan::removeGroupReferences(Group* gp) {
+  GroupIndex* index = getGroupIndex();
+  for (Timeslot* timeslot : index->getTimeslots(gp)) {
+    timeslot->removeActiveGroup(gp);
+  }
+  for (Module* module : index->getModules(gp)) {
+    module->removeGroup(gp);
+    module->removeConstraint(gp);
+  }
+}
+
 void Plan::fromJsonObject(const QJsonObject& content) {
-  simpleValuesFromJsonObject(content);
+  simpleValuesFromJsonObject(PropertyTable::identity(content));
+  PropertyTable::fromJsonObject(this, content, planProperties);
+
+  trackContentHashes(groups, &Plan::groupContentHashChanged, false);
+  trackContentHashes(constraints, &Plan::constraintContentHashChanged, false);
+  trackContentHashes(modules, &Plan::moduleContentHashChanged, false);
+  trackContentHashes(weeks, &Plan::updateWeeksHash, false);
 
   QJsonArray groupsJsonArray = content.value("groups").toArray();
   groups = fromObjectJsonArray<Group>(groupsJsonArray);
@@ -117,8 +333,27 @@ void Plan::fromJsonObject(const QJsonObject& content) {
 
   QJsonArray weeksJsonArray = content.value("weeks").toArray();
   weeks = fromObjectJsonArray<Week>(weeksJsonArray);
+
+  trackContentHashes(groups, &Plan::groupContentHashChanged, true);
+  trackContentHashes(constraints, &Plan::constraintContentHashChanged, true);
+  trackContentHashes(modules, &Plan::moduleContentHashChanged, true);
+  trackContentHashes(weeks, &Plan::updateWeeksHash, true);
+  groupsHash = ContentHash::ofContents(groups);
+  constraintsHash = ContentHash::ofContents(constraints);
+  modulesHash = ContentHash::ofContents(modules);
+  updateWeeksHash();
+  // The lists were replaced without emitting their signals
+  if (groupIndex != nullptr) {
+    groupIndex->rebuild();
+  }
+  if (examLoadMatrix != nullptr) {
+    examLoadMatrix->rebuild();
+  }
+  if (idIndex != nullptr) {
+    idIndex->rebuild();
+  }
 }
 
 QJsonObject Plan::toJsonObject() const {
-  return recursiveToJsonObject();
+  return PropertyTable::toJsonObject(this, planProperties);
 }
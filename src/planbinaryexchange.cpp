@@ -0,0 +1,345 @@
+#include <planbinaryexchange.h>
+#include <QFile>
+#include <QHash>
+#include <QSaveFile>
+#include <cstring>
+
+namespace {
+quint32 alignOffset(quint32 offset) {
+  return (offset + 7) & ~quint32(7);
+}
+
+// The data of a shared segment or mapped file may not be aligned for T
+template <typename T>
+T readValue(const char* data, quint32 offset) {
+  T value;
+  std::memcpy(&value, data + offset, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void writeValue(char* data, quint32 offset, const T& value) {
+  std::memcpy(data + offset, &value, sizeof(T));
+}
+
+/**
+ *  Locks a QSharedMemory segment for the lifetime of the guard
+ */
+class MemoryLocker {
+ public:
+  explicit MemoryLocker(QSharedMemory* memory)
+      : memory(memory), locked(memory->lock()) {}
+  ~MemoryLocker() {
+    if (locked) {
+      memory->unlock();
+    }
+  }
+  bool isLocked() const { return locked; }
+
+ private:
+  QSharedMemory* memory;
+  bool locked;
+};
+}  // namespace
+
+QByteArray PlanBinaryExchange::createProblem(Plan* plan) {
+  if (plan == nullptr) {
+    return QByteArray();
+  }
+
+  QList<Timeslot*> timeslots;
+  QVector<quint32> slotDays;
+  quint32 dayCount = 0;
+  for (Week* week : plan->getWeeks()) {
+    for (Day* day : week->getDays()) {
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        timeslots.append(timeslot);
+        slotDays.append(dayCount);
+      }
+      dayCount++;
+    }
+  }
+  QList<Group*> groups = plan->getGroups() + plan->getConstraints();
+  QHash<Group*, quint32> groupIndices;
+  for (int i = 0; i < groups.size(); i++) {
+    groupIndices.insert(groups[i], i);
+  }
+  QList<Module*> modules = plan->getModules();
+  quint32 moduleGroupCount = 0;
+  for (Module* module : modules) {
+    moduleGroupCount += static_cast<quint32>(module->getGroups().size() +
+                                             module->getConstraints().size());
+  }
+
+  PlanBinaryHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = magic;
+  header.version = version;
+  header.status = Problem;
+  header.slotCount = static_cast<quint32>(timeslots.size());
+  header.dayCount = dayCount;
+  header.groupCount = static_cast<quint32>(groups.size());
+  header.moduleCount = static_cast<quint32>(modules.size());
+  header.maskWords = (header.slotCount + 63) / 64;
+  header.slotDaysOffset = alignOffset(sizeof(PlanBinaryHeader));
+  header.groupsOffset = alignOffset(header.slotDaysOffset +
+                                    header.slotCount * sizeof(quint32));
+  header.availabilityOffset = alignOffset(
+      header.groupsOffset + header.groupCount * sizeof(PlanBinaryGroup));
+  header.modulesOffset =
+      alignOffset(header.availabilityOffset +
+                  header.groupCount * header.maskWords * sizeof(quint64));
+  header.moduleGroupsOffset = alignOffset(
+      header.modulesOffset + header.moduleCount * sizeof(PlanBinaryModule));
+  header.assignmentsOffset = alignOffset(header.moduleGroupsOffset +
+                                         moduleGroupCount * sizeof(quint32));
+  header.size = alignOffset(header.assignmentsOffset +
+                            header.moduleCount * sizeof(qint32));
+
+  QByteArray problem(static_cast<int>(header.size), '\0');
+  char* data = problem.data();
+  writeValue(data, 0, header);
+
+  for (quint32 slot = 0; slot < header.slotCount; slot++) {
+    writeValue(data, header.slotDaysOffset + slot * sizeof(quint32),
+               slotDays[slot]);
+  }
+
+  QVector<quint64> availability(groups.size() * header.maskWords, 0);
+  for (int slot = 0; slot < timeslots.size(); slot++) {
+    for (Group* group : timeslots[slot]->getActiveGroups()) {
+      auto iterator = groupIndices.constFind(group);
+      if (iterator != groupIndices.constEnd()) {
+        availability[*iterator * header.maskWords + slot / 64] |=
+            quint64(1) << (slot % 64);
+      }
+    }
+  }
+  for (int i = 0; i < groups.size(); i++) {
+    PlanBinaryGroup group;
+    group.examsPerDay = groups[i]->getExamsPerDay();
+    group.flags = (groups[i]->getActive() ? GroupActive : 0) |
+                  (i >= plan->getGroups().size() ? Constraint : 0);
+    writeValue(data, header.groupsOffset + i * sizeof(PlanBinaryGroup), group);
+  }
+  for (int i = 0; i < availability.size(); i++) {
+    writeValue(data, header.availabilityOffset + i * sizeof(quint64),
+               availability[i]);
+  }
+
+  QHash<Module*, qint32> assignments;
+  for (int slot = timeslots.size() - 1; slot >= 0; slot--) {
+    for (Module* module : timeslots[slot]->getModules()) {
+      assignments.insert(module, slot);
+    }
+  }
+  quint32 moduleGroup = 0;
+  for (int i = 0; i < modules.size(); i++) {
+    Module* module = modules[i];
+    PlanBinaryModule moduleData;
+    moduleData.examDuration = module->getExamDuration();
+    moduleData.flags = (module->getActive() ? ModuleActive : 0) |
+                       (module->getPinned() ? Pinned : 0);
+    moduleData.firstGroup = moduleGroup;
+    moduleData.groupCount = 0;
+    for (Group* group : module->getGroups() + module->getConstraints()) {
+      quint32 index = groupIndices.value(group, header.groupCount);
+      writeValue(data,
+                 header.moduleGroupsOffset + moduleGroup * sizeof(quint32),
+                 index);
+      moduleGroup++;
+      moduleData.groupCount++;
+    }
+    writeValue(data, header.modulesOffset + i * sizeof(PlanBinaryModule),
+               moduleData);
+    writeValue(data, header.assignmentsOffset + i * sizeof(qint32),
+               assignments.value(module, -1));
+  }
+  return problem;
+}
+
+bool PlanBinaryExchange::writeProblem(Plan* plan, QSharedMemory* memory) {
+  QByteArray problem = createProblem(plan);
+  if (problem.isEmpty() || memory == nullptr) {
+    return false;
+  }
+  if (!memory->isAttached() && !memory->create(problem.size())) {
+    return false;
+  }
+  MemoryLocker locker(memory);
+  if (!locker.isLocked() || memory->size() < problem.size()) {
+    return false;
+  }
+  std::memcpy(memory->data(), problem.constData(), problem.size());
+  return true;
+}
+
+bool PlanBinaryExchange::writeProblem(Plan* plan, const QString& path) {
+  QByteArray problem = createProblem(plan);
+  if (problem.isEmpty()) {
+    return false;
+  }
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+  if (file.write(problem) != problem.size()) {
+    file.cancelWriting();
+    return false;
+  }
+  return file.commit();
+}
+
+bool PlanBinaryExchange::isValid(const char* data, qint64 size) {
+  PlanBinaryHeader header;
+  return readHeader(data, size, header);
+}
+
+bool PlanBinaryExchange::writeSolution(char* data,
+                                       qint64 size,
+                                       const QVector<qint32>& assignments) {
+  PlanBinaryHeader header;
+  if (!readHeader(data, size, header) ||
+      assignments.size() != static_cast<int>(header.moduleCount)) {
+    return false;
+  }
+  for (int i = 0; i < assignments.size(); i++) {
+    writeValue(data, header.assignmentsOffset + i * sizeof(qint32),
+               assignments[i]);
+  }
+  header.status = Solved;
+  writeValue(data, 0, header);
+  return true;
+}
+
+bool PlanBinaryExchange::readAssignments(const char* data,
+                                         qint64 size,
+                                         QVector<qint32>& assignments) {
+  PlanBinaryHeader header;
+  if (!readHeader(data, size, header)) {
+    return false;
+  }
+  assignments.resize(static_cast<int>(header.moduleCount));
+  for (int i = 0; i < assignments.size(); i++) {
+    assignments[i] =
+        readValue<qint32>(data, header.assignmentsOffset + i * sizeof(qint32));
+  }
+  return true;
+}
+
+bool PlanBinaryExchange::readSolution(const char* data,
+                                      qint64 size,
+                                      Plan* plan) {
+  PlanBinaryHeader header;
+  QVector<qint32> assignments;
+  if (plan == nullptr || !readHeader(data, size, header) ||
+      header.status != Solved || !readAssignments(data, size, assignments)) {
+    return false;
+  }
+  QList<Timeslot*> timeslots = getTimeslots(plan);
+  QList<Module*> modules = plan->getModules();
+  if (static_cast<int>(header.slotCount) != timeslots.size() ||
+      static_cast<int>(header.moduleCount) != modules.size()) {
+    return false;
+  }
+  for (qint32 slot : assignments) {
+    if (slot < -1 || slot >= static_cast<qint32>(header.slotCount)) {
+      return false;
+    }
+  }
+
+  QHash<Module*, QList<Timeslot*>> scheduled;
+  for (Timeslot* timeslot : timeslots) {
+    for (Module* module : timeslot->getModules()) {
+      scheduled[module].append(timeslot);
+    }
+  }
+  for (int i = 0; i < modules.size(); i++) {
+    Module* module = modules[i];
+    if (module == nullptr || module->getPinned()) {
+      continue;
+    }
+    Timeslot* target = assignments[i] < 0 ? nullptr : timeslots[assignments[i]];
+    QList<Timeslot*> current = scheduled.value(module);
+    if (current.size() == 1 && current.first() == target) {
+      continue;
+    }
+    for (Timeslot* timeslot : current) {
+      timeslot->removeModule(module);
+    }
+    if (target != nullptr) {
+      target->addModule(module);
+    }
+  }
+  return true;
+}
+
+bool PlanBinaryExchange::readSolution(QSharedMemory* memory, Plan* plan) {
+  if (memory == nullptr || !memory->isAttached()) {
+    return false;
+  }
+  MemoryLocker locker(memory);
+  if (!locker.isLocked()) {
+    return false;
+  }
+  return readSolution(static_cast<const char*>(memory->constData()),
+                      memory->size(), plan);
+}
+
+bool PlanBinaryExchange::readSolution(const QString& path, Plan* plan) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+    return false;
+  }
+  uchar* data = file.map(0, file.size());
+  if (data == nullptr) {
+    return false;
+  }
+  bool success =
+      readSolution(reinterpret_cast<const char*>(data), file.size(), plan);
+  file.unmap(data);
+  return success;
+}
+
+QList<Timeslot*> PlanBinaryExchange::getTimeslots(Plan* plan) {
+  QList<Timeslot*> timeslots;
+  for (Week* week : plan->getWeeks()) {
+    for (Day* day : week->getDays()) {
+      timeslots.append(day->getTimeslots());
+    }
+  }
+  return timeslots;
+}
+
+bool PlanBinaryExchange::readHeader(const char* data,
+                                    qint64 size,
+                                    PlanBinaryHeader& header) {
+  if (data == nullptr || size < static_cast<qint64>(sizeof(header))) {
+    return false;
+  }
+  header = readValue<PlanBinaryHeader>(data, 0);
+  if (header.magic != magic || header.version != version ||
+      header.size > size) {
+    return false;
+  }
+  // Every section has to end before the next one starts
+  quint64 slotDaysEnd =
+      quint64(header.slotDaysOffset) + quint64(header.slotCount) * 4;
+  quint64 groupsEnd = quint64(header.groupsOffset) +
+                      quint64(header.groupCount) * sizeof(PlanBinaryGroup);
+  quint64 availabilityEnd =
+      quint64(header.availabilityOffset) +
+      quint64(header.groupCount) * header.maskWords * sizeof(quint64);
+  quint64 modulesEnd = quint64(header.modulesOffset) +
+                       quint64(header.moduleCount) * sizeof(PlanBinaryModule);
+  quint64 assignmentsEnd =
+      quint64(header.assignmentsOffset) + quint64(header.moduleCount) * 4;
+  return header.maskWords == (header.slotCount + 63) / 64 &&
+         header.slotDaysOffset >= sizeof(header) &&
+         header.groupsOffset >= slotDaysEnd &&
+         header.availabilityOffset >= groupsEnd &&
+         header.modulesOffset >= availabilityEnd &&
+         header.moduleGroupsOffset >= modulesEnd &&
+         header.assignmentsOffset >= header.moduleGroupsOffset &&
+         assignmentsEnd <= header.size;
+}
@@ -0,0 +1,450 @@
+#include <planchangelog.h>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QMetaMethod>
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+const quint32 logMagic = 0x50434c47;  // "PCLG"
+const quint32 logVersion = 1;
+const QDataStream::Version streamVersion = QDataStream::Qt_5_6;
+
+template <typename T>
+QList<QUuid> toIds(const QList<T*>& objects) {
+  QList<QUuid> ids;
+  for (T* object : objects) {
+    if (object != nullptr) {
+      ids.append(object->getId());
+    }
+  }
+  return ids;
+}
+
+template <typename T>
+QList<T*> fromIds(Plan* plan, const QList<QUuid>& ids) {
+  QList<T*> objects;
+  for (const QUuid& id : ids) {
+    T* object = plan->findById<T>(id);
+    if (object != nullptr) {
+      objects.append(object);
+    }
+  }
+  return objects;
+}
+
+/**
+ *  Get the ids of a list property, that references objects owned by the
+ * plan. Returns false for the lists of owned objects, like the days of a
+ * week.
+ */
+bool getReferenceIds(QObject* object,
+                     const QByteArray& name,
+                     QList<QUuid>& ids) {
+  if (auto* timeslot = qobject_cast<Timeslot*>(object)) {
+    if (name == "modules") {
+      ids = toIds(timeslot->getModules());
+      return true;
+    }
+    if (name == "activeGroups") {
+      ids = toIds(timeslot->getActiveGroups());
+      return true;
+    }
+  } else if (auto* module = qobject_cast<Module*>(object)) {
+    if (name == "groups") {
+      ids = toIds(module->getGroups());
+      return true;
+    }
+    if (name == "constraints") {
+      ids = toIds(module->getConstraints());
+      return true;
+    }
+  }
+  return false;
+}
+
+bool setReferences(Plan* plan,
+                   QObject* object,
+                   const QByteArray& name,
+                   const QList<QUuid>& ids) {
+  if (auto* timeslot = qobject_cast<Timeslot*>(object)) {
+    if (name == "modules") {
+      timeslot->setModules(fromIds<Module>(plan, ids));
+      return true;
+    }
+    if (name == "activeGroups") {
+      timeslot->setActiveGroups(fromIds<Group>(plan, ids));
+      return true;
+    }
+  } else if (auto* module = qobject_cast<Module*>(object)) {
+    if (name == "groups") {
+      module->setGroups(fromIds<Group>(plan, ids));
+      return true;
+    }
+    if (name == "constraints") {
+      module->setConstraints(fromIds<Group>(plan, ids));
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+PlanChangeLog::PlanChangeLog(const QString& path, QObject* parent)
+    : QObject(parent),
+      path(path),
+      replayedCount(0),
+      compactionThreshold(1024 * 1024),
+      compactionPending(false),
+      compactionRequested(false),
+      lastCompactionSucceeded(true),
+      compactedLogSize(0) {
+  connect(&compaction, &QFutureWatcher<bool>::finished, this,
+          &PlanChangeLog::finishCompaction);
+}
+
+PlanChangeLog::~PlanChangeLog() {
+  // Trim the log, so the next load does not replay the compacted records
+  waitForCompaction();
+  detach();
+}
+
+QString PlanChangeLog::getSnapshotPath() const {
+  return path;
+}
+
+QString PlanChangeLog::getLogPath() const {
+  return path + ".log";
+}
+
+Plan* PlanChangeLog::load(QObject* parent) {
+  replayedCount = 0;
+  QFile snapshot(path);
+  if (!snapshot.open(QIODevice::ReadOnly)) {
+    return nullptr;
+  }
+  QJsonDocument document = QJsonDocument::fromJson(snapshot.readAll());
+  if (!document.isObject()) {
+    return nullptr;
+  }
+
+  Plan* loaded = new Plan(parent);
+  loaded->fromJsonObject(document.object());
+  QFile logFile(getLogPath());
+  if (logFile.open(QIODevice::ReadOnly)) {
+    replay(loaded, logFile.readAll());
+  }
+  return loaded;
+}
+
+bool PlanChangeLog::attach(Plan* plan) {
+  detach();
+  if (plan == nullptr) {
+    return false;
+  }
+
+  bool opened;
+  if (QFile::exists(path)) {
+    opened = openLog(false);
+  } else {
+    opened = writeSnapshot(path, plan->toJsonObject()) && openLog(true);
+  }
+  if (!opened) {
+    return false;
+  }
+  this->plan = plan;
+  connectObjects();
+  return true;
+}
+
+void PlanChangeLog::detach() {
+  disconnectObjects();
+  plan = nullptr;
+  log.close();
+}
+
+Plan* PlanChangeLog::getPlan() const {
+  return plan.data();
+}
+
+qint64 PlanChangeLog::getLogSize() const {
+  if (log.isOpen()) {
+    return log.size();
+  }
+  return QFileInfo(getLogPath()).size();
+}
+
+int PlanChangeLog::getReplayedCount() const {
+  return replayedCount;
+}
+
+void PlanChangeLog::setCompactionThreshold(qint64 compactionThreshold) {
+  this->compactionThreshold = compactionThreshold;
+}
+
+qint64 PlanChangeLog::getCompactionThreshold() const {
+  return compactionThreshold;
+}
+
+bool PlanChangeLog::isCompacting() const {
+  return compactionPending;
+}
+
+bool PlanChangeLog::waitForCompaction() {
+  // A requested compaction is started while the last one is finished
+  while (compactionPending) {
+    compaction.waitForFinished();
+    finishCompaction();
+  }
+  return lastCompactionSucceeded;
+}
+
+bool PlanChangeLog::compact() {
+  if (plan.isNull() || !log.isOpen()) {
+    return false;
+  }
+  if (compactionPending) {
+    compactionRequested = true;
+    return true;
+  }
+
+  log.flush();
+  compactedLogSize = log.size();
+  compactionPending = true;
+  QJsonObject content = plan->toJsonObject();
+  QString snapshotPath = path;
+  compaction.setFuture(QtConcurrent::run([snapshotPath, content]() {
+    return writeSnapshot(snapshotPath, content);
+  }));
+  return true;
+}
+
+void PlanChangeLog::propertyChanged() {
+  auto* object = qobject_cast<SerializableDataObject*>(sender());
+  if (object == nullptr) {
+    return;
+  }
+  int signalIndex = senderSignalIndex();
+  const QMetaObject* metaObject = object->metaObject();
+  for (int i = 0; i < metaObject->propertyCount(); i++) {
+    QMetaProperty property = metaObject->property(i);
+    if (property.notifySignalIndex() == signalIndex) {
+      record(object, property);
+    }
+  }
+}
+
+void PlanChangeLog::connectObjects() {
+  disconnectObjects();
+  if (plan.isNull()) {
+    return;
+  }
+
+  track(plan);
+  for (const QList<Group*>& groups :
+       {plan->getGroups(), plan->getConstraints()}) {
+    for (Group* group : groups) {
+      track(group);
+    }
+  }
+  for (Module* module : plan->getModules()) {
+    track(module);
+  }
+  for (Week* week : plan->getWeeks()) {
+    if (week == nullptr) {
+      continue;
+    }
+    track(week);
+    for (Day* day : week->getDays()) {
+      if (day == nullptr) {
+        continue;
+      }
+      track(day);
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        track(timeslot);
+      }
+    }
+  }
+}
+
+void PlanChangeLog::disconnectObjects() {
+  for (const QMetaObject::Connection& connection : connections) {
+    disconnect(connection);
+  }
+  connections.clear();
+}
+
+void PlanChangeLog::track(QObject* object) {
+  if (object == nullptr) {
+    return;
+  }
+  QMetaMethod slot = staticMetaObject.method(
+      staticMetaObject.indexOfSlot("propertyChanged()"));
+  const QMetaObject* metaObject = object->metaObject();
+  for (int i = 0; i < metaObject->propertyCount(); i++) {
+    QMetaProperty property = metaObject->property(i);
+    if (property.isWritable() && property.hasNotifySignal()) {
+      connections.append(
+          connect(object, property.notifySignal(), this, slot));
+    }
+  }
+}
+
+void PlanChangeLog::record(SerializableDataObject* object,
+                           const QMetaProperty& property) {
+  QByteArray name = property.name();
+  QByteArray payload;
+  QDataStream stream(&payload, QIODevice::WriteOnly);
+  stream.setVersion(streamVersion);
+  if (QByteArray(property.typeName()).startsWith("QList<")) {
+    QList<QUuid> ids;
+    if (!getReferenceIds(object, name, ids)) {
+      // Objects were added or removed, which only a snapshot can store
+      connectObjects();
+      compact();
+      return;
+    }
+    stream << static_cast<quint8>(ReferencesRecord) << object->getId() << name
+           << ids;
+  } else {
+    stream << static_cast<quint8>(PropertyRecord) << object->getId() << name
+           << property.read(object);
+  }
+  append(payload);
+}
+
+bool PlanChangeLog::openLog(bool truncate) {
+  log.close();
+  log.setFileName(getLogPath());
+  QIODevice::OpenMode mode =
+      QIODevice::WriteOnly |
+      (truncate ? QIODevice::Truncate : QIODevice::Append);
+  if (!log.open(mode)) {
+    return false;
+  }
+  if (log.size() == 0) {
+    QDataStream stream(&log);
+    stream.setVersion(streamVersion);
+    stream << logMagic << logVersion;
+    log.flush();
+  }
+  return true;
+}
+
+bool PlanChangeLog::append(const QByteArray& payload) {
+  if (!log.isOpen()) {
+    return false;
+  }
+  // The payload is written with its size, so a cut off record is detected
+  QByteArray frame;
+  QDataStream stream(&frame, QIODevice::WriteOnly);
+  stream.setVersion(streamVersion);
+  stream << payload;
+  if (log.write(frame) != frame.size() || !log.flush()) {
+    return false;
+  }
+  if (log.size() > compactionThreshold && !compactionPending) {
+    compact();
+  }
+  return true;
+}
+
+void PlanChangeLog::replay(Plan* plan, const QByteArray& content) {
+  QDataStream stream(content);
+  stream.setVersion(streamVersion);
+  quint32 magic = 0;
+  quint32 version = 0;
+  stream >> magic >> version;
+  if (stream.status() != QDataStream::Ok || magic != logMagic ||
+      version != logVersion) {
+    return;
+  }
+  while (!stream.atEnd()) {
+    QByteArray payload;
+    stream >> payload;
+    if (stream.status() != QDataStream::Ok) {
+      break;
+    }
+    if (apply(plan, payload)) {
+      replayedCount++;
+    }
+  }
+}
+
+bool PlanChangeLog::apply(Plan* plan, const QByteArray& payload) {
+  QDataStream stream(payload);
+  stream.setVersion(streamVersion);
+  quint8 type = 0;
+  QUuid id;
+  QByteArray name;
+  stream >> type >> id >> name;
+  // Objects removed after the record was written are not in the snapshot
+  SerializableDataObject* object = plan->findById(id);
+  if (stream.status() != QDataStream::Ok || object == nullptr) {
+    return false;
+  }
+
+  if (type == ReferencesRecord) {
+    QList<QUuid> ids;
+    stream >> ids;
+    return stream.status() == QDataStream::Ok &&
+           setReferences(plan, object, name, ids);
+  }
+  if (type == PropertyRecord) {
+    QVariant value;
+    stream >> value;
+    return stream.status() == QDataStream::Ok &&
+           object->setProperty(name.constData(), value);
+  }
+  return false;
+}
+
+void PlanChangeLog::finishCompaction() {
+  if (!compactionPending || !compaction.isFinished()) {
+    return;
+  }
+  compactionPending = false;
+  lastCompactionSucceeded = compaction.result();
+
+  if (lastCompactionSucceeded && log.isOpen()) {
+    // Keep the records appended after the snapshot was taken
+    log.flush();
+    QFile current(getLogPath());
+    bool readable =
+        current.open(QIODevice::ReadOnly) && current.seek(compactedLogSize);
+    QByteArray tail = readable ? current.readAll() : QByteArray();
+    current.close();
+
+    QSaveFile trimmed(getLogPath());
+    if (readable && trimmed.open(QIODevice::WriteOnly)) {
+      QDataStream stream(&trimmed);
+      stream.setVersion(streamVersion);
+      stream << logMagic << logVersion;
+      trimmed.write(tail);
+      log.close();
+      lastCompactionSucceeded = trimmed.commit();
+    }
+    openLog(false);
+  }
+  emit compacted(lastCompactionSucceeded);
+
+  if (compactionRequested) {
+    compactionRequested = false;
+    compact();
+  }
+}
+
+bool PlanChangeLog::writeSnapshot(const QString& path,
+                                  const QJsonObject& content) {
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+  QByteArray data = QJsonDocument(content).toJson(QJsonDocument::Compact);
+  if (file.write(data) != data.size()) {
+    file.cancelWriting();
+    return false;
+  }
+  return file.commit();
+}
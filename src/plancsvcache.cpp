@@ -0,0 +1,81 @@
+#include <plancsvcache.h>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutexLocker>
+
+bool PlanCsvFileFingerprint::operator==(
+    const PlanCsvFileFingerprint& other) const {
+  return size == other.size && lastModified == other.lastModified;
+}
+
+bool PlanCsvFileFingerprint::operator!=(
+    const PlanCsvFileFingerprint& other) const {
+  return !(*this == other);
+}
+
+PlanCsvCache::PlanCsvCache(int maximumEntries)
+    : entries(maximumEntries), hits(0), misses(0) {}
+
+PlanCsvFileFingerprint PlanCsvCache::createFingerprint(const QString& path) {
+  PlanCsvFileFingerprint fingerprint;
+  QFileInfo fileInfo(path);
+  if (fileInfo.exists()) {
+    fingerprint.size = fileInfo.size();
+    fingerprint.lastModified = fileInfo.lastModified();
+  }
+  return fingerprint;
+}
+
+bool PlanCsvCache::lookup(const QString& key,
+                          const QList<PlanCsvFileFingerprint>& fingerprints,
+                          const QList<QByteArray>& contents,
+                          PlanCsvData& data) {
+  QMutexLocker locker(&mutex);
+  Entry* entry = entries.object(key);
+  bool hit = entry != nullptr && entry->fingerprints == fingerprints &&
+             entry->hashes.size() == contents.size();
+  for (int i = 0; hit && i < contents.size(); i++) {
+    hit = entry->hashes[i] == qHash(contents[i]);
+  }
+  if (!hit) {
+    misses++;
+    return false;
+  }
+  hits++;
+  data = entry->data;
+  return true;
+}
+
+void PlanCsvCache::insert(const QString& key,
+                          const QList<PlanCsvFileFingerprint>& fingerprints,
+                          const QList<QByteArray>& contents,
+                          const PlanCsvData& data) {
+  Entry* entry = new Entry();
+  entry->fingerprints = fingerprints;
+  for (const QByteArray& content : contents) {
+    entry->hashes.append(qHash(content));
+  }
+  entry->data = data;
+  QMutexLocker locker(&mutex);
+  entries.insert(key, entry);
+}
+
+void PlanCsvCache::clear() {
+  QMutexLocker locker(&mutex);
+  entries.clear();
+}
+
+int PlanCsvCache::size() const {
+  QMutexLocker locker(&mutex);
+  return entries.size();
+}
+
+int PlanCsvCache::getHits() const {
+  QMutexLocker locker(&mutex);
+  return hits;
+}
+
+int PlanCsvCache::getMisses() const {
+  QMutexLocker locker(&mutex);
+  return misses;
+}
@@ -1,4 +1,117 @@
 #include <plancsvhelper.h>
+#include <QBuffer>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QPair>
+#include <QPointer>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+template <typename T>
+QFuture<T> finishedFuture(const T& result) {
+  QFutureInterface<T> futureInterface;
+  futureInterface.reportStarted();
+  futureInterface.reportResult(result);
+  futureInterface.reportFinished();
+  return futureInterface.future();
+}
+
+/**
+ *  Opens a device for the lifetime of the guard. Devices, that are already
+ * open with a compatible mode are used as they are and stay open.
+ */
+class DeviceGuard {
+ public:
+  DeviceGuard(QIODevice* device, QIODevice::OpenMode mode)
+      : device(device), opened(false), usable(false) {
+    if (device == nullptr) {
+      return;
+    }
+    if (device->isOpen()) {
+      QIODevice::OpenMode required = mode & QIODevice::ReadWrite;
+      usable = (device->openMode() & required) == required;
+    } else {
+      opened = device->open(mode);
+      usable = opened;
+    }
+  }
+
+  ~DeviceGuard() {
+    if (opened) {
+      device->close();
+    }
+  }
+
+  bool isOpen() const { return usable; }
+
+ private:
+  QIODevice* device;
+  bool opened;
+  bool usable;
+};
+
+/**
+ *  In memory devices for all csv files, used to move the contents of devices
+ * owned by another thread to a worker thread
+ */
+class BufferedDevices {
+ public:
+  explicit BufferedDevices(const QList<QByteArray>& contents = {}) {
+    for (int i = 0; i < bufferCount; i++) {
+      buffers[i].setData(contents.value(i));
+    }
+  }
+
+  PlanCsvDevices getDevices() {
+    PlanCsvDevices devices;
+    devices.examsIntervals = &buffers[0];
+    devices.exams = &buffers[1];
+    devices.groupsExams = &buffers[2];
+    devices.groupsExamsPref = &buffers[3];
+    devices.planningExamsResult = &buffers[4];
+    return devices;
+  }
+
+  QList<QByteArray> getContents() const {
+    QList<QByteArray> contents;
+    for (int i = 0; i < bufferCount; i++) {
+      contents.append(buffers[i].data());
+    }
+    return contents;
+  }
+
+ private:
+  static constexpr int bufferCount = 5;
+  QBuffer buffers[bufferCount];
+};
+
+QList<QIODevice*> toList(const PlanCsvDevices& devices) {
+  return {devices.examsIntervals, devices.exams, devices.groupsExams,
+          devices.groupsExamsPref, devices.planningExamsResult};
+}
+
+bool readDevice(QIODevice* device, QByteArray& content) {
+  DeviceGuard guard(device, QIODevice::ReadOnly);
+  if (!guard.isOpen()) {
+    return false;
+  }
+  content = device->readAll();
+  return true;
+}
+
+bool writeDevice(QIODevice* device, const QByteArray& content) {
+  DeviceGuard guard(device, QIODevice::WriteOnly | QIODevice::Truncate);
+  if (!guard.isOpen()) {
+    return false;
+  }
+  return device->write(content) == content.size();
+}
+}  // namespace
 
 PlanCsvHelper::PlanCsvHelper(QString path) : basePath(path) {
   initializeFilePaths();
@@ -9,23 +122,470 @@ PlanCsvHelper::PlanCsvHelper() : temporaryDirectory(new QTemporaryDir()) {
   initializeFilePaths();
 }
 
+PlanCsvHelper::PlanCsvHelper(const PlanCsvDevices& devices)
+    : devices(devices), usesDevices(true) {}
+
 Plan* PlanCsvHelper::readPlan(QObject* parent) {
-  QScopedPointer<Plan> newPlan(new Plan(parent));
+  PlanCsvData data;
+  if (!usesDevices && cache != nullptr) {
+    if (!readCachedPlanData(getInputFilePaths(), cache.data(), data)) {
+      return nullptr;
+    }
+    return createPlan(data, parent);
+  }
+  if (!readPlanData(devices, data)) {
+    return nullptr;
+  }
+  return createPlan(data, parent);
+}
+
+bool PlanCsvHelper::writePlan(Plan* plan) {
+  if (plan == nullptr) {
+    return false;
+  }
+  if (!usesDevices && !createResultDirectory(basePath)) {
+    return false;
+  }
+  return writePlanData(devices, createPlanData(plan, pinnedModulesFixed));
+}
+
+bool PlanCsvHelper::isWritten() {
+  if (usesDevices) {
+    return devices.examsIntervals != nullptr && devices.exams != nullptr &&
+           devices.groupsExams != nullptr &&
+           devices.groupsExamsPref != nullptr;
+  }
+  return examsIntervalsFile.exists() && examsFile.exists() &&
+         groupsExamsFile.exists() && groupsExamsPrefFile.exists();
+}
+
+bool PlanCsvHelper::isScheduled() {
+  if (usesDevices) {
+    return devices.planningExamsResult != nullptr;
+  }
+  return planningExamsResultFile.exists() && groupsExamsResultFile.exists();
+}
+
+QString PlanCsvHelper::getPath() {
+  return basePath;
+}
+
+bool PlanCsvHelper::readSchedule(Plan* plan) {
+  QList<PlanCsvScheduleEntry> schedule;
+  if (!readScheduleFile(devices.planningExamsResult, schedule)) {
+    return false;
+  }
+  return applySchedule(schedule, plan);
+}
+
+bool PlanCsvHelper::readSchedules(const QList<PlanCsvHelper*>& helpers,
+                                  Plan* plan) {
+  if (plan == nullptr) {
+    return false;
+  }
+  QList<PlanCsvScheduleEntry> schedule;
+  for (PlanCsvHelper* helper : helpers) {
+    if (helper == nullptr ||
+        !readScheduleFile(helper->devices.planningExamsResult, schedule)) {
+      return false;
+    }
+  }
+  return applySchedule(schedule, plan);
+}
+
+QFuture<Plan*> PlanCsvHelper::readPlanAsync(QObject* parent) {
+  // Devices belong to the calling thread, so only their contents are passed to
+  // the worker
+  QList<QByteArray> contents;
+  if (usesDevices) {
+    QList<QIODevice*> deviceList = toList(devices);
+    for (int i = 0; i < 4; i++) {
+      QByteArray content;
+      if (!readDevice(deviceList[i], content)) {
+        return finishedFuture<Plan*>(nullptr);
+      }
+      contents.append(content);
+    }
+  }
+
+  QFutureInterface<Plan*> futureInterface;
+  // One step for every file and one for creating the plan
+  futureInterface.setProgressRange(0, 5);
+  futureInterface.reportStarted();
+
+  QString path = basePath;
+  bool inMemory = usesDevices;
+  QSharedPointer<PlanCsvCache> sharedCache =
+      usesDevices ? QSharedPointer<PlanCsvCache>() : cache;
+  auto* watcher = new QFutureWatcher<QSharedPointer<PlanCsvData>>();
+  QPointer<QObject> parentGuard(parent);
+  bool hasParent = parent != nullptr;
+  QObject::connect(
+      watcher, &QFutureWatcher<QSharedPointer<PlanCsvData>>::finished, watcher,
+      [watcher, futureInterface, parentGuard, hasParent]() mutable {
+        watcher->deleteLater();
+        if (futureInterface.isCanceled()) {
+          futureInterface.reportFinished();
+          return;
+        }
+        QSharedPointer<PlanCsvData> data = watcher->result();
+        Plan* plan = nullptr;
+        if (data != nullptr && (!hasParent || !parentGuard.isNull())) {
+          plan = createPlan(*data, parentGuard.data());
+        }
+        futureInterface.setProgressValue(5);
+        futureInterface.reportResult(plan);
+        futureInterface.reportFinished();
+      });
+
+  watcher->setFuture(QtConcurrent::run(
+      [path, inMemory, contents, sharedCache,
+       futureInterface]() mutable -> QSharedPointer<PlanCsvData> {
+        PlanCsvHelper helper(path);
+        QSharedPointer<PlanCsvData> data(new PlanCsvData());
+        if (sharedCache != nullptr) {
+          if (!readCachedPlanData(helper.getInputFilePaths(),
+                                  sharedCache.data(), *data,
+                                  &futureInterface)) {
+            return nullptr;
+          }
+          return data;
+        }
+        BufferedDevices buffers(contents);
+        PlanCsvDevices devices =
+            inMemory ? buffers.getDevices() : helper.getDevices();
+        if (!readPlanData(devices, *data, &futureInterface)) {
+          return nullptr;
+        }
+        return data;
+      }));
+
+  return futureInterface.future();
+}
+
+QFuture<bool> PlanCsvHelper::writePlanAsync(Plan* plan) {
+  if (plan == nullptr) {
+    return finishedFuture(false);
+  }
+
+  QFutureInterface<bool> futureInterface;
+  futureInterface.setProgressRange(0, 5);
+  futureInterface.reportStarted();
+
+  PlanCsvData data = createPlanData(plan, pinnedModulesFixed);
+
+  if (!usesDevices) {
+    QString path = basePath;
+    QtConcurrent::run([path, data, futureInterface]() mutable {
+      PlanCsvHelper helper(path);
+      bool success = createResultDirectory(path) &&
+                     writePlanData(helper.getDevices(), data, &futureInterface);
+      futureInterface.reportResult(success);
+      futureInterface.reportFinished();
+    });
+    return futureInterface.future();
+  }
+
+  // The files are formatted on the worker and written to the devices on the
+  // calling thread
+  QList<QPointer<QIODevice>> targets;
+  for (QIODevice* device : toList(devices)) {
+    targets.append(device);
+  }
+  bool writeSchedule = devices.planningExamsResult != nullptr;
+  auto* watcher = new QFutureWatcher<QSharedPointer<QList<QByteArray>>>();
+  QObject::connect(
+      watcher, &QFutureWatcher<QSharedPointer<QList<QByteArray>>>::finished,
+      watcher, [watcher, futureInterface, targets, writeSchedule]() mutable {
+        watcher->deleteLater();
+        if (futureInterface.isCanceled()) {
+          futureInterface.reportFinished();
+          return;
+        }
+        QSharedPointer<QList<QByteArray>> contents = watcher->result();
+        bool success = contents != nullptr;
+        int fileCount = writeSchedule ? targets.size() : targets.size() - 1;
+        for (int i = 0; success && i < fileCount; i++) {
+          success = writeDevice(targets[i].data(), contents->at(i));
+        }
+        futureInterface.reportResult(success);
+        futureInterface.reportFinished();
+      });
+
+  watcher->setFuture(QtConcurrent::run(
+      [data, writeSchedule,
+       futureInterface]() mutable -> QSharedPointer<QList<QByteArray>> {
+        BufferedDevices buffers;
+        PlanCsvDevices devices = buffers.getDevices();
+        if (!writeSchedule) {
+          devices.planningExamsResult = nullptr;
+        }
+        if (!writePlanData(devices, data, &futureInterface)) {
+          return nullptr;
+        }
+        return QSharedPointer<QList<QByteArray>>(
+            new QList<QByteArray>(buffers.getContents()));
+      }));
+
+  return futureInterface.future();
+}
+
+QFuture<bool> PlanCsvHelper::readScheduleAsync(Plan* plan) {
+  if (plan == nullptr) {
+    return finishedFuture(false);
+  }
+
+  QByteArray content;
+  if (usesDevices && !readDevice(devices.planningExamsResult, content)) {
+    return finishedFuture(false);
+  }
+
+  QFutureInterface<bool> futureInterface;
+  // One step for reading the file and one for applying the schedule
+  futureInterface.setProgressRange(0, 2);
+  futureInterface.reportStarted();
+
+  QString path = basePath;
+  bool inMemory = usesDevices;
+  auto* watcher =
+      new QFutureWatcher<QSharedPointer<QList<PlanCsvScheduleEntry>>>();
+  QPointer<Plan> planGuard(plan);
+  QObject::connect(
+      watcher,
+      &QFutureWatcher<QSharedPointer<QList<PlanCsvScheduleEntry>>>::finished,
+      watcher, [watcher, futureInterface, planGuard]() mutable {
+        watcher->deleteLater();
+        if (futureInterface.isCanceled()) {
+          futureInterface.reportFinished();
+          return;
+        }
+        QSharedPointer<QList<PlanCsvScheduleEntry>> schedule =
+            watcher->result();
+        bool success = schedule != nullptr && !planGuard.isNull() &&
+                       applySchedule(*schedule, planGuard.data());
+        futureInterface.setProgressValue(2);
+        futureInterface.reportResult(success);
+        futureInterface.reportFinished();
+      });
+
+  watcher->setFuture(QtConcurrent::run(
+      [path, inMemory, content,
+       futureInterface]() mutable
+      -> QSharedPointer<QList<PlanCsvScheduleEntry>> {
+        if (futureInterface.isCanceled()) {
+          return nullptr;
+        }
+        PlanCsvHelper helper(path);
+        QBuffer buffer;
+        buffer.setData(content);
+        QIODevice* device = inMemory
+                                ? &buffer
+                                : helper.getDevices().planningExamsResult;
+        QSharedPointer<QList<PlanCsvScheduleEntry>> schedule(
+            new QList<PlanCsvScheduleEntry>());
+        if (!readScheduleFile(device, *schedule)) {
+          return nullptr;
+        }
+        futureInterface.setProgressValue(1);
+        return schedule;
+      }));
+
+  return futureInterface.future();
+}
+
+void PlanCsvHelper::setCache(QSharedPointer<PlanCsvCache> cache) {
+  this->cache = cache;
+}
+
+QSharedPointer<PlanCsvCache> PlanCsvHelper::getCache() {
+  return cache;
+}
+
+void PlanCsvHelper::initializeFilePaths() {
+  examsIntervalsFile.setFileName(basePath + "/pruef-intervalle.csv");
+  examsFile.setFileName(basePath + "/pruefungen.csv");
+  groupsExamsFile.setFileName(basePath + "/zuege-pruef.csv");
+  groupsExamsPrefFile.setFileName(basePath + "/zuege-pruef-pref2.csv");
+  planningExamsResultFile.setFileName(basePath +
+                                      "/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv");
+  groupsExamsResultFile.setFileName(basePath +
+                                    "/SPA-ERGEBNIS-PP/SPA-zuege-pruef.csv");
+
+  devices.examsIntervals = &examsIntervalsFile;
+  devices.exams = &examsFile;
+  devices.groupsExams = &groupsExamsFile;
+  devices.groupsExamsPref = &groupsExamsPrefFile;
+  devices.planningExamsResult = &planningExamsResultFile;
+}
+
+PlanCsvDevices PlanCsvHelper::getDevices() {
+  return devices;
+}
+
+void PlanCsvHelper::setPinnedModulesFixed(bool pinnedModulesFixed) {
+  this->pinnedModulesFixed = pinnedModulesFixed;
+}
+
+bool PlanCsvHelper::getPinnedModulesFixed() {
+  return pinnedModulesFixed;
+}
+
+QStringList PlanCsvHelper::getInputFilePaths() {
+  return {examsIntervalsFile.fileName(), examsFile.fileName(),
+          groupsExamsFile.fileName(), groupsExamsPrefFile.fileName()};
+}
+
+bool PlanCsvHelper::readCachedPlanData(const QStringList& paths,
+                                       PlanCsvCache* cache,
+                                       PlanCsvData& data,
+                                       QFutureInterfaceBase* future) {
+  // The fingerprints are taken before the contents are read, so a file
+  // changing in between can only cause a miss on the next lookup
+  QList<QByteArray> contents;
+  QList<PlanCsvFileFingerprint> fingerprints;
+  QStringList canonicalPaths;
+  for (const QString& path : paths) {
+    fingerprints.append(PlanCsvCache::createFingerprint(path));
+    QFile file(path);
+    QByteArray content;
+    if (!readDevice(&file, content)) {
+      return false;
+    }
+    contents.append(content);
+    canonicalPaths.append(QFileInfo(path).absoluteFilePath());
+  }
+  QString key = canonicalPaths.join('\n');
+
+  if (cache->lookup(key, fingerprints, contents, data)) {
+    if (future != nullptr) {
+      future->setProgressValue(4);
+    }
+    return true;
+  }
+
+  BufferedDevices buffers(contents);
+  if (!readPlanData(buffers.getDevices(), data, future)) {
+    return false;
+  }
+  cache->insert(key, fingerprints, contents, data);
+  return true;
+}
+
+bool PlanCsvHelper::readPlanData(const PlanCsvDevices& devices,
+                                 PlanCsvData& data,
+                                 QFutureInterfaceBase* future) {
+  if (!readAvailabilityFile(devices.examsIntervals, data.constraints)) {
+    return false;
+  }
+  if (future != nullptr) {
+    if (future->isCanceled()) {
+      return false;
+    }
+    future->setProgressValue(1);
+  }
+
+  if (!readAvailabilityFile(devices.groupsExams, data.groups)) {
+    return false;
+  }
+  if (future != nullptr) {
+    if (future->isCanceled()) {
+      return false;
+    }
+    future->setProgressValue(2);
+  }
+
+  if (!readExamsFile(devices.exams, data)) {
+    return false;
+  }
+  if (future != nullptr) {
+    if (future->isCanceled()) {
+      return false;
+    }
+    future->setProgressValue(3);
+  }
+
+  if (!readGroupsExamsPrefFile(devices.groupsExamsPref, data)) {
+    return false;
+  }
+  if (future != nullptr) {
+    future->setProgressValue(4);
+  }
+
+  return true;
+}
+
+bool PlanCsvHelper::writePlanData(const PlanCsvDevices& devices,
+                                  const PlanCsvData& data,
+                                  QFutureInterfaceBase* future) {
+  if (!writeAvailabilityFile(devices.examsIntervals, data.constraints)) {
+    return false;
+  }
+  if (future != nullptr) {
+    if (future->isCanceled()) {
+      return false;
+    }
+    future->setProgressValue(1);
+  }
+
+  if (!writeExamsFile(devices.exams, data)) {
+    return false;
+  }
+  if (future != nullptr) {
+    if (future->isCanceled()) {
+      return false;
+    }
+    future->setProgressValue(2);
+  }
+
+  if (!writeAvailabilityFile(devices.groupsExams, data.groups)) {
+    return false;
+  }
+  if (future != nullptr) {
+    if (future->isCanceled()) {
+      return false;
+    }
+    future->setProgressValue(3);
+  }
+
+  if (!writeGroupsExamsPrefFile(devices.groupsExamsPref, data)) {
+    return false;
+  }
+  if (future != nullptr) {
+    if (future->isCanceled()) {
+      return false;
+    }
+    future->setProgressValue(4);
+  }
+
+  // Devices without a result file only get the input files
+  if (devices.planningExamsResult != nullptr &&
+      !writePlanningExamsResultFile(devices.planningExamsResult, data)) {
+    return false;
+  }
+  if (future != nullptr) {
+    future->setProgressValue(5);
+  }
+
+  return true;
+}
+
+Plan* PlanCsvHelper::createPlan(const PlanCsvData& data, QObject* parent) {
+  Plan* newPlan = new Plan(parent);
   // TODO add support for custom names
   newPlan->setName("new plan");
 
   // Add base
   QList<Week*> weeks;
-  weeks.append(new Week(newPlan.get()));
-  weeks.append(new Week(newPlan.get()));
-  weeks.append(new Week(newPlan.get()));
+  weeks.append(new Week(newPlan));
+  weeks.append(new Week(newPlan));
+  weeks.append(new Week(newPlan));
   weeks[0]->setName("Woche 1");
   weeks[1]->setName("Woche 2");
   weeks[2]->setName("Woche 3");
   newPlan->setWeeks(weeks);
   for (Week* week : weeks) {
     QList<Day*> days;
-    for (int x = 0; x < 6; x++) {
+    for (int x = 0; x < dayCount; x++) {
       days.append(new Day(week));
     }
     days[0]->setName("Montag");
@@ -36,7 +596,7 @@ Plan* PlanCsvHelper::readPlan(QObject* parent) {
     days[5]->setName("Samstag");
     for (Day* day : days) {
       QList<Timeslot*> timeslots;
-      for (int x = 0; x < 6; x++) {
+      for (int x = 0; x < timeslotCount; x++) {
         timeslots.append(new Timeslot(day));
       }
       timeslots[0]->setName("Block 1");
@@ -50,88 +610,291 @@ Plan* PlanCsvHelper::readPlan(QObject* parent) {
     week->setDays(days);
   }
 
-  if (!readExamsIntervalsFile(newPlan.get())) {
-    return nullptr;
+  auto createGroup = [newPlan](const PlanCsvGroupData& groupData) {
+    Group* group = new Group(newPlan);
+    group->setName(groupData.name);
+    group->setExamsPerDay(groupData.examsPerDay);
+    group->setActive(groupData.active);
+    group->setSmall(groupData.small);
+    group->setObsolete(groupData.obsolete);
+    return group;
+  };
+
+  // Groups are resolved by name to the first group with that name
+  QList<Group*> constraints;
+  QHash<QString, Group*> constraintsByName;
+  for (const PlanCsvGroupData& constraintData : data.constraints) {
+    Group* constraint = createGroup(constraintData);
+    constraints.append(constraint);
+    if (!constraintsByName.contains(constraint->getName())) {
+      constraintsByName.insert(constraint->getName(), constraint);
+    }
   }
 
-  if (!readGroupsExamsFile(newPlan.get())) {
-    return nullptr;
+  QList<Group*> groups;
+  QHash<QString, Group*> groupsByName;
+  for (const PlanCsvGroupData& groupData : data.groups) {
+    Group* group = createGroup(groupData);
+    groups.append(group);
+    if (!groupsByName.contains(group->getName())) {
+      groupsByName.insert(group->getName(), group);
+    }
   }
 
-  if (!readExamsFile(newPlan.get())) {
-    return nullptr;
+  // Constraints are added to the timeslots before groups
+  int block = 0;
+  for (Week* week : weeks) {
+    for (Day* day : week->getDays()) {
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        QList<Group*> activeGroups;
+        for (int i = 0; i < constraints.size(); i++) {
+          if (data.constraints[i].availability.value(block, false)) {
+            activeGroups.append(constraints[i]);
+          }
+        }
+        for (int i = 0; i < groups.size(); i++) {
+          if (data.groups[i].availability.value(block, false)) {
+            activeGroups.append(groups[i]);
+          }
+        }
+        timeslot->setActiveGroups(activeGroups);
+        block++;
+      }
+    }
   }
 
-  if (!readGroupsExamsPrefFile(newPlan.get())) {
-    return nullptr;
+  QList<Module*> modules;
+  for (const PlanCsvModuleData& moduleData : data.modules) {
+    Module* module = new Module(newPlan);
+    module->setName(moduleData.name);
+    module->setOrigin(moduleData.origin);
+    module->setNumber(moduleData.number);
+    module->setActive(moduleData.active);
+
+    QList<Group*> moduleGroups;
+    for (const QString& groupName : moduleData.groups) {
+      moduleGroups.append(groupsByName.value(groupName));
+    }
+    module->setGroups(moduleGroups);
+
+    if (moduleData.constraint != "") {
+      module->setConstraints({constraintsByName.value(moduleData.constraint)});
+    }
+
+    module->setExamType(moduleData.examType);
+    module->setExamDuration(moduleData.examDuration);
+    modules.append(module);
   }
 
-  return newPlan.take();
+  newPlan->setConstraints(constraints);
+  newPlan->setGroups(groups);
+  newPlan->setModules(modules);
+
+  return newPlan;
 }
 
-bool PlanCsvHelper::writePlan(Plan* plan) {
-  if (plan == nullptr) {
-    return false;
+PlanCsvData PlanCsvHelper::createPlanData(Plan* plan,
+                                          bool pinnedModulesFixed) {
+  PlanCsvData data;
+
+  // TODO check that plan has the right amount of days
+  QList<Timeslot*> blocks;
+  for (int week = 0; week < weekCount; week++) {
+    for (int day = 0; day < dayCount; day++) {
+      for (int timeslot = 0; timeslot < timeslotCount; timeslot++) {
+        Timeslot* block = nullptr;
+        if (week < plan->getWeeks().size() &&
+            day < plan->getWeeks()[week]->getDays().size() &&
+            timeslot < plan->getWeeks()[week]
+                           ->getDays()[day]
+                           ->getTimeslots()
+                           .size()) {
+          block = plan->getWeeks()[week]
+                      ->getDays()[day]
+                      ->getTimeslots()[timeslot];
+        }
+        blocks.append(block);
+      }
+    }
   }
-  return writeExamsIntervalsFile(plan) && writeExamsFile(plan) &&
-         writeGroupsExamsFile(plan) && writeGroupsExamsPrefFile(plan) &&
-         writePlanningExamsResultFile(plan);
-}
 
-bool PlanCsvHelper::isWritten() {
-  return examsIntervalsFile.exists() && examsFile.exists() &&
-         groupsExamsFile.exists() && groupsExamsPrefFile.exists();
-}
+  // The blocks occupied by pinned modules are not available for their groups
+  QSet<QPair<Group*, int>> fixedBlocks;
+  for (int block = 0; pinnedModulesFixed && block < blocks.size(); block++) {
+    if (blocks[block] == nullptr) {
+      continue;
+    }
+    for (Module* module : blocks[block]->getModules()) {
+      if (!module->getPinned()) {
+        continue;
+      }
+      int duration = static_cast<int>(module->getExamDuration());
+      for (int offset = 0; offset < duration; offset++) {
+        // A module cannot continue on the next day
+        if (block % timeslotCount + offset >= timeslotCount) {
+          break;
+        }
+        for (Group* group : module->getGroups() + module->getConstraints()) {
+          fixedBlocks.insert(qMakePair(group, block + offset));
+        }
+      }
+    }
+  }
+
+  auto createGroupData = [&blocks, &fixedBlocks](Group* group) {
+    PlanCsvGroupData groupData;
+    groupData.name = group->getName();
+    groupData.examsPerDay = group->getExamsPerDay();
+    groupData.active = group->getActive();
+    groupData.small = group->getSmall();
+    groupData.obsolete = group->getObsolete();
+    for (int block = 0; block < blocks.size(); block++) {
+      groupData.availability.append(
+          blocks[block] != nullptr &&
+          blocks[block]->containsActiveGroup(group) &&
+          !fixedBlocks.contains(qMakePair(group, block)));
+    }
+    return groupData;
+  };
+
+  for (Group* constraint : plan->getConstraints()) {
+    data.constraints.append(createGroupData(constraint));
+  }
+  for (Group* group : plan->getGroups()) {
+    data.groups.append(createGroupData(group));
+  }
+
+  for (Module* module : plan->getModules()) {
+    PlanCsvModuleData moduleData;
+    moduleData.name = module->getName();
+    moduleData.origin = module->getOrigin();
+    moduleData.number = module->getNumber();
+    moduleData.active =
+        module->getActive() && !(pinnedModulesFixed && module->getPinned());
+    moduleData.examType = module->getExamType();
+    moduleData.examDuration = module->getExamDuration();
+    for (Group* group : module->getGroups()) {
+      moduleData.groups.append(group->getName());
+    }
+    // Only one constraint is possible, because the legacy algorithm does not
+    // support more
+    if (module->getConstraints().size() >= 1) {
+      moduleData.constraint = module->getConstraints()[0]->getName();
+    }
+    data.modules.append(moduleData);
+  }
+
+  int weekId = -1;
+  for (Week* week : plan->getWeeks()) {
+    weekId++;
+    int dayId = -1;
+    for (Day* day : week->getDays()) {
+      dayId++;
+      int timeslotId = -1;
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        timeslotId++;
+        for (Module* module : timeslot->getModules()) {
+          PlanCsvScheduleEntry entry;
+          entry.number = module->getNumber();
+          entry.name = module->getName();
+          entry.origin = module->getOrigin();
+          entry.examType = module->getExamType();
+          for (Group* group : module->getGroups()) {
+            entry.groups.append(group->getName());
+          }
+          entry.week = weekId;
+          entry.day = dayId;
+          entry.timeslot = timeslotId;
+          data.schedule.append(entry);
+        }
+      }
+    }
+  }
 
-bool PlanCsvHelper::isScheduled() {
-  return planningExamsResultFile.exists() && groupsExamsResultFile.exists();
+  return data;
 }
 
-QString PlanCsvHelper::getPath() {
-  return basePath;
+bool PlanCsvHelper::createResultDirectory(const QString& path) {
+  if (!QDir(path).exists()) {
+    return false;
+  }
+  return QDir().mkpath(path + "/SPA-ERGEBNIS-PP");
 }
 
-bool PlanCsvHelper::readSchedule(Plan* plan) {
-  if (!planningExamsResultFile.open(QFile::ReadOnly)) {
+bool PlanCsvHelper::readScheduleFile(QIODevice* device,
+                                     QList<PlanCsvScheduleEntry>& schedule) {
+  DeviceGuard guard(device, QIODevice::ReadOnly);
+  if (!guard.isOpen()) {
     return false;
   }
-  QTextStream fileStream(&planningExamsResultFile);
+  QTextStream fileStream(device);
 
   // Check, that firstline is valid
-  if (fileStream.readLine() !=
-      QString("BelegNr;Zug;Modul;Import;Prüfungsform;Zuordnung;Tag;Block;")) {
-    planningExamsResultFile.close();
+  if (fileStream.readLine() != QString(scheduleHeader)) {
     return false;
   }
 
-  // The modules will only be added to the slots, if the file is correct. Until
-  // then they will be stored here.
-  QList<QPair<Module*, Timeslot*>> modulesToAdd;
-
   while (!fileStream.atEnd()) {
     QString line = fileStream.readLine();
     if (line == "") {
-      planningExamsResultFile.close();
-      return true;
+      break;
     }
-    QList<QString> words = line.split(";");
-    if (words.size() != 9) {
-      planningExamsResultFile.close();
+    PlanCsvScheduleEntry entry;
+    if (!parseScheduleLine(line, entry)) {
       return false;
     }
+    schedule.append(entry);
+  }
 
-    // Generate module number (BelegNr[,Zug])
-    QString moduleNumber = words[0];
-    if (words[1] != "") {
-      moduleNumber.append(",").append(words[1]);
-    }
+  return true;
+}
+
+bool PlanCsvHelper::parseScheduleLine(const QString& line,
+                                      PlanCsvScheduleEntry& entry) {
+  QList<QString> words = line.split(";");
+  if (words.size() != 9) {
+    return false;
+  }
+
+  // Generate module number (BelegNr[,Zug])
+  entry.number = words[0];
+  if (words[1] != "") {
+    entry.number.append(",").append(words[1]);
+  }
+  entry.name = words[2];
+  entry.examType = words[4];
+
+  bool dayOk = false;
+  int day = words[6].toInt(&dayOk) - 1;
+  if (!dayOk || day < 0) {
+    return false;
+  }
+  bool slotOk = false;
+  int slot = words[7].toInt(&slotOk) - 1;
+  if (!slotOk || slot < 0) {
+    return false;
+  }
+
+  // The result file counts seven days per week
+  entry.week = day / 7;
+  entry.day = day % 7;
+  entry.timeslot = slot;
+  return true;
+}
+
+bool PlanCsvHelper::applySchedule(const QList<PlanCsvScheduleEntry>& schedule,
+                                  Plan* plan) {
+  // The modules will only be added to the slots, if the file is correct. Until
+  // then they will be stored here.
+  QList<QPair<Module*, Timeslot*>> modulesToAdd;
 
+  for (const PlanCsvScheduleEntry& entry : schedule) {
     // Find matching module
     Module* matchingModule = nullptr;
     for (Module* module : plan->getModules()) {
-      if (module->getNumber() == moduleNumber) {
-        if (module->getName() == words[2]) {
-          if (module->getExamType() == words[4]) {
+      if (module->getNumber() == entry.number) {
+        if (module->getName() == entry.name) {
+          if (module->getExamType() == entry.examType) {
             matchingModule = module;
             break;
           }
@@ -139,42 +902,27 @@ bool PlanCsvHelper::readSchedule(Plan* plan) {
       }
     }
     if (matchingModule == nullptr) {
-      planningExamsResultFile.close();
-      return false;
-    }
-
-    // Find matching timeslot
-    Timeslot* matchingTimeslot;
-    bool dayOk = false;
-    int day = words[6].toInt(&dayOk) - 1;
-    if (!dayOk) {
-      planningExamsResultFile.close();
       return false;
     }
-    bool slotOk = false;
-    int slot = words[7].toInt(&slotOk) - 1;
-    if (!slotOk) {
-      planningExamsResultFile.close();
-      return false;
+    if (matchingModule->getPinned()) {
+      continue;
     }
 
-    if (day < 0 || day / 7 >= plan->getWeeks().size()) {
-      planningExamsResultFile.close();
+    // Find matching timeslot
+    if (entry.week >= plan->getWeeks().size()) {
       return false;
     }
-    Week* weekPointer = plan->getWeeks()[day / 7];
+    Week* weekPointer = plan->getWeeks()[entry.week];
 
-    if (day % 7 >= weekPointer->getDays().size()) {
-      planningExamsResultFile.close();
+    if (entry.day >= weekPointer->getDays().size()) {
       return false;
     }
-    Day* dayPointer = weekPointer->getDays()[day % 7];
+    Day* dayPointer = weekPointer->getDays()[entry.day];
 
-    if (slot < 0 || slot >= dayPointer->getTimeslots().size()) {
-      planningExamsResultFile.close();
+    if (entry.timeslot >= dayPointer->getTimeslots().size()) {
       return false;
     }
-    matchingTimeslot = dayPointer->getTimeslots()[slot];
+    Timeslot* matchingTimeslot = dayPointer->getTimeslots()[entry.timeslot];
 
     modulesToAdd.append(
         QPair<Module*, Timeslot*>(matchingModule, matchingTimeslot));
@@ -192,314 +940,190 @@ bool PlanCsvHelper::readSchedule(Plan* plan) {
     moduleTimeslotPair.second->addModule(moduleTimeslotPair.first);
   }
 
-  planningExamsResultFile.close();
   return true;
 }
 
-void PlanCsvHelper::initializeFilePaths() {
-  examsIntervalsFile.setFileName(basePath + "/pruef-intervalle.csv");
-  examsFile.setFileName(basePath + "/pruefungen.csv");
-  groupsExamsFile.setFileName(basePath + "/zuege-pruef.csv");
-  groupsExamsPrefFile.setFileName(basePath + "/zuege-pruef-pref2.csv");
-  planningExamsResultFile.setFileName(basePath +
-                                      "/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv");
-  groupsExamsResultFile.setFileName(basePath +
-                                    "/SPA-ERGEBNIS-PP/SPA-zuege-pruef.csv");
-}
-
-bool PlanCsvHelper::writeExamsIntervalsFile(Plan* plan) {
-  if (!examsIntervalsFile.open(QFile::ReadWrite)) {
+bool PlanCsvHelper::writeAvailabilityFile(
+    QIODevice* device,
+    const QList<PlanCsvGroupData>& groups) {
+  DeviceGuard guard(device, QIODevice::WriteOnly | QIODevice::Truncate);
+  if (!guard.isOpen()) {
     return false;
   }
-  QTextStream fileStream(&examsIntervalsFile);
+  QTextStream fileStream(device);
 
   fileStream << "Block;";
-  for (auto constraint : plan->getConstraints()) {
-    fileStream << constraint->getName() << ";";
+  for (const PlanCsvGroupData& group : groups) {
+    fileStream << group.name << ";";
   }
   fileStream << "-ENDE-\n";
 
   fileStream << QString("Maximale Prü/Tag;");
-  for (Group* constraint : plan->getConstraints()) {
-    fileStream << constraint->getExamsPerDay() << ";";
+  for (const PlanCsvGroupData& group : groups) {
+    fileStream << group.examsPerDay << ";";
   }
   fileStream << "\n";
 
-  // TODO check that plan has the right amount of days
-  for (int week = 0; week < 3; week++) {
-    for (int day = 0; day < 6; day++) {
-      for (int timeslot = 0; timeslot < 6; timeslot++) {
-        fileStream << blockNames[week * 6 * 6 + day * 6 + timeslot] << ";";
-        for (Group* constraint : plan->getConstraints()) {
-          if (plan->getWeeks()[week]
-                  ->getDays()[day]
-                  ->getTimeslots()[timeslot]
-                  ->containsActiveGroup(constraint)) {
-            fileStream << "FREI;";
-          } else {
-            fileStream << "BLOCKIERT;";
-          }
-        }
-        fileStream << "\n";
-      }
-    }
-  }
-
-  /*
-//TODO check if correct blocknames are neccesary
-for (Week* week : plan->weeks) {
-  for (Day* day : week->getDays()) {
-    for (Timeslot* timeslot : day->getTimeslots()) {
-      fileStream << day->name().chopped(2) << week->name().chopped(1) << "_"
-                 << timeslot->name() << ";";
-      for (Group* constraint : plan->constraints) {
-        if (timeslot->containsActiveGroup(constraint)) {
-          fileStream << "FREI;";
-        } else {
-          fileStream << "BLOCKIERT;";
-        }
+  for (int block = 0; block < blockCount; block++) {
+    fileStream << blockNames[block] << ";";
+    for (const PlanCsvGroupData& group : groups) {
+      if (group.availability.value(block, false)) {
+        fileStream << "FREI;";
+      } else {
+        fileStream << "BLOCKIERT;";
       }
     }
+    fileStream << "\n";
   }
-}
-*/
 
   fileStream << "-ENDE-;";
-  for (int i = 0; i < plan->getConstraints().size(); i++) {
+  for (int i = 0; i < groups.size(); i++) {
     fileStream << ";";
   }
 
-  examsIntervalsFile.close();
   return true;
 
   // TODO Check if the second part of the csv file is needed
 }
 
-bool PlanCsvHelper::writeExamsFile(Plan* plan) {
-  if (!examsFile.open(QFile::ReadWrite)) {
+bool PlanCsvHelper::writeExamsFile(QIODevice* device, const PlanCsvData& data) {
+  DeviceGuard guard(device, QIODevice::WriteOnly | QIODevice::Truncate);
+  if (!guard.isOpen()) {
     return false;
   }
-  QTextStream fileStream(&examsFile);
+  QTextStream fileStream(device);
 
-  for (Module* module : plan->getModules()) {
+  for (const PlanCsvModuleData& module : data.modules) {
     // Comment inactive modules
     // Exam type "-" forces a module inactive
-    if (module->getActive() == false || module->getExamType() == "-"){
+    if (module.active == false || module.examType == "-") {
       fileStream << "//";
     }
 
     // TODO Check somewhere else
-    if (module->getOrigin() == "EIT") {
+    if (module.origin == "EIT") {
       // SPA-algorithmus fails if there are EIT exams, because "Prüfungen von
       // EIT müssen fest abgesprochen sein!!"
       continue;
     }
 
-    // Only one constraint is possible, because the legacy algorithm does not
-    // support more
-    if (module->getConstraints().size() >= 1) {
-      fileStream << module->getConstraints()[0]->getName();
-    }
+    fileStream << module.constraint;
     fileStream << ";";
 
     // TODO Check somewhere, that groupnames do not contain commas
-    QString divider = "";
-    for (Group* group : module->getGroups()) {
-      fileStream << divider << group->getName();
-      divider = ",";
-    }
+    fileStream << module.groups.join(",");
     fileStream << ";";
 
-    fileStream << module->getName() << ";";
-    fileStream << module->getNumber() << ";";
-    fileStream << module->getOrigin() << ";";
+    fileStream << module.name << ";";
+    fileStream << module.number << ";";
+    fileStream << module.origin << ";";
 
-    if (module->getExamType() == "K" || module->getExamType() == "P" || module->getExamType() == "-") {
-      fileStream << module->getExamType() << ";";
+    if (module.examType == "K" || module.examType == "P" ||
+        module.examType == "-") {
+      fileStream << module.examType << ";";
     } else {
-      examsFile.close();
       return false;
     }
 
     // The duration can also be omitted if it is 1, but we dont do that
-    fileStream << module->getExamDuration() << ";";
-
-    fileStream << "";
+    fileStream << module.examDuration << ";";
 
     fileStream << "\n";
   }
   fileStream << "-ENDE-;;;;;;";
 
-  examsFile.close();
-  return true;
-}
-
-bool PlanCsvHelper::writeGroupsExamsFile(Plan* plan) {
-  if (!groupsExamsFile.open(QFile::ReadWrite)) {
-    return false;
-  }
-  QTextStream fileStream(&groupsExamsFile);
-
-  fileStream << "Block;";
-  for (Group* group : plan->getGroups()) {
-    fileStream << group->getName() << ";";
-  }
-  fileStream << "-ENDE-\n";
-
-  fileStream << QString("Maximale Prü/Tag;");
-  for (Group* group : plan->getGroups()) {
-    fileStream << group->getExamsPerDay() << ";";
-  }
-  fileStream << "\n";
-
-  // TODO check that plan has the right amount of days
-  for (int week = 0; week < 3; week++) {
-    for (int day = 0; day < 6; day++) {
-      for (int timeslot = 0; timeslot < 6; timeslot++) {
-        fileStream << blockNames[week * 6 * 6 + day * 6 + timeslot] << ";";
-        for (Group* group : plan->getGroups()) {
-          if (plan->getWeeks()[week]
-                  ->getDays()[day]
-                  ->getTimeslots()[timeslot]
-                  ->containsActiveGroup(group)) {
-            fileStream << "FREI;";
-          } else {
-            fileStream << "BLOCKIERT;";
-          }
-        }
-        fileStream << "\n";
-      }
-    }
-  }
-
-  /*
-//TODO check if correct blocknames are neccesary
-for (Week* week : plan->weeks) {
-  for (Day* day : week->getDays()) {
-    for (Timeslot* timeslot : day->getTimeslots()) {
-      fileStream << day->name().chopped(2) << week->name().chopped(1) << "_"
-                 << timeslot->name() << ";";
-      for (Group* group : plan->groups) {
-        if (timeslot->containsActiveGroup(group)) {
-          fileStream << "FREI;";
-        } else {
-          fileStream << "BLOCKIERT;";
-        }
-      }
-    }
-  }
-}
-*/
-
-  fileStream << "-ENDE-;";
-  for (int i = 0; i < plan->getGroups().size(); i++) {
-    fileStream << ";";
-  }
-
-  groupsExamsFile.close();
   return true;
 }
 
-bool PlanCsvHelper::writeGroupsExamsPrefFile(Plan* plan) {
-  if (!groupsExamsPrefFile.open(QFile::ReadWrite)) {
+bool PlanCsvHelper::writeGroupsExamsPrefFile(QIODevice* device,
+                                             const PlanCsvData& data) {
+  DeviceGuard guard(device, QIODevice::WriteOnly | QIODevice::Truncate);
+  if (!guard.isOpen()) {
     return false;
   }
 
-  QTextStream fileStream(&groupsExamsPrefFile);
+  QTextStream fileStream(device);
 
-  for (Group* group : plan->getGroups()) {
-    if (!group->getActive()) {
-      fileStream << group->getName() << "\n";
+  for (const PlanCsvGroupData& group : data.groups) {
+    if (!group.active) {
+      fileStream << group.name << "\n";
     }
   }
   fileStream << "-ENDE-\n";
 
-  for (Group* group : plan->getGroups()) {
-    if (group->getSmall()) {
-      fileStream << group->getName() << "\n";
+  for (const PlanCsvGroupData& group : data.groups) {
+    if (group.small) {
+      fileStream << group.name << "\n";
     }
   }
   fileStream << "-ENDE-\n";
 
-  for (Group* group : plan->getGroups()) {
-    if (group->getObsolete()) {
-      fileStream << group->getName() << "\n";
+  for (const PlanCsvGroupData& group : data.groups) {
+    if (group.obsolete) {
+      fileStream << group.name << "\n";
     }
   }
   fileStream << "-ENDE-\n";
 
-  groupsExamsPrefFile.close();
   return true;
 }
 
-bool PlanCsvHelper::writePlanningExamsResultFile(Plan* plan) {
-  if (!QDir(basePath).exists()) {
+bool PlanCsvHelper::writePlanningExamsResultFile(QIODevice* device,
+                                                 const PlanCsvData& data) {
+  DeviceGuard guard(device, QIODevice::WriteOnly | QIODevice::Truncate);
+  if (!guard.isOpen()) {
     return false;
   }
-  QDir().mkpath(basePath + "/SPA-ERGEBNIS-PP");
-  if (!planningExamsResultFile.open(QFile::ReadWrite)) {
-    return false;
-  }
-  QTextStream fileStream(&planningExamsResultFile);
-  fileStream << "BelegNr;Zug;Modul;Import;Prüfungsform;Zuordnung;Tag;Block;\n";
-  int weekId = -1;
-  for (Week* week : plan->getWeeks()) {
-    weekId++;
-    int dayId = -1;
-    for (Day* day : week->getDays()) {
-      dayId++;
-      int timeslotId = -1;
-      for (Timeslot* timeslot : day->getTimeslots()) {
-        timeslotId++;
-        for (Module* module : timeslot->getModules()) {
-          // TODO find a better name for this list
-          QList<QString> moduleNumberParts =
-              module->getNumber().split(',', Qt::SkipEmptyParts);
-          if (moduleNumberParts.size() >= 1) {
-            fileStream << moduleNumberParts[0];
-          }
-          fileStream << ";";
-          if (moduleNumberParts.size() >= 2) {
-            fileStream << moduleNumberParts[1];
-          }
-          fileStream << ";";
-          fileStream << module->getName() << ";";
-          if (module->getOrigin() == "") {
-            fileStream << "0";
-          } else {
-            fileStream << "1";
-          }
-          fileStream << ";";
-          if (module->getExamType() == "K" || module->getExamType() == "P" || module->getExamType() == "-") {
-            fileStream << module->getExamType() << ";";
-          } else {
-            planningExamsResultFile.close();
-            return false;
-          }
-          for (Group* group : module->getGroups()) {
-            fileStream << group->getName() << "/";
-          }
-          // TODO find out what these words mean
-          fileStream << "ALLE ("
-                     << blockNames[weekId * 6 * 6 + dayId * 6 + timeslotId]
-                     << ");";
-
-          fileStream << weekId * 7 + dayId + 1 << ";" << timeslotId + 1
-                     << ";\n";
-        }
-      }
+  QTextStream fileStream(device);
+  fileStream << scheduleHeader << "\n";
+  for (const PlanCsvScheduleEntry& entry : data.schedule) {
+    // TODO find a better name for this list
+    QList<QString> moduleNumberParts =
+        entry.number.split(',', Qt::SkipEmptyParts);
+    if (moduleNumberParts.size() >= 1) {
+      fileStream << moduleNumberParts[0];
+    }
+    fileStream << ";";
+    if (moduleNumberParts.size() >= 2) {
+      fileStream << moduleNumberParts[1];
+    }
+    fileStream << ";";
+    fileStream << entry.name << ";";
+    if (entry.origin == "") {
+      fileStream << "0";
+    } else {
+      fileStream << "1";
+    }
+    fileStream << ";";
+    if (entry.examType == "K" || entry.examType == "P" ||
+        entry.examType == "-") {
+      fileStream << entry.examType << ";";
+    } else {
+      return false;
+    }
+    for (const QString& group : entry.groups) {
+      fileStream << group << "/";
     }
+    // TODO find out what these words mean
+    int block = entry.week * dayCount * timeslotCount +
+                entry.day * timeslotCount + entry.timeslot;
+    fileStream << "ALLE (" << (block < blockCount ? blockNames[block] : "")
+               << ");";
+
+    fileStream << entry.week * 7 + entry.day + 1 << ";" << entry.timeslot + 1
+               << ";\n";
   }
-  planningExamsResultFile.close();
   return true;
 }
 
-bool PlanCsvHelper::readExamsIntervalsFile(Plan* plan) {
-  if (!examsIntervalsFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+bool PlanCsvHelper::readAvailabilityFile(QIODevice* device,
+                                         QList<PlanCsvGroupData>& groups) {
+  DeviceGuard guard(device, QIODevice::ReadOnly | QIODevice::Text);
+  if (!guard.isOpen()) {
     return false;
   }
 
-  QTextStream fileStream(&examsIntervalsFile);
+  QTextStream fileStream(device);
 
   // Read and check first two lines
   int wordsPerLine;
@@ -510,74 +1134,67 @@ bool PlanCsvHelper::readExamsIntervalsFile(Plan* plan) {
       firstLine.takeLast();
     }
     if (firstLine.size() == 0) {
-      examsIntervalsFile.close();
       return false;
     }
   }
   wordsPerLine = firstLine.size();
 
   QList<QString> secondLine = fileStream.readLine().split(";");
-  if (secondLine[0] != QString("Maximale Prü/Tag") || secondLine.last() != "") {
-    examsIntervalsFile.close();
+  if (secondLine[0] != QString("Maximale Prü/Tag") ||
+      secondLine.last() != "" || secondLine.size() < wordsPerLine - 1) {
     return false;
   }
 
-  QList<Group*> constraints = plan->getConstraints();
+  int firstGroup = groups.size();
   for (int i = 1; i < wordsPerLine - 1; i++) {
-    Group* group = new Group(plan);
-    group->setName(firstLine[i]);
+    PlanCsvGroupData group;
+    group.name = firstLine[i];
     bool parseIntWorked;
     unsigned int examsPerDay = secondLine[i].toUInt(&parseIntWorked);
     if (parseIntWorked) {
-      group->setExamsPerDay(examsPerDay);
+      group.examsPerDay = examsPerDay;
     } else if (secondLine[i] == "") {
       // If the field is empty there are unlimited exams per day allowed
-      group->setExamsPerDay(99);
+      group.examsPerDay = 99;
     } else {
-      examsIntervalsFile.close();
       return false;
     }
-    constraints.append(group);
+    groups.append(group);
   }
 
   // Read a line for each timeslot
-  for (Week* week : plan->getWeeks()) {
-    for (Day* day : week->getDays()) {
-      for (Timeslot* timeslot : day->getTimeslots()) {
-        QList<QString> words = fileStream.readLine().split(";");
-        if (words.size() != wordsPerLine) {
-          examsIntervalsFile.close();
-          return false;
-        }
-        for (int i = 0; i < constraints.size(); i++) {
-          if (words[i + 1] == "FREI") {
-            timeslot->addActiveGroup(constraints[i]);
-          } else if (words[i + 1] != "BLOCKIERT") {
-            examsIntervalsFile.close();
-            return false;
-          }
-        }
+  for (int block = 0; block < blockCount; block++) {
+    QList<QString> words = fileStream.readLine().split(";");
+    if (words.size() != wordsPerLine) {
+      return false;
+    }
+    for (int i = firstGroup; i < groups.size(); i++) {
+      const QString& word = words[i - firstGroup + 1];
+      if (word == "FREI") {
+        groups[i].availability.append(true);
+      } else if (word == "BLOCKIERT") {
+        groups[i].availability.append(false);
+      } else {
+        return false;
       }
     }
   }
 
-  plan->setConstraints(constraints);
-
-  examsIntervalsFile.close();
   return true;
 }
 
-bool PlanCsvHelper::readExamsFile(Plan* plan,
+bool PlanCsvHelper::readExamsFile(QIODevice* device,
+                                  PlanCsvData& data,
                                   bool parseComments,
                                   bool addMissingGroups) {
-  if (!examsFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  DeviceGuard guard(device, QIODevice::ReadOnly | QIODevice::Text);
+  if (!guard.isOpen()) {
     return false;
   }
 
-  QTextStream fileStream(&examsFile);
+  QTextStream fileStream(device);
 
   QList<QString> words = fileStream.readLine().split(";");
-  QList<Module*> modules = plan->getModules();
 
   // If the first line is the generated header, skip it
   if (words.size() >= 3 && (words[1] == "Kategorie" || words[2] == "Modul")) {
@@ -603,27 +1220,23 @@ bool PlanCsvHelper::readExamsFile(Plan* plan,
         words = fileStream.readLine().split(";");
         continue;
       } else {
-        examsFile.close();
         return false;
       }
     }
-    Module* module = new Module(plan);
+    PlanCsvModuleData module;
 
     if (comment) {
-      module->setActive(false);
+      module.active = false;
     }
 
-    module->setName(words[2]);
-    module->setOrigin(words[4]);
-    module->setNumber(words[3]);
+    module.name = words[2];
+    module.origin = words[4];
+    module.number = words[3];
     bool foundAllGroups = true;
     for (QString groupName : words[1].split(",")) {
       bool foundGroup = false;
-      for (Group* group : plan->getGroups()) {
-        if (group->getName() == groupName) {
-          auto groups = module->getGroups();
-          groups.append(group);
-          module->setGroups(groups);
+      for (const PlanCsvGroupData& group : data.groups) {
+        if (group.name == groupName) {
           foundGroup = true;
           break;
         }
@@ -633,37 +1246,29 @@ bool PlanCsvHelper::readExamsFile(Plan* plan,
         // added, but that line gets discarded later on
         if (addMissingGroups) {
           qDebug() << "Adding missing group " << groupName;
-          Group* newGroup = new Group(plan);
-          newGroup->setName(groupName);
-          auto planGroups = plan->getGroups();
-          planGroups.append(newGroup);
-          plan->setGroups(planGroups);
-          auto moduleGroups = module->getGroups();
-          moduleGroups.append(newGroup);
-          module->setGroups(moduleGroups);
+          PlanCsvGroupData newGroup;
+          newGroup.name = groupName;
+          data.groups.append(newGroup);
         } else {
           foundAllGroups = false;
           break;
         }
       }
+      module.groups.append(groupName);
     }
     if (!foundAllGroups) {
       if (comment) {
         words = fileStream.readLine().split(";");
         continue;
       } else {
-        examsFile.close();
         return false;
       }
     }
 
-    bool foundConstraint = false;
     if (words[0] != "") {
-      for (Group* constraint : plan->getConstraints()) {
-        if (constraint->getName() == words[0]) {
-          auto constraints = module->getConstraints();
-          constraints.append(constraint);
-          module->setConstraints(constraints);
+      bool foundConstraint = false;
+      for (const PlanCsvGroupData& constraint : data.constraints) {
+        if (constraint.name == words[0]) {
           foundConstraint = true;
           break;
         }
@@ -671,38 +1276,32 @@ bool PlanCsvHelper::readExamsFile(Plan* plan,
       if (!foundConstraint) {
         if (addMissingGroups) {
           qDebug() << "Adding missing constraint " << words[0];
-          Group* newConstraint = new Group(plan);
-          newConstraint->setName(words[0]);
-          auto planConstraints = plan->getConstraints();
-          planConstraints.append(newConstraint);
-          plan->setConstraints(planConstraints);
-          auto moduleConstraints = module->getConstraints();
-          moduleConstraints.append(newConstraint);
-          module->setConstraints(moduleConstraints);
+          PlanCsvGroupData newConstraint;
+          newConstraint.name = words[0];
+          data.constraints.append(newConstraint);
         } else {
           if (comment) {
             words = fileStream.readLine().split(";");
             continue;
           } else {
-            examsFile.close();
             return false;
           }
         }
       }
+      module.constraint = words[0];
     }
 
     if (words[5] == "P" || words[5] == "K" || words[5] == "-") {
-      //Exam type "-" forces modules inactive
-      if(words[5] == "-"){
-          module->setActive(false);
+      // Exam type "-" forces modules inactive
+      if (words[5] == "-") {
+        module.active = false;
       }
-      module->setExamType(words[5]);
+      module.examType = words[5];
     } else {
       if (comment) {
         words = fileStream.readLine().split(";");
         continue;
       } else {
-        examsFile.close();
         return false;
       }
     }
@@ -716,7 +1315,6 @@ bool PlanCsvHelper::readExamsFile(Plan* plan,
           words = fileStream.readLine().split(";");
           continue;
         } else {
-          examsFile.close();
           return false;
         }
       }
@@ -724,108 +1322,55 @@ bool PlanCsvHelper::readExamsFile(Plan* plan,
         qDebug()
             << "Mysterious bug appeared, where the exam duration is not 1 or 2";
       }
-      module->setExamDuration(examDuration);
+      module.examDuration = examDuration;
     } else {
       // No value for examDuration implicitly means 1
-      module->setExamDuration(1);
+      module.examDuration = 1;
     }
 
-    modules.append(module);
+    data.modules.append(module);
 
     words = fileStream.readLine().split(";");
   }
 
-  plan->setModules(modules);
-
   return true;
 }
 
-bool PlanCsvHelper::readGroupsExamsFile(Plan* plan) {
-  if (!groupsExamsFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-    return false;
-  }
-
-  QTextStream fileStream(&groupsExamsFile);
-
-  // Read and check first two lines
-  int wordsPerLine;
-  QList<QString> firstLine = fileStream.readLine().split(";");
-  if (firstLine.size() < 2 || firstLine[0] != "Block" ||
-      firstLine.last() != "-ENDE-") {
-    while (firstLine.size() > 0 && firstLine.last() != "-ENDE-") {
-      firstLine.takeLast();
-    }
-    if (firstLine.size() == 0) {
-      examsIntervalsFile.close();
-      return false;
-    }
-  }
-  wordsPerLine = firstLine.size();
-
-  QList<QString> secondLine = fileStream.readLine().split(";");
-  if (secondLine[0] != QString("Maximale Prü/Tag") || secondLine.last() != "") {
-    groupsExamsFile.close();
+bool PlanCsvHelper::readGroupsExamsPrefFile(QIODevice* device,
+                                            PlanCsvData& data,
+                                            bool addMissingGroups) {
+  DeviceGuard guard(device, QIODevice::ReadOnly | QIODevice::Text);
+  if (!guard.isOpen()) {
     return false;
   }
 
-  QList<Group*> groups = plan->getGroups();
-  for (int i = 1; i < wordsPerLine - 1; i++) {
-    Group* group = new Group(plan);
-    group->setName(firstLine[i]);
-    bool parseIntWorked;
-    unsigned int examsPerDay = secondLine[i].toUInt(&parseIntWorked);
-    if (parseIntWorked) {
-      group->setExamsPerDay(examsPerDay);
-    } else if (secondLine[i] == "") {
-      // If the field is empty there are unlimited exams per day allowed
-      group->setExamsPerDay(99);
-    } else {
-      groupsExamsFile.close();
-      return false;
-    }
-    groups.append(group);
-  }
+  QTextStream fileStream(device);
 
-  // Read a line for each timeslot
-  for (Week* week : plan->getWeeks()) {
-    for (Day* day : week->getDays()) {
-      for (Timeslot* timeslot : day->getTimeslots()) {
-        QList<QString> words = fileStream.readLine().split(";");
-        if (words.size() != wordsPerLine) {
-          groupsExamsFile.close();
-          return false;
-        }
-        for (int i = 0; i < groups.size(); i++) {
-          if (words[i + 1] == "FREI") {
-            timeslot->addActiveGroup(groups[i]);
-          } else if (words[i + 1] != "BLOCKIERT") {
-            groupsExamsFile.close();
-            return false;
-          }
-        }
-      }
-    }
+  for (PlanCsvGroupData& group : data.groups) {
+    group.active = true;
+    group.small = false;
+    group.obsolete = false;
   }
 
-  plan->setGroups(groups);
+  bool success = readGroupsExamsPrefSection(fileStream, data,
+                                            &PlanCsvGroupData::active, false,
+                                            addMissingGroups) &&
+                 readGroupsExamsPrefSection(fileStream, data,
+                                            &PlanCsvGroupData::small, true,
+                                            addMissingGroups) &&
+                 readGroupsExamsPrefSection(fileStream, data,
+                                            &PlanCsvGroupData::obsolete, true,
+                                            addMissingGroups);
 
-  groupsExamsFile.close();
-  return true;
+  // The contents of the groupsExamsPrefFile are not relevant for plan
+  return success;
 }
 
-bool PlanCsvHelper::readGroupsExamsPrefFile(Plan* plan, bool addMissingGroups) {
-  if (!groupsExamsPrefFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-    return false;
-  }
-
-  QTextStream fileStream(&groupsExamsPrefFile);
-
-  for (Group* group : plan->getGroups()) {
-    group->setActive(true);
-    group->setSmall(false);
-    group->setObsolete(false);
-  }
-
+bool PlanCsvHelper::readGroupsExamsPrefSection(QTextStream& fileStream,
+                                               PlanCsvData& data,
+                                               bool PlanCsvGroupData::*flag,
+                                               bool value,
+                                               bool addMissingGroups) {
   QList<QString> line = fileStream.readLine().split(";");
   while (line.size() >= 1 && line[0] != "-ENDE-") {
     if (line[0].startsWith("//")) {
@@ -833,71 +1378,9 @@ bool PlanCsvHelper::readGroupsExamsPrefFile(Plan* plan, bool addMissingGroups) {
       continue;
     }
     bool found = false;
-    for (Group* group : plan->getGroups()) {
-      if (group->getName() == line[0]) {
-        group->setActive(false);
-        found = true;
-        break;
-      }
-    }
-    if (!found) {
-      if (addMissingGroups && line[0] != "") {
-        qDebug() << "Adding missing group " << line[0];
-        Group* newGroup = new Group(plan);
-        newGroup->setName(line[0]);
-        newGroup->setActive(false);
-        auto planGroups = plan->getGroups();
-        planGroups.append(newGroup);
-        plan->setGroups(planGroups);
-      } else {
-        groupsExamsPrefFile.close();
-        return false;
-      }
-    }
-    line = fileStream.readLine().split(";");
-  }
-
-  line = fileStream.readLine().split(";");
-  while (line.size() >= 1 && line[0] != "-ENDE-") {
-    if (line[0].startsWith("//")) {
-      line = fileStream.readLine().split(";");
-      continue;
-    }
-    bool found = false;
-    for (Group* group : plan->getGroups()) {
-      if (group->getName() == line[0]) {
-        group->setSmall(true);
-        found = true;
-        break;
-      }
-    }
-    if (!found) {
-      if (addMissingGroups && line[0] != "") {
-        qDebug() << "Adding missing group " << line[0];
-        Group* newGroup = new Group(plan);
-        newGroup->setName(line[0]);
-        newGroup->setSmall(true);
-        auto planGroups = plan->getGroups();
-        planGroups.append(newGroup);
-        plan->setGroups(planGroups);
-      } else {
-        groupsExamsPrefFile.close();
-        return false;
-      }
-    }
-    line = fileStream.readLine().split(";");
-  }
-
-  line = fileStream.readLine().split(";");
-  while (line.size() >= 1 && line[0] != "-ENDE-") {
-    if (line[0].startsWith("//")) {
-      line = fileStream.readLine().split(";");
-      continue;
-    }
-    bool found = false;
-    for (Group* group : plan->getGroups()) {
-      if (group->getName() == line[0]) {
-        group->setObsolete(true);
+    for (PlanCsvGroupData& group : data.groups) {
+      if (group.name == line[0]) {
+        group.*flag = value;
         found = true;
         break;
       }
@@ -905,21 +1388,15 @@ bool PlanCsvHelper::readGroupsExamsPrefFile(Plan* plan, bool addMissingGroups) {
     if (!found) {
       if (addMissingGroups && line[0] != "") {
         qDebug() << "Adding missing group " << line[0];
-        Group* newGroup = new Group(plan);
-        newGroup->setName(line[0]);
-        newGroup->setObsolete(true);
-        auto planGroups = plan->getGroups();
-        planGroups.append(newGroup);
-        plan->setGroups(planGroups);
+        PlanCsvGroupData newGroup;
+        newGroup.name = line[0];
+        newGroup.*flag = value;
+        data.groups.append(newGroup);
       } else {
-        groupsExamsPrefFile.close();
         return false;
       }
     }
     line = fileStream.readLine().split(";");
   }
-
-  // The contents of the groupsExamsPrefFile are not relevant for plan
-  groupsExamsPrefFile.close();
   return true;
 }
@@ -0,0 +1,181 @@
+#include <plancsvhelper.h>
+#include <plancsvscheduletailer.h>
+#include <QDir>
+#include <QList>
+
+PlanCsvScheduleTailer::PlanCsvScheduleTailer(const QString& path,
+                                             Plan* plan,
+                                             QObject* parent)
+    : QObject(parent),
+      path(path),
+      filePath(path + "/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv"),
+      plan(plan),
+      running(false),
+      offset(0),
+      headerRead(false),
+      headerValid(false),
+      endReached(false),
+      appliedCount(0),
+      rejectedCount(0) {
+  debounceTimer.setSingleShot(true);
+  debounceTimer.setInterval(50);
+  connect(&debounceTimer, &QTimer::timeout, this,
+          &PlanCsvScheduleTailer::readNewLines);
+  auto changed = [this]() {
+    updateWatchedPaths();
+    debounceTimer.start();
+  };
+  connect(&watcher, &QFileSystemWatcher::fileChanged, this, changed);
+  connect(&watcher, &QFileSystemWatcher::directoryChanged, this, changed);
+}
+
+QString PlanCsvScheduleTailer::getFilePath() const {
+  return filePath;
+}
+
+void PlanCsvScheduleTailer::setDebounceInterval(int debounceInterval) {
+  debounceTimer.setInterval(debounceInterval);
+}
+
+int PlanCsvScheduleTailer::getDebounceInterval() const {
+  return debounceTimer.interval();
+}
+
+qint64 PlanCsvScheduleTailer::getOffset() const {
+  return offset;
+}
+
+int PlanCsvScheduleTailer::getAppliedCount() const {
+  return appliedCount;
+}
+
+int PlanCsvScheduleTailer::getRejectedCount() const {
+  return rejectedCount;
+}
+
+bool PlanCsvScheduleTailer::isRunning() const {
+  return running;
+}
+
+void PlanCsvScheduleTailer::start() {
+  if (running) {
+    return;
+  }
+  running = true;
+  updateWatchedPaths();
+  readNewLines();
+}
+
+void PlanCsvScheduleTailer::stop() {
+  if (!running) {
+    return;
+  }
+  running = false;
+  debounceTimer.stop();
+  if (!watcher.files().isEmpty()) {
+    watcher.removePaths(watcher.files());
+  }
+  if (!watcher.directories().isEmpty()) {
+    watcher.removePaths(watcher.directories());
+  }
+}
+
+bool PlanCsvScheduleTailer::readNewLines() {
+  if (plan.isNull()) {
+    return false;
+  }
+  QFile file(filePath);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  if (isReplaced(file)) {
+    offset = 0;
+    lastLine.clear();
+    headerRead = false;
+    endReached = false;
+  }
+  if (!file.seek(offset)) {
+    return false;
+  }
+  QByteArray content = file.readAll();
+  int end = content.lastIndexOf('\n');
+  if (end < 0) {
+    return true;
+  }
+  offset += end + 1;
+  int lastLineStart = end > 0 ? content.lastIndexOf('\n', end - 1) + 1 : 0;
+  lastLine = content.mid(lastLineStart, end + 1 - lastLineStart);
+
+  QList<PlanCsvScheduleEntry> entries;
+  int rejected = 0;
+  for (QByteArray bytes : content.left(end).split('\n')) {
+    if (bytes.endsWith('\r')) {
+      bytes.chop(1);
+    }
+    QString line = QString::fromLocal8Bit(bytes);
+    if (!headerRead) {
+      headerRead = true;
+      headerValid = line == QString(PlanCsvHelper::scheduleHeader);
+      if (!headerValid) {
+        rejected++;
+      }
+      continue;
+    }
+    // Like readScheduleFile, everything after an empty line is ignored
+    if (endReached || line.isEmpty()) {
+      endReached = true;
+      continue;
+    }
+    PlanCsvScheduleEntry entry;
+    if (!headerValid || !PlanCsvHelper::parseScheduleLine(line, entry)) {
+      rejected++;
+      continue;
+    }
+    entries.append(entry);
+  }
+
+  int applied = 0;
+  for (const PlanCsvScheduleEntry& entry : entries) {
+    if (PlanCsvHelper::applySchedule({entry}, plan)) {
+      applied++;
+    } else {
+      rejected++;
+    }
+  }
+  appliedCount += applied;
+  rejectedCount += rejected;
+  if (applied > 0) {
+    emit entriesApplied(applied);
+  }
+  if (rejected > 0) {
+    emit linesRejected(rejected);
+  }
+  return true;
+}
+
+bool PlanCsvScheduleTailer::isReplaced(QFile& file) const {
+  if (file.size() < offset) {
+    return true;
+  }
+  // A replacement of the same size or longer differs in the last read line
+  // in almost all cases
+  if (lastLine.isEmpty() || !file.seek(offset - lastLine.size())) {
+    return !lastLine.isEmpty();
+  }
+  return file.read(lastLine.size()) != lastLine;
+}
+
+void PlanCsvScheduleTailer::updateWatchedPaths() {
+  if (!running) {
+    return;
+  }
+  // The file and its directory may not exist before the solver starts
+  QString resultPath = path + "/SPA-ERGEBNIS-PP";
+  for (const QString& watchedPath : {path, resultPath, filePath}) {
+    if (QFile::exists(watchedPath) &&
+        !watcher.files().contains(watchedPath) &&
+        !watcher.directories().contains(watchedPath)) {
+      watcher.addPath(watchedPath);
+    }
+  }
+}
@@ -0,0 +1,1059 @@
+#include <plandatabase.h>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSet>
+#include <QStringList>
+#include <QSqlError>
+#include <QSqlQuery>
+
+namespace {
+// Rows of the groups table are either a group or a constraint of the plan
+constexpr int groupKind = 0;
+constexpr int constraintKind = 1;
+// The lists of a tracked plan are indexed by the kinds and the modules
+constexpr int moduleList = 2;
+
+// Plans copied from the same JSON share the ids of their objects, so rows of
+// plans are keyed by the plan and the id. The keys start with the plan, so
+// they also serve the queries for all rows of a plan.
+const QStringList tableStatements = {
+    "CREATE TABLE IF NOT EXISTS semesters (id TEXT PRIMARY KEY, name TEXT)",
+    "CREATE TABLE IF NOT EXISTS plans (id TEXT PRIMARY KEY, semester TEXT, "
+    "position INTEGER, name TEXT)",
+    "CREATE INDEX IF NOT EXISTS plansBySemester ON plans (semester)",
+    "CREATE TABLE IF NOT EXISTS planGroups (id TEXT, plan TEXT, "
+    "kind INTEGER, position INTEGER, data TEXT, PRIMARY KEY (plan, id))",
+    "CREATE TABLE IF NOT EXISTS modules (id TEXT, plan TEXT, "
+    "position INTEGER, data TEXT, PRIMARY KEY (plan, id))",
+    "CREATE TABLE IF NOT EXISTS weeks (id TEXT, plan TEXT, "
+    "position INTEGER, name TEXT, PRIMARY KEY (plan, id))",
+    "CREATE TABLE IF NOT EXISTS days (id TEXT, plan TEXT, "
+    "week TEXT, position INTEGER, name TEXT, PRIMARY KEY (plan, id))",
+    "CREATE TABLE IF NOT EXISTS timeslots (id TEXT, plan TEXT, "
+    "day TEXT, position INTEGER, name TEXT, PRIMARY KEY (plan, id))",
+    "CREATE TABLE IF NOT EXISTS availability (timeslot TEXT, groupId TEXT, "
+    "plan TEXT, position INTEGER, PRIMARY KEY (plan, timeslot, groupId))",
+    "CREATE TABLE IF NOT EXISTS assignments (timeslot TEXT, module TEXT, "
+    "plan TEXT, position INTEGER, PRIMARY KEY (plan, timeslot, module))"};
+
+// The tables with rows of a plan, in the order they are cleared
+const QStringList planTables = {"availability", "assignments", "timeslots",
+                                "days",         "weeks",       "modules",
+                                "planGroups"};
+
+QString toKey(const QUuid& id) {
+  return id.toString();
+}
+
+QString toData(const QJsonObject& object) {
+  return QString::fromUtf8(
+      QJsonDocument(object).toJson(QJsonDocument::Compact));
+}
+
+QJsonObject fromData(const QString& data) {
+  return QJsonDocument::fromJson(data.toUtf8()).object();
+}
+
+QString toKey(const QJsonValue& id) {
+  return toKey(QUuid(id.toString()));
+}
+
+template <typename T>
+QList<QUuid> toIds(const QList<T*>& objects) {
+  QList<QUuid> ids;
+  for (T* object : objects) {
+    if (object != nullptr) {
+      ids.append(object->getId());
+    }
+  }
+  return ids;
+}
+
+QList<QUuid> toIds(const QJsonArray& references) {
+  QList<QUuid> ids;
+  for (const QJsonValue& reference : references) {
+    ids.append(QUuid(reference.toString()));
+  }
+  return ids;
+}
+}  // namespace
+
+PlanDatabase::PlanDatabase(QObject* parent)
+    : QObject(parent), flushInterval(100) {
+  flushTimer.setSingleShot(true);
+  connect(&flushTimer, &QTimer::timeout, this, &PlanDatabase::flush);
+}
+
+PlanDatabase::~PlanDatabase() {
+  close();
+  for (TrackedPlan& tracked : trackedPlans) {
+    disconnectPlan(tracked);
+  }
+}
+
+bool PlanDatabase::open(const QString& path) {
+  close();
+  connectionName = QUuid::createUuid().toString();
+  database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+  database.setDatabaseName(path);
+  if (!database.open()) {
+    lastError = database.lastError().text();
+    close();
+    return false;
+  }
+  if (!createTables()) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void PlanDatabase::close() {
+  if (connectionName.isEmpty()) {
+    return;
+  }
+  if (database.isOpen()) {
+    flush();
+    database.close();
+  }
+  flushTimer.stop();
+  database = QSqlDatabase();
+  QSqlDatabase::removeDatabase(connectionName);
+  connectionName.clear();
+}
+
+bool PlanDatabase::isOpen() const {
+  return database.isOpen();
+}
+
+QString PlanDatabase::getLastError() const {
+  return lastError;
+}
+
+bool PlanDatabase::saveSemester(Semester* semester) {
+  if (semester == nullptr || !isOpen()) {
+    lastError = "No semester or no open database";
+    return false;
+  }
+
+  // Unloaded plans are written from their JSON, so they stay unloaded
+  QList<QJsonObject> contents;
+  QSet<QUuid> planIds;
+  for (int i = 0; i < semester->getPlanCount(); i++) {
+    contents.append(semester->getPlanContent(i));
+    if (!contents[i].isEmpty()) {
+      planIds.insert(QUuid(contents[i].value("id").toString()));
+    }
+  }
+
+  int rowCount = 0;
+  database.transaction();
+  bool success = exec("INSERT OR REPLACE INTO semesters VALUES (?, ?)",
+                      {toKey(semester->getId()), semester->getName()});
+  for (const QUuid& id : getPlanIds(semester->getId())) {
+    if (success && !planIds.contains(id)) {
+      success = deletePlan(id);
+    }
+  }
+  for (int position = 0; success && position < contents.size(); position++) {
+    if (!contents[position].isEmpty()) {
+      success = writePlan(contents[position], semester->getId(), position,
+                          rowCount);
+    }
+  }
+  if (!success || !database.commit()) {
+    if (success) {
+      lastError = database.lastError().text();
+    }
+    database.rollback();
+    return false;
+  }
+
+  for (int position = 0; position < contents.size(); position++) {
+    if (!semester->isPlanLoaded(position)) {
+      continue;
+    }
+    auto iterator = trackedPlans.find(semester->getPlan(position));
+    if (iterator != trackedPlans.end()) {
+      iterator->semesterId = semester->getId();
+      iterator->position = position;
+      resetPositions(*iterator);
+      clearChanges(*iterator);
+    }
+  }
+  return true;
+}
+
+bool PlanDatabase::savePlan(Plan* plan, const QUuid& semesterId, int position) {
+  if (plan == nullptr || !isOpen()) {
+    lastError = "No plan or no open database";
+    return false;
+  }
+
+  int rowCount = 0;
+  database.transaction();
+  if (!writePlan(plan->toJsonObject(), semesterId, position, rowCount)) {
+    database.rollback();
+    return false;
+  }
+  if (!database.commit()) {
+    lastError = database.lastError().text();
+    database.rollback();
+    return false;
+  }
+
+  auto iterator = trackedPlans.find(plan);
+  if (iterator != trackedPlans.end()) {
+    iterator->semesterId = semesterId;
+    iterator->position = position;
+    resetPositions(*iterator);
+    clearChanges(*iterator);
+  }
+  return true;
+}
+
+QList<QUuid> PlanDatabase::getSemesterIds() const {
+  QList<QUuid> ids;
+  QSqlQuery query(database);
+  if (query.exec("SELECT id FROM semesters ORDER BY name")) {
+    while (query.next()) {
+      ids.append(QUuid(query.value(0).toString()));
+    }
+  }
+  return ids;
+}
+
+QList<QUuid> PlanDatabase::getPlanIds(const QUuid& semesterId) const {
+  QList<QUuid> ids;
+  QSqlQuery query(database);
+  query.prepare("SELECT id FROM plans WHERE semester = ? ORDER BY position");
+  query.addBindValue(toKey(semesterId));
+  if (query.exec()) {
+    while (query.next()) {
+      ids.append(QUuid(query.value(0).toString()));
+    }
+  }
+  return ids;
+}
+
+QString PlanDatabase::getPlanName(const QUuid& id) const {
+  QSqlQuery query(database);
+  query.prepare("SELECT name FROM plans WHERE id = ?");
+  query.addBindValue(toKey(id));
+  if (!query.exec() || !query.next()) {
+    return QString();
+  }
+  // A stored empty name is not null
+  QString name = query.value(0).toString();
+  return name.isNull() ? QString("") : name;
+}
+
+Plan* PlanDatabase::loadPlan(const QUuid& id, QObject* parent) const {
+  QJsonObject content = readPlan(id);
+  if (content.isEmpty()) {
+    return nullptr;
+  }
+  Plan* plan = new Plan(parent);
+  plan->fromJsonObject(content);
+  return plan;
+}
+
+Semester* PlanDatabase::loadSemester(const QUuid& id, QObject* parent) const {
+  QSqlQuery query(database);
+  query.prepare("SELECT name FROM semesters WHERE id = ?");
+  query.addBindValue(toKey(id));
+  if (!query.exec() || !query.next()) {
+    return nullptr;
+  }
+
+  Semester* semester = new Semester(parent);
+  QJsonObject content;
+  content.insert("id", toKey(id));
+  content.insert("name", query.value(0).toString());
+  content.insert("plans", QJsonArray());
+  semester->fromJsonObject(content);
+
+  QList<Plan*> plans;
+  for (const QUuid& planId : getPlanIds(id)) {
+    Plan* plan = loadPlan(planId, semester);
+    if (plan != nullptr) {
+      plans.append(plan);
+    }
+  }
+  semester->setPlans(plans);
+  return semester;
+}
+
+void PlanDatabase::track(Plan* plan) {
+  if (plan == nullptr || trackedPlans.contains(plan)) {
+    return;
+  }
+
+  TrackedPlan& tracked = trackedPlans[plan];
+  tracked.plan = plan;
+  QSqlQuery query(database);
+  query.prepare("SELECT semester, position FROM plans WHERE id = ?");
+  query.addBindValue(toKey(plan->getId()));
+  bool stored = query.exec() && query.next();
+  connectPlan(tracked);
+  if (stored) {
+    tracked.semesterId = QUuid(query.value(0).toString());
+    tracked.position = query.value(1).toInt();
+    readPositions(tracked);
+  } else {
+    // Not stored yet, so the first flush writes all of it
+    tracked.structureChanged = true;
+    changed();
+  }
+}
+
+void PlanDatabase::untrack(Plan* plan) {
+  auto iterator = trackedPlans.find(plan);
+  if (iterator == trackedPlans.end()) {
+    return;
+  }
+  disconnectPlan(*iterator);
+  trackedPlans.erase(iterator);
+}
+
+bool PlanDatabase::hasPendingChanges() const {
+  for (const TrackedPlan& tracked : trackedPlans) {
+    if (tracked.structureChanged || tracked.nameChanged ||
+        !tracked.groups.isEmpty() || !tracked.modules.isEmpty() ||
+        !tracked.weeks.isEmpty() || !tracked.days.isEmpty() ||
+        !tracked.timeslots.isEmpty() || !tracked.assignments.isEmpty() ||
+        !tracked.availability.isEmpty()) {
+      return true;
+    }
+    for (const TrackedList& list : tracked.lists) {
+      if (!list.removed.isEmpty() || !list.placed.isEmpty()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void PlanDatabase::setFlushInterval(int flushInterval) {
+  if (this->flushInterval == flushInterval)
+    return;
+
+  this->flushInterval = flushInterval;
+  if (flushInterval < 0) {
+    flushTimer.stop();
+  }
+}
+
+int PlanDatabase::getFlushInterval() const {
+  return flushInterval;
+}
+
+bool PlanDatabase::flush() {
+  flushTimer.stop();
+  if (!hasPendingChanges()) {
+    return true;
+  }
+  if (!isOpen()) {
+    lastError = "The database is not open";
+    return false;
+  }
+
+  int rowCount = 0;
+  bool success = database.transaction();
+  for (auto iterator = trackedPlans.begin();
+       success && iterator != trackedPlans.end(); iterator++) {
+    TrackedPlan& tracked = *iterator;
+    Plan* plan = tracked.plan.data();
+    if (plan == nullptr) {
+      continue;
+    }
+    if (tracked.structureChanged) {
+      success = writePlan(plan->toJsonObject(), tracked.semesterId,
+                          tracked.position, rowCount);
+      resetPositions(tracked);
+      continue;
+    }
+
+    QUuid planId = plan->getId();
+    QString planKey = toKey(planId);
+    if (tracked.nameChanged) {
+      success = exec("UPDATE plans SET name = ? WHERE id = ?",
+                     {plan->getName(), planKey}, rowCount);
+    }
+
+    // Rows are deleted before new rows are inserted, as a group, that moved
+    // from the groups to the constraints, keeps its id
+    for (int list : {groupKind, constraintKind, moduleList}) {
+      QString table = list == moduleList ? "modules" : "planGroups";
+      for (const QUuid& id : tracked.lists[list].removed) {
+        if (success) {
+          success = exec("DELETE FROM " + table + " WHERE plan = ? AND id = ?",
+                         {planKey, toKey(id)}, rowCount);
+        }
+      }
+    }
+    QList<Group*> groupLists[2] = {plan->getGroups(), plan->getConstraints()};
+    for (int kind : {groupKind, constraintKind}) {
+      const TrackedList& list = tracked.lists[kind];
+      for (Group* group : groupLists[kind]) {
+        if (success && list.placed.contains(group)) {
+          success =
+              insertGroup(planKey, group->toJsonObject(), kind,
+                          list.positions.value(group), rowCount);
+        }
+      }
+    }
+    const TrackedList& moduleRows = tracked.lists[moduleList];
+    for (Module* module : plan->getModules()) {
+      if (success && moduleRows.placed.contains(module)) {
+        success = insertModule(planKey, module->toJsonObject(),
+                               moduleRows.positions.value(module), rowCount);
+      }
+    }
+
+    // Inserted rows already contain the current data
+    for (Group* group : tracked.groups) {
+      if (success && group != nullptr &&
+          !tracked.lists[groupKind].placed.contains(group) &&
+          !tracked.lists[constraintKind].placed.contains(group)) {
+        success = writeGroup(planId, group, rowCount);
+      }
+    }
+    for (Module* module : tracked.modules) {
+      if (success && module != nullptr && !moduleRows.placed.contains(module)) {
+        success = writeModule(planId, module, rowCount);
+      }
+    }
+    for (Week* week : tracked.weeks) {
+      if (success && week != nullptr) {
+        success = exec("UPDATE weeks SET name = ? WHERE plan = ? AND id = ?",
+                       {week->getName(), planKey, toKey(week->getId())},
+                       rowCount);
+      }
+    }
+    for (Day* day : tracked.days) {
+      if (success && day != nullptr) {
+        success = exec("UPDATE days SET name = ? WHERE plan = ? AND id = ?",
+                       {day->getName(), planKey, toKey(day->getId())},
+                       rowCount);
+      }
+    }
+    for (Timeslot* timeslot : tracked.timeslots) {
+      if (success && timeslot != nullptr) {
+        success = exec(
+            "UPDATE timeslots SET name = ? WHERE plan = ? AND id = ?",
+            {timeslot->getName(), toKey(planId), toKey(timeslot->getId())},
+            rowCount);
+      }
+    }
+    for (Timeslot* timeslot : tracked.assignments) {
+      if (success && timeslot != nullptr) {
+        success = writeTimeslotIds("assignments", "module", planKey,
+                                   toKey(timeslot->getId()),
+                                   toIds(timeslot->getModules()), rowCount);
+      }
+    }
+    for (Timeslot* timeslot : tracked.availability) {
+      if (success && timeslot != nullptr) {
+        success = writeTimeslotIds("availability", "groupId", planKey,
+                                   toKey(timeslot->getId()),
+                                   toIds(timeslot->getActiveGroups()),
+                                   rowCount);
+      }
+    }
+  }
+
+  if (!success || !database.commit()) {
+    if (success) {
+      lastError = database.lastError().text();
+    }
+    // The changes stay marked for the next flush
+    database.rollback();
+    return false;
+  }
+  for (TrackedPlan& tracked : trackedPlans) {
+    clearChanges(tracked);
+  }
+  emit flushed(rowCount);
+  return true;
+}
+
+bool PlanDatabase::createTables() {
+  for (const QString& statement : tableStatements) {
+    if (!exec(statement)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PlanDatabase::exec(const QString& statement, const QVariantList& values) {
+  int rowCount = 0;
+  return exec(statement, values, rowCount);
+}
+
+bool PlanDatabase::exec(const QString& statement,
+                        const QVariantList& values,
+                        int& rowCount) {
+  QSqlQuery query(database);
+  if (!query.prepare(statement)) {
+    lastError = query.lastError().text();
+    return false;
+  }
+  for (const QVariant& value : values) {
+    query.addBindValue(value);
+  }
+  if (!query.exec()) {
+    lastError = query.lastError().text();
+    return false;
+  }
+  rowCount += qMax(0, query.numRowsAffected());
+  return true;
+}
+
+bool PlanDatabase::writePlan(const QJsonObject& content,
+                             const QUuid& semesterId,
+                             int position,
+                             int& rowCount) {
+  QUuid planId(content.value("id").toString());
+  QString planKey = toKey(planId);
+  if (!deletePlan(planId) ||
+      !exec("INSERT INTO plans VALUES (?, ?, ?, ?)",
+            {planKey, toKey(semesterId), position,
+             content.value("name").toString()},
+            rowCount)) {
+    return false;
+  }
+
+  const QString groupLists[2] = {"groups", "constraints"};
+  for (int kind : {groupKind, constraintKind}) {
+    QJsonArray groups = content.value(groupLists[kind]).toArray();
+    for (int i = 0; i < groups.size(); i++) {
+      if (!insertGroup(planKey, groups[i].toObject(), kind, i, rowCount)) {
+        return false;
+      }
+    }
+  }
+
+  QJsonArray modules = content.value("modules").toArray();
+  for (int i = 0; i < modules.size(); i++) {
+    if (!insertModule(planKey, modules[i].toObject(), i, rowCount)) {
+      return false;
+    }
+  }
+
+  QJsonArray weeks = content.value("weeks").toArray();
+  for (int w = 0; w < weeks.size(); w++) {
+    QJsonObject week = weeks[w].toObject();
+    QString weekKey = toKey(week.value("id"));
+    if (!exec("INSERT INTO weeks VALUES (?, ?, ?, ?)",
+              {weekKey, planKey, w, week.value("name").toString()},
+              rowCount)) {
+      return false;
+    }
+    QJsonArray days = week.value("days").toArray();
+    for (int d = 0; d < days.size(); d++) {
+      QJsonObject day = days[d].toObject();
+      QString dayKey = toKey(day.value("id"));
+      if (!exec("INSERT INTO days VALUES (?, ?, ?, ?, ?)",
+                {dayKey, planKey, weekKey, d, day.value("name").toString()},
+                rowCount)) {
+        return false;
+      }
+      QJsonArray timeslots = day.value("timeslots").toArray();
+      for (int t = 0; t < timeslots.size(); t++) {
+        QJsonObject timeslot = timeslots[t].toObject();
+        QString timeslotKey = toKey(timeslot.value("id"));
+        if (!exec("INSERT INTO timeslots VALUES (?, ?, ?, ?, ?)",
+                  {timeslotKey, planKey, dayKey, t,
+                   timeslot.value("name").toString()},
+                  rowCount) ||
+            !writeTimeslotIds("assignments", "module", planKey, timeslotKey,
+                              toIds(timeslot.value("modules").toArray()),
+                              rowCount) ||
+            !writeTimeslotIds("availability", "groupId", planKey,
+                              timeslotKey,
+                              toIds(timeslot.value("activeGroups").toArray()),
+                              rowCount)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool PlanDatabase::deletePlan(const QUuid& id) {
+  QString planKey = toKey(id);
+  for (const QString& table : planTables) {
+    if (!exec("DELETE FROM " + table + " WHERE plan = ?", {planKey})) {
+      return false;
+    }
+  }
+  return exec("DELETE FROM plans WHERE id = ?", {planKey});
+}
+
+bool PlanDatabase::insertGroup(const QString& planKey,
+                               const QJsonObject& content,
+                               int kind,
+                               int position,
+                               int& rowCount) {
+  return exec("INSERT OR REPLACE INTO planGroups VALUES (?, ?, ?, ?, ?)",
+              {toKey(content.value("id")), planKey, kind, position,
+               toData(content)},
+              rowCount);
+}
+
+bool PlanDatabase::insertModule(const QString& planKey,
+                                const QJsonObject& content,
+                                int position,
+                                int& rowCount) {
+  return exec("INSERT OR REPLACE INTO modules VALUES (?, ?, ?, ?)",
+              {toKey(content.value("id")), planKey, position,
+               toData(content)},
+              rowCount);
+}
+
+bool PlanDatabase::writeGroup(const QUuid& planId,
+                              Group* group,
+                              int& rowCount) {
+  return exec("UPDATE planGroups SET data = ? WHERE plan = ? AND id = ?",
+              {toData(group->toJsonObject()), toKey(planId),
+               toKey(group->getId())},
+              rowCount);
+}
+
+bool PlanDatabase::writeModule(const QUuid& planId,
+                               Module* module,
+                               int& rowCount) {
+  return exec("UPDATE modules SET data = ? WHERE plan = ? AND id = ?",
+              {toData(module->toJsonObject()), toKey(planId),
+               toKey(module->getId())},
+              rowCount);
+}
+
+bool PlanDatabase::writeTimeslotIds(const QString& table,
+                                    const QString& column,
+                                    const QString& planKey,
+                                    const QString& timeslotKey,
+                                    const QList<QUuid>& ids,
+                                    int& rowCount) {
+  if (!exec("DELETE FROM " + table + " WHERE plan = ? AND timeslot = ?",
+            {planKey, timeslotKey}, rowCount)) {
+    return false;
+  }
+  QString statement = "INSERT OR REPLACE INTO " + table + " (timeslot, " +
+                      column + ", plan, position) VALUES (?, ?, ?, ?)";
+  for (int i = 0; i < ids.size(); i++) {
+    if (!exec(statement, {timeslotKey, toKey(ids[i]), planKey, i},
+              rowCount)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+QJsonObject PlanDatabase::readPlan(const QUuid& id) const {
+  QString planKey = toKey(id);
+  QSqlQuery query(database);
+  query.prepare("SELECT name FROM plans WHERE id = ?");
+  query.addBindValue(planKey);
+  if (!query.exec() || !query.next()) {
+    return QJsonObject();
+  }
+  QJsonObject content;
+  content.insert("id", planKey);
+  content.insert("name", query.value(0).toString());
+
+  QJsonArray groupArrays[2];
+  query.prepare(
+      "SELECT kind, data FROM planGroups WHERE plan = ? "
+      "ORDER BY kind, position");
+  query.addBindValue(planKey);
+  if (query.exec()) {
+    while (query.next()) {
+      int kind = query.value(0).toInt() == constraintKind ? constraintKind
+                                                          : groupKind;
+      groupArrays[kind].append(fromData(query.value(1).toString()));
+    }
+  }
+  content.insert("groups", groupArrays[groupKind]);
+  content.insert("constraints", groupArrays[constraintKind]);
+
+  QJsonArray modules;
+  query.prepare("SELECT data FROM modules WHERE plan = ? ORDER BY position");
+  query.addBindValue(planKey);
+  if (query.exec()) {
+    while (query.next()) {
+      modules.append(fromData(query.value(0).toString()));
+    }
+  }
+  content.insert("modules", modules);
+
+  // Children are collected by the id of their parent, every query is sorted
+  // by position, so appending keeps the order
+  auto readChildren = [&query, &planKey](const QString& statement) {
+    QHash<QString, QJsonArray> children;
+    query.prepare(statement);
+    query.addBindValue(planKey);
+    if (query.exec()) {
+      while (query.next()) {
+        children[query.value(0).toString()].append(query.value(1).toString());
+      }
+    }
+    return children;
+  };
+  QHash<QString, QJsonArray> assignments = readChildren(
+      "SELECT timeslot, module FROM assignments WHERE plan = ? "
+      "ORDER BY position");
+  QHash<QString, QJsonArray> availability = readChildren(
+      "SELECT timeslot, groupId FROM availability WHERE plan = ? "
+      "ORDER BY position");
+
+  QHash<QString, QJsonArray> timeslots;
+  query.prepare(
+      "SELECT id, day, name FROM timeslots WHERE plan = ? ORDER BY position");
+  query.addBindValue(planKey);
+  if (query.exec()) {
+    while (query.next()) {
+      QString timeslotKey = query.value(0).toString();
+      QJsonObject timeslot;
+      timeslot.insert("id", timeslotKey);
+      timeslot.insert("name", query.value(2).toString());
+      timeslot.insert("modules", assignments.value(timeslotKey));
+      timeslot.insert("activeGroups", availability.value(timeslotKey));
+      timeslots[query.value(1).toString()].append(timeslot);
+    }
+  }
+
+  QHash<QString, QJsonArray> days;
+  query.prepare(
+      "SELECT id, week, name FROM days WHERE plan = ? ORDER BY position");
+  query.addBindValue(planKey);
+  if (query.exec()) {
+    while (query.next()) {
+      QString dayKey = query.value(0).toString();
+      QJsonObject day;
+      day.insert("id", dayKey);
+      day.insert("name", query.value(2).toString());
+      day.insert("timeslots", timeslots.value(dayKey));
+      days[query.value(1).toString()].append(day);
+    }
+  }
+
+  QJsonArray weeks;
+  query.prepare("SELECT id, name FROM weeks WHERE plan = ? ORDER BY position");
+  query.addBindValue(planKey);
+  if (query.exec()) {
+    while (query.next()) {
+      QString weekKey = query.value(0).toString();
+      QJsonObject week;
+      week.insert("id", weekKey);
+      week.insert("name", query.value(1).toString());
+      week.insert("days", days.value(weekKey));
+      weeks.append(week);
+    }
+  }
+  content.insert("weeks", weeks);
+  return content;
+}
+
+// Every change looks up the plan again, as trackedPlans may have been changed
+// since the connection was made
+template <typename Update>
+auto PlanDatabase::mark(Plan* plan, Update update) {
+  return [this, plan, update]() {
+    auto iterator = trackedPlans.find(plan);
+    if (iterator == trackedPlans.end()) {
+      return;
+    }
+    update(*iterator);
+    changed();
+  };
+}
+
+QMetaObject::Connection PlanDatabase::connectContent(Plan* plan,
+                                                     Group* group) {
+  return connect(group, &Group::contentHashChanged, this,
+                 mark(plan, [group](TrackedPlan& changes) {
+                   changes.groups.insert(group, group);
+                 }));
+}
+
+QMetaObject::Connection PlanDatabase::connectContent(Plan* plan,
+                                                     Module* module) {
+  return connect(module, &Module::contentHashChanged, this,
+                 mark(plan, [module](TrackedPlan& changes) {
+                   changes.modules.insert(module, module);
+                 }));
+}
+
+template <typename T>
+bool PlanDatabase::updateList(TrackedPlan& tracked,
+                              int list,
+                              const QList<T*>& current) {
+  TrackedList& rows = tracked.lists[list];
+  QSet<QObject*> currentSet;
+  currentSet.reserve(current.size());
+  for (T* object : current) {
+    if (object != nullptr) {
+      currentSet.insert(object);
+    }
+  }
+
+  bool updated = false;
+  for (QObject* object : rows.known) {
+    if (!currentSet.contains(object)) {
+      // The object may already be deleted, so only its address is used
+      rows.removed.insert(rows.ids.take(object));
+      rows.positions.remove(object);
+      rows.placed.remove(object);
+      disconnect(rows.connections.take(object));
+      updated = true;
+    }
+  }
+
+  // New objects and objects, that are out of order, get the position after
+  // the row before them
+  rows.known.clear();
+  int last = -1;
+  for (T* object : current) {
+    if (object == nullptr) {
+      continue;
+    }
+    if (!rows.ids.contains(object)) {
+      rows.ids.insert(object, object->getId());
+      rows.connections.insert(object,
+                              connectContent(tracked.plan.data(), object));
+    }
+    rows.known.append(object);
+    auto position = rows.positions.constFind(object);
+    if (position != rows.positions.constEnd() && *position > last) {
+      last = *position;
+    } else {
+      rows.positions.insert(object, ++last);
+      rows.placed.insert(object);
+      updated = true;
+    }
+  }
+  return updated;
+}
+
+void PlanDatabase::connectPlan(TrackedPlan& tracked) {
+  Plan* plan = tracked.plan.data();
+  if (plan == nullptr) {
+    return;
+  }
+
+  auto update = [this, plan](int list, const auto& current) {
+    auto iterator = trackedPlans.find(plan);
+    if (iterator != trackedPlans.end() &&
+        updateList(*iterator, list, current)) {
+      changed();
+    }
+  };
+
+  QList<QMetaObject::Connection>& connections = tracked.connections;
+  connections.append(connect(plan, &QObject::destroyed, this,
+                             [this, plan]() { untrack(plan); }));
+  connections.append(
+      connect(plan, &Plan::nameChanged, this,
+              mark(plan, [](TrackedPlan& changes) {
+                changes.nameChanged = true;
+              })));
+  connections.append(connect(
+      plan, &Plan::groupsChanged, this,
+      [update](const QList<Group*> groups) { update(groupKind, groups); }));
+  connections.append(connect(plan, &Plan::constraintsChanged, this,
+                             [update](const QList<Group*> constraints) {
+                               update(constraintKind, constraints);
+                             }));
+  connections.append(connect(
+      plan, &Plan::modulesChanged, this,
+      [update](const QList<Module*> modules) { update(moduleList, modules); }));
+
+  updateList(tracked, groupKind, plan->getGroups());
+  updateList(tracked, constraintKind, plan->getConstraints());
+  updateList(tracked, moduleList, plan->getModules());
+  // The rows of the current lists are written by saving the plan
+  for (TrackedList& list : tracked.lists) {
+    list.placed.clear();
+  }
+  connectWeeks(tracked);
+}
+
+void PlanDatabase::connectWeeks(TrackedPlan& tracked) {
+  Plan* plan = tracked.plan.data();
+  if (plan == nullptr) {
+    return;
+  }
+
+  // New or removed weeks, days or timeslots need new connections, so they
+  // are reconnected
+  auto structure = [this, plan]() {
+    auto iterator = trackedPlans.find(plan);
+    if (iterator == trackedPlans.end()) {
+      return;
+    }
+    disconnectWeeks(*iterator);
+    connectWeeks(*iterator);
+    iterator->structureChanged = true;
+    changed();
+  };
+
+  QList<QMetaObject::Connection>& connections = tracked.weekConnections;
+  connections.append(connect(plan, &Plan::weeksChanged, this, structure));
+  for (Week* week : plan->getWeeks()) {
+    if (week == nullptr) {
+      continue;
+    }
+    connections.append(connect(week, &Week::nameChanged, this,
+                               mark(plan, [week](TrackedPlan& changes) {
+                                 changes.weeks.insert(week, week);
+                               })));
+    connections.append(connect(week, &Week::daysChanged, this, structure));
+    for (Day* day : week->getDays()) {
+      if (day == nullptr) {
+        continue;
+      }
+      connections.append(connect(day, &Day::nameChanged, this,
+                                 mark(plan, [day](TrackedPlan& changes) {
+                                   changes.days.insert(day, day);
+                                 })));
+      connections.append(
+          connect(day, &Day::timeslotsChanged, this, structure));
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        if (timeslot == nullptr) {
+          continue;
+        }
+        connections.append(connect(timeslot, &Timeslot::nameChanged, this,
+                                   mark(plan, [timeslot](TrackedPlan& changes) {
+                                     changes.timeslots.insert(timeslot,
+                                                              timeslot);
+                                   })));
+        connections.append(connect(timeslot, &Timeslot::modulesChanged, this,
+                                   mark(plan, [timeslot](TrackedPlan& changes) {
+                                     changes.assignments.insert(timeslot,
+                                                                timeslot);
+                                   })));
+        connections.append(
+            connect(timeslot, &Timeslot::activeGroupsChanged, this,
+                    mark(plan, [timeslot](TrackedPlan& changes) {
+                      changes.availability.insert(timeslot, timeslot);
+                    })));
+      }
+    }
+  }
+}
+
+void PlanDatabase::disconnectPlan(TrackedPlan& tracked) {
+  for (const QMetaObject::Connection& connection : tracked.connections) {
+    disconnect(connection);
+  }
+  tracked.connections.clear();
+  for (TrackedList& list : tracked.lists) {
+    for (const QMetaObject::Connection& connection : list.connections) {
+      disconnect(connection);
+    }
+    list = TrackedList();
+  }
+  disconnectWeeks(tracked);
+}
+
+void PlanDatabase::disconnectWeeks(TrackedPlan& tracked) {
+  for (const QMetaObject::Connection& connection : tracked.weekConnections) {
+    disconnect(connection);
+  }
+  tracked.weekConnections.clear();
+}
+
+void PlanDatabase::readPositions(TrackedPlan& tracked) {
+  Plan* plan = tracked.plan.data();
+  if (plan == nullptr) {
+    return;
+  }
+
+  // Groups and constraints share the planGroups table
+  QHash<QUuid, int> stored[2];
+  const QString tables[2] = {"planGroups", "modules"};
+  QSqlQuery query(database);
+  for (int table : {0, 1}) {
+    query.prepare("SELECT id, position FROM " + tables[table] +
+                  " WHERE plan = ?");
+    query.addBindValue(toKey(plan->getId()));
+    if (query.exec()) {
+      while (query.next()) {
+        stored[table].insert(QUuid(query.value(0).toString()),
+                             query.value(1).toInt());
+      }
+    }
+  }
+
+  // Rows, that are missing or out of order, are fixed by rewriting the plan
+  for (int list : {groupKind, constraintKind, moduleList}) {
+    TrackedList& rows = tracked.lists[list];
+    const QHash<QUuid, int>& positions = stored[list == moduleList ? 1 : 0];
+    int last = -1;
+    for (QObject* object : rows.known) {
+      auto position = positions.constFind(rows.ids.value(object));
+      if (position == positions.constEnd() || *position <= last) {
+        tracked.structureChanged = true;
+        changed();
+        return;
+      }
+      last = *position;
+      rows.positions.insert(object, last);
+    }
+  }
+}
+
+void PlanDatabase::resetPositions(TrackedPlan& tracked) {
+  Plan* plan = tracked.plan.data();
+  if (plan == nullptr) {
+    return;
+  }
+
+  // writePlan uses the indexes in the lists as positions
+  QList<Group*> groupLists[2] = {plan->getGroups(), plan->getConstraints()};
+  for (int kind : {groupKind, constraintKind}) {
+    QHash<QObject*, int>& positions = tracked.lists[kind].positions;
+    positions.clear();
+    for (int i = 0; i < groupLists[kind].size(); i++) {
+      if (groupLists[kind][i] != nullptr) {
+        positions.insert(groupLists[kind][i], i);
+      }
+    }
+  }
+  QList<Module*> modules = plan->getModules();
+  QHash<QObject*, int>& positions = tracked.lists[moduleList].positions;
+  positions.clear();
+  for (int i = 0; i < modules.size(); i++) {
+    if (modules[i] != nullptr) {
+      positions.insert(modules[i], i);
+    }
+  }
+}
+
+void PlanDatabase::clearChanges(TrackedPlan& tracked) {
+  tracked.structureChanged = false;
+  tracked.nameChanged = false;
+  tracked.groups.clear();
+  tracked.modules.clear();
+  tracked.weeks.clear();
+  tracked.days.clear();
+  tracked.timeslots.clear();
+  tracked.assignments.clear();
+  tracked.availability.clear();
+  for (TrackedList& list : tracked.lists) {
+    list.removed.clear();
+    list.placed.clear();
+  }
+}
+
+void PlanDatabase::changed() {
+  // The timer is not restarted, so continuous changes are still written at
+  // most one interval after the first of them
+  if (flushInterval >= 0 && isOpen() && !flushTimer.isActive()) {
+    flushTimer.start(flushInterval);
+  }
+}
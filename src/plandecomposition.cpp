@@ -0,0 +1,266 @@
+#include <conflictgraph.h>
+#include <plancsvhelper.h>
+#include <plandecomposition.h>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QProcess>
+#include <QScopedPointer>
+#include <QSet>
+#include <QSharedPointer>
+#include <QUuid>
+#include <QtConcurrent/QtConcurrentMap>
+
+namespace {
+QJsonArray filterObjects(const QJsonArray& objects, const QSet<QUuid>& ids) {
+  QJsonArray result;
+  for (const QJsonValue& object : objects) {
+    if (ids.contains(QUuid(object.toObject().value("id").toString()))) {
+      result.append(object);
+    }
+  }
+  return result;
+}
+
+QJsonArray filterIds(const QJsonArray& references, const QSet<QUuid>& ids) {
+  QJsonArray result;
+  for (const QJsonValue& reference : references) {
+    if (ids.contains(QUuid(reference.toString()))) {
+      result.append(reference);
+    }
+  }
+  return result;
+}
+
+// How often a running process checks if the schedule was canceled
+const int cancelCheckInterval = 100;
+
+/**
+ *  Runs the scheduling program for one part. QtConcurrent in Qt 5 needs a
+ * result_type for functors.
+ */
+struct PartRun {
+  typedef bool result_type;
+
+  QString program;
+  QStringList arguments;
+  int timeout;
+  QFutureInterface<bool> futureInterface;
+
+  bool operator()(const QString& path) const {
+    if (futureInterface.isCanceled()) {
+      return false;
+    }
+    QStringList partArguments;
+    for (const QString& argument : arguments) {
+      partArguments.append(QString(argument).replace("{path}", path));
+    }
+
+    QProcess process;
+    process.setWorkingDirectory(path);
+    process.setStandardOutputFile(QProcess::nullDevice());
+    process.setStandardErrorFile(QProcess::nullDevice());
+    process.start(program, partArguments);
+    if (!process.waitForStarted()) {
+      return false;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    while (!process.waitForFinished(cancelCheckInterval) &&
+           process.state() != QProcess::NotRunning) {
+      if (futureInterface.isCanceled() ||
+          (timeout >= 0 && timer.hasExpired(timeout))) {
+        process.kill();
+        process.waitForFinished();
+        return false;
+      }
+    }
+    return process.exitStatus() == QProcess::NormalExit &&
+           process.exitCode() == 0;
+  }
+};
+}  // namespace
+
+PlanDecomposition::PlanDecomposition(Plan* plan) : plan(plan) {
+  if (plan == nullptr) {
+    return;
+  }
+
+  QList<Module*> modules = plan->getModules();
+  QHash<Group*, QVector<int>> groupModules;
+  for (int i = 0; i < modules.size(); i++) {
+    QList<Group*> groups =
+        modules[i]->getGroups() + modules[i]->getConstraints();
+    if (groups.isEmpty()) {
+      // Modules without groups and constraints share the part of nullptr
+      groups.append(nullptr);
+    }
+    for (Group* group : groups) {
+      QVector<int>& members = groupModules[group];
+      if (members.isEmpty() || members.last() != i) {
+        members.append(i);
+      }
+    }
+  }
+
+  QVector<int> components;
+  int partCount =
+      ConflictGraph::findComponents(modules.size(), groupModules, components);
+  for (int i = 0; i < partCount; i++) {
+    parts.append(QList<Module*>());
+  }
+  for (int i = 0; i < modules.size(); i++) {
+    parts[components[i]].append(modules[i]);
+  }
+}
+
+int PlanDecomposition::getPartCount() const {
+  return parts.size();
+}
+
+QList<Module*> PlanDecomposition::getModules(int part) const {
+  return parts.value(part);
+}
+
+Plan* PlanDecomposition::createPartPlan(int part, QObject* parent) const {
+  if (plan.isNull() || part < 0 || part >= parts.size()) {
+    return nullptr;
+  }
+
+  QSet<QUuid> moduleIds;
+  QSet<QUuid> groupIds;
+  for (Module* module : parts[part]) {
+    moduleIds.insert(module->getId());
+    for (Group* group : module->getGroups() + module->getConstraints()) {
+      groupIds.insert(group->getId());
+    }
+  }
+
+  QJsonObject content = plan->toJsonObject();
+  content["modules"] = filterObjects(content["modules"].toArray(), moduleIds);
+  content["groups"] = filterObjects(content["groups"].toArray(), groupIds);
+  content["constraints"] =
+      filterObjects(content["constraints"].toArray(), groupIds);
+
+  QJsonArray weeks;
+  for (const QJsonValue& weekValue : content["weeks"].toArray()) {
+    QJsonObject week = weekValue.toObject();
+    QJsonArray days;
+    for (const QJsonValue& dayValue : week["days"].toArray()) {
+      QJsonObject day = dayValue.toObject();
+      QJsonArray timeslots;
+      for (const QJsonValue& timeslotValue : day["timeslots"].toArray()) {
+        QJsonObject timeslot = timeslotValue.toObject();
+        timeslot["modules"] =
+            filterIds(timeslot["modules"].toArray(), moduleIds);
+        timeslot["activeGroups"] =
+            filterIds(timeslot["activeGroups"].toArray(), groupIds);
+        timeslots.append(timeslot);
+      }
+      day["timeslots"] = timeslots;
+      days.append(day);
+    }
+    week["days"] = days;
+    weeks.append(week);
+  }
+  content["weeks"] = weeks;
+
+  Plan* partPlan = new Plan(parent);
+  partPlan->fromJsonObject(content);
+  return partPlan;
+}
+
+QString PlanDecomposition::getPartPath(const QString& path, int part) {
+  return path + "/part-" + QString::number(part);
+}
+
+bool PlanDecomposition::writePlans(const QString& path) const {
+  if (plan.isNull()) {
+    return false;
+  }
+  for (int i = 0; i < parts.size(); i++) {
+    QString partPath = getPartPath(path, i);
+    if (!QDir().mkpath(partPath)) {
+      return false;
+    }
+    QScopedPointer<Plan> partPlan(createPartPlan(i));
+    PlanCsvHelper helper(partPath);
+    if (!helper.writePlan(partPlan.data())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PlanDecomposition::readSchedules(const QString& path) const {
+  if (plan.isNull()) {
+    return false;
+  }
+  QList<QSharedPointer<PlanCsvHelper>> helpers;
+  QList<PlanCsvHelper*> helperPointers;
+  for (int i = 0; i < parts.size(); i++) {
+    helpers.append(
+        QSharedPointer<PlanCsvHelper>(new PlanCsvHelper(getPartPath(path, i))));
+    helperPointers.append(helpers.last().data());
+  }
+  return PlanCsvHelper::readSchedules(helperPointers, plan.data());
+}
+
+QFuture<bool> PlanDecomposition::schedule(const QString& path,
+                                          const QString& program,
+                                          const QStringList& arguments,
+                                          int timeout) const {
+  QFutureInterface<bool> futureInterface;
+  futureInterface.setProgressRange(0, parts.size());
+  futureInterface.reportStarted();
+  if (!writePlans(path)) {
+    futureInterface.reportResult(false);
+    futureInterface.reportFinished();
+    return futureInterface.future();
+  }
+
+  QStringList partPaths;
+  for (int i = 0; i < parts.size(); i++) {
+    partPaths.append(getPartPath(path, i));
+    // Only results of the new runs may be merged. writePlan writes the
+    // current schedule of the part as result file.
+    QFile::remove(partPaths.last() + "/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv");
+  }
+
+  // The decomposition may be destroyed before the runs finish
+  PlanDecomposition decomposition(*this);
+  auto* watcher = new QFutureWatcher<bool>();
+  QObject::connect(watcher, &QFutureWatcher<bool>::progressValueChanged,
+                   watcher, [futureInterface](int progress) mutable {
+                     futureInterface.setProgressValue(progress);
+                   });
+  QObject::connect(
+      watcher, &QFutureWatcher<bool>::finished, watcher,
+      [watcher, futureInterface, decomposition, path]() mutable {
+        watcher->deleteLater();
+        if (futureInterface.isCanceled()) {
+          futureInterface.reportFinished();
+          return;
+        }
+        bool success = true;
+        for (bool result : watcher->future().results()) {
+          success = success && result;
+        }
+        success = success && decomposition.readSchedules(path);
+        futureInterface.reportResult(success);
+        futureInterface.reportFinished();
+      });
+
+  PartRun run;
+  run.program = program;
+  run.arguments = arguments;
+  run.timeout = timeout;
+  run.futureInterface = futureInterface;
+  watcher->setFuture(QtConcurrent::mapped(partPaths, run));
+  return futureInterface.future();
+}
@@ -0,0 +1,185 @@
+#include <planitemmodels.h>
+
+ModuleListModel::ModuleListModel(Plan* plan, QObject* parent)
+    : ObjectListModel(&Module::staticMetaObject, parent) {
+  if (plan == nullptr) {
+    return;
+  }
+  setObjects(plan->getModules());
+  connect(plan, &Plan::modulesChanged, this,
+          [this](const QList<Module*> modules) { setObjects(modules); });
+}
+
+ModuleListModel::ModuleListModel(Timeslot* timeslot, QObject* parent)
+    : ObjectListModel(&Module::staticMetaObject, parent) {
+  if (timeslot == nullptr) {
+    return;
+  }
+  setObjects(timeslot->getModules());
+  connect(timeslot, &Timeslot::modulesChanged, this,
+          [this](const QList<Module*> modules) { setObjects(modules); });
+}
+
+GroupListModel::GroupListModel(Plan* plan, Source source, QObject* parent)
+    : ObjectListModel(&Group::staticMetaObject, parent) {
+  if (plan == nullptr) {
+    return;
+  }
+  auto update = [this](const QList<Group*> groups) { setObjects(groups); };
+  if (source == Constraints) {
+    setObjects(plan->getConstraints());
+    connect(plan, &Plan::constraintsChanged, this, update);
+  } else {
+    setObjects(plan->getGroups());
+    connect(plan, &Plan::groupsChanged, this, update);
+  }
+}
+
+TimeslotTableModel::TimeslotTableModel(Plan* plan, QObject* parent)
+    : QAbstractTableModel(parent), plan(plan), columns(0) {
+  rebuild();
+}
+
+int TimeslotTableModel::rowCount(const QModelIndex& parent) const {
+  if (parent.isValid()) {
+    return 0;
+  }
+  return days.size();
+}
+
+int TimeslotTableModel::columnCount(const QModelIndex& parent) const {
+  if (parent.isValid()) {
+    return 0;
+  }
+  return columns;
+}
+
+QVariant TimeslotTableModel::data(const QModelIndex& index, int role) const {
+  Timeslot* timeslot = getTimeslot(index.row(), index.column());
+  if (timeslot == nullptr) {
+    return QVariant();
+  }
+  switch (role) {
+    case Qt::DisplayRole:
+    case NameRole:
+      return timeslot->getName();
+    case TimeslotRole:
+      return QVariant::fromValue(timeslot);
+    case ModulesRole:
+      return QVariant::fromValue(timeslot->getModules());
+    case ModuleCountRole:
+      return timeslot->getModules().size();
+    case ActiveGroupsRole:
+      return QVariant::fromValue(timeslot->getActiveGroups());
+    case DayRole:
+      return QVariant::fromValue(days[index.row()]);
+    case WeekRole:
+      return QVariant::fromValue(dayWeeks[index.row()]);
+    default:
+      return QVariant();
+  }
+}
+
+QVariant TimeslotTableModel::headerData(int section,
+                                        Qt::Orientation orientation,
+                                        int role) const {
+  if (role != Qt::DisplayRole) {
+    return QVariant();
+  }
+  if (orientation == Qt::Vertical) {
+    if (section < 0 || section >= days.size()) {
+      return QVariant();
+    }
+    return dayWeeks[section]->getName() + " " + days[section]->getName();
+  }
+  return section + 1;
+}
+
+QHash<int, QByteArray> TimeslotTableModel::roleNames() const {
+  return {{TimeslotRole, "timeslot"},
+          {NameRole, "name"},
+          {ModulesRole, "modules"},
+          {ModuleCountRole, "moduleCount"},
+          {ActiveGroupsRole, "activeGroups"},
+          {DayRole, "day"},
+          {WeekRole, "week"}};
+}
+
+Timeslot* TimeslotTableModel::getTimeslot(int row, int column) const {
+  if (row < 0 || row >= days.size() || column < 0) {
+    return nullptr;
+  }
+  QList<Timeslot*> timeslots = days[row]->getTimeslots();
+  if (column >= timeslots.size()) {
+    return nullptr;
+  }
+  return timeslots[column];
+}
+
+QModelIndex TimeslotTableModel::indexOf(Timeslot* timeslot) const {
+  auto iterator = cells.constFind(timeslot);
+  if (iterator == cells.constEnd()) {
+    return QModelIndex();
+  }
+  return index(iterator->first, iterator->second);
+}
+
+void TimeslotTableModel::rebuild() {
+  beginResetModel();
+  disconnectAll();
+  days.clear();
+  dayWeeks.clear();
+  cells.clear();
+  columns = 0;
+  if (plan.isNull()) {
+    endResetModel();
+    return;
+  }
+
+  connections.append(connect(plan, &Plan::weeksChanged, this,
+                             &TimeslotTableModel::rebuild));
+  for (Week* week : plan->getWeeks()) {
+    connections.append(
+        connect(week, &Week::daysChanged, this, &TimeslotTableModel::rebuild));
+    for (Day* day : week->getDays()) {
+      connections.append(connect(day, &Day::timeslotsChanged, this,
+                                 &TimeslotTableModel::rebuild));
+      QList<Timeslot*> timeslots = day->getTimeslots();
+      for (int column = 0; column < timeslots.size(); column++) {
+        Timeslot* timeslot = timeslots[column];
+        cells.insert(timeslot, qMakePair(days.size(), column));
+        connections.append(connect(
+            timeslot, &Timeslot::modulesChanged, this, [this, timeslot]() {
+              emitChanged(timeslot, {ModulesRole, ModuleCountRole});
+            }));
+        connections.append(connect(timeslot, &Timeslot::activeGroupsChanged,
+                                   this, [this, timeslot]() {
+                                     emitChanged(timeslot, {ActiveGroupsRole});
+                                   }));
+        connections.append(connect(
+            timeslot, &Timeslot::nameChanged, this, [this, timeslot]() {
+              emitChanged(timeslot, {Qt::DisplayRole, NameRole});
+            }));
+      }
+      columns = qMax(columns, timeslots.size());
+      days.append(day);
+      dayWeeks.append(week);
+    }
+  }
+  endResetModel();
+}
+
+void TimeslotTableModel::disconnectAll() {
+  for (const QMetaObject::Connection& connection : connections) {
+    disconnect(connection);
+  }
+  connections.clear();
+}
+
+void TimeslotTableModel::emitChanged(Timeslot* timeslot,
+                                     const QVector<int>& roles) {
+  QModelIndex cell = indexOf(timeslot);
+  if (cell.isValid()) {
+    emit dataChanged(cell, cell, roles);
+  }
+}
@@ -0,0 +1,391 @@
+#include <planview.h>
+
+namespace {
+template <typename T>
+QList<QUuid> toIds(const QList<T*>& objects) {
+  QList<QUuid> ids;
+  ids.reserve(objects.size());
+  for (T* object : objects) {
+    if (object != nullptr) {
+      ids.append(object->getId());
+    }
+  }
+  return ids;
+}
+
+/**
+ *  The list hashes of a plan do not depend on the order, so reusing a list
+ * also needs the same ids in the same order
+ */
+template <typename View, typename T>
+bool hasSameIds(const QList<View>& views, const QList<T*>& objects) {
+  int index = 0;
+  for (T* object : objects) {
+    if (object == nullptr) {
+      continue;
+    }
+    if (index >= views.size() || views[index]->getId() != object->getId()) {
+      return false;
+    }
+    index++;
+  }
+  return index == views.size();
+}
+
+template <typename View>
+QList<View> findAll(const QHash<QUuid, View>& index, const QList<QUuid>& ids) {
+  QList<View> views;
+  for (const QUuid& id : ids) {
+    View view = index.value(id);
+    if (view != nullptr) {
+      views.append(view);
+    }
+  }
+  return views;
+}
+}  // namespace
+
+GroupView::GroupView(const Group* group)
+    : id(group->getId()),
+      name(group->getName()),
+      selected(group->getSelected()),
+      examsPerDay(group->getExamsPerDay()),
+      active(group->getActive()),
+      small(group->getSmall()),
+      obsolete(group->getObsolete()),
+      contentHash(group->getContentHash()) {}
+
+QUuid GroupView::getId() const {
+  return id;
+}
+
+QString GroupView::getName() const {
+  return name;
+}
+
+bool GroupView::getSelected() const {
+  return selected;
+}
+
+unsigned int GroupView::getExamsPerDay() const {
+  return examsPerDay;
+}
+
+bool GroupView::getActive() const {
+  return active;
+}
+
+bool GroupView::getSmall() const {
+  return small;
+}
+
+bool GroupView::getObsolete() const {
+  return obsolete;
+}
+
+quint64 GroupView::getContentHash() const {
+  return contentHash;
+}
+
+ModuleView::ModuleView(const Module* module)
+    : id(module->getId()),
+      name(module->getName()),
+      origin(module->getOrigin()),
+      number(module->getNumber()),
+      active(module->getActive()),
+      examType(module->getExamType()),
+      examDuration(module->getExamDuration()),
+      pinned(module->getPinned()),
+      constraintIds(toIds(module->getConstraints())),
+      groupIds(toIds(module->getGroups())),
+      contentHash(module->getContentHash()) {}
+
+QUuid ModuleView::getId() const {
+  return id;
+}
+
+QString ModuleView::getName() const {
+  return name;
+}
+
+QString ModuleView::getOrigin() const {
+  return origin;
+}
+
+QString ModuleView::getNumber() const {
+  return number;
+}
+
+bool ModuleView::getActive() const {
+  return active;
+}
+
+QString ModuleView::getExamType() const {
+  return examType;
+}
+
+unsigned int ModuleView::getExamDuration() const {
+  return examDuration;
+}
+
+bool ModuleView::getPinned() const {
+  return pinned;
+}
+
+QList<QUuid> ModuleView::getConstraintIds() const {
+  return constraintIds;
+}
+
+QList<QUuid> ModuleView::getGroupIds() const {
+  return groupIds;
+}
+
+quint64 ModuleView::getContentHash() const {
+  return contentHash;
+}
+
+TimeslotView::TimeslotView(const Timeslot* timeslot)
+    : id(timeslot->getId()),
+      name(timeslot->getName()),
+      moduleIds(toIds(timeslot->getModules())),
+      activeGroupIds(toIds(timeslot->getActiveGroups())),
+      contentHash(timeslot->getContentHash()) {}
+
+QUuid TimeslotView::getId() const {
+  return id;
+}
+
+QString TimeslotView::getName() const {
+  return name;
+}
+
+QList<QUuid> TimeslotView::getModuleIds() const {
+  return moduleIds;
+}
+
+QList<QUuid> TimeslotView::getActiveGroupIds() const {
+  return activeGroupIds;
+}
+
+quint64 TimeslotView::getContentHash() const {
+  return contentHash;
+}
+
+DayView::DayView(const Day* day, const DayView* previous)
+    : id(day->getId()),
+      name(day->getName()),
+      contentHash(day->getContentHash()) {
+  QList<Timeslot*> liveTimeslots = day->getTimeslots();
+  for (int i = 0; i < liveTimeslots.size(); i++) {
+    Timeslot* timeslot = liveTimeslots[i];
+    if (timeslot == nullptr) {
+      continue;
+    }
+    TimeslotViewPointer old =
+        previous != nullptr ? previous->timeslots.value(i)
+                            : TimeslotViewPointer();
+    if (old != nullptr &&
+        old->getContentHash() == timeslot->getContentHash()) {
+      timeslots.append(old);
+    } else {
+      timeslots.append(TimeslotViewPointer(new TimeslotView(timeslot)));
+    }
+  }
+}
+
+QUuid DayView::getId() const {
+  return id;
+}
+
+QString DayView::getName() const {
+  return name;
+}
+
+QList<TimeslotViewPointer> DayView::getTimeslots() const {
+  return timeslots;
+}
+
+quint64 DayView::getContentHash() const {
+  return contentHash;
+}
+
+WeekView::WeekView(const Week* week, const WeekView* previous)
+    : id(week->getId()),
+      name(week->getName()),
+      contentHash(week->getContentHash()) {
+  QList<Day*> liveDays = week->getDays();
+  for (int i = 0; i < liveDays.size(); i++) {
+    Day* day = liveDays[i];
+    if (day == nullptr) {
+      continue;
+    }
+    DayViewPointer old =
+        previous != nullptr ? previous->days.value(i) : DayViewPointer();
+    if (old != nullptr && old->getContentHash() == day->getContentHash()) {
+      days.append(old);
+    } else {
+      days.append(DayViewPointer(new DayView(day, old.data())));
+    }
+  }
+}
+
+QUuid WeekView::getId() const {
+  return id;
+}
+
+QString WeekView::getName() const {
+  return name;
+}
+
+QList<DayViewPointer> WeekView::getDays() const {
+  return days;
+}
+
+quint64 WeekView::getContentHash() const {
+  return contentHash;
+}
+
+PlanViewPointer PlanView::create(const Plan* plan,
+                                 const PlanViewPointer& previous) {
+  if (plan == nullptr) {
+    return PlanViewPointer();
+  }
+  if (previous != nullptr &&
+      previous->getContentHash() == plan->getContentHash()) {
+    return previous;
+  }
+  return PlanViewPointer(new PlanView(plan, previous.data()));
+}
+
+PlanView::PlanView(const Plan* plan, const PlanView* previous)
+    : id(plan->getId()),
+      name(plan->getName()),
+      constraintsHash(plan->getConstraintsHash()),
+      groupsHash(plan->getGroupsHash()),
+      modulesHash(plan->getModulesHash()),
+      contentHash(plan->getContentHash()) {
+  QList<Group*> liveConstraints = plan->getConstraints();
+  QList<Group*> liveGroups = plan->getGroups();
+  bool sameConstraints = previous != nullptr &&
+                         previous->constraintsHash == constraintsHash &&
+                         hasSameIds(previous->constraints, liveConstraints);
+  bool sameGroups = previous != nullptr && previous->groupsHash == groupsHash &&
+                    hasSameIds(previous->groups, liveGroups);
+  if (sameConstraints && sameGroups) {
+    constraints = previous->constraints;
+    groups = previous->groups;
+    groupsById = previous->groupsById;
+  } else {
+    constraints = sameConstraints ? previous->constraints
+                                  : createGroups(liveConstraints, previous);
+    groups = sameGroups ? previous->groups : createGroups(liveGroups, previous);
+    groupsById.reserve(constraints.size() + groups.size());
+    for (const GroupViewPointer& view : constraints + groups) {
+      groupsById.insert(view->getId(), view);
+    }
+  }
+
+  QList<Module*> liveModules = plan->getModules();
+  if (previous != nullptr && previous->modulesHash == modulesHash &&
+      hasSameIds(previous->modules, liveModules)) {
+    modules = previous->modules;
+    modulesById = previous->modulesById;
+  } else {
+    modules.reserve(liveModules.size());
+    modulesById.reserve(liveModules.size());
+    for (Module* module : liveModules) {
+      if (module == nullptr) {
+        continue;
+      }
+      ModuleViewPointer old =
+          previous != nullptr ? previous->modulesById.value(module->getId())
+                              : ModuleViewPointer();
+      ModuleViewPointer view =
+          old != nullptr && old->getContentHash() == module->getContentHash()
+              ? old
+              : ModuleViewPointer(new ModuleView(module));
+      modules.append(view);
+      modulesById.insert(view->getId(), view);
+    }
+  }
+
+  QList<Week*> liveWeeks = plan->getWeeks();
+  for (int i = 0; i < liveWeeks.size(); i++) {
+    Week* week = liveWeeks[i];
+    if (week == nullptr) {
+      continue;
+    }
+    WeekViewPointer old =
+        previous != nullptr ? previous->weeks.value(i) : WeekViewPointer();
+    if (old != nullptr && old->getContentHash() == week->getContentHash()) {
+      weeks.append(old);
+    } else {
+      weeks.append(WeekViewPointer(new WeekView(week, old.data())));
+    }
+  }
+}
+
+QList<GroupViewPointer> PlanView::createGroups(const QList<Group*>& groups,
+                                               const PlanView* previous) {
+  QList<GroupViewPointer> views;
+  views.reserve(groups.size());
+  for (Group* group : groups) {
+    if (group == nullptr) {
+      continue;
+    }
+    GroupViewPointer old = previous != nullptr
+                               ? previous->groupsById.value(group->getId())
+                               : GroupViewPointer();
+    GroupViewPointer view =
+        old != nullptr && old->getContentHash() == group->getContentHash()
+            ? old
+            : GroupViewPointer(new GroupView(group));
+    views.append(view);
+  }
+  return views;
+}
+
+QUuid PlanView::getId() const {
+  return id;
+}
+
+QString PlanView::getName() const {
+  return name;
+}
+
+QList<GroupViewPointer> PlanView::getConstraints() const {
+  return constraints;
+}
+
+QList<GroupViewPointer> PlanView::getGroups() const {
+  return groups;
+}
+
+QList<ModuleViewPointer> PlanView::getModules() const {
+  return modules;
+}
+
+QList<WeekViewPointer> PlanView::getWeeks() const {
+  return weeks;
+}
+
+quint64 PlanView::getContentHash() const {
+  return contentHash;
+}
+
+GroupViewPointer PlanView::findGroup(const QUuid& id) const {
+  return groupsById.value(id);
+}
+
+ModuleViewPointer PlanView::findModule(const QUuid& id) const {
+  return modulesById.value(id);
+}
+
+QList<GroupViewPointer> PlanView::findGroups(const QList<QUuid>& ids) const {
+  return findAll(groupsById, ids);
+}
+
+QList<ModuleViewPointer> PlanView::findModules(
+    const QList<QUuid>& ids) const {
+  return findAll(modulesById, ids);
+}
@@ -0,0 +1,144 @@
+#include <plancsvhelper.h>
+#include <schedulecache.h>
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+// Changing the format of the exported files has to invalidate old results
+const QByteArray fingerprintVersion = "pruefungsplaner-schedule-cache-1";
+const QString resultSuffix = ".csv";
+// Hex encoded SHA-256
+const int fingerprintLength = 64;
+}  // namespace
+
+ScheduleCache::ScheduleCache()
+    : ScheduleCache(
+          QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+          "/schedules") {}
+
+ScheduleCache::ScheduleCache(const QString& path) : path(path) {}
+
+QString ScheduleCache::getPath() const {
+  return path;
+}
+
+QByteArray ScheduleCache::createFingerprint(Plan* plan) {
+  if (plan == nullptr) {
+    return QByteArray();
+  }
+
+  QBuffer examsIntervals;
+  QBuffer exams;
+  QBuffer groupsExams;
+  QBuffer groupsExamsPref;
+  PlanCsvDevices devices;
+  devices.examsIntervals = &examsIntervals;
+  devices.exams = &exams;
+  devices.groupsExams = &groupsExams;
+  devices.groupsExamsPref = &groupsExamsPref;
+  PlanCsvHelper helper(devices);
+  if (!helper.writePlan(plan)) {
+    return QByteArray();
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hash.addData(fingerprintVersion);
+  for (QBuffer* buffer : {&examsIntervals, &exams, &groupsExams,
+                          &groupsExamsPref}) {
+    // The size separates the files, so moving lines between files changes the
+    // fingerprint
+    hash.addData(QByteArray::number(buffer->data().size()));
+    hash.addData(":");
+    hash.addData(buffer->data());
+  }
+  return hash.result().toHex();
+}
+
+bool ScheduleCache::contains(Plan* plan) const {
+  QByteArray fingerprint = createFingerprint(plan);
+  if (fingerprint.isEmpty()) {
+    return false;
+  }
+  return QFile::exists(getFilePath(fingerprint));
+}
+
+bool ScheduleCache::store(Plan* plan, QIODevice* result) {
+  if (result == nullptr) {
+    return false;
+  }
+  QByteArray fingerprint = createFingerprint(plan);
+  if (fingerprint.isEmpty()) {
+    return false;
+  }
+
+  bool opened = false;
+  if (!result->isOpen()) {
+    if (!result->open(QIODevice::ReadOnly)) {
+      return false;
+    }
+    opened = true;
+  }
+  QByteArray content = result->readAll();
+  if (opened) {
+    result->close();
+  }
+
+  if (!QDir().mkpath(path)) {
+    return false;
+  }
+  // Other processes may read the file at any time, so it is only replaced
+  // once it is complete
+  QSaveFile file(getFilePath(fingerprint));
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+  if (file.write(content) != content.size()) {
+    file.cancelWriting();
+    return false;
+  }
+  return file.commit();
+}
+
+bool ScheduleCache::apply(Plan* plan) const {
+  QByteArray fingerprint = createFingerprint(plan);
+  if (fingerprint.isEmpty()) {
+    return false;
+  }
+  QFile file(getFilePath(fingerprint));
+  if (!file.exists()) {
+    return false;
+  }
+
+  PlanCsvDevices devices;
+  devices.planningExamsResult = &file;
+  PlanCsvHelper helper(devices);
+  return helper.readSchedule(plan);
+}
+
+bool ScheduleCache::remove(Plan* plan) {
+  QByteArray fingerprint = createFingerprint(plan);
+  if (fingerprint.isEmpty()) {
+    return false;
+  }
+  return QFile::remove(getFilePath(fingerprint));
+}
+
+void ScheduleCache::clear() {
+  QDir directory(path);
+  // Only remove files that look like cached results, in case the directory
+  // is shared with other files
+  for (const QString& fileName :
+       directory.entryList({"*" + resultSuffix}, QDir::Files)) {
+    if (fileName.size() == fingerprintLength + resultSuffix.size()) {
+      directory.remove(fileName);
+    }
+  }
+}
+
+QString ScheduleCache::getFilePath(const QByteArray& fingerprint) const {
+  return path + "/" + QString::fromLatin1(fingerprint) + resultSuffix;
+}
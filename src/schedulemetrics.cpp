@@ -0,0 +1,234 @@
+#include <schedulemetrics.h>
+
+namespace {
+// The sixth day of a week, like in PlanCsvHelper
+constexpr int saturdayIndex = 5;
+}  // namespace
+
+int GroupMetrics::score(const MetricWeights& weights) const {
+  return weights.gaps * gaps + weights.consecutiveDays * consecutiveDays +
+         weights.saturdaySlots * saturdaySlots + weights.lateSlots * lateSlots;
+}
+
+GroupMetrics& GroupMetrics::operator+=(const GroupMetrics& other) {
+  occupiedSlots += other.occupiedSlots;
+  gaps += other.gaps;
+  consecutiveDays += other.consecutiveDays;
+  saturdaySlots += other.saturdaySlots;
+  lateSlots += other.lateSlots;
+  return *this;
+}
+
+bool GroupMetrics::operator==(const GroupMetrics& other) const {
+  return occupiedSlots == other.occupiedSlots && gaps == other.gaps &&
+         consecutiveDays == other.consecutiveDays &&
+         saturdaySlots == other.saturdaySlots && lateSlots == other.lateSlots;
+}
+
+bool GroupMetrics::operator!=(const GroupMetrics& other) const {
+  return !(*this == other);
+}
+
+ScheduleMetrics::ScheduleMetrics(Plan* plan, int lateSlotCount)
+    : slotCount(0) {
+  if (plan == nullptr) {
+    return;
+  }
+
+  // Position of every timeslot in its day, the size of its day and the
+  // position of its day in the week
+  QVector<int> slotPositions;
+  QVector<int> daySizes;
+  QVector<int> slotWeekdays;
+  QVector<bool> dayFollowed;
+  int maxDaySize = 0;
+  for (Week* week : plan->getWeeks()) {
+    QList<Day*> days = week->getDays();
+    for (int weekday = 0; weekday < days.size(); weekday++) {
+      int daySize = days[weekday]->getTimeslots().size();
+      for (int position = 0; position < daySize; position++) {
+        slotDays.append(daySizes.size());
+        slotPositions.append(position);
+        slotWeekdays.append(weekday);
+      }
+      daySizes.append(daySize);
+      dayFollowed.append(weekday + 1 < days.size());
+      maxDaySize = qMax(maxDaySize, daySize);
+    }
+  }
+  slotCount = slotDays.size();
+
+  for (int step = 1; step < maxDaySize; step *= 2) {
+    SlotMask back(slotCount);
+    SlotMask ahead(slotCount);
+    for (int slot = 0; slot < slotCount; slot++) {
+      back.setBit(slot, slot - step >= 0 &&
+                            slotDays[slot - step] == slotDays[slot]);
+      ahead.setBit(slot, slot + step < slotCount &&
+                             slotDays[slot + step] == slotDays[slot]);
+    }
+    backward.append(back);
+    forward.append(ahead);
+  }
+
+  firstSlots = SlotMask(slotCount);
+  lastSlots = SlotMask(slotCount);
+  followedSlots = SlotMask(slotCount);
+  saturdaySlots = SlotMask(slotCount);
+  lateSlots = SlotMask(slotCount);
+  for (int slot = 0; slot < slotCount; slot++) {
+    int daySize = daySizes[slotDays[slot]];
+    bool last = slotPositions[slot] == daySize - 1;
+    firstSlots.setBit(slot, slotPositions[slot] == 0);
+    lastSlots.setBit(slot, last);
+    followedSlots.setBit(slot, last && dayFollowed[slotDays[slot]]);
+    saturdaySlots.setBit(slot, slotWeekdays[slot] == saturdayIndex);
+    lateSlots.setBit(slot, slotPositions[slot] >= daySize - lateSlotCount);
+  }
+
+  groups = plan->getGroups();
+  QHash<Group*, int> groupIndices;
+  for (int i = 0; i < groups.size(); i++) {
+    groupIndices.insert(groups[i], i);
+  }
+  QList<Module*> modules = plan->getModules();
+  for (int i = 0; i < modules.size(); i++) {
+    QVector<int> indices;
+    if (modules[i] != nullptr) {
+      moduleIndices.insert(modules[i], i);
+      for (Group* group : modules[i]->getGroups()) {
+        int index = groupIndices.value(group, -1);
+        if (index >= 0) {
+          indices.append(index);
+        }
+      }
+    }
+    moduleGroups.append(indices);
+    moduleDurations.append(
+        modules[i] == nullptr
+            ? 1
+            : qMax(1, static_cast<int>(modules[i]->getExamDuration())));
+  }
+}
+
+int ScheduleMetrics::getSlotCount() const {
+  return slotCount;
+}
+
+QList<Group*> ScheduleMetrics::getGroups() const {
+  return groups;
+}
+
+QVector<SlotMask> ScheduleMetrics::getOccupancy(Plan* plan) const {
+  QVector<SlotMask> occupancy(groups.size(), SlotMask(slotCount));
+  if (plan == nullptr) {
+    return occupancy;
+  }
+  int slot = 0;
+  for (Week* week : plan->getWeeks()) {
+    for (Day* day : week->getDays()) {
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        if (slot >= slotCount) {
+          return occupancy;
+        }
+        for (Module* module : timeslot->getModules()) {
+          int index = moduleIndices.value(module, -1);
+          if (index >= 0) {
+            occupy(occupancy, index, slot);
+          }
+        }
+        slot++;
+      }
+    }
+  }
+  return occupancy;
+}
+
+QVector<SlotMask> ScheduleMetrics::getOccupancy(
+    const QVector<qint32>& assignments) const {
+  if (assignments.size() != moduleGroups.size()) {
+    return QVector<SlotMask>();
+  }
+  QVector<SlotMask> occupancy(groups.size(), SlotMask(slotCount));
+  for (int module = 0; module < assignments.size(); module++) {
+    if (assignments[module] >= 0 && assignments[module] < slotCount) {
+      occupy(occupancy, module, assignments[module]);
+    }
+  }
+  return occupancy;
+}
+
+GroupMetrics ScheduleMetrics::evaluate(const SlotMask& occupancy) const {
+  GroupMetrics metrics;
+  if (occupancy.size() != slotCount || !occupancy.any()) {
+    return metrics;
+  }
+
+  // Segmented prefix and suffix over the timeslots of every day, afterwards
+  // bit i of before is set if there is an exam in a timeslot <= i of the same
+  // day and bit i of after if there is one in a timeslot >= i
+  SlotMask before = occupancy;
+  SlotMask after = occupancy;
+  for (int step = 0; step < backward.size(); step++) {
+    before |= before.shifted(-(1 << step)) & backward[step];
+    after |= after.shifted(1 << step) & forward[step];
+  }
+
+  metrics.occupiedSlots = occupancy.count();
+  if (!backward.isEmpty()) {
+    SlotMask earlier = before.shifted(-1) & backward[0];
+    SlotMask later = after.shifted(1) & forward[0];
+    metrics.gaps = (~occupancy & earlier & later).count();
+  }
+  // The last timeslot of a day in before and the first in after tell if the
+  // day has an exam. The first timeslot of the next day directly follows the
+  // last one.
+  SlotMask dayEnds = before & followedSlots;
+  SlotMask nextDayStarts = (after & firstSlots).shifted(1);
+  metrics.consecutiveDays = (dayEnds & nextDayStarts).count();
+  metrics.saturdaySlots = (occupancy & saturdaySlots).count();
+  metrics.lateSlots = (occupancy & lateSlots).count();
+  return metrics;
+}
+
+QVector<GroupMetrics> ScheduleMetrics::evaluate(
+    const QVector<SlotMask>& occupancy) const {
+  QVector<GroupMetrics> result;
+  result.reserve(occupancy.size());
+  for (const SlotMask& mask : occupancy) {
+    result.append(evaluate(mask));
+  }
+  return result;
+}
+
+GroupMetrics ScheduleMetrics::evaluateTotal(
+    const QVector<qint32>& assignments) const {
+  GroupMetrics total;
+  for (const SlotMask& mask : getOccupancy(assignments)) {
+    total += evaluate(mask);
+  }
+  return total;
+}
+
+GroupMetrics ScheduleMetrics::sum(const QVector<GroupMetrics>& metrics) {
+  GroupMetrics total;
+  for (const GroupMetrics& groupMetrics : metrics) {
+    total += groupMetrics;
+  }
+  return total;
+}
+
+void ScheduleMetrics::occupy(QVector<SlotMask>& occupancy,
+                             int module,
+                             int slot) const {
+  int day = slotDays[slot];
+  for (int offset = 0; offset < moduleDurations[module]; offset++) {
+    int occupied = slot + offset;
+    if (occupied >= slotCount || slotDays[occupied] != day) {
+      break;
+    }
+    for (int group : moduleGroups[module]) {
+      occupancy[group].setBit(occupied);
+    }
+  }
+}
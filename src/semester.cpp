@@ -1,6 +1,46 @@
+#include <idindex.h>
+#include <propertytable.h>
 #include <semester.h>
+#include <QJsonArray>
+
+namespace {
+QList<QUuid> getIds(const QJsonArray& objects) {
+  QList<QUuid> ids;
+  for (const QJsonValue& object : objects) {
+    ids.append(QUuid(object.toObject().value("id").toString()));
+  }
+  return ids;
+}
+
+// The ids of a plan and all of its objects
+QList<QUuid> getPlanIds(const QJsonObject& plan) {
+  QList<QUuid> ids{QUuid(plan.value("id").toString())};
+  ids += getIds(plan.value("groups").toArray());
+  ids += getIds(plan.value("constraints").toArray());
+  ids += getIds(plan.value("modules").toArray());
+  for (const QJsonValue& week : plan.value("weeks").toArray()) {
+    ids.append(QUuid(week.toObject().value("id").toString()));
+    for (const QJsonValue& day : week.toObject().value("days").toArray()) {
+      ids.append(QUuid(day.toObject().value("id").toString()));
+      ids += getIds(day.toObject().value("timeslots").toArray());
+    }
+  }
+  return ids;
+}
+
+// The plans are written separately, so unloaded plans are not loaded
+constexpr auto semesterProperties = std::make_tuple(
+    PropertyTable::value("name", &Semester::getName, &Semester::setName));
+}  // namespace
+
+Semester::Semester(QObject* parent)
+    : SerializableDataObject(parent),
+      contentHash(0),
+      idsIndexed(false) {
+  accessClock.start();
+  updateContentHash();
+}
 
-Semester::Semester(QObject* parent) : SerializableDataObject(parent) {}
 QString Semester::getName() const {
   return name;
 }
@@ -10,10 +50,25 @@ void Semester::setName(const QString& name) {
     return;
 
   this->name = name;
+  updateContentHash();
   emit nameChanged(this->name);
 }
 
 QList<Plan*> Semester::getPlans() const {
+  // Loading only fills in objects for the stored JSON, so it is done for
+  // const semesters as well
+  auto* self = const_cast<Semester*>(this);
+  bool loaded = false;
+  for (int i = 0; i < plans.size(); i++) {
+    planAccesses[i] = accessClock.elapsed();
+    if (!isPlanLoaded(i)) {
+      self->loadPlan(i);
+      loaded = true;
+    }
+  }
+  if (loaded) {
+    emit self->plansChanged(this->plans);
+  }
   return this->plans;
 }
 
@@ -21,17 +76,260 @@ void Semester::setPlans(QList<Plan*> plans) {
   if (this->plans == plans)
     return;
 
+  trackPlans(this->plans, false);
+  clearPlanIndices();
   this->plans = plans;
+  planContents.clear();
+  for (int i = 0; i < plans.size(); i++) {
+    planContents.append(QJsonObject());
+  }
+  planLoaded = QVector<bool>(plans.size(), true);
+  planHashes = QVector<quint64>(plans.size(), 0);
+  planAccesses = QVector<qint64>(plans.size(), accessClock.elapsed());
+  trackPlans(this->plans, true);
+  updateContentHash();
   emit plansChanged(this->plans);
 }
 
+int Semester::getPlanCount() const {
+  return plans.size();
+}
+
+Plan* Semester::getPlan(int index) const {
+  if (index < 0 || index >= plans.size()) {
+    return nullptr;
+  }
+  planAccesses[index] = accessClock.elapsed();
+  if (isPlanLoaded(index)) {
+    return plans[index];
+  }
+  // Loading only fills in objects for the stored JSON, so it is done for
+  // const semesters as well
+  auto* self = const_cast<Semester*>(this);
+  Plan* plan = self->loadPlan(index);
+  emit self->plansChanged(this->plans);
+  return plan;
+}
+
+bool Semester::isPlanLoaded(int index) const {
+  return index >= 0 && index < planLoaded.size() && planLoaded[index];
+}
+
+QList<Plan*> Semester::getLoadedPlans() const {
+  QList<Plan*> loadedPlans;
+  for (Plan* plan : plans) {
+    if (plan != nullptr) {
+      loadedPlans.append(plan);
+    }
+  }
+  return loadedPlans;
+}
+
+QJsonObject Semester::getPlanContent(int index) const {
+  if (index < 0 || index >= plans.size()) {
+    return QJsonObject();
+  }
+  if (!isPlanLoaded(index)) {
+    return planContents[index];
+  }
+  return plans[index] == nullptr ? QJsonObject() : plans[index]->toJsonObject();
+}
+
+bool Semester::unloadPlan(int index) {
+  if (!isPlanLoaded(index) || plans[index] == nullptr ||
+      plans[index]->parent() != this) {
+    return false;
+  }
+
+  Plan* plan = plans[index];
+  trackPlans({plan}, false);
+  indexPlan(index, false);
+  planContents[index] = plan->toJsonObject();
+  planHashes[index] = Plan::contentHashOf(planContents[index]);
+  planLoaded[index] = false;
+  plans[index] = nullptr;
+  delete plan;
+  indexPlan(index, true);
+  updateContentHash();
+  emit plansChanged(this->plans);
+  return true;
+}
+
+int Semester::unloadIdlePlans(qint64 idleTime) {
+  int unloaded = 0;
+  qint64 now = accessClock.elapsed();
+  for (int i = 0; i < plans.size(); i++) {
+    if (now - planAccesses[i] >= idleTime && unloadPlan(i)) {
+      unloaded++;
+    }
+  }
+  return unloaded;
+}
+
+quint64 Semester::getContentHash() const {
+  return contentHash;
+}
+
+SerializableDataObject* Semester::findById(const QUuid& id) const {
+  if (!idsIndexed) {
+    idsIndexed = true;
+    indexConnections = QVector<QList<QMetaObject::Connection>>(plans.size());
+    for (int i = 0; i < plans.size(); i++) {
+      indexPlan(i, true);
+    }
+  }
+
+  // Usually only one plan contains id, otherwise the first loaded one is
+  // preferred
+  int found = -1;
+  for (int index : planIndices.values(id)) {
+    if (found < 0 || (isPlanLoaded(index) && !isPlanLoaded(found)) ||
+        (isPlanLoaded(index) == isPlanLoaded(found) && index < found)) {
+      found = index;
+    }
+  }
+  Plan* plan = getPlan(found);
+  return plan != nullptr ? plan->findById(id) : nullptr;
+}
+
+Plan* Semester::loadPlan(int index) {
+  indexPlan(index, false);
+  Plan* plan = new Plan(this);
+  plan->fromJsonObject(planContents[index]);
+  plans[index] = plan;
+  planContents[index] = QJsonObject();
+  planLoaded[index] = true;
+  trackPlans({plan}, true);
+  indexPlan(index, true);
+  // Only differs for content without ids, which get new ones
+  updateContentHash();
+  return plan;
+}
+
+quint64 Semester::getPlanHash(int index) const {
+  if (!isPlanLoaded(index)) {
+    return planHashes[index];
+  }
+  return plans[index] != nullptr ? plans[index]->getContentHash() : 0;
+}
+
+void Semester::indexPlan(int index, bool insert) const {
+  if (!idsIndexed) {
+    return;
+  }
+
+  QList<QUuid> ids;
+  if (!isPlanLoaded(index)) {
+    ids = getPlanIds(planContents[index]);
+  } else if (plans[index] != nullptr) {
+    IdIndex* idIndex = plans[index]->getIdIndex();
+    ids = idIndex->getIds();
+    if (insert) {
+      indexConnections[index]
+          << connect(idIndex, &IdIndex::inserted, this,
+                     [this, index](const QUuid& id) {
+                       planIndices.insert(id, index);
+                     })
+          << connect(idIndex, &IdIndex::removed, this,
+                     [this, index](const QUuid& id) {
+                       planIndices.remove(id, index);
+                     });
+    } else {
+      for (const QMetaObject::Connection& connection :
+           indexConnections[index]) {
+        disconnect(connection);
+      }
+      indexConnections[index].clear();
+    }
+  }
+  for (const QUuid& id : ids) {
+    if (insert) {
+      planIndices.insert(id, index);
+    } else {
+      planIndices.remove(id, index);
+    }
+  }
+}
+
+void Semester::clearPlanIndices() {
+  for (const QList<QMetaObject::Connection>& connections : indexConnections) {
+    for (const QMetaObject::Connection& connection : connections) {
+      disconnect(connection);
+    }
+  }
+  indexConnections.clear();
+  planIndices.clear();
+  idsIndexed = false;
+}
+
+void Semester::updateContentHash() {
+  // Like ContentHash::ofOrderedContents with the hashes of the plans, that
+  // are not loaded, taken from their JSON objects
+  quint64 plansHash = plans.size();
+  for (int i = 0; i < plans.size(); i++) {
+    plansHash = ContentHash::combine(plansHash, getPlanHash(i));
+  }
+
+  quint64 hash = ContentHash::ofId(getId());
+  hash = ContentHash::combine(hash, ContentHash::ofString(name));
+  hash = ContentHash::combine(hash, plansHash);
+  if (hash == contentHash)
+    return;
+
+  quint64 oldHash = contentHash;
+  contentHash = hash;
+  emit contentHashChanged(oldHash, contentHash);
+}
+
+void Semester::trackPlans(const QList<Plan*>& plans, bool track) {
+  for (Plan* plan : plans) {
+    if (plan == nullptr)
+      continue;
+
+    if (track) {
+      connect(plan, &Plan::contentHashChanged, this,
+              &Semester::updateContentHash, Qt::UniqueConnection);
+    } else {
+      disconnect(plan, &Plan::contentHashChanged, this,
+                 &Semester::updateContentHash);
+    }
+  }
+}
+
 void Semester::fromJsonObject(const QJsonObject& content) {
-  simpleValuesFromJsonObject(content);
+  simpleValuesFromJsonObject(PropertyTable::identity(content));
+  PropertyTable::fromJsonObject(this, content, semesterProperties);
 
   QJsonArray plansJsonArray = content.value("plans").toArray();
-  plans = fromObjectJsonArray<Plan>(plansJsonArray);
+  trackPlans(plans, false);
+  clearPlanIndices();
+  plans.clear();
+  planContents.clear();
+  planLoaded.clear();
+  planHashes.clear();
+  planAccesses.clear();
+  // The plans are created on their first access
+  for (const QJsonValue& planJson : plansJsonArray) {
+    QJsonObject planContent = planJson.toObject();
+    plans.append(nullptr);
+    planContents.append(planContent);
+    planLoaded.append(false);
+    planHashes.append(Plan::contentHashOf(planContent));
+    planAccesses.append(accessClock.elapsed());
+  }
+  updateContentHash();
 }
 
 QJsonObject Semester::toJsonObject() const {
-  return recursiveToJsonObject();
+  QJsonObject content = PropertyTable::toJsonObject(this, semesterProperties);
+  QJsonArray plansJsonArray;
+  for (int i = 0; i < plans.size(); i++) {
+    if (!isPlanLoaded(i)) {
+      plansJsonArray.append(planContents[i]);
+    } else if (plans[i] != nullptr) {
+      plansJsonArray.append(plans[i]->toJsonObject());
+    }
+  }
+  content.insert("plans", plansJsonArray);
+  return content;
 }
@@ -0,0 +1,202 @@
+#include <semesterloader.h>
+#include <QHash>
+#include <QUuid>
+#include <QtConcurrent/QtConcurrentMap>
+#include <initializer_list>
+
+namespace {
+QHash<QUuid, int> indexIds(const QJsonArray& objects, int offset = 0) {
+  QHash<QUuid, int> indices;
+  indices.reserve(objects.size());
+  for (int i = 0; i < objects.size(); i++) {
+    indices.insert(QUuid(objects[i].toObject().value("id").toString()),
+                   offset + i);
+  }
+  return indices;
+}
+
+QVector<int> resolveIds(const QJsonValue& ids,
+                        const QHash<QUuid, int>& indices) {
+  QVector<int> resolved;
+  for (const QJsonValue& id : ids.toArray()) {
+    int index = indices.value(QUuid(id.toString()), -1);
+    if (index >= 0) {
+      resolved.append(index);
+    }
+  }
+  return resolved;
+}
+
+QVector<QJsonObject> toObjects(const QJsonArray& array) {
+  QVector<QJsonObject> objects;
+  objects.reserve(array.size());
+  for (const QJsonValue& value : array) {
+    objects.append(value.toObject());
+  }
+  return objects;
+}
+
+// Replace lists, that are created separately, by empty lists
+QJsonObject withoutLists(QJsonObject content,
+                         std::initializer_list<const char*> keys) {
+  for (const char* key : keys) {
+    content.insert(QLatin1String(key), QJsonArray());
+  }
+  return content;
+}
+
+template <typename T>
+QList<T*> select(const QList<T*>& objects, const QVector<int>& indices) {
+  QList<T*> selected;
+  selected.reserve(indices.size());
+  for (int index : indices) {
+    selected.append(objects[index]);
+  }
+  return selected;
+}
+
+template <typename T>
+QList<T*> createObjects(const QVector<QJsonObject>& contents,
+                        QObject* parent) {
+  QList<T*> objects;
+  objects.reserve(contents.size());
+  for (const QJsonObject& content : contents) {
+    T* object = new T(parent);
+    object->fromJsonObject(content);
+    objects.append(object);
+  }
+  return objects;
+}
+}  // namespace
+
+Semester* SemesterLoader::load(const QJsonObject& content, QObject* parent) {
+  Semester* semester = new Semester(parent);
+  semester->fromJsonObject(withoutLists(content, {"plans"}));
+  semester->setPlans(loadPlans(content.value("plans").toArray(), semester));
+  return semester;
+}
+
+QList<Plan*> SemesterLoader::loadPlans(const QJsonArray& plans,
+                                       QObject* parent) {
+  QList<QJsonObject> contents;
+  for (const QJsonValue& plan : plans) {
+    contents.append(plan.toObject());
+  }
+  QList<PreparedPlan> prepared =
+      QtConcurrent::blockingMapped(contents, &SemesterLoader::prepare);
+
+  QList<Plan*> result;
+  for (const PreparedPlan& plan : prepared) {
+    result.append(createPlan(plan, parent));
+  }
+  return result;
+}
+
+PreparedPlan SemesterLoader::prepare(const QJsonObject& content) {
+  PreparedPlan prepared;
+  prepared.content =
+      withoutLists(content, {"groups", "constraints", "modules", "weeks"});
+
+  QJsonArray groups = content.value("groups").toArray();
+  QJsonArray constraints = content.value("constraints").toArray();
+  QJsonArray modules = content.value("modules").toArray();
+  prepared.groups = toObjects(groups);
+  prepared.constraints = toObjects(constraints);
+
+  QHash<QUuid, int> groupIndices = indexIds(groups);
+  QHash<QUuid, int> constraintIndices = indexIds(constraints);
+  QHash<QUuid, int> moduleIndices = indexIds(modules);
+  // Timeslots search the groups before the constraints
+  QHash<QUuid, int> activeGroupIndices = indexIds(constraints, groups.size());
+  for (auto iterator = groupIndices.constBegin();
+       iterator != groupIndices.constEnd(); iterator++) {
+    activeGroupIndices.insert(iterator.key(), iterator.value());
+  }
+
+  prepared.modules.reserve(modules.size());
+  for (const QJsonValue& moduleJson : modules) {
+    QJsonObject module = moduleJson.toObject();
+    PreparedModule preparedModule;
+    preparedModule.content = withoutLists(module, {"groups", "constraints"});
+    preparedModule.groups = resolveIds(module.value("groups"), groupIndices);
+    preparedModule.constraints =
+        resolveIds(module.value("constraints"), constraintIndices);
+    prepared.modules.append(preparedModule);
+  }
+
+  for (const QJsonValue& weekJson : content.value("weeks").toArray()) {
+    QJsonObject week = weekJson.toObject();
+    PreparedWeek preparedWeek;
+    preparedWeek.content = withoutLists(week, {"days"});
+    for (const QJsonValue& dayJson : week.value("days").toArray()) {
+      QJsonObject day = dayJson.toObject();
+      PreparedDay preparedDay;
+      preparedDay.content = withoutLists(day, {"timeslots"});
+      for (const QJsonValue& timeslotJson : day.value("timeslots").toArray()) {
+        QJsonObject timeslot = timeslotJson.toObject();
+        PreparedTimeslot preparedTimeslot;
+        preparedTimeslot.content =
+            withoutLists(timeslot, {"modules", "activeGroups"});
+        preparedTimeslot.modules =
+            resolveIds(timeslot.value("modules"), moduleIndices);
+        preparedTimeslot.activeGroups =
+            resolveIds(timeslot.value("activeGroups"), activeGroupIndices);
+        preparedDay.timeslots.append(preparedTimeslot);
+      }
+      preparedWeek.days.append(preparedDay);
+    }
+    prepared.weeks.append(preparedWeek);
+  }
+  return prepared;
+}
+
+Plan* SemesterLoader::createPlan(const PreparedPlan& prepared,
+                                 QObject* parent) {
+  Plan* plan = new Plan(parent);
+  plan->fromJsonObject(prepared.content);
+
+  QList<Group*> groups = createObjects<Group>(prepared.groups, plan);
+  QList<Group*> constraints = createObjects<Group>(prepared.constraints, plan);
+  plan->setGroups(groups);
+  plan->setConstraints(constraints);
+  QList<Group*> activeGroups = groups + constraints;
+
+  QList<Module*> modules;
+  modules.reserve(prepared.modules.size());
+  for (const PreparedModule& preparedModule : prepared.modules) {
+    Module* module = new Module(plan);
+    module->fromJsonObject(preparedModule.content);
+    module->setGroups(select(groups, preparedModule.groups));
+    module->setConstraints(select(constraints, preparedModule.constraints));
+    modules.append(module);
+  }
+  plan->setModules(modules);
+
+  QList<Week*> weeks;
+  for (const PreparedWeek& preparedWeek : prepared.weeks) {
+    // Timeslots find the plan through their parents, so every object gets
+    // its parent before its contents
+    Week* week = new Week(plan);
+    week->fromJsonObject(preparedWeek.content);
+    QList<Day*> days;
+    for (const PreparedDay& preparedDay : preparedWeek.days) {
+      Day* day = new Day(week);
+      day->fromJsonObject(preparedDay.content);
+      QList<Timeslot*> timeslots;
+      for (const PreparedTimeslot& preparedTimeslot : preparedDay.timeslots) {
+        Timeslot* timeslot = new Timeslot(day);
+        timeslot->fromJsonObject(preparedTimeslot.content);
+        timeslot->setModules(select(modules, preparedTimeslot.modules));
+        timeslot->setActiveGroups(
+            select(activeGroups, preparedTimeslot.activeGroups));
+        timeslots.append(timeslot);
+      }
+      day->setTimeslots(timeslots);
+      days.append(day);
+    }
+    week->setDays(days);
+    weeks.append(week);
+  }
+  plan->setWeeks(weeks);
+  return plan;
+}
@@ -0,0 +1,150 @@
+#include <slotmask.h>
+#include <QtAlgorithms>
+
+SlotMask::SlotMask(int size, bool value)
+    : words((size + wordSize - 1) / wordSize, value ? ~quint64(0) : 0),
+      bitCount(size) {
+  clearUnusedBits();
+}
+
+int SlotMask::size() const {
+  return bitCount;
+}
+
+bool SlotMask::testBit(int slot) const {
+  if (slot < 0 || slot >= bitCount) {
+    return false;
+  }
+  return (words[slot / wordSize] >> (slot % wordSize)) & 1;
+}
+
+void SlotMask::setBit(int slot, bool value) {
+  if (slot < 0 || slot >= bitCount) {
+    return;
+  }
+  quint64 bit = quint64(1) << (slot % wordSize);
+  if (value) {
+    words[slot / wordSize] |= bit;
+  } else {
+    words[slot / wordSize] &= ~bit;
+  }
+}
+
+void SlotMask::fill(bool value) {
+  words.fill(value ? ~quint64(0) : 0);
+  clearUnusedBits();
+}
+
+int SlotMask::count() const {
+  int count = 0;
+  for (quint64 word : words) {
+    count += qPopulationCount(word);
+  }
+  return count;
+}
+
+bool SlotMask::any() const {
+  for (quint64 word : words) {
+    if (word != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+QList<int> SlotMask::toList() const {
+  QList<int> result;
+  for (int i = 0; i < words.size(); i++) {
+    quint64 word = words[i];
+    while (word != 0) {
+      result.append(i * wordSize + qCountTrailingZeroBits(word));
+      word &= word - 1;
+    }
+  }
+  return result;
+}
+
+SlotMask SlotMask::shifted(int offset) const {
+  SlotMask result(bitCount);
+  int wordCount = words.size();
+  int wordShift = qAbs(offset) / wordSize;
+  int bitShift = qAbs(offset) % wordSize;
+  for (int i = 0; i < wordCount; i++) {
+    quint64 word = 0;
+    if (offset >= 0) {
+      int source = i + wordShift;
+      if (source < wordCount) {
+        word = words[source] >> bitShift;
+        if (bitShift != 0 && source + 1 < wordCount) {
+          word |= words[source + 1] << (wordSize - bitShift);
+        }
+      }
+    } else {
+      int source = i - wordShift;
+      if (source >= 0) {
+        word = words[source] << bitShift;
+        if (bitShift != 0 && source - 1 >= 0) {
+          word |= words[source - 1] >> (wordSize - bitShift);
+        }
+      }
+    }
+    result.words[i] = word;
+  }
+  result.clearUnusedBits();
+  return result;
+}
+
+const QVector<quint64>& SlotMask::getWords() const {
+  return words;
+}
+
+SlotMask& SlotMask::operator&=(const SlotMask& other) {
+  for (int i = 0; i < words.size(); i++) {
+    words[i] &= other.words.value(i, 0);
+  }
+  return *this;
+}
+
+SlotMask& SlotMask::operator|=(const SlotMask& other) {
+  for (int i = 0; i < words.size(); i++) {
+    words[i] |= other.words.value(i, 0);
+  }
+  clearUnusedBits();
+  return *this;
+}
+
+SlotMask SlotMask::operator&(const SlotMask& other) const {
+  SlotMask result(*this);
+  result &= other;
+  return result;
+}
+
+SlotMask SlotMask::operator|(const SlotMask& other) const {
+  SlotMask result(*this);
+  result |= other;
+  return result;
+}
+
+SlotMask SlotMask::operator~() const {
+  SlotMask result(*this);
+  for (quint64& word : result.words) {
+    word = ~word;
+  }
+  result.clearUnusedBits();
+  return result;
+}
+
+bool SlotMask::operator==(const SlotMask& other) const {
+  return bitCount == other.bitCount && words == other.words;
+}
+
+bool SlotMask::operator!=(const SlotMask& other) const {
+  return !(*this == other);
+}
+
+void SlotMask::clearUnusedBits() {
+  int usedBits = bitCount % wordSize;
+  if (usedBits != 0 && !words.isEmpty()) {
+    words.last() &= (quint64(1) << usedBits) - 1;
+  }
+}
@@ -0,0 +1,255 @@
+#include <plancsvhelper.h>
+#include <solverrunner.h>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QProcess>
+#include <QScopedPointer>
+#include <QSet>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QVector>
+
+namespace {
+const QStringList resultFiles = {"SPA-ERGEBNIS-PP/SPA-planung-pruef.csv",
+                                 "SPA-ERGEBNIS-PP/SPA-zuege-pruef.csv"};
+
+/**
+ *  The state of all runs, shared by the handlers of the processes
+ */
+struct RunState {
+  QFutureInterface<bool> futureInterface;
+  QPointer<Plan> plan;
+  QString path;
+  QObject* context = nullptr;
+  QList<QProcess*> processes;
+  QVector<bool> finished;
+  QVector<bool> succeeded;
+  int finishedCount = 0;
+};
+
+void completeRuns(QSharedPointer<RunState> state) {
+  state->context->deleteLater();
+  if (state->futureInterface.isCanceled()) {
+    state->futureInterface.reportFinished();
+    return;
+  }
+
+  int best = -1;
+  SolverScore bestScore;
+  for (int i = 0; i < state->succeeded.size() && !state->plan.isNull(); i++) {
+    SolverScore score;
+    if (!state->succeeded[i] ||
+        !SolverRunner::scoreResult(
+            state->plan, SolverRunner::getRunPath(state->path, i), score)) {
+      continue;
+    }
+    if (best < 0 || score < bestScore) {
+      best = i;
+      bestScore = score;
+    }
+  }
+
+  bool success = false;
+  if (best >= 0 && !state->plan.isNull()) {
+    PlanCsvHelper helper(SolverRunner::getRunPath(state->path, best));
+    success = helper.readSchedule(state->plan);
+  }
+  state->futureInterface.reportResult(success);
+  state->futureInterface.reportFinished();
+}
+
+void killRuns(QSharedPointer<RunState> state) {
+  for (QProcess* process : state->processes) {
+    if (process->state() != QProcess::NotRunning) {
+      process->kill();
+    }
+  }
+}
+
+void finishRun(QSharedPointer<RunState> state, int run, bool succeeded) {
+  if (state->finished[run]) {
+    return;
+  }
+  state->finished[run] = true;
+  state->succeeded[run] = succeeded;
+  state->finishedCount++;
+  state->futureInterface.setProgressValue(state->finishedCount);
+  if (state->finishedCount == state->processes.size()) {
+    completeRuns(state);
+  }
+}
+}  // namespace
+
+bool SolverScore::operator<(const SolverScore& other) const {
+  if (unscheduledModules != other.unscheduledModules) {
+    return unscheduledModules < other.unscheduledModules;
+  }
+  return cost.total() < other.cost.total();
+}
+
+SolverRunner::SolverRunner(const QString& program,
+                           const QStringList& arguments)
+    : program(program),
+      arguments(arguments),
+      runCount(4),
+      firstSeed(1),
+      timeout(-1) {}
+
+void SolverRunner::setRunCount(int runCount) {
+  this->runCount = runCount;
+}
+
+int SolverRunner::getRunCount() const {
+  return runCount;
+}
+
+void SolverRunner::setFirstSeed(int firstSeed) {
+  this->firstSeed = firstSeed;
+}
+
+int SolverRunner::getFirstSeed() const {
+  return firstSeed;
+}
+
+void SolverRunner::setTimeout(int timeout) {
+  this->timeout = timeout;
+}
+
+int SolverRunner::getTimeout() const {
+  return timeout;
+}
+
+QString SolverRunner::getRunPath(const QString& path, int run) {
+  return path + "/run-" + QString::number(run);
+}
+
+bool SolverRunner::scoreResult(Plan* plan,
+                               const QString& path,
+                               SolverScore& score) {
+  if (plan == nullptr) {
+    return false;
+  }
+  QScopedPointer<Plan> copy(new Plan());
+  copy->fromJsonObject(plan->toJsonObject());
+  PlanCsvHelper helper(path);
+  if (!helper.readSchedule(copy.data())) {
+    return false;
+  }
+
+  QSet<Module*> scheduledModules;
+  for (Week* week : copy->getWeeks()) {
+    for (Day* day : week->getDays()) {
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        for (Module* module : timeslot->getModules()) {
+          scheduledModules.insert(module);
+        }
+      }
+    }
+  }
+  score.unscheduledModules = 0;
+  for (Module* module : copy->getModules()) {
+    if (module != nullptr && module->getActive() &&
+        !scheduledModules.contains(module)) {
+      score.unscheduledModules++;
+    }
+  }
+  score.cost = MoveEvaluator(copy.data()).getCost();
+  return true;
+}
+
+QFuture<bool> SolverRunner::run(Plan* plan, const QString& path) const {
+  QSharedPointer<RunState> state(new RunState());
+  state->futureInterface.setProgressRange(0, qMax(0, runCount));
+  state->futureInterface.reportStarted();
+  if (plan == nullptr || runCount < 1 || !prepareRuns(plan, path)) {
+    state->futureInterface.reportResult(false);
+    state->futureInterface.reportFinished();
+    return state->futureInterface.future();
+  }
+
+  state->plan = plan;
+  state->path = path;
+  state->context = new QObject();
+  state->finished.fill(false, runCount);
+  state->succeeded.fill(false, runCount);
+  for (int i = 0; i < runCount; i++) {
+    QString runPath = getRunPath(path, i);
+    QString seed = QString::number(firstSeed + i);
+    QStringList runArguments;
+    for (const QString& argument : arguments) {
+      runArguments.append(
+          QString(argument).replace("{path}", runPath).replace("{seed}", seed));
+    }
+
+    auto* process = new QProcess(state->context);
+    process->setWorkingDirectory(runPath);
+    process->setStandardOutputFile(QProcess::nullDevice());
+    process->setStandardErrorFile(QProcess::nullDevice());
+    process->setProgram(program);
+    process->setArguments(runArguments);
+    QObject::connect(
+        process,
+        static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
+            &QProcess::finished),
+        state->context,
+        [state, i](int exitCode, QProcess::ExitStatus exitStatus) {
+          finishRun(state, i,
+                    exitStatus == QProcess::NormalExit && exitCode == 0);
+        });
+    QObject::connect(process, &QProcess::errorOccurred, state->context,
+                     [state, i](QProcess::ProcessError error) {
+                       if (error == QProcess::FailedToStart) {
+                         finishRun(state, i, false);
+                       }
+                     });
+    state->processes.append(process);
+  }
+
+  if (timeout >= 0) {
+    QTimer::singleShot(timeout, state->context,
+                       [state]() { killRuns(state); });
+  }
+  // The killed processes finish the runs, so the future finishes as well
+  auto* watcher = new QFutureWatcher<bool>(state->context);
+  QObject::connect(watcher, &QFutureWatcher<bool>::canceled, state->context,
+                   [state]() { killRuns(state); });
+  watcher->setFuture(state->futureInterface.future());
+  for (QProcess* process : state->processes) {
+    process->start();
+  }
+  return state->futureInterface.future();
+}
+
+bool SolverRunner::prepareRuns(Plan* plan, const QString& path) const {
+  QString inputPath = path + "/input";
+  if (!QDir().mkpath(inputPath)) {
+    return false;
+  }
+  PlanCsvHelper helper(inputPath);
+  if (!helper.writePlan(plan)) {
+    return false;
+  }
+
+  for (int i = 0; i < runCount; i++) {
+    QString runPath = getRunPath(path, i);
+    if (!QDir().mkpath(runPath + "/SPA-ERGEBNIS-PP")) {
+      return false;
+    }
+    // Only results of the new runs may be scored
+    for (const QString& resultFile : resultFiles) {
+      QFile::remove(runPath + "/" + resultFile);
+    }
+    for (const QString& inputFile : helper.getInputFilePaths()) {
+      QString target = runPath + "/" + QFileInfo(inputFile).fileName();
+      QFile::remove(target);
+      if (!QFile::copy(inputFile, target)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
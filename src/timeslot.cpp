@@ -1,9 +1,24 @@
 #include <module.h>
+#include <propertytable.h>
 #include <timeslot.h>
 
 class Module;
 
-Timeslot::Timeslot(QObject* parent) : SerializableDataObject(parent) {}
+namespace {
+constexpr auto timeslotProperties = std::make_tuple(
+    PropertyTable::value("name", &Timeslot::getName, &Timeslot::setName),
+    PropertyTable::references("modules", &Timeslot::getModules),
+    PropertyTable::references("activeGroups", &Timeslot::getActiveGroups));
+}  // namespace
+
+Timeslot::Timeslot(QObject* parent)
+    : SerializableDataObject(parent),
+      modulesHash(0),
+      activeGroupsHash(0),
+      contentHash(0) {
+  updateContentHash();
+}
+
 QString Timeslot::getName() const {
   return name;
 }
@@ -13,6 +28,7 @@ void Timeslot::setName(const QString& name) {
     return;
 
   this->name = name;
+  updateContentHash();
   emit nameChanged(this->name);
 }
 
@@ -25,6 +41,8 @@ void Timeslot::setModules(QList<Module*> modules) {
     return;
 
   this->modules = modules;
+  modulesHash = ContentHash::ofIds(this->modules);
+  updateContentHash();
   emit modulesChanged(this->modules);
 }
 
@@ -37,6 +55,8 @@ void Timeslot::setActiveGroups(QList<Group*> activeGroups) {
     return;
 
   this->activeGroups = activeGroups;
+  activeGroupsHash = ContentHash::ofIds(this->activeGroups);
+  updateContentHash();
   emit activeGroupsChanged(this->activeGroups);
 }
 
@@ -49,11 +69,16 @@ void Timeslot::addActiveGroup(Group* gp) {
     return;
   }
   activeGroups.append(gp);
+  activeGroupsHash += ContentHash::ofReference(gp);
+  updateContentHash();
   emit activeGroupsChanged(this->activeGroups);
 }
 
 void Timeslot::removeActiveGroup(Group* gp) {
-  if (activeGroups.removeAll(gp) > 0) {
+  int removed = activeGroups.removeAll(gp);
+  if (removed > 0) {
+    activeGroupsHash -= removed * ContentHash::ofReference(gp);
+    updateContentHash();
     emit activeGroupsChanged(this->activeGroups);
   }
 }
@@ -67,17 +92,59 @@ void Timeslot::addModule(Module* module) {
     return;
   }
   modules.append(module);
+  modulesHash += ContentHash::ofReference(module);
+  updateContentHash();
   emit modulesChanged(this->modules);
 }
 
 void Timeslot::removeModule(Module* module) {
-  if (modules.removeAll(module) > 0) {
+  int removed = modules.removeAll(module);
+  if (removed > 0) {
+    modulesHash -= removed * ContentHash::ofReference(module);
+    updateContentHash();
     emit modulesChanged(this->modules);
   }
 }
 
+quint64 Timeslot::getContentHash() const {
+  return contentHash;
+}
+
+quint64 Timeslot::contentHashOf(const QJsonObject& content,
+                                const QSet<QUuid>& moduleIds,
+                                const QSet<QUuid>& groupIds) {
+  return hashOf(
+      PropertyTable::idOf(content),
+      PropertyTable::valueOf<QString>(content, "name", QString()),
+      ContentHash::ofReferences(content.value("modules").toArray(), moduleIds),
+      ContentHash::ofReferences(content.value("activeGroups").toArray(),
+                                groupIds));
+}
+
+quint64 Timeslot::hashOf(const QUuid& id,
+                         const QString& name,
+                         quint64 modulesHash,
+                         quint64 activeGroupsHash) {
+  quint64 hash = ContentHash::ofId(id);
+  hash = ContentHash::combine(hash, ContentHash::ofString(name));
+  hash = ContentHash::combine(hash, modulesHash);
+  hash = ContentHash::combine(hash, activeGroupsHash);
+  return hash;
+}
+
+void Timeslot::updateContentHash() {
+  quint64 hash = hashOf(getId(), name, modulesHash, activeGroupsHash);
+  if (hash == contentHash)
+    return;
+
+  quint64 oldHash = contentHash;
+  contentHash = hash;
+  emit contentHashChanged(oldHash, contentHash);
+}
+
 void Timeslot::fromJsonObject(const QJsonObject& content) {
-  simpleValuesFromJsonObject(content);
+  simpleValuesFromJsonObject(PropertyTable::identity(content));
+  PropertyTable::fromJsonObject(this, content, timeslotProperties);
 
   Plan* activePlan = (Plan*)this->parent()->parent()->parent();
 
@@ -89,8 +156,12 @@ void Timeslot::fromJsonObject(const QJsonObject& content) {
 
   modules = fromIdJsonArray<Module>(content.value("modules"),
                                     activePlan->getModules());
+
+  modulesHash = ContentHash::ofIds(modules);
+  activeGroupsHash = ContentHash::ofIds(activeGroups);
+  updateContentHash();
 }
 
 QJsonObject Timeslot::toJsonObject() const {
-  return recursiveToJsonObject();
+  return PropertyTable::toJsonObject(this, timeslotProperties);
 }
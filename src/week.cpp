@@ -1,6 +1,16 @@
+#include <propertytable.h>
 #include <week.h>
 
-Week::Week(QObject* parent) : SerializableDataObject(parent) {}
+namespace {
+constexpr auto weekProperties = std::make_tuple(
+    PropertyTable::value("name", &Week::getName, &Week::setName),
+    PropertyTable::objects("days", &Week::getDays));
+}  // namespace
+
+Week::Week(QObject* parent)
+    : SerializableDataObject(parent), contentHash(0) {
+  updateContentHash();
+}
 
 QString Week::getName() const {
   return name;
@@ -11,6 +21,7 @@ void Week::setName(const QString& name) {
     return;
 
   this->name = name;
+  updateContentHash();
   emit nameChanged(this->name);
 }
 
@@ -22,21 +33,75 @@ void Week::setDays(QList<Day*> days) {
   if (this->days == days)
     return;
 
+  trackDays(this->days, false);
   this->days = days;
+  trackDays(this->days, true);
+  updateContentHash();
   emit daysChanged(this->days);
 }
 
+quint64 Week::getContentHash() const {
+  return contentHash;
+}
+
+quint64 Week::contentHashOf(const QJsonObject& content,
+                            const QSet<QUuid>& moduleIds,
+                            const QSet<QUuid>& groupIds) {
+  // Like ContentHash::ofOrderedContents
+  QJsonArray days = content.value("days").toArray();
+  quint64 daysHash = days.size();
+  for (const QJsonValue& day : days) {
+    daysHash = ContentHash::combine(
+        daysHash, Day::contentHashOf(day.toObject(), moduleIds, groupIds));
+  }
+  return hashOf(PropertyTable::idOf(content),
+                PropertyTable::valueOf<QString>(content, "name", QString()),
+                daysHash);
+}
+
+quint64 Week::hashOf(const QUuid& id, const QString& name, quint64 daysHash) {
+  quint64 hash = ContentHash::ofId(id);
+  hash = ContentHash::combine(hash, ContentHash::ofString(name));
+  hash = ContentHash::combine(hash, daysHash);
+  return hash;
+}
+
+void Week::updateContentHash() {
+  quint64 hash = hashOf(getId(), name, ContentHash::ofOrderedContents(days));
+  if (hash == contentHash)
+    return;
+
+  quint64 oldHash = contentHash;
+  contentHash = hash;
+  emit contentHashChanged(oldHash, contentHash);
+}
+
+void Week::trackDays(const QList<Day*>& days, bool track) {
+  for (Day* day : days) {
+    if (day == nullptr)
+      continue;
+
+    if (track) {
+      connect(day, &Day::contentHashChanged, this, &Week::updateContentHash,
+              Qt::UniqueConnection);
+    } else {
+      disconnect(day, &Day::contentHashChanged, this,
+                 &Week::updateContentHash);
+    }
+  }
+}
+
 void Week::fromJsonObject(const QJsonObject& content) {
-  simpleValuesFromJsonObject(content);
+  simpleValuesFromJsonObject(PropertyTable::identity(content));
+  PropertyTable::fromJsonObject(this, content, weekProperties);
 
   QJsonArray daysJsonArray = content.value("days").toArray();
+  trackDays(days, false);
   days = fromObjectJsonArray<Day>(daysJsonArray);
-  QVariant var;
-  var.setValue(days);
-  createListFromValueAndContentType(daysJsonArray,
-                                    (QMetaType::Type)var.userType());
+  trackDays(days, true);
+  updateContentHash();
 }
 
 QJsonObject Week::toJsonObject() const {
-  return recursiveToJsonObject();
+  return PropertyTable::toJsonObject(this, weekProperties);
 }
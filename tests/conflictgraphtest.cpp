@@ -0,0 +1,120 @@
+#ifndef CONFLICTGRAPH_TEST_CPP
+#define CONFLICTGRAPH_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <conflictgraph.h>
+#include <QSharedPointer>
+#include <algorithm>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+bool shareGroup(Module* first, Module* second) {
+  for (Group* group : first->getGroups()) {
+    if (second->getGroups().contains(group)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ *  Creates a plan with two separate groups of modules:
+ *  - a, b and c share group x, c and d share group y
+ *  - e and f share group z
+ *  - g has no groups
+ */
+QSharedPointer<Plan> createSmallPlan() {
+  QSharedPointer<Plan> plan(new Plan());
+  plan->addNewGroup("x");
+  plan->addNewGroup("y");
+  plan->addNewGroup("z");
+  Group* x = plan->getGroups()[0];
+  Group* y = plan->getGroups()[1];
+  Group* z = plan->getGroups()[2];
+  QList<QList<Group*>> moduleGroups = {{x}, {x}, {x, y}, {y}, {z}, {z}, {}};
+  QList<Module*> modules;
+  for (const QList<Group*>& groups : moduleGroups) {
+    Module* module = new Module(plan.get());
+    module->setGroups(groups);
+    modules.append(module);
+  }
+  plan->setModules(modules);
+  return plan;
+}
+}  // namespace
+
+TEST(conflictGraphTests, adjacencyMatchesSharedGroups) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<Module*> modules = plan->getModules();
+  ConflictGraph graph(modules);
+  ASSERT_EQ(graph.getModuleCount(), modules.size());
+  ASSERT_EQ(graph.getOffsets().size(), modules.size() + 1);
+  for (int i = 0; i < modules.size(); i++) {
+    for (int j = 0; j < modules.size(); j++) {
+      bool expected = i != j && shareGroup(modules[i], modules[j]);
+      EXPECT_EQ(graph.conflicts(i, j), expected) << i << " " << j;
+    }
+    QVector<int> neighbors = graph.getNeighbors(i);
+    EXPECT_TRUE(std::is_sorted(neighbors.begin(), neighbors.end()));
+  }
+}
+
+TEST(conflictGraphTests, degreeStatistics) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  ConflictGraph graph(plan->getModules());
+  EXPECT_EQ(graph.getNeighbors(2), QVector<int>({0, 1, 3}));
+  EXPECT_EQ(graph.getDegree(2), 3);
+  EXPECT_EQ(graph.getEdgeCount(), 5);
+  EXPECT_EQ(graph.getMinimumDegree(), 0);
+  EXPECT_EQ(graph.getMaximumDegree(), 3);
+  EXPECT_DOUBLE_EQ(graph.getAverageDegree(), 10.0 / 7);
+}
+
+TEST(conflictGraphTests, cliqueBounds) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  ConflictGraph graph(plan->getModules());
+  EXPECT_EQ(graph.getClique(), QVector<int>({0, 1, 2}));
+  EXPECT_EQ(graph.getCliqueLowerBound(), 3);
+  EXPECT_EQ(graph.getRequiredSlotsLowerBound(), 3);
+
+  plan->getModules()[4]->setExamDuration(2);
+  plan->getModules()[5]->setExamDuration(2);
+  ConflictGraph longExamGraph(plan->getModules());
+  EXPECT_EQ(longExamGraph.getCliqueLowerBound(), 3);
+  EXPECT_EQ(longExamGraph.getRequiredSlotsLowerBound(), 4);
+}
+
+TEST(conflictGraphTests, connectedComponents) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  ConflictGraph graph(plan->getModules());
+  EXPECT_EQ(graph.getComponentCount(), 3);
+  EXPECT_EQ(graph.getComponents(),
+            QList<QVector<int>>({{0, 1, 2, 3}, {4, 5}, {6}}));
+  EXPECT_EQ(graph.getComponent(3), 0);
+  EXPECT_EQ(graph.indexOf(plan->getModules()[5]), 5);
+}
+
+TEST(conflictGraphTests, componentsDoNotConflict) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  ConflictGraph graph(plan->getModules());
+  for (int i = 0; i < graph.getModuleCount(); i++) {
+    for (int neighbor : graph.getNeighbors(i)) {
+      EXPECT_EQ(graph.getComponent(i), graph.getComponent(neighbor));
+    }
+  }
+}
+
+TEST(conflictGraphTests, emptyGraph) {
+  ConflictGraph graph((QList<Module*>()));
+  EXPECT_EQ(graph.getModuleCount(), 0);
+  EXPECT_EQ(graph.getEdgeCount(), 0);
+  EXPECT_EQ(graph.getComponentCount(), 0);
+  EXPECT_EQ(graph.getCliqueLowerBound(), 0);
+  EXPECT_EQ(graph.getAverageDegree(), 0);
+}
+
+#endif  // CONFLICTGRAPH_TEST_CPP
@@ -0,0 +1,179 @@
+#ifndef CONTENTHASH_TEST_CPP
+#define CONTENTHASH_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <contenthash.h>
+#include <QJsonArray>
+#include <QSharedPointer>
+#include "plan.h"
+#include "semester.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+Timeslot* firstTimeslot(Plan* plan) {
+  return plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0];
+}
+
+quint64 reloadedContentHash(Plan* plan) {
+  Plan reloadedPlan;
+  reloadedPlan.fromJsonObject(plan->toJsonObject());
+  return reloadedPlan.getContentHash();
+}
+}  // namespace
+
+TEST(contentHashTests, equalPlansHaveEqualHashes) {
+  Plan first;
+  first.fromJsonObject(getValidJsonPlan());
+  Plan second;
+  second.fromJsonObject(getValidJsonPlan());
+  EXPECT_NE(first.getContentHash(), 0u);
+  EXPECT_EQ(first.getContentHash(), second.getContentHash());
+}
+
+TEST(contentHashTests, differentPlansHaveDifferentHashes) {
+  Plan valid;
+  valid.fromJsonObject(getValidJsonPlan());
+  Plan invalid;
+  invalid.fromJsonObject(getInvalidJsonPlan());
+  EXPECT_NE(valid.getContentHash(), invalid.getContentHash());
+}
+
+TEST(contentHashTests, changingModuleChangesHashes) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  quint64 planHash = plan->getContentHash();
+  quint64 moduleHash = module->getContentHash();
+  quint64 groupsHash = plan->getGroupsHash();
+  quint64 weeksHash = plan->getWeeksHash();
+
+  QString name = module->getName();
+  module->setName(name + " changed");
+  EXPECT_NE(module->getContentHash(), moduleHash);
+  EXPECT_NE(plan->getContentHash(), planHash);
+  EXPECT_EQ(plan->getGroupsHash(), groupsHash);
+  EXPECT_EQ(plan->getWeeksHash(), weeksHash);
+
+  module->setName(name);
+  EXPECT_EQ(module->getContentHash(), moduleHash);
+  EXPECT_EQ(plan->getContentHash(), planHash);
+}
+
+TEST(contentHashTests, pinningModuleChangesHashAndIsSerialized) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  quint64 moduleHash = module->getContentHash();
+  EXPECT_FALSE(module->getPinned());
+
+  module->setPinned(true);
+  EXPECT_NE(module->getContentHash(), moduleHash);
+  QSharedPointer<Plan> reloadedPlan(new Plan());
+  reloadedPlan->fromJsonObject(plan->toJsonObject());
+  EXPECT_TRUE(reloadedPlan->getModules()[0]->getPinned());
+  EXPECT_FALSE(reloadedPlan->getModules()[1]->getPinned());
+  EXPECT_EQ(reloadedPlan->getContentHash(), plan->getContentHash());
+}
+
+TEST(contentHashTests, changingGroupChangesPlanHash) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Group* group = plan->getGroups()[0];
+  quint64 planHash = plan->getContentHash();
+  quint64 modulesHash = plan->getModulesHash();
+
+  group->setExamsPerDay(group->getExamsPerDay() + 1);
+  EXPECT_NE(plan->getContentHash(), planHash);
+  EXPECT_EQ(plan->getModulesHash(), modulesHash);
+}
+
+TEST(contentHashTests, schedulingModuleChangesWeeksHash) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Timeslot* timeslot = firstTimeslot(plan.get());
+  Module* module = plan->getModules()[0];
+  timeslot->removeModule(module);
+  quint64 planHash = plan->getContentHash();
+  quint64 weeksHash = plan->getWeeksHash();
+  quint64 timeslotHash = timeslot->getContentHash();
+
+  timeslot->addModule(module);
+  EXPECT_NE(timeslot->getContentHash(), timeslotHash);
+  EXPECT_NE(plan->getWeeksHash(), weeksHash);
+  EXPECT_NE(plan->getContentHash(), planHash);
+
+  timeslot->removeModule(module);
+  EXPECT_EQ(timeslot->getContentHash(), timeslotHash);
+  EXPECT_EQ(plan->getWeeksHash(), weeksHash);
+  EXPECT_EQ(plan->getContentHash(), planHash);
+}
+
+TEST(contentHashTests, incrementalHashMatchesReloadedPlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  plan->getModules()[0]->setNumber("1234");
+  plan->getGroups()[0]->setActive(!plan->getGroups()[0]->getActive());
+  firstTimeslot(plan.get())->addModule(plan->getModules()[1]);
+  firstTimeslot(plan.get())->removeActiveGroup(plan->getGroups()[1]);
+  plan->addNewConstraint("constraint");
+  plan->setName("changed");
+
+  EXPECT_EQ(plan->getContentHash(), reloadedContentHash(plan.get()));
+}
+
+TEST(contentHashTests, jsonHashMatchesCreatedPlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  EXPECT_EQ(Plan::contentHashOf(getValidJsonPlan()), plan->getContentHash());
+
+  Module* module = plan->getModules()[0];
+  module->setPinned(true);
+  module->setGroups({});
+  firstTimeslot(plan.get())->addModule(module);
+  plan->getConstraints()[0]->setExamsPerDay(3);
+  EXPECT_EQ(Plan::contentHashOf(plan->toJsonObject()), plan->getContentHash());
+}
+
+TEST(contentHashTests, jsonHashSkipsLikeFromJsonObject) {
+  QJsonObject content = getValidJsonPlan();
+  QJsonArray modules = content.value("modules").toArray();
+  QJsonObject module = modules[0].toObject();
+  module.insert("examType", "X");
+  module.insert("examDuration", 3);
+  QJsonArray groups = module.value("groups").toArray();
+  groups.append(QUuid::createUuid().toString());
+  module.insert("groups", groups);
+  modules[0] = module;
+  content.insert("modules", modules);
+
+  Plan plan;
+  plan.fromJsonObject(content);
+  EXPECT_EQ(Plan::contentHashOf(content), plan.getContentHash());
+}
+
+TEST(contentHashTests, replacedObjectsAreNoLongerTracked) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<Module*> modules = plan->getModules();
+  Module* removedModule = modules.takeLast();
+  plan->setModules(modules);
+  quint64 planHash = plan->getContentHash();
+
+  removedModule->setName("removed");
+  EXPECT_EQ(plan->getContentHash(), planHash);
+}
+
+TEST(contentHashTests, semesterHashFollowsPlans) {
+  Semester semester;
+  Plan* plan = new Plan(&semester);
+  plan->fromJsonObject(getValidJsonPlan());
+  semester.setPlans({plan});
+  quint64 semesterHash = semester.getContentHash();
+
+  plan->getGroups()[0]->setSmall(!plan->getGroups()[0]->getSmall());
+  EXPECT_NE(semester.getContentHash(), semesterHash);
+}
+
+TEST(contentHashTests, unorderedListHashSupportsReplacement) {
+  quint64 hash = ContentHash::mix(1) + ContentHash::mix(2);
+  EXPECT_EQ(ContentHash::replace(hash, 2, 3),
+            ContentHash::mix(1) + ContentHash::mix(3));
+}
+
+#endif  // CONTENTHASH_TEST_CPP
@@ -0,0 +1,153 @@
+#ifndef EXAMLOADMATRIX_TEST_CPP
+#define EXAMLOADMATRIX_TEST_CPP
+
+#include <examloadmatrix.h>
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <QSharedPointer>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+int scanCount(Group* group, Day* day) {
+  int count = 0;
+  for (Timeslot* timeslot : day->getTimeslots()) {
+    for (Module* module : timeslot->getModules()) {
+      if (module->getGroups().contains(group)) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+void expectMatchesScan(Plan* plan, ExamLoadMatrix& matrix) {
+  for (Group* group : plan->getGroups()) {
+    int total = 0;
+    for (Week* week : plan->getWeeks()) {
+      for (Day* day : week->getDays()) {
+        int count = scanCount(group, day);
+        EXPECT_EQ(matrix.getCount(group, day), count);
+        total += count;
+      }
+    }
+    EXPECT_EQ(matrix.getTotal(group), total);
+  }
+}
+
+void schedule(Plan* plan) {
+  QList<Module*> modules = plan->getModules();
+  for (Week* week : plan->getWeeks()) {
+    for (Day* day : week->getDays()) {
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        timeslot->setModules({});
+      }
+    }
+  }
+  for (int i = 0; i < modules.size(); i++) {
+    Day* day = plan->getWeeks()[i % 3]->getDays()[i % 6];
+    day->getTimeslots()[i % 5]->addModule(modules[i]);
+  }
+}
+}  // namespace
+
+TEST(examLoadMatrixTests, matrixMatchesFullScan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  schedule(plan.get());
+  ExamLoadMatrix matrix(plan.get());
+  EXPECT_EQ(matrix.getGroups(), plan->getGroups());
+  EXPECT_EQ(matrix.getDays().size(), 18);
+  expectMatchesScan(plan.get(), matrix);
+  EXPECT_EQ(matrix.getCounts(plan->getGroups()[0]).size(), 18);
+  EXPECT_TRUE(matrix.getCounts(nullptr).isEmpty());
+  EXPECT_EQ(matrix.getCount(-1, 0), 0);
+}
+
+TEST(examLoadMatrixTests, matrixFollowsSchedule) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  schedule(plan.get());
+  ExamLoadMatrix* matrix = plan->getExamLoadMatrix();
+  EXPECT_EQ(plan->getExamLoadMatrix(), matrix);
+  Module* module = plan->getModules()[0];
+  ASSERT_FALSE(module->getGroups().isEmpty());
+  Group* group = module->getGroups().first();
+  Day* day = plan->getWeeks()[2]->getDays()[5];
+  int count = matrix->getCount(group, day);
+  int total = matrix->getTotal(group);
+
+  QList<int> notified;
+  QObject::connect(matrix, &ExamLoadMatrix::countChanged,
+                   [&notified, group, day](Group* changedGroup,
+                                           Day* changedDay, int value) {
+                     if (changedGroup == group && changedDay == day) {
+                       notified.append(value);
+                     }
+                   });
+  day->getTimeslots()[5]->addModule(module);
+  EXPECT_EQ(matrix->getCount(group, day), count + 1);
+  EXPECT_EQ(matrix->getTotal(group), total + 1);
+  EXPECT_THAT(notified, ElementsAre(count + 1));
+
+  day->getTimeslots()[5]->removeModule(module);
+  EXPECT_EQ(matrix->getCount(group, day), count);
+  EXPECT_EQ(matrix->getTotal(group), total);
+
+  module->removeGroup(group);
+  expectMatchesScan(plan.get(), *matrix);
+  plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0]->setModules({});
+  expectMatchesScan(plan.get(), *matrix);
+}
+
+TEST(examLoadMatrixTests, matrixFollowsModuleList) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  schedule(plan.get());
+  ExamLoadMatrix matrix(plan.get());
+  // The first module is scheduled on the first day
+  Module* module = plan->getModules()[0];
+  ASSERT_FALSE(module->getGroups().isEmpty());
+  Group* group = module->getGroups().first();
+  Day* day = plan->getWeeks()[0]->getDays()[0];
+  int count = matrix.getCount(group, day);
+
+  QList<Module*> modules = plan->getModules();
+  plan->setModules(modules.mid(1));
+  EXPECT_EQ(matrix.getCount(group, day), count - 1);
+  // Removed modules are no longer followed
+  module->removeGroup(group);
+  EXPECT_EQ(matrix.getCount(group, day), count - 1);
+
+  module->setGroups(module->getGroups() << group);
+  plan->setModules(modules);
+  EXPECT_EQ(matrix.getCount(group, day), count);
+  expectMatchesScan(plan.get(), matrix);
+}
+
+TEST(examLoadMatrixTests, limitsAreChecked) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  schedule(plan.get());
+  ExamLoadMatrix matrix(plan.get());
+  Module* module = plan->getModules()[0];
+  ASSERT_FALSE(module->getGroups().isEmpty());
+  Group* group = module->getGroups().first();
+  Day* day = plan->getWeeks()[1]->getDays()[3];
+  for (Timeslot* timeslot : day->getTimeslots()) {
+    timeslot->setModules({});
+  }
+  group->setExamsPerDay(1);
+
+  EXPECT_TRUE(matrix.canAdd(module, day));
+  day->getTimeslots()[0]->addModule(module);
+  EXPECT_FALSE(matrix.isOverloaded(group, day));
+  EXPECT_FALSE(matrix.canAdd(module, day));
+  day->getTimeslots()[3]->addModule(module);
+  EXPECT_TRUE(matrix.isOverloaded(group, day));
+  EXPECT_TRUE(matrix.getOverloadedDays(group).contains(day));
+
+  group->setExamsPerDay(2);
+  EXPECT_FALSE(matrix.isOverloaded(group, day));
+  EXPECT_FALSE(matrix.getOverloadedDays(group).contains(day));
+}
+
+#endif  // EXAMLOADMATRIX_TEST_CPP
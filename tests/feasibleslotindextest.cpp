@@ -0,0 +1,172 @@
+#ifndef FEASIBLESLOTINDEX_TEST_CPP
+#define FEASIBLESLOTINDEX_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <feasibleslotindex.h>
+#include <slotmask.h>
+#include <QSharedPointer>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+bool allActive(Module* module, Timeslot* timeslot) {
+  for (Group* group : module->getGroups() + module->getConstraints()) {
+    if (!timeslot->containsActiveGroup(group)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+QList<Timeslot*> expectedTimeslots(Plan* plan, Module* module) {
+  QList<Timeslot*> result;
+  for (Week* week : plan->getWeeks()) {
+    for (Day* day : week->getDays()) {
+      QList<Timeslot*> timeslots = day->getTimeslots();
+      for (int i = 0; i < timeslots.size(); i++) {
+        bool feasible = allActive(module, timeslots[i]);
+        if (module->getExamDuration() == 2) {
+          feasible = feasible && i + 1 < timeslots.size() &&
+                     allActive(module, timeslots[i + 1]);
+        }
+        if (feasible) {
+          result.append(timeslots[i]);
+        }
+      }
+    }
+  }
+  return result;
+}
+}  // namespace
+
+TEST(slotMaskTests, setAndTestBits) {
+  SlotMask mask(130);
+  mask.setBit(0);
+  mask.setBit(64);
+  mask.setBit(129);
+  mask.setBit(130);
+  EXPECT_TRUE(mask.testBit(64));
+  EXPECT_FALSE(mask.testBit(63));
+  EXPECT_EQ(mask.count(), 3);
+  EXPECT_EQ(mask.toList(), QList<int>({0, 64, 129}));
+  mask.setBit(64, false);
+  EXPECT_EQ(mask.count(), 2);
+}
+
+TEST(slotMaskTests, invertKeepsSize) {
+  SlotMask mask(70);
+  mask.setBit(3);
+  SlotMask inverted = ~mask;
+  EXPECT_EQ(inverted.count(), 69);
+  EXPECT_FALSE(inverted.testBit(3));
+  EXPECT_FALSE((mask & inverted).any());
+  EXPECT_EQ((mask | inverted), SlotMask(70, true));
+}
+
+TEST(slotMaskTests, shiftedMovesBitsAcrossWords) {
+  SlotMask mask(130);
+  mask.setBit(64);
+  mask.setBit(0);
+  EXPECT_EQ(mask.shifted(1).toList(), QList<int>({63}));
+  EXPECT_EQ(mask.shifted(-1).toList(), QList<int>({1, 65}));
+  EXPECT_EQ(mask.shifted(-66).toList(), QList<int>({66}));
+}
+
+TEST(feasibleSlotIndexTests, indexContainsAllTimeslots) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  FeasibleSlotIndex index(plan.get());
+  EXPECT_EQ(index.getSlotCount(), 108);
+  Timeslot* timeslot = plan->getWeeks()[1]->getDays()[0]->getTimeslots()[2];
+  EXPECT_EQ(index.indexOf(timeslot), 38);
+  EXPECT_EQ(index.getTimeslots()[38], timeslot);
+}
+
+TEST(feasibleSlotIndexTests, feasibleSlotsMatchActiveGroups) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  FeasibleSlotIndex index(plan.get());
+  for (Module* module : plan->getModules()) {
+    EXPECT_EQ(index.getFeasibleTimeslots(module),
+              expectedTimeslots(plan.get(), module))
+        << "Wrong slots for module " << module->getName().toStdString();
+  }
+}
+
+TEST(feasibleSlotIndexTests, removingActiveGroupUpdatesModules) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  FeasibleSlotIndex index(plan.get());
+  Module* module = plan->getModules()[0];
+  ASSERT_FALSE(module->getGroups().isEmpty());
+  QList<Timeslot*> feasible = index.getFeasibleTimeslots(module);
+  ASSERT_FALSE(feasible.isEmpty());
+  Timeslot* timeslot = feasible[0];
+
+  QList<Module*> changedModules;
+  QObject::connect(&index, &FeasibleSlotIndex::feasibleSlotsChanged,
+                   [&changedModules](Module* module) {
+                     changedModules.append(module);
+                   });
+  timeslot->removeActiveGroup(module->getGroups()[0]);
+  EXPECT_FALSE(index.isFeasible(module, timeslot));
+  EXPECT_TRUE(changedModules.contains(module));
+
+  timeslot->addActiveGroup(module->getGroups()[0]);
+  EXPECT_TRUE(index.isFeasible(module, timeslot));
+}
+
+TEST(feasibleSlotIndexTests, changingGroupsUpdatesModule) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  FeasibleSlotIndex index(plan.get());
+  Module* module = plan->getModules()[0];
+
+  module->setGroups({});
+  module->setConstraints({});
+  EXPECT_EQ(index.getFeasibleSlots(module).count(), 108);
+
+  module->setConstraints({plan->getConstraints()[0]});
+  EXPECT_EQ(index.getFeasibleTimeslots(module),
+            expectedTimeslots(plan.get(), module));
+}
+
+TEST(feasibleSlotIndexTests, longExamsNeedTwoConsecutiveSlots) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  FeasibleSlotIndex index(plan.get());
+  Module* module = plan->getModules()[0];
+  module->setExamDuration(2);
+  EXPECT_EQ(index.getFeasibleTimeslots(module),
+            expectedTimeslots(plan.get(), module));
+
+  module->setGroups({});
+  module->setConstraints({});
+  SlotMask mask = index.getFeasibleSlots(module);
+  EXPECT_EQ(mask.count(), 90);
+  EXPECT_FALSE(mask.testBit(5));
+  EXPECT_TRUE(mask.testBit(6));
+}
+
+TEST(feasibleSlotIndexTests, addingAndRemovingModulesUpdatesIndex) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  FeasibleSlotIndex* index = plan->getFeasibleSlotIndex();
+  EXPECT_EQ(plan->getFeasibleSlotIndex(), index);
+  Module* kept = plan->getModules()[1];
+  SlotMask keptSlots = index->getFeasibleSlots(kept);
+
+  Module* module = new Module(plan.get());
+  module->setConstraints({plan->getConstraints()[0]});
+  QList<Module*> modules = plan->getModules();
+  modules.append(module);
+  plan->setModules(modules);
+  EXPECT_EQ(index->getFeasibleTimeslots(module),
+            expectedTimeslots(plan.get(), module));
+  EXPECT_EQ(index->getFeasibleSlots(kept), keptSlots);
+
+  modules.removeOne(module);
+  plan->setModules(modules);
+  EXPECT_FALSE(index->getFeasibleSlots(module).any());
+  EXPECT_EQ(index->getFeasibleSlots(kept), keptSlots);
+  delete module;
+}
+
+#endif  // FEASIBLESLOTINDEX_TEST_CPP
@@ -0,0 +1,138 @@
+#ifndef GROUPINDEX_TEST_CPP
+#define GROUPINDEX_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <groupindex.h>
+#include <gtest/gtest.h>
+#include <QSharedPointer>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+QList<Timeslot*> scanTimeslots(Plan* plan, Group* group) {
+  QList<Timeslot*> result;
+  for (Timeslot* timeslot : getTimeslots(plan)) {
+    if (timeslot->containsActiveGroup(group)) {
+      result.append(timeslot);
+    }
+  }
+  return result;
+}
+
+QList<Module*> scanModules(Plan* plan, Group* group) {
+  QList<Module*> result;
+  for (Module* module : plan->getModules()) {
+    if (module->getGroups().contains(group) ||
+        module->getConstraints().contains(group)) {
+      result.append(module);
+    }
+  }
+  return result;
+}
+
+void expectMatchesScan(Plan* plan, GroupIndex& index) {
+  for (Group* group : plan->getGroups() + plan->getConstraints()) {
+    EXPECT_THAT(index.getTimeslots(group),
+                UnorderedElementsAreArray(scanTimeslots(plan, group)));
+    EXPECT_THAT(index.getModules(group),
+                UnorderedElementsAreArray(scanModules(plan, group)));
+  }
+}
+}  // namespace
+
+TEST(groupIndexTests, indexMatchesFullScan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  GroupIndex index(plan.get());
+  expectMatchesScan(plan.get(), index);
+  Group* group = plan->getModules()[0]->getGroups().first();
+  EXPECT_GT(index.getModuleCount(group), 0);
+  EXPECT_GT(index.getTimeslotCount(group), 0);
+  EXPECT_EQ(index.getModuleCount(nullptr), 0);
+  EXPECT_TRUE(index.getTimeslots(nullptr).isEmpty());
+}
+
+TEST(groupIndexTests, indexFollowsChanges) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  GroupIndex index(plan.get());
+  Module* module = plan->getModules()[0];
+  Group* group = module->getGroups().first();
+  int moduleCount = index.getModuleCount(group);
+  int timeslotCount = index.getTimeslotCount(group);
+
+  module->removeGroup(group);
+  EXPECT_EQ(index.getModuleCount(group), moduleCount - 1);
+  EXPECT_FALSE(index.getModules(group).contains(module));
+  module->setConstraints(module->getConstraints() << group);
+  EXPECT_TRUE(index.getModules(group).contains(module));
+
+  Timeslot* timeslot = index.getTimeslots(group).first();
+  timeslot->removeActiveGroup(group);
+  EXPECT_EQ(index.getTimeslotCount(group), timeslotCount - 1);
+  timeslot->addActiveGroup(group);
+  EXPECT_EQ(index.getTimeslotCount(group), timeslotCount);
+
+  Module* newModule = new Module(plan.get());
+  newModule->setGroups({group});
+  plan->setModules(plan->getModules() << newModule);
+  EXPECT_TRUE(index.getModules(group).contains(newModule));
+  expectMatchesScan(plan.get(), index);
+}
+
+TEST(groupIndexTests, indexFollowsModuleList) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  GroupIndex index(plan.get());
+  Module* module = plan->getModules()[0];
+  Group* group = module->getGroups().first();
+
+  QList<Module*> modules = plan->getModules();
+  modules.removeOne(module);
+  plan->setModules(modules);
+  EXPECT_FALSE(index.getModules(group).contains(module));
+  // Removed modules are no longer followed
+  module->setConstraints({group});
+  EXPECT_FALSE(index.getModules(group).contains(module));
+  expectMatchesScan(plan.get(), index);
+
+  Module* newModule = new Module(plan.get());
+  plan->setModules(plan->getModules() << newModule);
+  newModule->setGroups({group});
+  EXPECT_TRUE(index.getModules(group).contains(newModule));
+  expectMatchesScan(plan.get(), index);
+}
+
+TEST(groupIndexTests, removingGroupCascades) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Group* group = plan->getModules()[0]->getGroups().first();
+  QList<Module*> modules = scanModules(plan.get(), group);
+  ASSERT_FALSE(modules.isEmpty());
+  ASSERT_FALSE(scanTimeslots(plan.get(), group).isEmpty());
+
+  plan->removeGroup(group);
+  EXPECT_FALSE(plan->getGroups().contains(group));
+  EXPECT_TRUE(scanTimeslots(plan.get(), group).isEmpty());
+  EXPECT_TRUE(scanModules(plan.get(), group).isEmpty());
+  EXPECT_EQ(plan->getGroupIndex()->getModuleCount(group), 0);
+  EXPECT_EQ(plan->getGroupIndex()->getTimeslotCount(group), 0);
+  expectMatchesScan(plan.get(), *plan->getGroupIndex());
+}
+
+TEST(groupIndexTests, removingConstraintCascades) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  plan->addNewConstraint("Room");
+  Group* constraint = plan->getConstraints().last();
+  Module* module = plan->getModules()[3];
+  module->setConstraints(module->getConstraints() << constraint);
+  Timeslot* timeslot = getTimeslots(plan.get())[5];
+  timeslot->addActiveGroup(constraint);
+  // The index already exists, before the constraint is removed
+  EXPECT_EQ(plan->getGroupIndex()->getModuleCount(constraint), 1);
+
+  plan->removeConstraint(constraint);
+  EXPECT_FALSE(module->getConstraints().contains(constraint));
+  EXPECT_FALSE(timeslot->containsActiveGroup(constraint));
+  EXPECT_EQ(plan->getGroupIndex()->getTimeslotCount(constraint), 0);
+}
+
+#endif  // GROUPINDEX_TEST_CPP
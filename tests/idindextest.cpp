@@ -0,0 +1,135 @@
+#ifndef IDINDEX_TEST_CPP
+#define IDINDEX_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <idindex.h>
+#include <semester.h>
+#include <QSharedPointer>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+TEST(idIndexTests, findsAllObjectsOfPlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Week* week = plan->getWeeks()[1];
+  Day* day = week->getDays()[2];
+  Timeslot* timeslot = day->getTimeslots()[3];
+  Module* module = plan->getModules()[7];
+  Group* group = plan->getGroups()[4];
+
+  EXPECT_EQ(plan->findById(plan->getId()), plan.get());
+  EXPECT_EQ(plan->findById(week->getId()), week);
+  EXPECT_EQ(plan->findById(day->getId()), day);
+  EXPECT_EQ(plan->findById(timeslot->getId()), timeslot);
+  EXPECT_EQ(plan->findById(module->getId()), module);
+  EXPECT_EQ(plan->findById(group->getId()), group);
+  EXPECT_EQ(plan->findById(QUuid::createUuid()), nullptr);
+
+  EXPECT_EQ(plan->findById<Module>(module->getId()), module);
+  EXPECT_EQ(plan->findById<Group>(module->getId()), nullptr);
+
+  IdIndex index(plan.get());
+  int timeslotCount = 0;
+  int dayCount = 0;
+  for (Week* planWeek : plan->getWeeks()) {
+    dayCount += planWeek->getDays().size();
+    for (Day* planDay : planWeek->getDays()) {
+      timeslotCount += planDay->getTimeslots().size();
+    }
+  }
+  EXPECT_EQ(index.getCount(),
+            1 + plan->getGroups().size() + plan->getConstraints().size() +
+                plan->getModules().size() + plan->getWeeks().size() +
+                dayCount + timeslotCount);
+}
+
+TEST(idIndexTests, followsAddedAndRemovedObjects) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  IdIndex index(plan.get());
+  int count = index.getCount();
+
+  Module* module = new Module(plan.get());
+  plan->setModules(plan->getModules() << module);
+  EXPECT_EQ(index.find(module->getId()), module);
+  EXPECT_EQ(index.getCount(), count + 1);
+
+  Module* removed = plan->getModules()[0];
+  QList<Module*> modules = plan->getModules();
+  modules.removeFirst();
+  plan->setModules(modules);
+  EXPECT_EQ(index.find(removed->getId()), nullptr);
+
+  plan->addNewConstraint("Room");
+  Group* constraint = plan->getConstraints().last();
+  EXPECT_EQ(index.find(constraint->getId()), constraint);
+  plan->removeConstraint(constraint);
+  EXPECT_EQ(index.find(constraint->getId()), nullptr);
+  EXPECT_EQ(index.getCount(), count);
+}
+
+TEST(idIndexTests, followsTimeslotGrid) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  IdIndex index(plan.get());
+  Week* week = plan->getWeeks()[0];
+  Day* day = week->getDays()[0];
+  Timeslot* timeslot = day->getTimeslots()[0];
+
+  Timeslot* newTimeslot = new Timeslot(day);
+  day->setTimeslots(day->getTimeslots().mid(1) << newTimeslot);
+  EXPECT_EQ(index.find(timeslot->getId()), nullptr);
+  EXPECT_EQ(index.find(newTimeslot->getId()), newTimeslot);
+
+  // Removing a day removes its timeslots as well
+  Timeslot* otherTimeslot = week->getDays()[1]->getTimeslots()[2];
+  week->setDays({day});
+  EXPECT_EQ(index.find(otherTimeslot->getId()), nullptr);
+  EXPECT_EQ(index.find(newTimeslot->getId()), newTimeslot);
+
+  plan->setWeeks({});
+  EXPECT_EQ(index.find(day->getId()), nullptr);
+  EXPECT_EQ(index.find(newTimeslot->getId()), nullptr);
+}
+
+TEST(idIndexTests, semesterFindsObjectsOfAllPlans) {
+  QSharedPointer<Plan> first = getValidPlan();
+  QSharedPointer<Plan> second = getValidPlan();
+  Module* module = new Module(second.get());
+  second->setModules(second->getModules() << module);
+  Semester semester;
+  semester.setPlans({first.get(), second.get()});
+
+  EXPECT_EQ(semester.findById(module->getId()), module);
+  EXPECT_EQ(semester.findById<Module>(module->getId()), module);
+  // Both plans were loaded from the same file, so the first one is found
+  Module* firstModule = first->getModules()[0];
+  EXPECT_EQ(semester.findById(firstModule->getId()), firstModule);
+  EXPECT_EQ(semester.findById(QUuid::createUuid()), nullptr);
+}
+
+TEST(idIndexTests, semesterIndexFollowsPlans) {
+  Semester semester;
+  Plan* plan = new Plan(&semester);
+  plan->fromJsonObject(getValidJsonPlan());
+  semester.setPlans({plan});
+  EXPECT_EQ(semester.findById(plan->getId()), plan);
+
+  Module* module = new Module(plan);
+  QUuid moduleId = module->getId();
+  QList<Module*> modules = plan->getModules();
+  plan->setModules(modules + QList<Module*>{module});
+  EXPECT_EQ(semester.findById(moduleId), module);
+  plan->setModules(modules);
+  EXPECT_EQ(semester.findById(moduleId), nullptr);
+
+  QUuid groupId = plan->getGroups()[0]->getId();
+  ASSERT_TRUE(semester.unloadPlan(0));
+  Group* group = semester.findById<Group>(groupId);
+  ASSERT_NE(group, nullptr);
+  EXPECT_TRUE(semester.isPlanLoaded(0));
+  EXPECT_EQ(group->parent(), semester.getPlan(0));
+  EXPECT_EQ(semester.findById(moduleId), nullptr);
+}
+
+#endif  // IDINDEX_TEST_CPP
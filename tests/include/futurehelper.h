@@ -0,0 +1,60 @@
+#ifndef FUTURE_HELPER_H
+#define FUTURE_HELPER_H
+
+/**
+ * This file contains functions to test asynchronous code
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFuture>
+
+/**
+ *  @brief Make sure there is a QCoreApplication
+ *
+ * Asynchronous functions deliver their results through the event loop, which
+ * requires a QCoreApplication. The application is never deleted.
+ */
+inline void ensureCoreApplication() {
+  if (QCoreApplication::instance() == nullptr) {
+    static int argc = 1;
+    static char name[] = "pruefungsplaner-datamodel-tests";
+    static char* argv[] = {name, nullptr};
+    new QCoreApplication(argc, argv);
+  }
+}
+
+/**
+ *  @brief Process events until the condition is true
+ *  @param condition is checked after every iteration of the event loop
+ *  @param timeout is the maximum time to wait in milliseconds
+ *  @return True if the condition became true before the timeout
+ */
+template <typename Condition>
+inline bool processEventsUntil(Condition condition, int timeout = 10000) {
+  ensureCoreApplication();
+  QElapsedTimer timer;
+  timer.start();
+  while (!condition()) {
+    if (timer.hasExpired(timeout)) {
+      return false;
+    }
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  }
+  return true;
+}
+
+/**
+ *  @brief Process events until the future is finished
+ *  @param future is the future
+ *  @param timeout is the maximum time to wait in milliseconds
+ *  @return True if the future finished before the timeout
+ */
+template <typename T>
+inline bool waitForFuture(QFuture<T> future, int timeout = 10000) {
+  return processEventsUntil([&future]() { return future.isFinished(); },
+                            timeout);
+}
+
+#endif
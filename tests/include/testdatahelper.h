@@ -9,10 +9,12 @@
 #include <gtest/gtest.h>
 #include <QDir>
 #include <QFile>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QQueue>
 #include <QSharedPointer>
 #include <QString>
+#include <QUuid>
 #include "plan.h"
 
 /**
@@ -109,6 +111,54 @@ inline QJsonObject getInvalidJsonPlan() {
   return document.object();
 }
 
+/**
+ *  @brief Create the JSON object of a semester with copies of the valid plan
+ *  @param planCount is the number of plans
+ *  @return The semester, its plans have new ids and the names "Plan <i>",
+ * but share the ids of all of their other objects
+ */
+inline QJsonObject getSemesterJson(int planCount) {
+  QJsonArray plans;
+  for (int i = 0; i < planCount; i++) {
+    QJsonObject plan = getValidJsonPlan();
+    plan.insert("id", QUuid::createUuid().toString());
+    plan.insert("name", QString("Plan %1").arg(i));
+    plans.append(plan);
+  }
+  QJsonObject semester;
+  semester.insert("id", QUuid::createUuid().toString());
+  semester.insert("objectName", "");
+  semester.insert("name", "Wintersemester");
+  semester.insert("plans", plans);
+  return semester;
+}
+
+/**
+ *  @brief Get all timeslots of a plan
+ *  @param plan is the plan
+ *  @return The timeslots of all days of all weeks in the order of the plan
+ */
+inline QList<Timeslot*> getTimeslots(Plan* plan) {
+  QList<Timeslot*> timeslots;
+  for (Week* week : plan->getWeeks()) {
+    for (Day* day : week->getDays()) {
+      timeslots.append(day->getTimeslots());
+    }
+  }
+  return timeslots;
+}
+
+/**
+ *  @brief Remove a module from all timeslots of a plan
+ *  @param plan is the plan
+ *  @param module is the module
+ */
+inline void unschedule(Plan* plan, Module* module) {
+  for (Timeslot* timeslot : getTimeslots(plan)) {
+    timeslot->removeModule(module);
+  }
+}
+
 /**
  *  @brief Load all the files that are expected after successful scheduling into
  * a directory
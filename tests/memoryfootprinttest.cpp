@@ -0,0 +1,89 @@
+#ifndef MEMORYFOOTPRINT_TEST_CPP
+#define MEMORYFOOTPRINT_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <memoryfootprint.h>
+#include <QSharedPointer>
+#include "plan.h"
+#include "semester.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+TEST(memoryFootprintTests, nullptrHasNoFootprint) {
+  EXPECT_EQ(MemoryFootprintHelper::measure((Plan*)nullptr).total(), 0);
+  EXPECT_EQ(MemoryFootprintHelper::measure((Semester*)nullptr).total(), 0);
+}
+
+TEST(memoryFootprintTests, validPlanHasFootprintInEveryCategory) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  MemoryFootprint footprint = MemoryFootprintHelper::measure(plan.get());
+  EXPECT_GT(footprint.plans, 0);
+  EXPECT_GT(footprint.modules, 0);
+  EXPECT_GT(footprint.groups, 0);
+  EXPECT_GT(footprint.weeks, 0);
+  EXPECT_GT(footprint.days, 0);
+  EXPECT_GT(footprint.timeslots, 0);
+  EXPECT_GT(footprint.strings, 0);
+  EXPECT_GT(footprint.lists, 0);
+  EXPECT_EQ(footprint.semesters, 0);
+}
+
+TEST(memoryFootprintTests, totalIsSumOfCategories) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  MemoryFootprint footprint = MemoryFootprintHelper::measure(plan.get());
+  EXPECT_EQ(footprint.total(),
+            footprint.semesters + footprint.plans + footprint.modules +
+                footprint.groups + footprint.weeks + footprint.days +
+                footprint.timeslots + footprint.strings + footprint.lists +
+                footprint.connections + footprint.planContents);
+}
+
+TEST(memoryFootprintTests, addingGroupIncreasesFootprint) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  MemoryFootprint before = MemoryFootprintHelper::measure(plan.get());
+  plan->addNewGroup("a group with a long name");
+  MemoryFootprint after = MemoryFootprintHelper::measure(plan.get());
+  EXPECT_GT(after.groups, before.groups);
+  EXPECT_GT(after.strings, before.strings);
+  EXPECT_GT(after.total(), before.total());
+}
+
+TEST(memoryFootprintTests, connectionsAreCounted) {
+  Plan plan;
+  MemoryFootprint before = MemoryFootprintHelper::measure(&plan);
+  QObject receiver;
+  QObject::connect(&plan, &Plan::nameChanged, &receiver, [] {});
+  MemoryFootprint after = MemoryFootprintHelper::measure(&plan);
+  EXPECT_GT(after.connections, before.connections);
+}
+
+TEST(memoryFootprintTests, semesterContainsPlans) {
+  Semester semester;
+  QSharedPointer<Plan> plan = getValidPlan();
+  MemoryFootprint planFootprint = MemoryFootprintHelper::measure(plan.get());
+  semester.setPlans({plan.get()});
+  MemoryFootprint semesterFootprint =
+      MemoryFootprintHelper::measure(&semester);
+  EXPECT_GT(semesterFootprint.semesters, 0);
+  EXPECT_EQ(semesterFootprint.modules, planFootprint.modules);
+  EXPECT_GT(semesterFootprint.total(), planFootprint.total());
+  EXPECT_EQ(semesterFootprint.planContents, 0);
+}
+
+TEST(memoryFootprintTests, unloadedPlansCountWithTheirJson) {
+  Semester semester;
+  semester.fromJsonObject(getSemesterJson(2));
+  MemoryFootprint unloaded = MemoryFootprintHelper::measure(&semester);
+  EXPECT_GT(unloaded.planContents, 0);
+  EXPECT_EQ(unloaded.plans, 0);
+
+  ASSERT_NE(semester.getPlan(0), nullptr);
+  MemoryFootprint loaded = MemoryFootprintHelper::measure(&semester);
+  EXPECT_GT(loaded.plans, 0);
+  EXPECT_GT(loaded.planContents, 0);
+  EXPECT_LT(loaded.planContents, unloaded.planContents);
+}
+
+#endif  // MEMORYFOOTPRINT_TEST_CPP
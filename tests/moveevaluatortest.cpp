@@ -0,0 +1,314 @@
+#ifndef MOVEEVALUATOR_TEST_CPP
+#define MOVEEVALUATOR_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <moveevaluator.h>
+#include <QSharedPointer>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+QList<QList<Timeslot*>> getDays(Plan* plan) {
+  QList<QList<Timeslot*>> days;
+  for (Week* week : plan->getWeeks()) {
+    for (Day* day : week->getDays()) {
+      days.append(day->getTimeslots());
+    }
+  }
+  return days;
+}
+
+// Recalculates the cost of the whole plan without any counters
+ScheduleCost calculateCost(Plan* plan) {
+  ScheduleCost cost;
+  for (const QList<Timeslot*>& day : getDays(plan)) {
+    QHash<Group*, int> dayCounts;
+    QList<QList<Module*>> occupying;
+    for (int i = 0; i < day.size(); i++) {
+      occupying.append(QList<Module*>());
+    }
+    for (int i = 0; i < day.size(); i++) {
+      for (Module* module : day[i]->getModules()) {
+        for (Group* group : module->getGroups()) {
+          dayCounts[group]++;
+        }
+        for (unsigned int offset = 0; offset < module->getExamDuration();
+             offset++) {
+          if (i + static_cast<int>(offset) < day.size()) {
+            occupying[i + offset].append(module);
+          } else {
+            cost.blockedSlots +=
+                module->getGroups().size() + module->getConstraints().size();
+          }
+        }
+      }
+    }
+    for (auto iterator = dayCounts.constBegin();
+         iterator != dayCounts.constEnd(); iterator++) {
+      cost.examsPerDayOverflow +=
+          qMax(0, iterator.value() -
+                      static_cast<int>(iterator.key()->getExamsPerDay()));
+    }
+    for (int i = 0; i < day.size(); i++) {
+      QHash<Group*, int> slotCounts;
+      for (Module* module : occupying[i]) {
+        for (Group* group : module->getGroups()) {
+          slotCounts[group]++;
+        }
+        for (Group* group : module->getGroups() + module->getConstraints()) {
+          if (!day[i]->containsActiveGroup(group)) {
+            cost.blockedSlots++;
+          }
+        }
+      }
+      for (int count : slotCounts) {
+        cost.collisions += qMax(0, count - 1);
+      }
+    }
+  }
+  return cost;
+}
+
+Timeslot* findTimeslot(Plan* plan, Module* module) {
+  for (Timeslot* timeslot : getTimeslots(plan)) {
+    if (timeslot->containsModule(module)) {
+      return timeslot;
+    }
+  }
+  return nullptr;
+}
+
+void move(Module* module, Timeslot* from, Timeslot* to) {
+  if (from != nullptr) {
+    from->removeModule(module);
+  }
+  if (to != nullptr) {
+    to->addModule(module);
+  }
+}
+
+/**
+ *  Creates a plan with one week of two days with two timeslots each. Group x
+ * allows one exam per day and is not active in the second timeslot of the
+ * second day. Module a and b have group x, c has constraint y and an
+ * examDuration of 2.
+ */
+QSharedPointer<Plan> createSmallPlan() {
+  QSharedPointer<Plan> plan(new Plan());
+  plan->addNewGroup("x");
+  plan->addNewConstraint("y");
+  Group* x = plan->getGroups()[0];
+  Group* y = plan->getConstraints()[0];
+  x->setExamsPerDay(1);
+
+  Week* week = new Week(plan.get());
+  QList<Day*> days;
+  for (int i = 0; i < 2; i++) {
+    Day* day = new Day(week);
+    QList<Timeslot*> timeslots;
+    for (int j = 0; j < 2; j++) {
+      Timeslot* timeslot = new Timeslot(day);
+      timeslot->setActiveGroups({x, y});
+      timeslots.append(timeslot);
+    }
+    day->setTimeslots(timeslots);
+    days.append(day);
+  }
+  days[1]->getTimeslots()[1]->removeActiveGroup(x);
+  week->setDays(days);
+  plan->setWeeks({week});
+
+  QList<Module*> modules;
+  for (int i = 0; i < 3; i++) {
+    modules.append(new Module(plan.get()));
+  }
+  modules[0]->setGroups({x});
+  modules[1]->setGroups({x});
+  modules[2]->setConstraints({y});
+  modules[2]->setExamDuration(2);
+  plan->setModules(modules);
+  return plan;
+}
+}  // namespace
+
+TEST(moveEvaluatorTests, costOfSmallPlan) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.get());
+  QList<Module*> modules = plan->getModules();
+  MoveEvaluator evaluator(plan.get());
+  EXPECT_EQ(evaluator.getCost(), ScheduleCost());
+
+  timeslots[0]->addModule(modules[0]);
+  timeslots[0]->addModule(modules[1]);
+  ScheduleCost expected;
+  expected.collisions = 1;
+  expected.examsPerDayOverflow = 1;
+  EXPECT_EQ(evaluator.getCost(), expected);
+  EXPECT_EQ(evaluator.getSlotCount(plan->getGroups()[0], timeslots[0]), 2);
+
+  ScheduleCost delta;
+  delta.collisions = -1;
+  EXPECT_EQ(evaluator.evaluateMove(modules[1], timeslots[0], timeslots[1]),
+            delta);
+  delta.examsPerDayOverflow = -1;
+  EXPECT_EQ(evaluator.evaluateMove(modules[1], timeslots[0], timeslots[2]),
+            delta);
+  delta.blockedSlots = 1;
+  EXPECT_EQ(evaluator.evaluateMove(modules[1], timeslots[0], timeslots[3]),
+            delta);
+  EXPECT_EQ(evaluator.evaluateMove(modules[1], timeslots[1], timeslots[3]),
+            ScheduleCost());
+
+  // The second timeslot of c does not exist on the day
+  ScheduleCost missing;
+  missing.blockedSlots = 1;
+  EXPECT_EQ(evaluator.evaluateMove(modules[2], nullptr, timeslots[1]),
+            missing);
+  EXPECT_EQ(evaluator.evaluateMove(modules[2], nullptr, timeslots[2]),
+            ScheduleCost());
+}
+
+TEST(moveEvaluatorTests, costFollowsChangesOfPlan) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.get());
+  QList<Module*> modules = plan->getModules();
+  Group* x = plan->getGroups()[0];
+  MoveEvaluator evaluator(plan.get());
+  timeslots[0]->addModule(modules[0]);
+  timeslots[1]->addModule(modules[1]);
+  timeslots[2]->addModule(modules[2]);
+  EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get()));
+
+  timeslots[1]->removeActiveGroup(x);
+  EXPECT_EQ(evaluator.getCost().blockedSlots, 1);
+  x->setExamsPerDay(2);
+  EXPECT_EQ(evaluator.getCost().examsPerDayOverflow, 0);
+  modules[2]->setGroups({x});
+  EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get()));
+  modules[0]->setExamDuration(2);
+  EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get()));
+  timeslots[1]->addActiveGroup(x);
+  EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get()));
+  plan->addNewGroup("z");
+  EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get()));
+}
+
+TEST(moveEvaluatorTests, examsPerDayAreReadFromMatrix) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.get());
+  QList<Module*> modules = plan->getModules();
+  Group* x = plan->getGroups()[0];
+  Day* day = plan->getWeeks()[0]->getDays()[0];
+  MoveEvaluator evaluator(plan.get());
+  ExamLoadMatrix* matrix = plan->getExamLoadMatrix();
+  timeslots[0]->addModule(modules[0]);
+  timeslots[1]->addModule(modules[1]);
+  EXPECT_EQ(matrix->getCount(x, day), 2);
+  EXPECT_EQ(evaluator.getDayCount(x, day), 2);
+  EXPECT_EQ(evaluator.getCost().examsPerDayOverflow, 1);
+
+  matrix->rebuild();
+  EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get()));
+  // Scheduled modules, that are not in the plan, are not counted
+  plan->setModules({modules[0], modules[2]});
+  EXPECT_EQ(evaluator.getDayCount(x, day), 1);
+  EXPECT_EQ(evaluator.getCost().examsPerDayOverflow, 0);
+}
+
+TEST(moveEvaluatorTests, addingAndRemovingModulesUpdatesCost) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.get());
+  QList<Module*> modules = plan->getModules();
+  MoveEvaluator evaluator(plan.get());
+  timeslots[0]->addModule(modules[0]);
+  timeslots[0]->addModule(modules[1]);
+  timeslots[1]->addModule(modules[2]);
+
+  plan->setModules({modules[0], modules[2]});
+  EXPECT_EQ(evaluator.getSlotCount(plan->getGroups()[0], timeslots[0]), 1);
+  EXPECT_EQ(evaluator.getCost().collisions, 0);
+  EXPECT_EQ(evaluator.evaluateMove(modules[1], timeslots[0], timeslots[1]),
+            ScheduleCost());
+
+  plan->setModules(modules);
+  EXPECT_EQ(evaluator.getSlotCount(plan->getGroups()[0], timeslots[0]), 2);
+  EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get()));
+  timeslots[0]->removeModule(modules[1]);
+  EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get()));
+}
+
+TEST(moveEvaluatorTests, moveDeltaMatchesRecalculation) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.get());
+  QList<Module*> modules = plan->getModules();
+  for (int i = 0; i < 20; i++) {
+    timeslots[(i * 7) % timeslots.size()]->addModule(modules[i]);
+  }
+  MoveEvaluator evaluator(plan.get());
+  ASSERT_EQ(evaluator.getCost(), calculateCost(plan.get()));
+
+  for (int i = 0; i < 30; i++) {
+    Module* module = modules[(i * 5) % 25];
+    Timeslot* from = findTimeslot(plan.get(), module);
+    Timeslot* to = timeslots[(i * 11) % timeslots.size()];
+    ScheduleCost before = calculateCost(plan.get());
+    ScheduleCost delta = evaluator.evaluateMove(module, from, to);
+    move(module, from, to);
+    EXPECT_EQ(delta, calculateCost(plan.get()) - before) << i;
+    EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get())) << i;
+  }
+
+  Module* module = modules[0];
+  Timeslot* from = findTimeslot(plan.get(), module);
+  ScheduleCost before = calculateCost(plan.get());
+  ScheduleCost delta = evaluator.evaluateMove(module, from, nullptr);
+  move(module, from, nullptr);
+  EXPECT_EQ(delta, calculateCost(plan.get()) - before);
+}
+
+TEST(moveEvaluatorTests, swapDeltaMatchesRecalculation) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.get());
+  QList<Module*> modules = plan->getModules();
+  for (int i = 0; i < 20; i++) {
+    timeslots[(i * 3) % timeslots.size()]->addModule(modules[i]);
+  }
+  MoveEvaluator evaluator(plan.get());
+
+  for (int i = 0; i < 20; i++) {
+    Module* first = modules[i];
+    Module* second = modules[(i * 7 + 3) % 20];
+    Timeslot* firstTimeslot = findTimeslot(plan.get(), first);
+    Timeslot* secondTimeslot = findTimeslot(plan.get(), second);
+    ScheduleCost before = calculateCost(plan.get());
+    ScheduleCost delta =
+        evaluator.evaluateSwap(first, firstTimeslot, second, secondTimeslot);
+    move(first, firstTimeslot, secondTimeslot);
+    move(second, secondTimeslot, firstTimeslot);
+    EXPECT_EQ(delta, calculateCost(plan.get()) - before) << i;
+    EXPECT_EQ(evaluator.getCost(), calculateCost(plan.get())) << i;
+  }
+}
+
+TEST(moveEvaluatorTests, invalidMovesHaveNoDelta) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.get());
+  QList<Module*> modules = plan->getModules();
+  MoveEvaluator evaluator(plan.get());
+  Module other;
+  Timeslot otherTimeslot;
+  EXPECT_EQ(evaluator.evaluateMove(&other, nullptr, timeslots[0]),
+            ScheduleCost());
+  EXPECT_EQ(evaluator.evaluateMove(modules[0], timeslots[0], timeslots[1]),
+            ScheduleCost());
+  EXPECT_EQ(evaluator.evaluateMove(modules[0], nullptr, &otherTimeslot),
+            ScheduleCost());
+  EXPECT_EQ(evaluator.evaluateSwap(modules[0], timeslots[0], modules[1],
+                                   timeslots[1]),
+            ScheduleCost());
+}
+
+#endif  // MOVEEVALUATOR_TEST_CPP
@@ -0,0 +1,136 @@
+#ifndef PLANCHANGELOG_TEST_CPP
+#define PLANCHANGELOG_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <planchangelog.h>
+#include <QFile>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+Timeslot* getFirstTimeslot(Plan* plan) {
+  return plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0];
+}
+
+Module* getUnscheduledModule(Plan* plan, Timeslot* timeslot) {
+  for (Module* module : plan->getModules()) {
+    if (!timeslot->getModules().contains(module)) {
+      return module;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+TEST(planChangeLogTests, replaysChangesOnSnapshot) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  QString path = directory.filePath("plan.json");
+  QSharedPointer<Plan> plan = getValidPlan();
+  {
+    PlanChangeLog changeLog(path);
+    ASSERT_TRUE(changeLog.attach(plan.data()));
+    EXPECT_TRUE(QFile::exists(path));
+    qint64 emptySize = changeLog.getLogSize();
+
+    plan->getModules()[0]->setName("Umbenanntes Modul");
+    plan->getGroups()[0]->setExamsPerDay(
+        plan->getGroups()[0]->getExamsPerDay() + 1);
+    Timeslot* timeslot = getFirstTimeslot(plan.data());
+    Module* module = getUnscheduledModule(plan.data(), timeslot);
+    ASSERT_NE(module, nullptr);
+    timeslot->addModule(module);
+    EXPECT_GT(changeLog.getLogSize(), emptySize);
+  }
+
+  PlanChangeLog changeLog(path);
+  QScopedPointer<Plan> loaded(changeLog.load());
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(changeLog.getReplayedCount(), 3);
+  EXPECT_EQ(loaded->getModules()[0]->getName(), "Umbenanntes Modul");
+  EXPECT_EQ(loaded->getContentHash(), plan->getContentHash());
+}
+
+TEST(planChangeLogTests, compactionKeepsContent) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  QString path = directory.filePath("plan.json");
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanChangeLog changeLog(path);
+  ASSERT_TRUE(changeLog.attach(plan.data()));
+  qint64 emptySize = changeLog.getLogSize();
+  changeLog.setCompactionThreshold(emptySize + 1);
+
+  int compactions = 0;
+  QObject::connect(&changeLog, &PlanChangeLog::compacted,
+                   [&compactions](bool success) {
+                     EXPECT_TRUE(success);
+                     compactions++;
+                   });
+  plan->setName("Kompaktierter Plan");
+  EXPECT_TRUE(changeLog.isCompacting());
+  ASSERT_TRUE(changeLog.waitForCompaction());
+  EXPECT_EQ(compactions, 1);
+  EXPECT_EQ(changeLog.getLogSize(), emptySize);
+
+  PlanChangeLog reader(path);
+  QScopedPointer<Plan> loaded(reader.load());
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(reader.getReplayedCount(), 0);
+  EXPECT_EQ(loaded->getName(), "Kompaktierter Plan");
+  EXPECT_EQ(loaded->getContentHash(), plan->getContentHash());
+}
+
+TEST(planChangeLogTests, structureChangeWritesSnapshot) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  QString path = directory.filePath("plan.json");
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanChangeLog changeLog(path);
+  ASSERT_TRUE(changeLog.attach(plan.data()));
+
+  plan->addNewGroup("Neue Gruppe");
+  ASSERT_TRUE(changeLog.waitForCompaction());
+  // The new group is logged after the snapshot
+  plan->getGroups().last()->setExamsPerDay(
+      plan->getGroups().last()->getExamsPerDay() + 1);
+
+  PlanChangeLog reader(path);
+  QScopedPointer<Plan> loaded(reader.load());
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(reader.getReplayedCount(), 1);
+  EXPECT_EQ(loaded->getGroups().size(), plan->getGroups().size());
+  EXPECT_EQ(loaded->getContentHash(), plan->getContentHash());
+}
+
+TEST(planChangeLogTests, cutOffRecordIsIgnored) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  QString path = directory.filePath("plan.json");
+  QSharedPointer<Plan> plan = getValidPlan();
+  {
+    PlanChangeLog changeLog(path);
+    ASSERT_TRUE(changeLog.attach(plan.data()));
+    plan->setName("Vollstaendig");
+  }
+
+  QFile log(path + ".log");
+  ASSERT_TRUE(log.open(QIODevice::Append));
+  // The size of a record without the record
+  log.write(QByteArray::fromHex("00000040"));
+  log.close();
+
+  PlanChangeLog changeLog(path);
+  QScopedPointer<Plan> loaded(changeLog.load());
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(changeLog.getReplayedCount(), 1);
+  EXPECT_EQ(loaded->getName(), "Vollstaendig");
+}
+
+#endif  // PLANCHANGELOG_TEST_CPP
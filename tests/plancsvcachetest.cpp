@@ -0,0 +1,146 @@
+#ifndef PLANCSVCACHE_TEST_CPP
+#define PLANCSVCACHE_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <plancsvcache.h>
+#include <plancsvhelper.h>
+#include <QFile>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+#include "futurehelper.h"
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+TEST(planCsvCacheTests, fingerprintDependsOnFile) {
+  QTemporaryDir directory;
+  QString path = directory.path() + "/file.csv";
+  PlanCsvFileFingerprint missing = PlanCsvCache::createFingerprint(path);
+  EXPECT_EQ(missing.size, -1);
+
+  QFile file(path);
+  ASSERT_TRUE(file.open(QFile::WriteOnly));
+  file.write("content");
+  file.close();
+  PlanCsvFileFingerprint written = PlanCsvCache::createFingerprint(path);
+  EXPECT_EQ(written.size, 7);
+  EXPECT_EQ(written, PlanCsvCache::createFingerprint(path));
+  EXPECT_NE(written, missing);
+}
+
+TEST(planCsvCacheTests, lookupFindsInsertedData) {
+  PlanCsvCache cache;
+  QList<PlanCsvFileFingerprint> fingerprints = {
+      PlanCsvCache::createFingerprint("file.csv")};
+  PlanCsvData data;
+  data.groups.append(PlanCsvGroupData());
+  data.groups[0].name = "group";
+  cache.insert("key", fingerprints, {"content"}, data);
+
+  PlanCsvData cachedData;
+  ASSERT_TRUE(cache.lookup("key", fingerprints, {"content"}, cachedData));
+  ASSERT_EQ(cachedData.groups.size(), 1);
+  EXPECT_EQ(cachedData.groups[0].name, "group");
+  EXPECT_EQ(cache.getHits(), 1);
+}
+
+TEST(planCsvCacheTests, lookupDetectsChangedContent) {
+  PlanCsvCache cache;
+  QList<PlanCsvFileFingerprint> fingerprints = {
+      PlanCsvCache::createFingerprint("file.csv")};
+  cache.insert("key", fingerprints, {"old"}, PlanCsvData());
+
+  PlanCsvData data;
+  EXPECT_FALSE(cache.lookup("key", fingerprints, {"new"}, data));
+  EXPECT_FALSE(cache.lookup("otherKey", fingerprints, {"old"}, data));
+  EXPECT_EQ(cache.getMisses(), 2);
+}
+
+TEST(planCsvCacheTests, lookupDetectsChangedFingerprint) {
+  PlanCsvCache cache;
+  PlanCsvFileFingerprint fingerprint =
+      PlanCsvCache::createFingerprint("file.csv");
+  cache.insert("key", {fingerprint}, {"content"}, PlanCsvData());
+
+  PlanCsvFileFingerprint modified = fingerprint;
+  modified.lastModified = QDateTime::currentDateTime();
+  PlanCsvData data;
+  EXPECT_FALSE(cache.lookup("key", {modified}, {"content"}, data));
+  EXPECT_EQ(cache.getMisses(), 1);
+}
+
+TEST(planCsvCacheTests, clearRemovesEntries) {
+  PlanCsvCache cache;
+  cache.insert("key", {}, {}, PlanCsvData());
+  ASSERT_EQ(cache.size(), 1);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(planCsvCacheTests, readPlanUsesCacheForUnchangedFiles) {
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  QSharedPointer<PlanCsvCache> cache(new PlanCsvCache());
+  helper.setCache(cache);
+  helper.writePlan(plan.get());
+
+  QScopedPointer<Plan> firstPlan(helper.readPlan());
+  ASSERT_NE(firstPlan.get(), nullptr);
+  EXPECT_EQ(cache->getMisses(), 1);
+  EXPECT_EQ(cache->getHits(), 0);
+
+  QScopedPointer<Plan> secondPlan(helper.readPlan());
+  ASSERT_NE(secondPlan.get(), nullptr);
+  EXPECT_EQ(cache->getHits(), 1);
+  EXPECT_EQ(secondPlan->getModules().size(), firstPlan->getModules().size());
+  EXPECT_EQ(secondPlan->getGroups().size(), firstPlan->getGroups().size());
+}
+
+TEST(planCsvCacheTests, readPlanDetectsChangedFiles) {
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  QSharedPointer<PlanCsvCache> cache(new PlanCsvCache());
+  helper.setCache(cache);
+  helper.writePlan(plan.get());
+  QScopedPointer<Plan> firstPlan(helper.readPlan());
+  ASSERT_NE(firstPlan.get(), nullptr);
+
+  QList<Module*> modules = firstPlan->getModules();
+  modules.removeLast();
+  firstPlan->setModules(modules);
+  helper.writePlan(firstPlan.get());
+
+  QScopedPointer<Plan> secondPlan(helper.readPlan());
+  ASSERT_NE(secondPlan.get(), nullptr);
+  EXPECT_EQ(cache->getHits(), 0);
+  EXPECT_EQ(secondPlan->getModules().size(), modules.size());
+}
+
+TEST(planCsvCacheTests, readPlanAsyncUsesCache) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  QSharedPointer<PlanCsvCache> cache(new PlanCsvCache());
+  helper.setCache(cache);
+  helper.writePlan(plan.get());
+  QScopedPointer<Plan> syncReadPlan(helper.readPlan());
+
+  QFuture<Plan*> future = helper.readPlanAsync();
+  ASSERT_TRUE(waitForFuture(future));
+  QScopedPointer<Plan> readPlan(future.result());
+  ASSERT_NE(readPlan.get(), nullptr);
+  EXPECT_EQ(cache->getHits(), 1);
+  EXPECT_EQ(readPlan->getModules().size(), syncReadPlan->getModules().size());
+  EXPECT_EQ(future.progressValue(), future.progressMaximum());
+}
+
+#endif  // PLANCSVCACHE_TEST_CPP
@@ -4,6 +4,7 @@
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 #include <plancsvhelper.h>
+#include <QBuffer>
 #include <QDir>
 #include <QFile>
 #include <QJsonDocument>
@@ -13,6 +14,7 @@
 #include <QTextStream>
 #include "plan.h"
 #include "semester.h"
+#include "futurehelper.h"
 #include "qthelper.cpp"
 #include "testdatahelper.h"
 
@@ -576,4 +578,347 @@ TEST(planCsvHelperTests, writingAndReadingPlanPreservesSmallGroup) {
   ASSERT_EQ(readPlan->getGroups()[2]->getSmall(), false);
 }
 
+TEST(planCsvHelperTests, readPlanAsyncReadsWrittenPlan) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  helper.writePlan(plan.get());
+  QFuture<Plan*> future = helper.readPlanAsync();
+  ASSERT_TRUE(waitForFuture(future));
+  QScopedPointer<Plan> readPlan(future.result());
+  ASSERT_NE(readPlan.get(), nullptr);
+  QScopedPointer<Plan> syncReadPlan(helper.readPlan());
+  ASSERT_EQ(readPlan->getModules().size(), syncReadPlan->getModules().size());
+  ASSERT_EQ(readPlan->getGroups().size(), syncReadPlan->getGroups().size());
+  EXPECT_EQ(future.progressValue(), future.progressMaximum());
+}
+
+TEST(planCsvHelperTests, readPlanAsyncReturnsNullptrOnFailure) {
+  ensureCoreApplication();
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  QFuture<Plan*> future = helper.readPlanAsync();
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_EQ(future.result(), nullptr);
+}
+
+TEST(planCsvHelperTests, readPlanAsyncSetsParent) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  helper.writePlan(plan.get());
+  Semester semester;
+  QFuture<Plan*> future = helper.readPlanAsync(&semester);
+  ASSERT_TRUE(waitForFuture(future));
+  ASSERT_NE(future.result(), nullptr);
+  EXPECT_EQ(future.result()->parent(), &semester);
+}
+
+TEST(planCsvHelperTests, writePlanAsyncCreatesFiles) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  QFuture<bool> future = helper.writePlanAsync(plan.get());
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_TRUE(future.result());
+  EXPECT_TRUE(helper.isWritten());
+}
+
+TEST(planCsvHelperTests, writePlanAsyncReturnsFalseWithNullptr) {
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  QFuture<bool> future = helper.writePlanAsync(nullptr);
+  ASSERT_TRUE(future.isFinished());
+  EXPECT_FALSE(future.result());
+}
+
+TEST(planCsvHelperTests, readScheduleAsyncReadsCorrectSchedule) {
+  ensureCoreApplication();
+  QTemporaryDir directory;
+  prepareScheduledDirectory(directory.path());
+
+  PlanCsvHelper helper(directory.path());
+  QScopedPointer<Plan> plan(helper.readPlan());
+  ASSERT_NE(plan.get(), nullptr);
+  QFuture<bool> future = helper.readScheduleAsync(plan.get());
+  ASSERT_TRUE(waitForFuture(future));
+  ASSERT_TRUE(future.result());
+  ASSERT_GE(
+      plan->getWeeks()[1]->getDays()[2]->getTimeslots()[4]->getModules().size(),
+      1);
+  EXPECT_EQ(plan->getWeeks()[1]
+                ->getDays()[2]
+                ->getTimeslots()[4]
+                ->getModules()[0]
+                ->getNumber(),
+            "30.2342");
+  EXPECT_EQ(future.progressValue(), future.progressMaximum());
+}
+
+TEST(planCsvHelperTests, writePlanToBuffersAndReadPlanFromBuffers) {
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QBuffer examsIntervals, exams, groupsExams, groupsExamsPref, result;
+  PlanCsvDevices devices;
+  devices.examsIntervals = &examsIntervals;
+  devices.exams = &exams;
+  devices.groupsExams = &groupsExams;
+  devices.groupsExamsPref = &groupsExamsPref;
+  devices.planningExamsResult = &result;
+  PlanCsvHelper helper(devices);
+  EXPECT_EQ(helper.getPath(), "");
+  EXPECT_TRUE(helper.isWritten());
+  ASSERT_TRUE(helper.writePlan(plan.get()));
+  EXPECT_GT(exams.data().size(), 0);
+  EXPECT_FALSE(exams.isOpen());
+
+  QTemporaryDir directory;
+  PlanCsvHelper fileHelper(directory.path());
+  ASSERT_TRUE(fileHelper.writePlan(plan.get()));
+  QFile examsFile(directory.path() + "/pruefungen.csv");
+  ASSERT_TRUE(examsFile.open(QFile::ReadOnly));
+  EXPECT_EQ(exams.data(), examsFile.readAll());
+
+  QScopedPointer<Plan> readPlan(helper.readPlan());
+  ASSERT_NE(readPlan.get(), nullptr);
+  QScopedPointer<Plan> fileReadPlan(fileHelper.readPlan());
+  ASSERT_NE(fileReadPlan.get(), nullptr);
+  EXPECT_EQ(readPlan->getModules().size(), fileReadPlan->getModules().size());
+  EXPECT_EQ(readPlan->getGroups().size(), fileReadPlan->getGroups().size());
+}
+
+TEST(planCsvHelperTests, writePlanTruncatesBuffers) {
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QBuffer examsIntervals, exams, groupsExams, groupsExamsPref;
+  exams.setData(QByteArray(1000000, 'x'));
+  PlanCsvDevices devices;
+  devices.examsIntervals = &examsIntervals;
+  devices.exams = &exams;
+  devices.groupsExams = &groupsExams;
+  devices.groupsExamsPref = &groupsExamsPref;
+  PlanCsvHelper helper(devices);
+  ASSERT_TRUE(helper.writePlan(plan.get()));
+  EXPECT_FALSE(exams.data().contains("xxx"));
+  EXPECT_FALSE(helper.isScheduled());
+}
+
+TEST(planCsvHelperTests, writePlanKeepsOpenDevicesOpen) {
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QBuffer examsIntervals, exams, groupsExams, groupsExamsPref;
+  ASSERT_TRUE(exams.open(QIODevice::WriteOnly));
+  PlanCsvDevices devices;
+  devices.examsIntervals = &examsIntervals;
+  devices.exams = &exams;
+  devices.groupsExams = &groupsExams;
+  devices.groupsExamsPref = &groupsExamsPref;
+  PlanCsvHelper helper(devices);
+  ASSERT_TRUE(helper.writePlan(plan.get()));
+  EXPECT_TRUE(exams.isOpen());
+  EXPECT_GT(exams.data().size(), 0);
+}
+
+TEST(planCsvHelperTests, writePlanFailsWithMissingDevice) {
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QBuffer examsIntervals, exams, groupsExams;
+  PlanCsvDevices devices;
+  devices.examsIntervals = &examsIntervals;
+  devices.exams = &exams;
+  devices.groupsExams = &groupsExams;
+  PlanCsvHelper helper(devices);
+  EXPECT_FALSE(helper.isWritten());
+  EXPECT_FALSE(helper.writePlan(plan.get()));
+}
+
+TEST(planCsvHelperTests, readScheduleWorksWithDevices) {
+  QFile examsIntervals(":/data/scheduled/pruef-intervalle.csv");
+  QFile exams(":/data/scheduled/pruefungen.csv");
+  QFile groupsExams(":/data/scheduled/zuege-pruef.csv");
+  QFile groupsExamsPref(":/data/scheduled/zuege-pruef-pref2.csv");
+  QFile result(":/data/scheduled/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv");
+  PlanCsvDevices devices;
+  devices.examsIntervals = &examsIntervals;
+  devices.exams = &exams;
+  devices.groupsExams = &groupsExams;
+  devices.groupsExamsPref = &groupsExamsPref;
+  devices.planningExamsResult = &result;
+  PlanCsvHelper helper(devices);
+
+  QScopedPointer<Plan> plan(helper.readPlan());
+  ASSERT_NE(plan.get(), nullptr);
+  ASSERT_TRUE(helper.readSchedule(plan.get()));
+  ASSERT_GE(
+      plan->getWeeks()[1]->getDays()[1]->getTimeslots()[2]->getModules().size(),
+      1);
+  EXPECT_EQ(plan->getWeeks()[1]
+                ->getDays()[1]
+                ->getTimeslots()[2]
+                ->getModules()[0]
+                ->getNumber(),
+            "30.2476");
+}
+
+TEST(planCsvHelperTests, writePlanAsyncWritesBuffers) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QBuffer examsIntervals, exams, groupsExams, groupsExamsPref;
+  PlanCsvDevices devices;
+  devices.examsIntervals = &examsIntervals;
+  devices.exams = &exams;
+  devices.groupsExams = &groupsExams;
+  devices.groupsExamsPref = &groupsExamsPref;
+  PlanCsvHelper helper(devices);
+  QFuture<bool> future = helper.writePlanAsync(plan.get());
+  ASSERT_TRUE(waitForFuture(future));
+  ASSERT_TRUE(future.result());
+  EXPECT_GT(exams.data().size(), 0);
+
+  QFuture<Plan*> readFuture = helper.readPlanAsync();
+  ASSERT_TRUE(waitForFuture(readFuture));
+  QScopedPointer<Plan> readPlan(readFuture.result());
+  ASSERT_NE(readPlan.get(), nullptr);
+}
+
+TEST(planCsvHelperTests, canceledReadPlanAsyncCreatesNoPlan) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  helper.writePlan(plan.get());
+  Semester semester;
+  QFuture<Plan*> future = helper.readPlanAsync(&semester);
+  future.cancel();
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_TRUE(future.isCanceled());
+  EXPECT_EQ(future.resultCount(), 0);
+  EXPECT_TRUE(semester.findChildren<Plan*>().isEmpty());
+}
+
+TEST(planCsvHelperTests, canceledWritePlanAsyncWritesNoBuffers) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+
+  QBuffer examsIntervals, exams, groupsExams, groupsExamsPref;
+  PlanCsvDevices devices;
+  devices.examsIntervals = &examsIntervals;
+  devices.exams = &exams;
+  devices.groupsExams = &groupsExams;
+  devices.groupsExamsPref = &groupsExamsPref;
+  PlanCsvHelper helper(devices);
+  QFuture<bool> future = helper.writePlanAsync(plan.get());
+  future.cancel();
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_TRUE(future.isCanceled());
+  EXPECT_EQ(future.resultCount(), 0);
+  EXPECT_EQ(exams.data().size(), 0);
+}
+
+TEST(planCsvHelperTests, canceledReadScheduleAsyncKeepsPlan) {
+  ensureCoreApplication();
+  QTemporaryDir directory;
+  prepareScheduledDirectory(directory.path());
+
+  PlanCsvHelper helper(directory.path());
+  QScopedPointer<Plan> plan(helper.readPlan());
+  ASSERT_NE(plan.get(), nullptr);
+  QByteArray before = QJsonDocument(plan->toJsonObject()).toJson();
+  QFuture<bool> future = helper.readScheduleAsync(plan.get());
+  future.cancel();
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_TRUE(future.isCanceled());
+  EXPECT_EQ(future.resultCount(), 0);
+  EXPECT_EQ(QJsonDocument(plan->toJsonObject()).toJson(), before);
+}
+
+TEST(planCsvHelperTests, readScheduleKeepsPinnedModules) {
+  QTemporaryDir directory;
+  prepareScheduledDirectory(directory.path());
+
+  PlanCsvHelper helper(directory.path());
+  QScopedPointer<Plan> plan(helper.readPlan());
+  ASSERT_NE(plan.get(), nullptr);
+  Module* pinnedModule = nullptr;
+  for (Module* module : plan->getModules()) {
+    if (module->getNumber() == "30.2476") {
+      pinnedModule = module;
+    }
+  }
+  ASSERT_NE(pinnedModule, nullptr);
+  Timeslot* pinnedTimeslot =
+      plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0];
+  pinnedTimeslot->addModule(pinnedModule);
+  pinnedModule->setPinned(true);
+  ASSERT_TRUE(helper.readSchedule(plan.get()));
+
+  EXPECT_TRUE(pinnedTimeslot->containsModule(pinnedModule));
+  EXPECT_FALSE(plan->getWeeks()[1]
+                   ->getDays()[1]
+                   ->getTimeslots()[2]
+                   ->containsModule(pinnedModule));
+  // The other modules are still scheduled
+  EXPECT_EQ(plan->getWeeks()[1]
+                ->getDays()[2]
+                ->getTimeslots()[4]
+                ->getModules()[0]
+                ->getNumber(),
+            "30.2342");
+}
+
+TEST(planCsvHelperTests, writePlanFixesPinnedModules) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  ASSERT_TRUE(module->getActive());
+  ASSERT_GE(module->getGroups().size(), 1);
+  Timeslot* timeslot = plan->getWeeks()[0]->getDays()[1]->getTimeslots()[2];
+  for (Group* group : module->getGroups()) {
+    timeslot->addActiveGroup(group);
+  }
+  timeslot->addModule(module);
+  module->setPinned(true);
+  QString groupName = module->getGroups()[0]->getName();
+
+  auto readGroupActive = [&groupName](Plan* readPlan) {
+    Timeslot* readTimeslot =
+        readPlan->getWeeks()[0]->getDays()[1]->getTimeslots()[2];
+    for (Group* group : readTimeslot->getActiveGroups()) {
+      if (group->getName() == groupName) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  EXPECT_FALSE(helper.getPinnedModulesFixed());
+  ASSERT_TRUE(helper.writePlan(plan.get()));
+  QScopedPointer<Plan> readPlan(helper.readPlan());
+  ASSERT_NE(readPlan.get(), nullptr);
+  EXPECT_TRUE(readPlan->getModules()[0]->getActive());
+  EXPECT_TRUE(readGroupActive(readPlan.get()));
+
+  helper.setPinnedModulesFixed(true);
+  ASSERT_TRUE(helper.writePlan(plan.get()));
+  readPlan.reset(helper.readPlan());
+  ASSERT_NE(readPlan.get(), nullptr);
+  EXPECT_FALSE(readPlan->getModules()[0]->getActive());
+  EXPECT_FALSE(readGroupActive(readPlan.get()));
+  // The fixed assignment is kept in the result file
+  ASSERT_TRUE(helper.readSchedule(readPlan.get()));
+  EXPECT_TRUE(readPlan->getWeeks()[0]
+                  ->getDays()[1]
+                  ->getTimeslots()[2]
+                  ->containsModule(readPlan->getModules()[0]));
+}
+
 #endif  // TEST_CPP
@@ -0,0 +1,187 @@
+#ifndef PLANCSVSCHEDULETAILER_TEST_CPP
+#define PLANCSVSCHEDULETAILER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <plancsvhelper.h>
+#include <plancsvscheduletailer.h>
+#include <QDir>
+#include <QFile>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+#include "futurehelper.h"
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+int countScheduledModules(Plan* plan) {
+  int count = 0;
+  for (Timeslot* timeslot : getTimeslots(plan)) {
+    count += timeslot->getModules().size();
+  }
+  return count;
+}
+
+void clearSchedule(Plan* plan) {
+  for (Timeslot* timeslot : getTimeslots(plan)) {
+    timeslot->setModules({});
+  }
+}
+
+/**
+ *  Creates the lines of a result file, that schedules two modules of plan
+ */
+QList<QByteArray> createResultLines(Plan* plan) {
+  clearSchedule(plan);
+  QList<Timeslot*> timeslots = getTimeslots(plan);
+  timeslots[8]->addModule(plan->getModules()[0]);
+  timeslots[100]->addModule(plan->getModules()[5]);
+  QTemporaryDir directory;
+  PlanCsvHelper helper(directory.path());
+  helper.writePlan(plan);
+  QFile file(directory.path() + "/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv");
+  file.open(QIODevice::ReadOnly);
+  QList<QByteArray> lines = file.readAll().split('\n');
+  while (!lines.isEmpty() && lines.last().isEmpty()) {
+    lines.removeLast();
+  }
+  clearSchedule(plan);
+  return lines;
+}
+
+bool append(const QString& path, const QByteArray& content) {
+  QFile file(path + "/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv");
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    return false;
+  }
+  return file.write(content) == content.size();
+}
+}  // namespace
+
+TEST(planCsvScheduleTailerTests, onlyCompleteLinesAreApplied) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<QByteArray> lines = createResultLines(plan.get());
+  ASSERT_EQ(lines.size(), 3);
+  QTemporaryDir directory;
+  ASSERT_TRUE(QDir().mkpath(directory.path() + "/SPA-ERGEBNIS-PP"));
+  PlanCsvScheduleTailer tailer(directory.path(), plan.get());
+  EXPECT_FALSE(tailer.readNewLines());
+
+  ASSERT_TRUE(append(directory.path(), lines[0] + "\n" + lines[1] + "\n" +
+                                           lines[2].left(10)));
+  ASSERT_TRUE(tailer.readNewLines());
+  EXPECT_EQ(tailer.getOffset(), lines[0].size() + lines[1].size() + 2);
+  EXPECT_EQ(tailer.getAppliedCount(), 1);
+  EXPECT_EQ(countScheduledModules(plan.get()), 1);
+
+  ASSERT_TRUE(append(directory.path(), lines[2].mid(10) + "\n"));
+  ASSERT_TRUE(tailer.readNewLines());
+  EXPECT_EQ(tailer.getAppliedCount(), 2);
+  EXPECT_EQ(tailer.getRejectedCount(), 0);
+  QList<Timeslot*> timeslots = getTimeslots(plan.get());
+  EXPECT_TRUE(timeslots[8]->containsModule(plan->getModules()[0]));
+  EXPECT_TRUE(timeslots[100]->containsModule(plan->getModules()[5]));
+}
+
+TEST(planCsvScheduleTailerTests, invalidLinesAreSkipped) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<QByteArray> lines = createResultLines(plan.get());
+  ASSERT_EQ(lines.size(), 3);
+  QTemporaryDir directory;
+  ASSERT_TRUE(QDir().mkpath(directory.path() + "/SPA-ERGEBNIS-PP"));
+  PlanCsvScheduleTailer tailer(directory.path(), plan.get());
+
+  QByteArray unknownModule = lines[1];
+  unknownModule.replace(0, 1, "X");
+  ASSERT_TRUE(append(directory.path(), lines[0] + "\nnot;a;line\n" +
+                                           unknownModule + "\n" + lines[2] +
+                                           "\n"));
+  ASSERT_TRUE(tailer.readNewLines());
+  EXPECT_EQ(tailer.getAppliedCount(), 1);
+  EXPECT_EQ(tailer.getRejectedCount(), 2);
+  EXPECT_EQ(countScheduledModules(plan.get()), 1);
+}
+
+TEST(planCsvScheduleTailerTests, replacedFileIsReadFromStart) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<QByteArray> lines = createResultLines(plan.get());
+  ASSERT_EQ(lines.size(), 3);
+  QTemporaryDir directory;
+  ASSERT_TRUE(QDir().mkpath(directory.path() + "/SPA-ERGEBNIS-PP"));
+  PlanCsvScheduleTailer tailer(directory.path(), plan.get());
+
+  ASSERT_TRUE(append(directory.path(),
+                     lines[0] + "\n" + lines[1] + "\n" + lines[2] + "\n"));
+  ASSERT_TRUE(tailer.readNewLines());
+  ASSERT_TRUE(QFile::remove(tailer.getFilePath()));
+  ASSERT_TRUE(append(directory.path(), lines[0] + "\n" + lines[2] + "\n"));
+  ASSERT_TRUE(tailer.readNewLines());
+  EXPECT_EQ(tailer.getAppliedCount(), 3);
+  EXPECT_EQ(tailer.getOffset(), lines[0].size() + lines[2].size() + 2);
+}
+
+TEST(planCsvScheduleTailerTests, replacementOfSameSizeIsReadFromStart) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<QByteArray> lines = createResultLines(plan.get());
+  ASSERT_EQ(lines.size(), 3);
+  QTemporaryDir directory;
+  ASSERT_TRUE(QDir().mkpath(directory.path() + "/SPA-ERGEBNIS-PP"));
+  PlanCsvScheduleTailer tailer(directory.path(), plan.get());
+
+  ASSERT_TRUE(append(directory.path(),
+                     lines[0] + "\n" + lines[1] + "\n" + lines[2] + "\n"));
+  ASSERT_TRUE(tailer.readNewLines());
+  ASSERT_TRUE(QFile::remove(tailer.getFilePath()));
+  ASSERT_TRUE(append(directory.path(),
+                     lines[0] + "\n" + lines[2] + "\n" + lines[1] + "\n"));
+  ASSERT_TRUE(tailer.readNewLines());
+  EXPECT_EQ(tailer.getAppliedCount(), 4);
+  EXPECT_EQ(tailer.getRejectedCount(), 0);
+}
+
+TEST(planCsvScheduleTailerTests, scheduleEndsAtEmptyLine) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<QByteArray> lines = createResultLines(plan.get());
+  ASSERT_EQ(lines.size(), 3);
+  QTemporaryDir directory;
+  ASSERT_TRUE(QDir().mkpath(directory.path() + "/SPA-ERGEBNIS-PP"));
+  PlanCsvScheduleTailer tailer(directory.path(), plan.get());
+
+  ASSERT_TRUE(append(directory.path(),
+                     lines[0] + "\n" + lines[1] + "\n\n" + lines[2] + "\n"));
+  ASSERT_TRUE(tailer.readNewLines());
+  ASSERT_TRUE(append(directory.path(), "not;a;line\n"));
+  ASSERT_TRUE(tailer.readNewLines());
+  EXPECT_EQ(tailer.getAppliedCount(), 1);
+  EXPECT_EQ(tailer.getRejectedCount(), 0);
+  EXPECT_EQ(countScheduledModules(plan.get()), 1);
+}
+
+TEST(planCsvScheduleTailerTests, appendedLinesAreAppliedLive) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<QByteArray> lines = createResultLines(plan.get());
+  ASSERT_EQ(lines.size(), 3);
+  QTemporaryDir directory;
+  PlanCsvScheduleTailer tailer(directory.path(), plan.get());
+  tailer.setDebounceInterval(10);
+  tailer.start();
+  EXPECT_TRUE(tailer.isRunning());
+
+  // The result directory is created after the tailer started
+  ASSERT_TRUE(QDir().mkpath(directory.path() + "/SPA-ERGEBNIS-PP"));
+  ASSERT_TRUE(append(directory.path(), lines[0] + "\n" + lines[1] + "\n"));
+  EXPECT_TRUE(processEventsUntil(
+      [&tailer]() { return tailer.getAppliedCount() == 1; }));
+  ASSERT_TRUE(append(directory.path(), lines[2] + "\n"));
+  EXPECT_TRUE(processEventsUntil(
+      [&tailer]() { return tailer.getAppliedCount() == 2; }));
+  EXPECT_EQ(countScheduledModules(plan.get()), 2);
+
+  tailer.stop();
+  EXPECT_FALSE(tailer.isRunning());
+}
+
+#endif  // PLANCSVSCHEDULETAILER_TEST_CPP
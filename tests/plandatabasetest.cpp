@@ -0,0 +1,243 @@
+#ifndef PLANDATABASE_TEST_CPP
+#define PLANDATABASE_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <plandatabase.h>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+#include "futurehelper.h"
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+TEST(planDatabaseTests, savedPlanLoadsWithSameContent) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  PlanDatabase database;
+  ASSERT_TRUE(database.open(directory.filePath("plans.sqlite")))
+      << database.getLastError().toStdString();
+
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.data());
+  timeslots[3]->addModule(plan->getModules()[0]);
+  ASSERT_TRUE(database.savePlan(plan.data()));
+
+  QScopedPointer<Plan> loaded(database.loadPlan(plan->getId()));
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(loaded->getContentHash(), plan->getContentHash());
+  EXPECT_EQ(loaded->toJsonObject(), plan->toJsonObject());
+  EXPECT_EQ(database.getPlanName(plan->getId()), plan->getName());
+  EXPECT_EQ(database.loadPlan(QUuid::createUuid()), nullptr);
+}
+
+TEST(planDatabaseTests, semesterPlansLoadOneByOne) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  PlanDatabase database;
+  ASSERT_TRUE(database.open(directory.filePath("plans.sqlite")));
+
+  Semester semester;
+  semester.setName("Sommersemester");
+  Plan* first = new Plan(&semester);
+  first->setName("Erster Plan");
+  Plan* second = new Plan(&semester);
+  second->setName("Zweiter Plan");
+  semester.setPlans({first, second});
+  ASSERT_TRUE(database.saveSemester(&semester));
+
+  EXPECT_THAT(database.getSemesterIds(), ElementsAre(semester.getId()));
+  EXPECT_THAT(database.getPlanIds(semester.getId()),
+              ElementsAre(first->getId(), second->getId()));
+  QScopedPointer<Plan> plan(database.loadPlan(second->getId()));
+  ASSERT_FALSE(plan.isNull());
+  EXPECT_EQ(plan->getName(), "Zweiter Plan");
+
+  // Removed plans are removed from the database
+  semester.setPlans({second});
+  ASSERT_TRUE(database.saveSemester(&semester));
+  EXPECT_THAT(database.getPlanIds(semester.getId()),
+              ElementsAre(second->getId()));
+  EXPECT_TRUE(database.getPlanName(first->getId()).isNull());
+
+  QScopedPointer<Semester> loaded(database.loadSemester(semester.getId()));
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(loaded->getContentHash(), semester.getContentHash());
+}
+
+TEST(planDatabaseTests, savingSemesterKeepsPlansUnloaded) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  PlanDatabase database;
+  ASSERT_TRUE(database.open(directory.filePath("plans.sqlite")));
+
+  Semester semester;
+  Plan* plan = new Plan(&semester);
+  plan->fromJsonObject(getValidJsonPlan());
+  semester.setPlans({plan});
+  ASSERT_TRUE(semester.unloadPlan(0));
+  ASSERT_TRUE(database.saveSemester(&semester))
+      << database.getLastError().toStdString();
+  EXPECT_FALSE(semester.isPlanLoaded(0));
+
+  QScopedPointer<Semester> loaded(database.loadSemester(semester.getId()));
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(loaded->getContentHash(), semester.getContentHash());
+}
+
+TEST(planDatabaseTests, plansMayShareObjectIds) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  PlanDatabase database;
+  database.setFlushInterval(-1);
+  ASSERT_TRUE(database.open(directory.filePath("plans.sqlite")));
+
+  // Both plans are copies of the same JSON with different plan ids
+  Semester semester;
+  QJsonObject content = getValidJsonPlan();
+  Plan* first = new Plan(&semester);
+  first->fromJsonObject(content);
+  content.insert("id", QUuid::createUuid().toString());
+  Plan* second = new Plan(&semester);
+  second->fromJsonObject(content);
+  getTimeslots(second)[0]->addModule(second->getModules()[0]);
+  semester.setPlans({first, second});
+  ASSERT_TRUE(database.saveSemester(&semester))
+      << database.getLastError().toStdString();
+
+  database.track(first);
+  database.track(second);
+  second->getModules()[1]->setName("Nur im zweiten Plan");
+  ASSERT_TRUE(database.flush());
+
+  for (Plan* plan : {first, second}) {
+    QScopedPointer<Plan> loaded(database.loadPlan(plan->getId()));
+    ASSERT_FALSE(loaded.isNull());
+    EXPECT_EQ(loaded->getContentHash(), plan->getContentHash());
+  }
+}
+
+TEST(planDatabaseTests, movingModuleOnlyWritesAssignments) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  PlanDatabase database;
+  database.setFlushInterval(-1);
+  ASSERT_TRUE(database.open(directory.filePath("plans.sqlite")));
+
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.data());
+  Module* module = plan->getModules()[0];
+  timeslots[0]->addModule(module);
+  ASSERT_TRUE(database.savePlan(plan.data()));
+  database.track(plan.data());
+  EXPECT_FALSE(database.hasPendingChanges());
+
+  int written = -1;
+  QObject::connect(&database, &PlanDatabase::flushed,
+                   [&written](int rowCount) { written = rowCount; });
+  // Both timeslots delete their old rows and insert their new ones
+  int expected = timeslots[0]->getModules().size() +
+                 timeslots[1]->getModules().size();
+  timeslots[0]->removeModule(module);
+  timeslots[1]->addModule(module);
+  expected += timeslots[0]->getModules().size() +
+              timeslots[1]->getModules().size();
+  EXPECT_TRUE(database.hasPendingChanges());
+  ASSERT_TRUE(database.flush());
+  EXPECT_EQ(written, expected);
+  EXPECT_FALSE(database.hasPendingChanges());
+
+  QScopedPointer<Plan> loaded(database.loadPlan(plan->getId()));
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(loaded->getContentHash(), plan->getContentHash());
+}
+
+TEST(planDatabaseTests, continuousChangesAreFlushed) {
+  ensureCoreApplication();
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  PlanDatabase database;
+  database.setFlushInterval(50);
+  ASSERT_TRUE(database.open(directory.filePath("plans.sqlite")));
+  QSharedPointer<Plan> plan = getValidPlan();
+  ASSERT_TRUE(database.savePlan(plan.data()));
+  database.track(plan.data());
+
+  bool flushed = false;
+  QObject::connect(&database, &PlanDatabase::flushed,
+                   [&flushed]() { flushed = true; });
+  // Every iteration of the event loop changes the plan again
+  int changes = 0;
+  EXPECT_TRUE(processEventsUntil(
+      [&]() {
+        plan->setName(QString("Name %1").arg(changes++));
+        return flushed;
+      },
+      2000));
+}
+
+TEST(planDatabaseTests, structureChangeRewritesPlan) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  PlanDatabase database;
+  database.setFlushInterval(-1);
+  ASSERT_TRUE(database.open(directory.filePath("plans.sqlite")));
+
+  QSharedPointer<Plan> plan = getValidPlan();
+  ASSERT_TRUE(database.savePlan(plan.data()));
+  database.track(plan.data());
+
+  plan->addNewGroup("Neue Gruppe");
+  Group* group = plan->getGroups().last();
+  // The new group is tracked after the structure change
+  group->setExamsPerDay(3);
+  plan->setName("Umbenannt");
+  ASSERT_TRUE(database.flush());
+
+  QScopedPointer<Plan> loaded(database.loadPlan(plan->getId()));
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(loaded->getName(), "Umbenannt");
+  EXPECT_EQ(loaded->getGroups().size(), plan->getGroups().size());
+  EXPECT_EQ(loaded->getContentHash(), plan->getContentHash());
+
+  database.untrack(plan.data());
+  plan->setName("Nicht gespeichert");
+  EXPECT_FALSE(database.hasPendingChanges());
+  EXPECT_EQ(database.getPlanName(plan->getId()), "Umbenannt");
+}
+
+TEST(planDatabaseTests, listChangesOnlyWriteTheirRows) {
+  QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  PlanDatabase database;
+  database.setFlushInterval(-1);
+  ASSERT_TRUE(database.open(directory.filePath("plans.sqlite")));
+
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<Module*> modules = plan->getModules();
+  unschedule(plan.data(), modules[0]);
+  ASSERT_TRUE(database.savePlan(plan.data()));
+  database.track(plan.data());
+
+  int written = -1;
+  QObject::connect(&database, &PlanDatabase::flushed,
+                   [&written](int rowCount) { written = rowCount; });
+  modules.removeFirst();
+  plan->setModules(modules);
+  plan->addNewConstraint("Neue Einschränkung");
+  Week* week = plan->getWeeks()[0];
+  week->setName("Erste Woche");
+  week->getDays()[0]->setName("Erster Tag");
+  // One deleted module, one inserted constraint and two renamed rows
+  ASSERT_TRUE(database.flush());
+  EXPECT_EQ(written, 4);
+
+  QScopedPointer<Plan> loaded(database.loadPlan(plan->getId()));
+  ASSERT_FALSE(loaded.isNull());
+  EXPECT_EQ(loaded->getModules().size(), modules.size());
+  EXPECT_EQ(loaded->getContentHash(), plan->getContentHash());
+}
+
+#endif  // PLANDATABASE_TEST_CPP
@@ -0,0 +1,195 @@
+#ifndef PLANDECOMPOSITION_TEST_CPP
+#define PLANDECOMPOSITION_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <plandecomposition.h>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+#include "futurehelper.h"
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+/**
+ *  Creates a plan with modules a to f:
+ *  - a and b share group x, b and c share group y
+ *  - d has group z and constraint w, e has constraint w
+ *  - f has no groups or constraints
+ */
+QSharedPointer<Plan> createSmallPlan() {
+  QSharedPointer<Plan> plan(new Plan());
+  plan->addNewGroup("x");
+  plan->addNewGroup("y");
+  plan->addNewGroup("z");
+  plan->addNewConstraint("w");
+  Group* x = plan->getGroups()[0];
+  Group* y = plan->getGroups()[1];
+  Group* z = plan->getGroups()[2];
+  Group* w = plan->getConstraints()[0];
+  QList<QList<Group*>> moduleGroups = {{x}, {x, y}, {y}, {z}, {}, {}};
+  QList<QList<Group*>> moduleConstraints = {{}, {}, {}, {w}, {w}, {}};
+  QList<Module*> modules;
+  for (int i = 0; i < moduleGroups.size(); i++) {
+    Module* module = new Module(plan.get());
+    module->setGroups(moduleGroups[i]);
+    module->setConstraints(moduleConstraints[i]);
+    modules.append(module);
+  }
+  plan->setModules(modules);
+  return plan;
+}
+
+Timeslot* getTimeslot(Plan* plan, int week, int day, int timeslot) {
+  return plan->getWeeks()[week]->getDays()[day]->getTimeslots()[timeslot];
+}
+}  // namespace
+
+TEST(planDecompositionTests, modulesAreGroupedBySharedGroupsAndConstraints) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  QList<Module*> modules = plan->getModules();
+  PlanDecomposition decomposition(plan.get());
+  ASSERT_EQ(decomposition.getPartCount(), 3);
+  EXPECT_EQ(decomposition.getModules(0), modules.mid(0, 3));
+  EXPECT_EQ(decomposition.getModules(1), modules.mid(3, 2));
+  EXPECT_EQ(decomposition.getModules(2), modules.mid(5, 1));
+}
+
+TEST(planDecompositionTests, partsOfValidPlanAreIndependent) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanDecomposition decomposition(plan.get());
+  QHash<Group*, int> groupParts;
+  int moduleCount = 0;
+  for (int part = 0; part < decomposition.getPartCount(); part++) {
+    for (Module* module : decomposition.getModules(part)) {
+      moduleCount++;
+      for (Group* group : module->getGroups() + module->getConstraints()) {
+        EXPECT_EQ(groupParts.value(group, part), part);
+        groupParts.insert(group, part);
+      }
+    }
+  }
+  EXPECT_EQ(moduleCount, plan->getModules().size());
+}
+
+TEST(planDecompositionTests, partPlanContainsOnlyItsPart) {
+  QSharedPointer<Plan> plan = createSmallPlan();
+  PlanDecomposition decomposition(plan.get());
+  QScopedPointer<Plan> partPlan(decomposition.createPartPlan(1));
+  ASSERT_NE(partPlan.get(), nullptr);
+  ASSERT_EQ(partPlan->getModules().size(), 2);
+  EXPECT_EQ(partPlan->getModules()[0]->getId(), plan->getModules()[3]->getId());
+  ASSERT_EQ(partPlan->getGroups().size(), 1);
+  EXPECT_EQ(partPlan->getGroups()[0]->getName(), "z");
+  ASSERT_EQ(partPlan->getConstraints().size(), 1);
+  EXPECT_EQ(partPlan->getModules()[1]->getConstraints(),
+            partPlan->getConstraints());
+  EXPECT_EQ(decomposition.createPartPlan(3), nullptr);
+}
+
+TEST(planDecompositionTests, partPlanKeepsAvailability) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanDecomposition decomposition(plan.get());
+  QScopedPointer<Plan> partPlan(decomposition.createPartPlan(0));
+  ASSERT_NE(partPlan.get(), nullptr);
+  ASSERT_EQ(partPlan->getWeeks().size(), plan->getWeeks().size());
+  Timeslot* timeslot = getTimeslot(plan.get(), 0, 0, 0);
+  Timeslot* partTimeslot = getTimeslot(partPlan.get(), 0, 0, 0);
+  for (Group* group : partPlan->getGroups()) {
+    bool active = false;
+    for (Group* originalGroup : timeslot->getActiveGroups()) {
+      active = active || originalGroup->getId() == group->getId();
+    }
+    EXPECT_EQ(partTimeslot->containsActiveGroup(group), active);
+  }
+}
+
+TEST(planDecompositionTests, schedulesOfPartsAreMergedIntoPlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* first = plan->getModules()[0];
+  Module* second = plan->getModules()[5];
+  getTimeslot(plan.get(), 0, 1, 2)->addModule(first);
+  getTimeslot(plan.get(), 2, 3, 4)->addModule(second);
+
+  QTemporaryDir directory;
+  PlanDecomposition decomposition(plan.get());
+  ASSERT_TRUE(decomposition.writePlans(directory.path()));
+  for (int part = 0; part < decomposition.getPartCount(); part++) {
+    EXPECT_TRUE(QDir(PlanDecomposition::getPartPath(directory.path(), part))
+                    .exists("pruefungen.csv"));
+  }
+
+  unschedule(plan.get(), first);
+  unschedule(plan.get(), second);
+  ASSERT_TRUE(decomposition.readSchedules(directory.path()));
+  EXPECT_TRUE(getTimeslot(plan.get(), 0, 1, 2)->containsModule(first));
+  EXPECT_TRUE(getTimeslot(plan.get(), 2, 3, 4)->containsModule(second));
+}
+
+#ifdef Q_OS_UNIX
+TEST(planDecompositionTests, scheduleRunsProgramForEveryPart) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  getTimeslot(plan.get(), 1, 1, 1)->addModule(module);
+
+  QTemporaryDir directory;
+  PlanDecomposition decomposition(plan.get());
+  QString expectedPath = directory.path() + "/expected";
+  ASSERT_TRUE(decomposition.writePlans(expectedPath));
+  unschedule(plan.get(), module);
+
+  // The fake solver copies the expected result of its part
+  QString script =
+      "cp \"$0/../../expected/$(basename \"$0\")/SPA-ERGEBNIS-PP/"
+      "SPA-planung-pruef.csv\" \"$0/SPA-ERGEBNIS-PP/\"";
+  QFuture<bool> future = decomposition.schedule(
+      directory.path() + "/runs", "/bin/sh", {"-c", script, "{path}"});
+  ASSERT_TRUE(waitForFuture(future));
+  ASSERT_TRUE(future.result());
+  EXPECT_TRUE(getTimeslot(plan.get(), 1, 1, 1)->containsModule(module));
+  EXPECT_EQ(future.progressValue(), decomposition.getPartCount());
+}
+
+TEST(planDecompositionTests, failingProgramDoesNotModifyPlan) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  getTimeslot(plan.get(), 1, 1, 1)->addModule(module);
+
+  QTemporaryDir directory;
+  PlanDecomposition decomposition(plan.get());
+  QFuture<bool> future =
+      decomposition.schedule(directory.path(), "/bin/sh", {"-c", "exit 1"});
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_FALSE(future.result());
+  EXPECT_TRUE(getTimeslot(plan.get(), 1, 1, 1)->containsModule(module));
+}
+
+TEST(planDecompositionTests, canceledScheduleKillsProgram) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  getTimeslot(plan.get(), 1, 1, 1)->addModule(module);
+
+  QTemporaryDir directory;
+  PlanDecomposition decomposition(plan.get());
+  QElapsedTimer timer;
+  timer.start();
+  QFuture<bool> future =
+      decomposition.schedule(directory.path(), "/bin/sh", {"-c", "sleep 10"});
+  future.cancel();
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_TRUE(future.isCanceled());
+  EXPECT_EQ(future.resultCount(), 0);
+  EXPECT_LT(timer.elapsed(), 5000);
+  EXPECT_TRUE(getTimeslot(plan.get(), 1, 1, 1)->containsModule(module));
+}
+#endif
+
+#endif  // PLANDECOMPOSITION_TEST_CPP
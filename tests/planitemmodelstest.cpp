@@ -0,0 +1,185 @@
+#ifndef PLANITEMMODELS_TEST_CPP
+#define PLANITEMMODELS_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <planitemmodels.h>
+#include <QSharedPointer>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+/**
+ *  Records the change signals of a model
+ */
+struct ModelChanges {
+  QList<QPair<int, int>> inserted;
+  QList<QPair<int, int>> removed;
+  QList<QPair<QModelIndex, QVector<int>>> changed;
+  int resets = 0;
+
+  explicit ModelChanges(QAbstractItemModel* model) {
+    QObject::connect(model, &QAbstractItemModel::rowsInserted,
+                     [this](const QModelIndex&, int first, int last) {
+                       inserted.append(qMakePair(first, last));
+                     });
+    QObject::connect(model, &QAbstractItemModel::rowsRemoved,
+                     [this](const QModelIndex&, int first, int last) {
+                       removed.append(qMakePair(first, last));
+                     });
+    QObject::connect(model, &QAbstractItemModel::dataChanged,
+                     [this](const QModelIndex& topLeft, const QModelIndex&,
+                            const QVector<int>& roles) {
+                       changed.append(qMakePair(topLeft, roles));
+                     });
+    QObject::connect(model, &QAbstractItemModel::modelReset,
+                     [this]() { resets++; });
+  }
+};
+}  // namespace
+
+TEST(planItemModelsTests, moduleListExposesProperties) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  ModuleListModel model(plan.get());
+  ASSERT_EQ(model.rowCount(), plan->getModules().size());
+  Module* module = plan->getModules()[0];
+  EXPECT_EQ(model.get(0), module);
+  EXPECT_EQ(model.indexOf(module), 0);
+  EXPECT_EQ(model.data(model.index(0), Qt::DisplayRole).toString(),
+            module->getName());
+  EXPECT_EQ(model.data(model.index(0), model.roleOf("number")).toString(),
+            module->getNumber());
+  EXPECT_EQ(model.data(model.index(0), ObjectListModel::ObjectRole)
+                .value<QObject*>(),
+            module);
+  EXPECT_TRUE(model.roleNames().values().contains("examDuration"));
+  EXPECT_EQ(model.roleOf("unknown"), -1);
+}
+
+TEST(planItemModelsTests, addingModuleInsertsOneRow) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  ModuleListModel model(plan.get());
+  ModelChanges changes(&model);
+  int count = plan->getModules().size();
+
+  QList<Module*> modules = plan->getModules();
+  Module* module = new Module(plan.get());
+  modules.insert(3, module);
+  plan->setModules(modules);
+  EXPECT_EQ(changes.resets, 0);
+  ASSERT_EQ(changes.inserted.size(), 1);
+  EXPECT_EQ(changes.inserted[0], qMakePair(3, 3));
+  EXPECT_EQ(model.rowCount(), count + 1);
+  EXPECT_EQ(model.get(3), module);
+  EXPECT_EQ(model.indexOf(plan->getModules()[4]), 4);
+
+  modules.removeAt(3);
+  modules.removeAt(0);
+  modules.removeAt(0);
+  plan->setModules(modules);
+  EXPECT_EQ(changes.resets, 0);
+  ASSERT_EQ(changes.removed.size(), 2);
+  EXPECT_EQ(changes.removed[0], qMakePair(3, 3));
+  EXPECT_EQ(changes.removed[1], qMakePair(0, 1));
+  EXPECT_EQ(model.rowCount(), count - 2);
+}
+
+TEST(planItemModelsTests, reorderingModulesResetsModel) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  ModuleListModel model(plan.get());
+  ModelChanges changes(&model);
+  QList<Module*> modules = plan->getModules();
+  modules.swap(0, 1);
+  plan->setModules(modules);
+  EXPECT_EQ(changes.resets, 1);
+  EXPECT_EQ(model.get(0), modules[0]);
+}
+
+TEST(planItemModelsTests, propertyChangeUpdatesOneRole) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  GroupListModel model(plan.get(), GroupListModel::Groups);
+  ASSERT_EQ(model.rowCount(), plan->getGroups().size());
+  ModelChanges changes(&model);
+
+  Group* group = plan->getGroups()[2];
+  group->setExamsPerDay(group->getExamsPerDay() + 1);
+  ASSERT_EQ(changes.changed.size(), 1);
+  EXPECT_EQ(changes.changed[0].first.row(), 2);
+  EXPECT_THAT(changes.changed[0].second,
+              ElementsAre(model.roleOf("examsPerDay")));
+
+  group->setName("Renamed");
+  ASSERT_EQ(changes.changed.size(), 2);
+  EXPECT_THAT(changes.changed[1].second,
+              UnorderedElementsAre(model.roleOf("name"), Qt::DisplayRole));
+}
+
+TEST(planItemModelsTests, constraintListFollowsPlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  GroupListModel model(plan.get(), GroupListModel::Constraints);
+  ModelChanges changes(&model);
+  int count = plan->getConstraints().size();
+  plan->addNewConstraint("New constraint");
+  EXPECT_EQ(model.rowCount(), count + 1);
+  ASSERT_EQ(changes.inserted.size(), 1);
+  EXPECT_EQ(changes.inserted[0], qMakePair(count, count));
+  EXPECT_EQ(model.data(model.index(count)).toString(), "New constraint");
+}
+
+TEST(planItemModelsTests, timeslotModulesUpdateOneRow) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Timeslot* timeslot = plan->getWeeks()[0]->getDays()[1]->getTimeslots()[2];
+  timeslot->setModules({});
+  ModuleListModel model(timeslot);
+  ModelChanges changes(&model);
+  timeslot->addModule(plan->getModules()[0]);
+  timeslot->addModule(plan->getModules()[1]);
+  ASSERT_EQ(changes.inserted.size(), 2);
+  EXPECT_EQ(changes.inserted[1], qMakePair(1, 1));
+  timeslot->removeModule(plan->getModules()[0]);
+  ASSERT_EQ(changes.removed.size(), 1);
+  EXPECT_EQ(changes.removed[0], qMakePair(0, 0));
+  EXPECT_EQ(changes.resets, 0);
+  EXPECT_EQ(model.get(0), plan->getModules()[1]);
+}
+
+TEST(planItemModelsTests, timeslotTableUpdatesOneCell) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  TimeslotTableModel model(plan.get());
+  EXPECT_EQ(model.rowCount(), 18);
+  EXPECT_EQ(model.columnCount(), 6);
+  Timeslot* timeslot = plan->getWeeks()[1]->getDays()[2]->getTimeslots()[3];
+  EXPECT_EQ(model.getTimeslot(8, 3), timeslot);
+  EXPECT_EQ(model.indexOf(timeslot), model.index(8, 3));
+  EXPECT_EQ(model.data(model.index(8, 3), TimeslotTableModel::DayRole)
+                .value<Day*>(),
+            plan->getWeeks()[1]->getDays()[2]);
+
+  timeslot->setModules({});
+  timeslot->setActiveGroups({});
+  ModelChanges changes(&model);
+  timeslot->addModule(plan->getModules()[0]);
+  ASSERT_EQ(changes.changed.size(), 1);
+  EXPECT_EQ(changes.changed[0].first, model.index(8, 3));
+  EXPECT_THAT(changes.changed[0].second,
+              UnorderedElementsAre(TimeslotTableModel::ModulesRole,
+                                   TimeslotTableModel::ModuleCountRole));
+  EXPECT_EQ(model.data(model.index(8, 3), TimeslotTableModel::ModuleCountRole)
+                .toInt(),
+            1);
+
+  timeslot->addActiveGroup(plan->getGroups()[0]);
+  ASSERT_EQ(changes.changed.size(), 2);
+  EXPECT_THAT(changes.changed[1].second,
+              ElementsAre(TimeslotTableModel::ActiveGroupsRole));
+  EXPECT_EQ(changes.resets, 0);
+
+  plan->getWeeks()[0]->getDays()[0]->setTimeslots({});
+  EXPECT_EQ(changes.resets, 1);
+  EXPECT_EQ(model.getTimeslot(0, 0), nullptr);
+  EXPECT_EQ(model.indexOf(timeslot), model.index(8, 3));
+}
+
+#endif  // PLANITEMMODELS_TEST_CPP
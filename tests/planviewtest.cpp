@@ -0,0 +1,153 @@
+#ifndef PLANVIEW_TEST_CPP
+#define PLANVIEW_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <planview.h>
+#include <QFuture>
+#include <QSharedPointer>
+#include <QtConcurrent/QtConcurrentRun>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+TEST(planViewTests, nullptrHasNoView) {
+  EXPECT_EQ(PlanView::create(nullptr), nullptr);
+}
+
+TEST(planViewTests, viewMirrorsPlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanViewPointer view = PlanView::create(plan.get());
+  ASSERT_NE(view, nullptr);
+  EXPECT_EQ(view->getId(), plan->getId());
+  EXPECT_EQ(view->getName(), plan->getName());
+  ASSERT_EQ(view->getModules().size(), plan->getModules().size());
+  ASSERT_EQ(view->getGroups().size(), plan->getGroups().size());
+  ASSERT_EQ(view->getConstraints().size(), plan->getConstraints().size());
+  ASSERT_EQ(view->getWeeks().size(), plan->getWeeks().size());
+
+  Module* module = plan->getModules()[0];
+  ModuleViewPointer moduleView = view->getModules()[0];
+  EXPECT_EQ(moduleView->getName(), module->getName());
+  EXPECT_EQ(moduleView->getNumber(), module->getNumber());
+  EXPECT_EQ(view->findGroups(moduleView->getGroupIds()).size(),
+            module->getGroups().size());
+
+  Timeslot* timeslot = plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0];
+  TimeslotViewPointer timeslotView =
+      view->getWeeks()[0]->getDays()[0]->getTimeslots()[0];
+  EXPECT_EQ(timeslotView->getName(), timeslot->getName());
+  EXPECT_EQ(view->findModules(timeslotView->getModuleIds()).size(),
+            timeslot->getModules().size());
+  EXPECT_EQ(view->findGroups(timeslotView->getActiveGroupIds()).size(),
+            timeslot->getActiveGroups().size());
+}
+
+TEST(planViewTests, viewDoesNotChangeWithPlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanViewPointer view = PlanView::create(plan.get());
+  QString name = plan->getModules()[0]->getName();
+  int moduleCount = plan->getModules().size();
+
+  plan->getModules()[0]->setName("changed");
+  plan->addNewGroup("new group");
+  EXPECT_EQ(view->getModules()[0]->getName(), name);
+  EXPECT_EQ(view->getModules().size(), moduleCount);
+  EXPECT_EQ(view->findModule(plan->getModules()[0]->getId())->getName(), name);
+}
+
+TEST(planViewTests, unchangedPlanReturnsPreviousView) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanViewPointer view = PlanView::create(plan.get());
+  EXPECT_EQ(PlanView::create(plan.get(), view), view);
+}
+
+TEST(planViewTests, unchangedObjectsAreShared) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanViewPointer first = PlanView::create(plan.get());
+
+  plan->getModules()[0]->setName("changed");
+  plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0]->addModule(
+      plan->getModules()[1]);
+  PlanViewPointer second = PlanView::create(plan.get(), first);
+
+  ASSERT_NE(second, first);
+  EXPECT_NE(second->getModules()[0], first->getModules()[0]);
+  EXPECT_EQ(second->getModules()[0]->getName(), "changed");
+  EXPECT_EQ(second->getModules()[1], first->getModules()[1]);
+  EXPECT_EQ(second->getGroups()[0], first->getGroups()[0]);
+
+  EXPECT_NE(second->getWeeks()[0], first->getWeeks()[0]);
+  EXPECT_EQ(second->getWeeks()[1], first->getWeeks()[1]);
+  DayViewPointer firstDay = first->getWeeks()[0]->getDays()[0];
+  DayViewPointer secondDay = second->getWeeks()[0]->getDays()[0];
+  EXPECT_NE(secondDay->getTimeslots()[0], firstDay->getTimeslots()[0]);
+  EXPECT_EQ(secondDay->getTimeslots()[1], firstDay->getTimeslots()[1]);
+  EXPECT_EQ(second->getWeeks()[0]->getDays()[1],
+            first->getWeeks()[0]->getDays()[1]);
+}
+
+TEST(planViewTests, unchangedListsAreShared) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanViewPointer first = PlanView::create(plan.get());
+
+  plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0]->addModule(
+      plan->getModules()[1]);
+  PlanViewPointer second = PlanView::create(plan.get(), first);
+
+  ASSERT_NE(second, first);
+  EXPECT_EQ(second->getModules(), first->getModules());
+  EXPECT_EQ(second->getGroups(), first->getGroups());
+  EXPECT_EQ(second->getConstraints(), first->getConstraints());
+  Module* module = plan->getModules()[0];
+  EXPECT_EQ(second->findModule(module->getId()), first->getModules()[0]);
+  Group* group = plan->getGroups()[0];
+  EXPECT_EQ(second->findGroup(group->getId()), first->getGroups()[0]);
+}
+
+TEST(planViewTests, reorderedListsAreNotShared) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanViewPointer first = PlanView::create(plan.get());
+
+  QList<Module*> modules = plan->getModules();
+  modules.move(0, modules.size() - 1);
+  plan->setModules(modules);
+  plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0]->addModule(modules[0]);
+  PlanViewPointer second = PlanView::create(plan.get(), first);
+
+  ASSERT_EQ(second->getModules().size(), modules.size());
+  EXPECT_EQ(second->getModules()[0]->getId(), modules[0]->getId());
+  EXPECT_EQ(second->getModules()[0], first->getModules()[1]);
+  EXPECT_EQ(second->getModules().last(), first->getModules()[0]);
+}
+
+TEST(planViewTests, viewCanBeReadFromOtherThreads) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanViewPointer view = PlanView::create(plan.get());
+
+  QList<QFuture<int>> futures;
+  for (int i = 0; i < 4; i++) {
+    futures.append(QtConcurrent::run([view]() {
+      int scheduled = 0;
+      for (const WeekViewPointer& week : view->getWeeks()) {
+        for (const DayViewPointer& day : week->getDays()) {
+          for (const TimeslotViewPointer& timeslot : day->getTimeslots()) {
+            scheduled += view->findModules(timeslot->getModuleIds()).size();
+          }
+        }
+      }
+      return scheduled;
+    }));
+  }
+  for (Module* module : plan->getModules()) {
+    module->setName(module->getName() + " changed");
+  }
+
+  int expected = futures[0].result();
+  for (QFuture<int>& future : futures) {
+    EXPECT_EQ(future.result(), expected);
+  }
+}
+
+#endif  // PLANVIEW_TEST_CPP
@@ -0,0 +1,147 @@
+#ifndef PROPERTYTABLE_TEST_CPP
+#define PROPERTYTABLE_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <iostream>
+#include "plan.h"
+#include "propertytable.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+// Gives access to the reflective serialization of SerializableDataObject
+struct ReflectiveSerializer : SerializableDataObject {
+  static QJsonObject write(const SerializableDataObject* object) {
+    return (object->*(&ReflectiveSerializer::recursiveToJsonObject))();
+  }
+
+  static void read(SerializableDataObject* object,
+                   const QJsonObject& content) {
+    (object->*(&ReflectiveSerializer::simpleValuesFromJsonObject))(content);
+  }
+};
+}  // namespace
+
+TEST(propertyTableTests, tableWritesSameJsonAsReflection) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  EXPECT_EQ(plan->toJsonObject(), ReflectiveSerializer::write(plan.data()));
+  for (Group* group : plan->getGroups() + plan->getConstraints()) {
+    EXPECT_EQ(group->toJsonObject(), ReflectiveSerializer::write(group));
+  }
+  for (Module* module : plan->getModules()) {
+    EXPECT_EQ(module->toJsonObject(), ReflectiveSerializer::write(module));
+  }
+  for (Week* week : plan->getWeeks()) {
+    EXPECT_EQ(week->toJsonObject(), ReflectiveSerializer::write(week));
+    for (Day* day : week->getDays()) {
+      EXPECT_EQ(day->toJsonObject(), ReflectiveSerializer::write(day));
+      for (Timeslot* timeslot : day->getTimeslots()) {
+        EXPECT_EQ(timeslot->toJsonObject(),
+                  ReflectiveSerializer::write(timeslot));
+      }
+    }
+  }
+}
+
+TEST(propertyTableTests, tableReadsSameValuesAsReflection) {
+  QJsonObject content = getValidJsonPlan();
+  for (const QJsonValue& groupJson : content.value("groups").toArray()) {
+    Group group;
+    group.fromJsonObject(groupJson.toObject());
+    Group reflected;
+    ReflectiveSerializer::read(&reflected, groupJson.toObject());
+    EXPECT_EQ(group.toJsonObject(), reflected.toJsonObject());
+    EXPECT_EQ(group.toJsonObject(), groupJson.toObject());
+  }
+
+  Plan plan;
+  for (const QJsonValue& moduleJson : content.value("modules").toArray()) {
+    Module module(&plan);
+    module.fromJsonObject(moduleJson.toObject());
+    Module reflected(&plan);
+    ReflectiveSerializer::read(&reflected, moduleJson.toObject());
+    EXPECT_EQ(module.toJsonObject(), reflected.toJsonObject());
+  }
+}
+
+TEST(propertyTableTests, missingValuesAreNotChanged) {
+  Group group;
+  group.setName("Informatik");
+  group.setExamsPerDay(2);
+  QJsonObject content;
+  content.insert("id", QUuid::createUuid().toString());
+  content.insert("small", true);
+  group.fromJsonObject(content);
+
+  EXPECT_EQ(group.getId(), QUuid(content.value("id").toString()));
+  EXPECT_EQ(group.getName(), "Informatik");
+  EXPECT_EQ(group.getExamsPerDay(), 2u);
+  EXPECT_TRUE(group.getSmall());
+}
+
+/**
+ *  Compares the property tables with the reflective serialization of the
+ * groups and modules of the valid plan. Reading with the tables still sets
+ * the id by reflection and also resolves references and updates the content
+ * hashes, so only writing is free of reflection. Run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(propertyTableTests, DISABLED_benchmarkAgainstReflection) {
+  const int iterations = 1000;
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<SerializableDataObject*> objects;
+  for (Group* group : plan->getGroups() + plan->getConstraints()) {
+    objects.append(group);
+  }
+  for (Module* module : plan->getModules()) {
+    objects.append(module);
+  }
+  QList<QJsonObject> contents;
+  for (SerializableDataObject* object : objects) {
+    contents.append(object->toJsonObject());
+  }
+  QElapsedTimer timer;
+
+  timer.start();
+  for (int i = 0; i < iterations; i++) {
+    for (SerializableDataObject* object : objects) {
+      ReflectiveSerializer::write(object);
+    }
+  }
+  qint64 reflectiveWrite = timer.nsecsElapsed();
+
+  timer.restart();
+  for (int i = 0; i < iterations; i++) {
+    for (SerializableDataObject* object : objects) {
+      object->toJsonObject();
+    }
+  }
+  qint64 tableWrite = timer.nsecsElapsed();
+
+  timer.restart();
+  for (int i = 0; i < iterations; i++) {
+    for (int j = 0; j < objects.size(); j++) {
+      ReflectiveSerializer::read(objects[j], contents[j]);
+    }
+  }
+  qint64 reflectiveRead = timer.nsecsElapsed();
+
+  timer.restart();
+  for (int i = 0; i < iterations; i++) {
+    for (int j = 0; j < objects.size(); j++) {
+      objects[j]->fromJsonObject(contents[j]);
+    }
+  }
+  qint64 tableRead = timer.nsecsElapsed();
+
+  std::cout << objects.size() * iterations << " objects: write reflective "
+            << reflectiveWrite / 1000 << " us, table " << tableWrite / 1000
+            << " us; read reflective " << reflectiveRead / 1000
+            << " us, table " << tableRead / 1000 << " us" << std::endl;
+}
+
+#endif  // PROPERTYTABLE_TEST_CPP
@@ -0,0 +1,128 @@
+#ifndef SCHEDULECACHE_TEST_CPP
+#define SCHEDULECACHE_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <plancsvhelper.h>
+#include <schedulecache.h>
+#include <QDir>
+#include <QFile>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+Plan* readScheduledPlan() {
+  QFile examsIntervals(":/data/scheduled/pruef-intervalle.csv");
+  QFile exams(":/data/scheduled/pruefungen.csv");
+  QFile groupsExams(":/data/scheduled/zuege-pruef.csv");
+  QFile groupsExamsPref(":/data/scheduled/zuege-pruef-pref2.csv");
+  PlanCsvDevices devices;
+  devices.examsIntervals = &examsIntervals;
+  devices.exams = &exams;
+  devices.groupsExams = &groupsExams;
+  devices.groupsExamsPref = &groupsExamsPref;
+  PlanCsvHelper helper(devices);
+  return helper.readPlan();
+}
+
+bool storeScheduledResult(ScheduleCache& cache, Plan* plan) {
+  QFile result(":/data/scheduled/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv");
+  return cache.store(plan, &result);
+}
+}  // namespace
+
+TEST(scheduleCacheTests, fingerprintIsStable) {
+  QSharedPointer<Plan> first = getValidPlan();
+  QSharedPointer<Plan> second = getValidPlan();
+  QByteArray fingerprint = ScheduleCache::createFingerprint(first.get());
+  EXPECT_EQ(fingerprint.size(), 64);
+  EXPECT_EQ(fingerprint, ScheduleCache::createFingerprint(second.get()));
+  EXPECT_TRUE(ScheduleCache::createFingerprint(nullptr).isEmpty());
+}
+
+TEST(scheduleCacheTests, fingerprintChangesWithSolverInputs) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QByteArray fingerprint = ScheduleCache::createFingerprint(plan.get());
+  Group* group = plan->getGroups()[0];
+  group->setExamsPerDay(group->getExamsPerDay() + 1);
+  EXPECT_NE(fingerprint, ScheduleCache::createFingerprint(plan.get()));
+}
+
+TEST(scheduleCacheTests, fingerprintIgnoresSchedule) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QByteArray fingerprint = ScheduleCache::createFingerprint(plan.get());
+  Timeslot* timeslot = plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0];
+  timeslot->addModule(plan->getModules()[0]);
+  EXPECT_EQ(fingerprint, ScheduleCache::createFingerprint(plan.get()));
+}
+
+TEST(scheduleCacheTests, applyReturnsFalseWithoutResult) {
+  QTemporaryDir directory;
+  ScheduleCache cache(directory.path());
+  QScopedPointer<Plan> plan(readScheduledPlan());
+  ASSERT_NE(plan.get(), nullptr);
+  EXPECT_FALSE(cache.contains(plan.get()));
+  EXPECT_FALSE(cache.apply(plan.get()));
+}
+
+TEST(scheduleCacheTests, storedResultGetsAppliedToEqualPlan) {
+  QTemporaryDir directory;
+  ScheduleCache cache(directory.path() + "/cache");
+  QScopedPointer<Plan> solvedPlan(readScheduledPlan());
+  ASSERT_NE(solvedPlan.get(), nullptr);
+  ASSERT_TRUE(storeScheduledResult(cache, solvedPlan.get()));
+
+  // A new cache object for the same directory simulates a restart
+  ScheduleCache restartedCache(directory.path() + "/cache");
+  QScopedPointer<Plan> plan(readScheduledPlan());
+  ASSERT_NE(plan.get(), nullptr);
+  EXPECT_TRUE(restartedCache.contains(plan.get()));
+  ASSERT_TRUE(restartedCache.apply(plan.get()));
+  ASSERT_GE(
+      plan->getWeeks()[1]->getDays()[1]->getTimeslots()[2]->getModules().size(),
+      1);
+  EXPECT_EQ(plan->getWeeks()[1]
+                ->getDays()[1]
+                ->getTimeslots()[2]
+                ->getModules()[0]
+                ->getNumber(),
+            "30.2476");
+}
+
+TEST(scheduleCacheTests, changedPlanDoesNotUseStoredResult) {
+  QTemporaryDir directory;
+  ScheduleCache cache(directory.path());
+  QScopedPointer<Plan> plan(readScheduledPlan());
+  ASSERT_NE(plan.get(), nullptr);
+  ASSERT_TRUE(storeScheduledResult(cache, plan.get()));
+
+  Module* module = plan->getModules()[0];
+  module->setExamDuration(module->getExamDuration() == 1 ? 2 : 1);
+  EXPECT_FALSE(cache.contains(plan.get()));
+  EXPECT_FALSE(cache.apply(plan.get()));
+}
+
+TEST(scheduleCacheTests, removeAndClearDeleteResults) {
+  QTemporaryDir directory;
+  ScheduleCache cache(directory.path());
+  QScopedPointer<Plan> plan(readScheduledPlan());
+  ASSERT_NE(plan.get(), nullptr);
+  ASSERT_TRUE(storeScheduledResult(cache, plan.get()));
+  EXPECT_TRUE(cache.remove(plan.get()));
+  EXPECT_FALSE(cache.contains(plan.get()));
+
+  ASSERT_TRUE(storeScheduledResult(cache, plan.get()));
+  QFile otherFile(directory.path() + "/other.csv");
+  ASSERT_TRUE(otherFile.open(QIODevice::WriteOnly));
+  otherFile.close();
+  cache.clear();
+  EXPECT_FALSE(cache.contains(plan.get()));
+  EXPECT_TRUE(otherFile.exists());
+}
+
+#endif  // SCHEDULECACHE_TEST_CPP
@@ -0,0 +1,132 @@
+#ifndef SCHEDULEMETRICS_TEST_CPP
+#define SCHEDULEMETRICS_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <schedulemetrics.h>
+#include <QSharedPointer>
+#include <random>
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+/**
+ *  Computes the criteria by looking at every day of a regular 3x6x6 plan
+ */
+GroupMetrics reference(const SlotMask& occupancy) {
+  GroupMetrics metrics;
+  QVector<bool> dayUsed;
+  for (int day = 0; day < 18; day++) {
+    int first = -1;
+    int last = -1;
+    int count = 0;
+    for (int position = 0; position < 6; position++) {
+      int slot = day * 6 + position;
+      if (occupancy.testBit(slot)) {
+        first = first < 0 ? position : first;
+        last = position;
+        count++;
+        metrics.saturdaySlots += day % 6 == 5 ? 1 : 0;
+        metrics.lateSlots += position == 5 ? 1 : 0;
+      }
+    }
+    metrics.occupiedSlots += count;
+    if (count > 0) {
+      metrics.gaps += last - first + 1 - count;
+    }
+    dayUsed.append(count > 0);
+  }
+  for (int day = 0; day + 1 < 18; day++) {
+    if (day % 6 != 5 && dayUsed[day] && dayUsed[day + 1]) {
+      metrics.consecutiveDays++;
+    }
+  }
+  return metrics;
+}
+}  // namespace
+
+TEST(scheduleMetricsTests, criteriaOfOneGroup) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  ScheduleMetrics metrics(plan.get());
+  ASSERT_EQ(metrics.getSlotCount(), 108);
+  SlotMask occupancy(108);
+  // Two exams with two free timeslots between them on monday
+  occupancy.setBit(0);
+  occupancy.setBit(3);
+  // Tuesday directly after monday, in the last timeslot
+  occupancy.setBit(11);
+  // Saturday of the first week and monday of the second week
+  occupancy.setBit(32);
+  occupancy.setBit(36);
+
+  GroupMetrics result = metrics.evaluate(occupancy);
+  EXPECT_EQ(result.occupiedSlots, 5);
+  EXPECT_EQ(result.gaps, 2);
+  EXPECT_EQ(result.consecutiveDays, 1);
+  EXPECT_EQ(result.saturdaySlots, 1);
+  EXPECT_EQ(result.lateSlots, 1);
+  EXPECT_EQ(result, reference(occupancy));
+  EXPECT_EQ(result.score(), 5);
+  MetricWeights weights;
+  weights.gaps = 10;
+  EXPECT_EQ(result.score(weights), 23);
+
+  EXPECT_EQ(metrics.evaluate(SlotMask(108)), GroupMetrics());
+  EXPECT_EQ(metrics.evaluate(SlotMask(12, true)), GroupMetrics());
+}
+
+TEST(scheduleMetricsTests, lateSlotCountIsConfigurable) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  ScheduleMetrics metrics(plan.get(), 3);
+  SlotMask occupancy(108);
+  occupancy.setBit(2);
+  occupancy.setBit(3);
+  occupancy.setBit(5);
+  EXPECT_EQ(metrics.evaluate(occupancy).lateSlots, 2);
+}
+
+TEST(scheduleMetricsTests, randomSchedulesMatchReference) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  ScheduleMetrics metrics(plan.get());
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> slotDistribution(-1, 107);
+  int moduleCount = plan->getModules().size();
+  for (int run = 0; run < 20; run++) {
+    QVector<qint32> assignments(moduleCount);
+    for (qint32& assignment : assignments) {
+      assignment = slotDistribution(generator);
+    }
+    QVector<SlotMask> occupancy = metrics.getOccupancy(assignments);
+    ASSERT_EQ(occupancy.size(), plan->getGroups().size());
+    QVector<GroupMetrics> result = metrics.evaluate(occupancy);
+    GroupMetrics total;
+    for (int group = 0; group < occupancy.size(); group++) {
+      EXPECT_EQ(result[group], reference(occupancy[group]));
+      total += reference(occupancy[group]);
+    }
+    EXPECT_EQ(ScheduleMetrics::sum(result), total);
+    EXPECT_EQ(metrics.evaluateTotal(assignments), total);
+  }
+  EXPECT_TRUE(metrics.getOccupancy(QVector<qint32>(3, 0)).isEmpty());
+}
+
+TEST(scheduleMetricsTests, occupancyOfPlanMatchesAssignments) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QList<Timeslot*> timeslots = getTimeslots(plan.get());
+  for (Timeslot* timeslot : timeslots) {
+    timeslot->setModules({});
+  }
+  QList<Module*> modules = plan->getModules();
+  QVector<qint32> assignments(modules.size(), -1);
+  for (int i = 0; i < modules.size(); i += 3) {
+    assignments[i] = (i * 7) % 108;
+    timeslots[assignments[i]]->addModule(modules[i]);
+  }
+  ScheduleMetrics metrics(plan.get());
+  EXPECT_EQ(metrics.getOccupancy(plan.get()),
+            metrics.getOccupancy(assignments));
+}
+
+#endif  // SCHEDULEMETRICS_TEST_CPP
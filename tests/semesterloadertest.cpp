@@ -0,0 +1,74 @@
+#ifndef SEMESTERLOADER_TEST_CPP
+#define SEMESTERLOADER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <semesterloader.h>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QScopedPointer>
+#include <iostream>
+#include "testdatahelper.h"
+
+using namespace testing;
+
+TEST(semesterLoaderTests, createsSamePlansAsFromJsonObject) {
+  QJsonObject content = getSemesterJson(4);
+  Semester expected;
+  expected.fromJsonObject(content);
+  QList<Plan*> expectedPlans = expected.getPlans();
+
+  QScopedPointer<Semester> semester(SemesterLoader::load(content));
+  QList<Plan*> plans = semester->getLoadedPlans();
+  ASSERT_EQ(plans.size(), expectedPlans.size());
+  for (int i = 0; i < plans.size(); i++) {
+    EXPECT_EQ(plans[i]->parent(), semester.data());
+    EXPECT_EQ(plans[i]->getContentHash(), expectedPlans[i]->getContentHash());
+    EXPECT_EQ(plans[i]->toJsonObject(), expectedPlans[i]->toJsonObject());
+  }
+  EXPECT_EQ(semester->getContentHash(), expected.getContentHash());
+}
+
+TEST(semesterLoaderTests, preparedPlanResolvesReferences) {
+  QJsonObject content = getValidJsonPlan();
+  PreparedPlan prepared = SemesterLoader::prepare(content);
+  EXPECT_EQ(prepared.groups.size(),
+            content.value("groups").toArray().size());
+  EXPECT_EQ(prepared.modules.size(),
+            content.value("modules").toArray().size());
+  EXPECT_TRUE(prepared.content.value("modules").toArray().isEmpty());
+
+  QScopedPointer<Plan> plan(SemesterLoader::createPlan(prepared));
+  QSharedPointer<Plan> expected = getValidPlan();
+  EXPECT_EQ(plan->getContentHash(), expected->getContentHash());
+}
+
+/**
+ *  Compares the loader with Semester::fromJsonObject for growing numbers of
+ * plans. Run with --gtest_also_run_disabled_tests.
+ */
+TEST(semesterLoaderTests, DISABLED_benchmarkAgainstSequentialLoading) {
+  for (int planCount = 1; planCount <= 64; planCount *= 2) {
+    QJsonObject content = getSemesterJson(planCount);
+    QElapsedTimer timer;
+
+    timer.start();
+    {
+      Semester semester;
+      semester.fromJsonObject(content);
+      semester.getPlans();
+    }
+    qint64 sequential = timer.nsecsElapsed();
+
+    timer.restart();
+    { QScopedPointer<Semester> semester(SemesterLoader::load(content)); }
+    qint64 parallel = timer.nsecsElapsed();
+
+    std::cout << planCount << " plans: sequential " << sequential / 1000
+              << " us, parallel " << parallel / 1000 << " us, speedup "
+              << static_cast<double>(sequential) / qMax<qint64>(1, parallel)
+              << std::endl;
+  }
+}
+
+#endif  // SEMESTERLOADER_TEST_CPP
@@ -0,0 +1,176 @@
+#ifndef SEMESTER_TEST_CPP
+#define SEMESTER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <QJsonArray>
+#include <QPointer>
+#include <QSharedPointer>
+#include "semester.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+TEST(semesterTests, plansAreLoadedOnFirstAccess) {
+  QJsonObject content = getSemesterJson(3);
+  Semester semester;
+  semester.fromJsonObject(content);
+
+  EXPECT_EQ(semester.getPlanCount(), 3);
+  EXPECT_TRUE(semester.getLoadedPlans().isEmpty());
+  EXPECT_EQ(semester.toJsonObject().value("plans"), content.value("plans"));
+
+  Plan* plan = semester.getPlan(1);
+  ASSERT_NE(plan, nullptr);
+  EXPECT_EQ(plan->getName(), "Plan 1");
+  EXPECT_EQ(plan->parent(), &semester);
+  EXPECT_THAT(semester.getLoadedPlans(), ElementsAre(plan));
+  EXPECT_FALSE(semester.isPlanLoaded(0));
+  EXPECT_EQ(semester.getPlan(1), plan);
+  EXPECT_EQ(semester.getPlan(3), nullptr);
+  QJsonArray plans = semester.toJsonObject().value("plans").toArray();
+  ASSERT_EQ(plans.size(), 3);
+  EXPECT_EQ(plans[0], content.value("plans").toArray()[0]);
+  EXPECT_EQ(plans[1].toObject(), plan->toJsonObject());
+
+  EXPECT_EQ(semester.getPlans().size(), 3);
+  EXPECT_EQ(semester.getLoadedPlans().size(), 3);
+}
+
+TEST(semesterTests, unloadedPlansKeepTheirContent) {
+  Semester semester;
+  semester.fromJsonObject(getSemesterJson(2));
+  QPointer<Plan> plan = semester.getPlan(0);
+  ASSERT_FALSE(plan.isNull());
+  plan->setName("Bearbeitet");
+  quint64 planHash = plan->getContentHash();
+  quint64 semesterHash = semester.getContentHash();
+
+  EXPECT_EQ(semester.unloadIdlePlans(0), 1);
+  EXPECT_TRUE(plan.isNull());
+  EXPECT_FALSE(semester.isPlanLoaded(0));
+  EXPECT_EQ(semester.getContentHash(), semesterHash);
+
+  Plan* reloaded = semester.getPlan(0);
+  ASSERT_NE(reloaded, nullptr);
+  EXPECT_EQ(reloaded->getName(), "Bearbeitet");
+  EXPECT_EQ(reloaded->getContentHash(), planHash);
+  EXPECT_EQ(semester.getContentHash(), semesterHash);
+}
+
+TEST(semesterTests, loadingDoesNotChangeTheHash) {
+  Semester semester;
+  semester.fromJsonObject(getSemesterJson(2));
+  quint64 semesterHash = semester.getContentHash();
+  int hashChanges = 0;
+  QObject::connect(&semester, &Semester::contentHashChanged,
+                   [&hashChanges]() { hashChanges++; });
+
+  Plan* plan = semester.getPlan(0);
+  ASSERT_NE(plan, nullptr);
+  EXPECT_EQ(semester.getContentHash(), semesterHash);
+  EXPECT_EQ(hashChanges, 0);
+
+  plan->setName("Bearbeitet");
+  EXPECT_NE(semester.getContentHash(), semesterHash);
+  EXPECT_EQ(hashChanges, 1);
+  plan->setName("Plan 0");
+  EXPECT_EQ(semester.getContentHash(), semesterHash);
+}
+
+TEST(semesterTests, hashDependsOnlyOnContent) {
+  QJsonObject content = getSemesterJson(2);
+  Semester semester;
+  semester.fromJsonObject(content);
+
+  // The same plans, created before they are added
+  Semester created;
+  created.fromJsonObject(content);
+  QList<Plan*> plans;
+  for (const QJsonValue& planJson : content.value("plans").toArray()) {
+    Plan* plan = new Plan(&created);
+    plan->fromJsonObject(planJson.toObject());
+    plans.append(plan);
+  }
+  created.setPlans(plans);
+  EXPECT_EQ(created.getContentHash(), semester.getContentHash());
+
+  // The same ids with another content
+  QJsonArray plansJson = content.value("plans").toArray();
+  QJsonObject planJson = plansJson[1].toObject();
+  planJson.insert("modules", QJsonArray());
+  plansJson[1] = planJson;
+  content.insert("plans", plansJson);
+  Semester changed;
+  changed.fromJsonObject(content);
+  EXPECT_NE(changed.getContentHash(), semester.getContentHash());
+}
+
+TEST(semesterTests, emptyPlanIsNotLoaded) {
+  QJsonObject content = getSemesterJson(0);
+  content.insert("plans", QJsonArray{QJsonObject()});
+  Semester semester;
+  semester.fromJsonObject(content);
+
+  EXPECT_FALSE(semester.isPlanLoaded(0));
+  EXPECT_EQ(semester.toJsonObject().value("plans").toArray().size(), 1);
+  EXPECT_NE(semester.getPlan(0), nullptr);
+  EXPECT_TRUE(semester.isPlanLoaded(0));
+}
+
+TEST(semesterTests, loadingAndUnloadingEmitsPlansChanged) {
+  Semester semester;
+  semester.fromJsonObject(getSemesterJson(2));
+  QList<QList<Plan*>> changes;
+  QObject::connect(&semester, &Semester::plansChanged,
+                   [&changes](const QList<Plan*>& plans) {
+                     changes.append(plans);
+                   });
+
+  Plan* plan = semester.getPlan(1);
+  ASSERT_EQ(changes.size(), 1);
+  EXPECT_THAT(changes[0], ElementsAre(nullptr, plan));
+  ASSERT_TRUE(semester.unloadPlan(1));
+  ASSERT_EQ(changes.size(), 2);
+  EXPECT_THAT(changes[1], ElementsAre(nullptr, nullptr));
+  semester.getPlans();
+  EXPECT_EQ(changes.size(), 3);
+  semester.getPlans();
+  EXPECT_EQ(changes.size(), 3);
+}
+
+TEST(semesterTests, findByIdLoadsOnlyTheContainingPlan) {
+  QJsonObject content = getSemesterJson(3);
+  Semester semester;
+  semester.fromJsonObject(content);
+  QJsonObject planJson = content.value("plans").toArray()[2].toObject();
+
+  SerializableDataObject* plan =
+      semester.findById(QUuid(planJson.value("id").toString()));
+  ASSERT_NE(plan, nullptr);
+  EXPECT_EQ(plan, semester.getPlan(2));
+  EXPECT_FALSE(semester.isPlanLoaded(0));
+  EXPECT_FALSE(semester.isPlanLoaded(1));
+
+  // All plans contain the module, the loaded plan is searched first
+  QJsonObject moduleJson = planJson.value("modules").toArray()[0].toObject();
+  QUuid moduleId(moduleJson.value("id").toString());
+  Module* module = semester.findById<Module>(moduleId);
+  ASSERT_NE(module, nullptr);
+  EXPECT_EQ(module->parent(), plan);
+  EXPECT_FALSE(semester.isPlanLoaded(0));
+  EXPECT_EQ(semester.findById(QUuid::createUuid()), nullptr);
+  EXPECT_FALSE(semester.isPlanLoaded(0));
+}
+
+TEST(semesterTests, foreignPlansAreNotUnloaded) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Semester semester;
+  semester.setPlans({plan.data()});
+  EXPECT_TRUE(semester.isPlanLoaded(0));
+  EXPECT_FALSE(semester.unloadPlan(0));
+  EXPECT_EQ(semester.unloadIdlePlans(0), 0);
+  EXPECT_EQ(semester.getPlan(0), plan.data());
+}
+
+#endif  // SEMESTER_TEST_CPP
@@ -0,0 +1,142 @@
+#ifndef SOLVERRUNNER_TEST_CPP
+#define SOLVERRUNNER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <feasibleslotindex.h>
+#include <plancsvhelper.h>
+#include <solverrunner.h>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+#include "futurehelper.h"
+#include "plan.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+namespace {
+/**
+ *  Writes the current schedule of plan as result to
+ * path/expected-<seed>/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv
+ */
+bool writeExpectedResult(Plan* plan, const QString& path, int seed) {
+  QString expectedPath = path + "/expected-" + QString::number(seed);
+  if (!QDir().mkpath(expectedPath)) {
+    return false;
+  }
+  PlanCsvHelper helper(expectedPath);
+  return helper.writePlan(plan);
+}
+
+// A stand-in solver, that copies the expected result of its seed
+const QString copyResultScript =
+    "cp ../../expected-{seed}/SPA-ERGEBNIS-PP/SPA-planung-pruef.csv "
+    "SPA-ERGEBNIS-PP/";
+}  // namespace
+
+TEST(solverRunnerTests, scoreCountsUnscheduledModules) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  unschedule(plan.get(), module);
+  QTemporaryDir directory;
+  ASSERT_TRUE(writeExpectedResult(plan.get(), directory.path(), 0));
+  FeasibleSlotIndex index(plan.get());
+  ASSERT_FALSE(index.getFeasibleTimeslots(module).isEmpty());
+  index.getFeasibleTimeslots(module).first()->addModule(module);
+  ASSERT_TRUE(writeExpectedResult(plan.get(), directory.path(), 1));
+  unschedule(plan.get(), module);
+
+  SolverScore unscheduled;
+  SolverScore scheduled;
+  ASSERT_TRUE(SolverRunner::scoreResult(
+      plan.get(), directory.path() + "/expected-0", unscheduled));
+  ASSERT_TRUE(SolverRunner::scoreResult(
+      plan.get(), directory.path() + "/expected-1", scheduled));
+  EXPECT_EQ(unscheduled.unscheduledModules, scheduled.unscheduledModules + 1);
+  EXPECT_TRUE(scheduled < unscheduled);
+  EXPECT_FALSE(unscheduled < scheduled);
+  EXPECT_FALSE(SolverRunner::scoreResult(
+      plan.get(), directory.path() + "/missing", scheduled));
+}
+
+#ifdef Q_OS_UNIX
+TEST(solverRunnerTests, bestResultIsApplied) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  unschedule(plan.get(), module);
+  FeasibleSlotIndex index(plan.get());
+  ASSERT_FALSE(index.getFeasibleTimeslots(module).isEmpty());
+  Timeslot* timeslot = index.getFeasibleTimeslots(module).first();
+
+  QTemporaryDir directory;
+  ASSERT_TRUE(writeExpectedResult(plan.get(), directory.path(), 1));
+  ASSERT_TRUE(writeExpectedResult(plan.get(), directory.path(), 3));
+  timeslot->addModule(module);
+  ASSERT_TRUE(writeExpectedResult(plan.get(), directory.path(), 2));
+  unschedule(plan.get(), module);
+
+  // The run with seed 4 fails
+  SolverRunner runner("/bin/sh",
+                      {"-c", "[ {seed} -ne 4 ] && " + copyResultScript});
+  runner.setRunCount(4);
+  runner.setFirstSeed(1);
+  QFuture<bool> future = runner.run(plan.get(), directory.path() + "/runs");
+  ASSERT_TRUE(waitForFuture(future));
+  ASSERT_TRUE(future.result());
+  EXPECT_EQ(future.progressValue(), 4);
+  EXPECT_TRUE(timeslot->containsModule(module));
+  EXPECT_TRUE(QDir(SolverRunner::getRunPath(directory.path() + "/runs", 3))
+                  .exists("pruefungen.csv"));
+}
+
+TEST(solverRunnerTests, runsAreKilledAfterTimeout) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+  QTemporaryDir directory;
+  SolverRunner runner("/bin/sh", {"-c", "sleep 10"});
+  runner.setRunCount(2);
+  runner.setTimeout(100);
+  QElapsedTimer timer;
+  timer.start();
+  QFuture<bool> future = runner.run(plan.get(), directory.path());
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_FALSE(future.result());
+  EXPECT_LT(timer.elapsed(), 5000);
+}
+
+TEST(solverRunnerTests, runsAreKilledOnCancel) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+  QTemporaryDir directory;
+  SolverRunner runner("/bin/sh", {"-c", "sleep 10"});
+  runner.setRunCount(2);
+  QElapsedTimer timer;
+  timer.start();
+  QFuture<bool> future = runner.run(plan.get(), directory.path());
+  future.cancel();
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_TRUE(future.isCanceled());
+  EXPECT_EQ(future.resultCount(), 0);
+  EXPECT_LT(timer.elapsed(), 5000);
+}
+
+TEST(solverRunnerTests, failingRunsDoNotModifyPlan) {
+  ensureCoreApplication();
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  Timeslot* timeslot = plan->getWeeks()[1]->getDays()[1]->getTimeslots()[1];
+  timeslot->addModule(module);
+  QTemporaryDir directory;
+  SolverRunner runner("/bin/sh", {"-c", "exit 1"});
+  runner.setRunCount(2);
+  QFuture<bool> future = runner.run(plan.get(), directory.path());
+  ASSERT_TRUE(waitForFuture(future));
+  EXPECT_FALSE(future.result());
+  EXPECT_TRUE(timeslot->containsModule(module));
+}
+#endif
+
+#endif  // SOLVERRUNNER_TEST_CPP